@@ -25,14 +25,15 @@ ChiLog::ChiLog() noexcept
 }
 
 //###################################################################
-/** Makes a log entry.*/
+/** Makes a log entry. Rank-0 levels are only printed on world rank 0,
+ * i.e., on location 0 of the first team.*/
 LogStream ChiLog::Log(LOG_LVL level)
 {
   switch (level)
   {
     case LOG_0:
     {
-      if (chi_mpi.location_id == 0)
+      if (chi_mpi.world_location_id == 0)
       {
         std::string header = "[" + std::to_string(chi_mpi.location_id) + "]  ";
         return LogStream(&std::cout, header);
@@ -45,7 +46,7 @@ LogStream ChiLog::Log(LOG_LVL level)
     }
     case LOG_0WARNING:
     {
-      if (chi_mpi.location_id == 0)
+      if (chi_mpi.world_location_id == 0)
       {
         std::string header = "[" + std::to_string(chi_mpi.location_id) + "]  ";
         header += "**WARNING** ";
@@ -59,7 +60,7 @@ LogStream ChiLog::Log(LOG_LVL level)
     }
     case LOG_0ERROR:
     {
-      if (chi_mpi.location_id == 0)
+      if (chi_mpi.world_location_id == 0)
       {
         std::string header = "[" + std::to_string(chi_mpi.location_id) + "]  ";
         header += "**!**ERROR**!** ";
@@ -75,7 +76,7 @@ LogStream ChiLog::Log(LOG_LVL level)
     case LOG_0VERBOSE_1:
     case LOG_0VERBOSE_2:
     {
-      if ((chi_mpi.location_id == 0) && (verbosity >= level))
+      if ((chi_mpi.world_location_id == 0) && (verbosity >= level))
       {
         std::string header = "[" + std::to_string(chi_mpi.location_id) + "]  ";
         return LogStream(&std::cout, header);
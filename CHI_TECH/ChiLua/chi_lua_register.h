@@ -39,6 +39,8 @@ RegisterFunction(chiMeshCreate2DOrthoMesh)
 RegisterFunction(chiMeshCreate3DOrthoMesh)
 RegisterFunction(chiUnpartitionedMeshFromVTU)
 RegisterFunction(chiUnpartitionedMeshFromEnsightGold)
+RegisterFunction(chiUnpartitionedMeshFromBinary)
+RegisterFunction(chiUnpartitionedMeshExportToBinary)
 
 
 //module:Mesh Utilities
@@ -67,6 +69,7 @@ RegisterFunction(chiEdgeLoopSplitByAngle)
     RegisterFunction(chiRegionExportMeshToPython)
     RegisterFunction(chiRegionExportMeshToObj)
     RegisterFunction(chiRegionExportMeshToVTK)
+    RegisterFunction(chiRegionExportPartitionToFile)
 //  SurfaceMesh
     RegisterFunction(chiSurfaceMeshCreate)
     RegisterFunction(chiSurfaceMeshCreateFromArrays)
@@ -100,6 +103,7 @@ RegisterFunction(chiEdgeLoopSplitByAngle)
       RegisterConstant(VOLUMEMESHER_PREDEFINED2D, 3);
       RegisterConstant(VOLUMEMESHER_EXTRUDER,     4);
       RegisterConstant(VOLUMEMESHER_PREDEFINED3D, 5)
+      RegisterConstant(VOLUMEMESHER_PARTITION_FILE, 6)
     RegisterFunction(chiVolumeMesherExecute)
     RegisterFunction(chiVolumeMesherSetProperty)
       RegisterConstant(FORCE_POLYGONS,   1);
@@ -177,10 +181,12 @@ RegisterFunction(chiPhysicsMaterialGetProperty)
 RegisterFunction(chiPhysicsTransportXSCreate)
 RegisterFunction(chiPhysicsTransportXSSet)
 RegisterFunction(chiPhysicsTransportXSMakeCombined)
+RegisterFunction(chiPhysicsTransportXSExportToChiXSFile)
 RegisterFunction(chiGetFieldFunctionList)
 RegisterFunction(chiExportFieldFunctionToVTK)
 RegisterFunction(chiExportFieldFunctionToVTKG)
 RegisterFunction(chiExportMultiFieldFunctionToVTKG)
+RegisterFunction(chiExportMultiFieldFunctionToVTK)
 
 
 //Property indices
@@ -195,6 +201,7 @@ RegisterConstant(SIMPLEXS0,              20);
 RegisterConstant(SIMPLEXS1,              21);
 RegisterConstant(PDT_XSFILE,             22);
 RegisterConstant(EXISTING,               23);
+RegisterConstant(CHI_XSFILE,             24);
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 #include "../../Modules/module_lua_register.h"
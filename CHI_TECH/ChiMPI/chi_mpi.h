@@ -25,12 +25,25 @@ public:
 };
 
 //################################################################### Class def
-/**An object for storing various MPI states.*/
+/**An object for storing various MPI states.
+ *
+ * For angular or energy decomposition the world is split into teams.
+ * Every team holds a complete copy of the same spatial partition and
+ * location_id, process_count and comm refer to the team, which is all
+ * that spatial code ever sees. across_teams_comm connects the ranks
+ * holding the same spatial location in the different teams.*/
 class ChiMPI
 {
 public:
   int location_id;
   int process_count;
+  MPI_Comm comm;                ///< Spatial communicator (team)
+
+  int world_location_id;
+  int world_process_count;
+  int num_teams;
+  int team_id;
+  MPI_Comm across_teams_comm;   ///< Same location across teams
   MPI_Datatype NODE_INFO_C;
   MPI_Datatype TRIFACE_INFO_C;
   MPI_Datatype CELL_INFO_C;
@@ -42,9 +55,17 @@ public:
   {
     location_id = 0;
     process_count = 1;
+    comm = MPI_COMM_WORLD;
+
+    world_location_id = 0;
+    world_process_count = 1;
+    num_teams = 1;
+    team_id = 0;
+    across_teams_comm = MPI_COMM_SELF;
   }
   //01
   void Initialize();
+  void SplitTeams();
 
   //02
 //  void BroadcastCellSets();
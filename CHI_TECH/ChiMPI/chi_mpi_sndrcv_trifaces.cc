@@ -39,7 +39,7 @@ void ChiMPI::BroadcastTriFaces(std::vector<chi_mesh::Face> *faces)
   for (int k=1;k<this->process_count; k++)
   {
     MPI_Send(face_stack,faces->size(),
-             TRIFACE_INFO_C, k,124,MPI_COMM_WORLD);
+             TRIFACE_INFO_C, k,124,comm);
   }
   delete [] face_stack;
 
@@ -54,7 +54,7 @@ void ChiMPI::ReceiveTriFaces(std::vector<chi_mesh::Face> *faces)
   //                                                   be received
   int face_count;
   MPI_Status status;
-  MPI_Probe(0, 124, MPI_COMM_WORLD, &status);
+  MPI_Probe(0, 124, comm, &status);
 
   MPI_Get_count(&status, TRIFACE_INFO_C, &face_count);
 
@@ -70,7 +70,7 @@ void ChiMPI::ReceiveTriFaces(std::vector<chi_mesh::Face> *faces)
   FACE_INFO* face_stack = new FACE_INFO[face_count];
 
   MPI_Recv(face_stack,face_count,
-           TRIFACE_INFO_C, 0,124,MPI_COMM_WORLD,&status);
+           TRIFACE_INFO_C, 0,124,comm,&status);
 
   for (int k=0;k<face_count;k++)
   {
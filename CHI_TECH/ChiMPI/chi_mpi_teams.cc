@@ -0,0 +1,43 @@
+#include "chi_mpi.h"
+
+#include <iostream>
+
+//###################################################################
+/** Splits the world into num_teams teams of consecutive ranks.
+ * Afterwards location_id, process_count and comm refer to the team and
+ * across_teams_comm connects the ranks with the same team location, ranked
+ * by team id. Requires world_location_id and world_process_count to be set.*/
+void ChiMPI::SplitTeams()
+{
+  comm = MPI_COMM_WORLD;
+  team_id = 0;
+  across_teams_comm = MPI_COMM_SELF;
+  location_id = world_location_id;
+  process_count = world_process_count;
+
+  if (num_teams <= 1)
+  {
+    num_teams = 1;
+    return;
+  }
+
+  if ((world_process_count % num_teams) != 0)
+  {
+    if (world_location_id == 0)
+      std::cerr << "Number of processes " << world_process_count
+                << " is not divisible by the number of teams "
+                << num_teams << "." << std::endl;
+    MPI_Abort(MPI_COMM_WORLD,EXIT_FAILURE);
+  }
+
+  int team_size = world_process_count/num_teams;
+  team_id = world_location_id/team_size;
+  int team_location = world_location_id%team_size;
+
+  MPI_Comm_split(MPI_COMM_WORLD,team_id,world_location_id,&comm);
+  MPI_Comm_split(MPI_COMM_WORLD,team_location,world_location_id,
+                 &across_teams_comm);
+
+  MPI_Comm_rank(comm,&location_id);
+  MPI_Comm_size(comm,&process_count);
+}
@@ -18,12 +18,12 @@ void SpatialDiscretization_PWL::
   std::vector<int> locI_block_addr(chi_mpi.process_count, 0);
   MPI_Allgather(&cfem_local_block_address,1,MPI_INT,
                 locI_block_addr.data()   ,1,MPI_INT,
-                MPI_COMM_WORLD);
+                chi_mpi.comm);
 
   if (chi_mpi.location_id == 0)
     for (auto locI : locI_block_addr)
       printf("Block address = %d\n", locI);
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
   //**************************************** DEFINE UTILITIES
 
@@ -214,7 +214,7 @@ void SpatialDiscretization_PWL::
 
   MPI_Alltoall(sendcount.data(), 1, MPI_INT,
                recvcount.data(), 1, MPI_INT,
-               MPI_COMM_WORLD);
+               chi_mpi.comm);
 
   //=================================== Step 3
   // We now establish send displacements and
@@ -261,7 +261,7 @@ void SpatialDiscretization_PWL::
                 recvcount.data(),
                 recv_displs.data(),
                 MPI_INT,
-                MPI_COMM_WORLD);
+                chi_mpi.comm);
 
   //======================================== Deserialze data
   chi_log.Log(LOG_0VERBOSE_1) << "Deserialize data.";
@@ -305,5 +305,5 @@ void SpatialDiscretization_PWL::
   }
 
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 }
\ No newline at end of file
@@ -195,7 +195,7 @@ BuildDFEMSparsityPattern(chi_mesh::MeshContinuum *grid,
   std::vector<int> recv_counts(chi_mpi.process_count,0);
 
   MPI_Alltoall(send_counts.data(), 1, MPI_INT,
-               recv_counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+               recv_counts.data(), 1, MPI_INT, chi_mpi.comm);
 
   //============================================= Build receive displacements
   std::vector<int> recv_displs(chi_mpi.process_count,0);
@@ -218,9 +218,9 @@ BuildDFEMSparsityPattern(chi_mesh::MeshContinuum *grid,
                 recv_counts.data(),
                 recv_displs.data(),
                 MPI_INT,
-                MPI_COMM_WORLD);
+                chi_mpi.comm);
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
   //============================================= Deserialize
   {
@@ -235,7 +235,7 @@ BuildDFEMSparsityPattern(chi_mesh::MeshContinuum *grid,
   }
 
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
   chi_log.Log(LOG_0) << "Done building DFEM sparsity pattern";
 
 }
@@ -64,6 +64,7 @@ namespace chi_math
                     const size_t c,
                     const MatDbl& A );
   void   GaussElimination(MatDbl& A, VecDbl& b, int n);
+  void   GaussElimination(MatDbl& A, MatDbl& B, int n);
   MatDbl InverseGEPivoting(const MatDbl& A);
   MatDbl Inverse(const MatDbl& A);
 
@@ -63,6 +63,7 @@ private:
                      FieldFunctionContext* ff_ctx);
 public:
   void ExportPython(std::string base_name);
+  std::vector<double> GetPointValues(size_t ff_index=0);
 };
 
 #endif
\ No newline at end of file
@@ -1,8 +1,12 @@
 #include "chi_ffinter_line.h"
 #include <ChiMath/SpatialDiscretization/PiecewiseLinear/pwl.h>
+#include "ChiMesh/MeshContinuum/chi_meshcontinuum.h"
+#include "ChiMesh/Raytrace/raytrace_bvh.h"
 
 #include <chi_log.h>
+#include <chi_mpi.h>
 extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
 
 //###################################################################
 /**Executes the interpolation.*/
@@ -97,6 +101,9 @@ CFEMInterpolate(Vec field,
 
     int cell_local_index = ff_ctx->interpolation_points_ass_cell[c];
     auto cell_fe_view = spatial_dm->MapFeViewL(cell_local_index);
+    //Points off a 2D or 1D mesh are evaluated at their projection
+    chi_mesh::Vector3 point =
+      grid_view->GetCellBVH().ProjectToMeshDimension(interpolation_points[c]);
 
     double weighted_value = 0.0;
     for (int i=0; i<cell_fe_view->dofs; i++)
@@ -109,7 +116,7 @@ CFEMInterpolate(Vec field,
       double weight=0.0;
       //Here I use c in interpolation_points because the vector should
       //be one-to-one with it.
-      weight = cell_fe_view->ShapeValue(i, interpolation_points[c]);
+      weight = cell_fe_view->ShapeValue(i, point);
 
       node_value *= weight;
 
@@ -144,6 +151,9 @@ void chi_mesh::FieldFunctionInterpolationLine::
 
     int cell_local_index = ff_ctx->interpolation_points_ass_cell[c];
     auto cell_fe_view = spatial_dm->MapFeViewL(cell_local_index);
+    //Points off a 2D or 1D mesh are evaluated at their projection
+    chi_mesh::Vector3 point =
+      grid_view->GetCellBVH().ProjectToMeshDimension(interpolation_points[c]);
 
     double weighted_value = 0.0;
     for (int i=0; i<cell_fe_view->dofs; i++)
@@ -156,7 +166,7 @@ void chi_mesh::FieldFunctionInterpolationLine::
       double weight=0.0;
       //Here I use c in interpolation_points because the vector should
       //be one-to-one with it.
-      weight = cell_fe_view->ShapeValue(i, interpolation_points[c]);
+      weight = cell_fe_view->ShapeValue(i, point);
 
       node_value *= weight;
 
@@ -166,4 +176,40 @@ void chi_mesh::FieldFunctionInterpolationLine::
     ff_ctx->interpolation_points_values[c] = weighted_value;
   }//for ass cell
 
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Returns the interpolated value of a field function at every point of
+ * the line, combined over all locations. Points located by more than one
+ * location get the average of their values and points outside the mesh
+ * get zero. This call is collective.*/
+std::vector<double> chi_mesh::FieldFunctionInterpolationLine::
+  GetPointValues(size_t ff_index)
+{
+  const size_t num_points = interpolation_points.size();
+  std::vector<double> local_values(num_points,0.0);
+  std::vector<double> local_counts(num_points,0.0);
+
+  if (ff_index < ff_contexts.size())
+  {
+    FieldFunctionContext* ff_ctx = ff_contexts[ff_index];
+    for (size_t p=0; p<ff_ctx->interpolation_points_values.size(); ++p)
+      if (ff_ctx->interpolation_points_ass_cell[p] >= 0)
+      {
+        local_values[p] = ff_ctx->interpolation_points_values[p];
+        local_counts[p] = 1.0;
+      }
+  }
+
+  std::vector<double> values(num_points,0.0);
+  std::vector<double> counts(num_points,0.0);
+  MPI_Allreduce(local_values.data(),values.data(),num_points,
+                MPI_DOUBLE,MPI_SUM,MPI_COMM_WORLD);
+  MPI_Allreduce(local_counts.data(),counts.data(),num_points,
+                MPI_DOUBLE,MPI_SUM,MPI_COMM_WORLD);
+
+  for (size_t p=0; p<num_points; ++p)
+    if (counts[p] > 0.0) values[p] /= counts[p];
+
+  return values;
+}
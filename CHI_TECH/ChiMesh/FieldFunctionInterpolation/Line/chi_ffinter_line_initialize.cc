@@ -3,6 +3,7 @@
 #include "ChiMesh/Cell/cell_slab.h"
 #include "ChiMesh/Cell/cell_polygon.h"
 #include "ChiMesh/Cell/cell_polyhedron.h"
+#include "ChiMesh/Raytrace/raytrace_bvh.h"
 
 #include <chi_log.h>
 
@@ -17,7 +18,8 @@ extern ChiLog chi_log;
  * face side-by-side.
  *
  * The second step is to find the cell associated with each point in
- * in the line.
+ * in the line. Points are located through the grid's cell
+ * bounding-volume hierarchy.
  *
  * Third step is to upload node indices for each-cell-point pair so that
  * the value can be interpolated.*/
@@ -64,137 +66,8 @@ Initialize()
 
       //================================================== Find a home for each
       //                                                   point
-      for (const auto& cell : grid_view->local_cells)
-      {
-        int cell_local_index = cell.local_id;
-
-        //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% SLAB
-        if (cell.Type() == chi_mesh::CellType::SLAB)
-        {
-          auto slab_cell = (chi_mesh::CellSlab*)(&cell);
-
-          for (int p=0; p<number_of_points; p++)
-          {
-            //Assume each point is inside the cell, now try to disprove it
-            bool is_inside = true;
-            int v0_i = slab_cell->vertex_ids[0];
-            int v1_i = slab_cell->vertex_ids[1];
-
-            chi_mesh::Vector3 v0 = *grid_view->vertices[v0_i];
-            chi_mesh::Vector3 v1 = *grid_view->vertices[v1_i];
-
-            chi_mesh::Vector3 v01 = v1 - v0;
-            chi_mesh::Vector3 v0p = interpolation_points[p] - v0;
-
-            double v01_norm = v01.Norm();
-            double projection = v01.Dot(v0p)/v01_norm;
-
-            if ((v0p.Dot(v01)<0.0) or (projection>v01_norm))
-            {
-              is_inside = false;
-            }
-
-            if (is_inside and interpolation_points_ass_cell[p]<0)
-            {
-              interpolation_points_ass_cell[p] = cell_local_index;
-              chi_log.Log(LOG_ALLVERBOSE_2)
-                << "Cell inter section found  " << p;
-            }
-
-          }//for each point
-        }//if slab
-
-          //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% POLYGON
-        else if (cell.Type() == chi_mesh::CellType::POLYGON)
-        {
-          auto poly_cell = (chi_mesh::CellPolygon*)(&cell);
-
-          size_t num_edges = poly_cell->faces.size();
-
-          for (int p=0; p<number_of_points; p++)
-          {
-            //Assume each point is inside the cell, now try to disprove it
-            bool is_inside = true;
-            //Form a plane for each edge
-            for (size_t e=0; e<num_edges; e++)
-            {
-              chi_mesh::Vector3 nref(0.0, 0.0, 1.0);
-              int v0_i = poly_cell->faces[e].vertex_ids[0];
-              int v1_i = poly_cell->faces[e].vertex_ids[1];
-
-              chi_mesh::Vector3 v0 = *grid_view->vertices[v0_i];
-              chi_mesh::Vector3 v1 = *grid_view->vertices[v1_i];
-
-              chi_mesh::Vector3 v01 = v1 - v0;
-              chi_mesh::Vector3   n = v01.Cross(nref);
-              n = n/n.Norm();
-
-              chi_mesh::Vector3 v0p = interpolation_points[p] - v0;
-              v0p=v0p/v0p.Norm();
-
-              if (n.Dot(v0p)>0.0)
-              {
-                is_inside = false;
-                break;
-              }
-            }//for edge
-
-            if (is_inside)
-            {
-              interpolation_points_ass_cell[p] = cell_local_index;
-              chi_log.Log(LOG_ALLVERBOSE_2)
-                << "Cell inter section found  " << p;
-            }
-
-          }//for each point
-        }//if polygon cell
-
-          //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% POLYHEDRON
-        else if (cell.Type() == chi_mesh::CellType::POLYHEDRON)
-        {
-          auto polyh_cell = (chi_mesh::CellPolyhedron*)(&cell);
-
-          size_t num_faces = polyh_cell->faces.size();
-
-          for (int p=0; p<number_of_points; p++)
-          {
-            //Assume each point is inside the cell, now try to disprove it
-            bool is_inside = true;
-            for (size_t f=0; f<num_faces; f++)
-            {
-              std::vector<std::vector<int>> edges = polyh_cell->GetFaceEdges(f);
-              size_t num_edges = edges.size();
-              //Form a plane for each side
-              for (size_t e=0; e<num_edges; e++)
-              {
-                int v0_i = edges[e][0];
-
-                chi_mesh::Vector3 v0 = *grid_view->vertices[v0_i];
-                chi_mesh::Vector3 n  = polyh_cell->faces[f].normal;
-
-                chi_mesh::Vector3 v0p = interpolation_points[p] - v0;
-                v0p=v0p/v0p.Norm();
-
-                if (n.Dot(v0p)>0.0)
-                {
-                  is_inside = false;
-                  break;
-                }
-              }//for e
-              if (!is_inside) break;
-            }//for f
-
-            if (is_inside)
-            {
-              interpolation_points_ass_cell[p] = cell_local_index;
-              chi_log.Log(LOG_ALLVERBOSE_2)
-                << "Cell inter section found  " << p;
-            }
-
-          }//for each point
-
-        }//if polyhedron
-      }//for local cell
+      grid_view->GetCellBVH().FindCells(interpolation_points,
+                                        interpolation_points_ass_cell);
 
       //================================================== Upload node indices that
       //                                                   need mapping
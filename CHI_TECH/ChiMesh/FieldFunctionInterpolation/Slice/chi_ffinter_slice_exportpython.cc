@@ -11,6 +11,8 @@ extern ChiLog chi_log;
 /***/
 void chi_mesh::FieldFunctionInterpolationSlice::ExportPython(std::string base_name)
 {
+  if (chi_mpi.team_id != 0) return;
+
   std::ofstream ofile;
 
   std::string fileName = base_name;
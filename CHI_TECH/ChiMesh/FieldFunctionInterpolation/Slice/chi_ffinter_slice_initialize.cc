@@ -2,17 +2,21 @@
 #include <ChiMesh/Cell/cell_slab.h>
 #include <ChiMesh/Cell/cell_polygon.h>
 #include <ChiMesh/Cell/cell_polyhedron.h>
+#include <ChiMesh/Raytrace/raytrace_bvh.h>
 
 #include <chi_log.h>
 
+#include <algorithm>
+
 extern ChiLog chi_log;
 
 /**Initializes the data structures necessary for interpolation. This is
  * independent of the physics and hence is a routine on its own.
  *
  * The first step of this initialization is to determine which cells
- * are intersected by this plane. For polyhedrons this is evaluated
- * tet-by-tet.
+ * are intersected by this plane. Candidate cells are obtained from the
+ * grid's cell bounding-volume hierarchy and, for polyhedrons, the
+ * intersection is then evaluated tet-by-tet.
  *
  * The second step is find where face-edges are intersected. This will
  * effectively create intersection polygons.*/
@@ -32,12 +36,31 @@ void chi_mesh::FieldFunctionInterpolationSlice::
     this->grid_view = field_functions[0]->grid;
   }
 
+  //================================================== Find candidate cells
+  //Only cells whose bounding boxes are cut by the plane need the detailed
+  //check. In 2D every cell lies in the slice.
+  std::vector<int> candidate_cells;
+  bool is_2d = (grid_view->local_cells.size() > 0) and
+               (grid_view->local_cells[0].Type() == chi_mesh::CellType::POLYGON);
+  if (is_2d)
+  {
+    candidate_cells.reserve(grid_view->local_cells.size());
+    for (const auto& cell : grid_view->local_cells)
+      candidate_cells.push_back(cell.local_id);
+  }
+  else
+  {
+    grid_view->GetCellBVH().
+      FindCellsIntersectingPlane(this->normal, this->point, candidate_cells);
+    std::sort(candidate_cells.begin(), candidate_cells.end());
+  }
+
   //================================================== Find cells intersecting plane
   intersecting_cell_indices.clear();
 
-  for (const auto& cell : grid_view->local_cells)
+  for (int cell_local_index : candidate_cells)
   {
-    int cell_local_index = cell.local_id;
+    const auto& cell = grid_view->local_cells[cell_local_index];
 
     //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% SLAB
     if (cell.Type() == chi_mesh::CellType::SLAB)
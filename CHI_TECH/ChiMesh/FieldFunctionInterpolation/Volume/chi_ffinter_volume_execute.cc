@@ -3,6 +3,7 @@
 #include <ChiMath/SpatialDiscretization/PiecewiseLinear/pwl.h>
 
 #include <chi_mpi.h>
+extern ChiMPI chi_mpi;
 
 //###################################################################
 /**Executes the volume interpolation.*/
@@ -98,9 +99,9 @@ CFEMInterpolate(Vec field, std::vector<int> &mapping)
   double all_total_volume = 0.0;
   double all_max_value=0.0;
 
-  MPI_Allreduce(&op_value,&all_value,1,MPI_DOUBLE,MPI_SUM,MPI_COMM_WORLD);
-  MPI_Allreduce(&total_volume,&all_total_volume,1,MPI_DOUBLE,MPI_SUM,MPI_COMM_WORLD);
-  MPI_Allreduce(&max_value,&all_max_value,1,MPI_DOUBLE,MPI_MAX,MPI_COMM_WORLD);
+  MPI_Allreduce(&op_value,&all_value,1,MPI_DOUBLE,MPI_SUM,chi_mpi.comm);
+  MPI_Allreduce(&total_volume,&all_total_volume,1,MPI_DOUBLE,MPI_SUM,chi_mpi.comm);
+  MPI_Allreduce(&max_value,&all_max_value,1,MPI_DOUBLE,MPI_MAX,chi_mpi.comm);
 
   if (op_type == OP_AVG)
     op_value = all_value/total_volume;
@@ -171,9 +172,9 @@ PWLDInterpolate(std::vector<double>& field, std::vector<int> &mapping)
   double all_total_volume = 0.0;
   double all_max_value;
 
-  MPI_Allreduce(&op_value,&all_value,1,MPI_DOUBLE,MPI_SUM,MPI_COMM_WORLD);
-  MPI_Allreduce(&total_volume,&all_total_volume,1,MPI_DOUBLE,MPI_SUM,MPI_COMM_WORLD);
-  MPI_Allreduce(&max_value,&all_max_value,1,MPI_DOUBLE,MPI_MAX,MPI_COMM_WORLD);
+  MPI_Allreduce(&op_value,&all_value,1,MPI_DOUBLE,MPI_SUM,chi_mpi.comm);
+  MPI_Allreduce(&total_volume,&all_total_volume,1,MPI_DOUBLE,MPI_SUM,chi_mpi.comm);
+  MPI_Allreduce(&max_value,&all_max_value,1,MPI_DOUBLE,MPI_MAX,chi_mpi.comm);
 
   if (op_type == OP_AVG)
     op_value = all_value/total_volume;
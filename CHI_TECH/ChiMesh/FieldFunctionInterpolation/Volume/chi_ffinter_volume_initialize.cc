@@ -1,9 +1,12 @@
 #include "chi_ffinter_volume.h"
 #include "ChiMesh/Cell/cell.h"
+#include "ChiMesh/Raytrace/raytrace_bvh.h"
 
 
 #include <chi_log.h>
 
+#include <algorithm>
+
 extern ChiLog chi_log;
 
 //###################################################################
@@ -22,10 +25,27 @@ void chi_mesh::FieldFunctionInterpolationVolume::Initialize()
     this->grid_view = field_functions[0]->grid;
   }
 
+  //================================================== Find candidate cells
+  //When the logical volume is bounded only cells overlapping its box
+  //are tested.
+  std::vector<int> candidate_cells;
+  chi_mesh::BoundingBox lv_box;
+  if ((logical_volume != nullptr) and logical_volume->GetBoundingBox(lv_box))
+  {
+    grid_view->GetCellBVH().FindCellsOverlapping(lv_box, candidate_cells);
+    std::sort(candidate_cells.begin(), candidate_cells.end());
+  }
+  else
+  {
+    candidate_cells.reserve(grid_view->local_cells.size());
+    for (const auto& cell : grid_view->local_cells)
+      candidate_cells.push_back(cell.local_id);
+  }
+
   //================================================== Find cell inside volume
-  for (const auto& cell : grid_view->local_cells)
+  for (int cell_local_index : candidate_cells)
   {
-    int cell_local_index = cell.local_id;
+    const auto& cell = grid_view->local_cells[cell_local_index];
 
     bool inside_logvolume=true;
 
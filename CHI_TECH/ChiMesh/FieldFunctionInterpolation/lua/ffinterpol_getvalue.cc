@@ -17,8 +17,14 @@ extern ChiPhysics chi_physics_handler;
  *
 \param FFIHandle int Handle to the field function interpolation.
 
+\return Value For VOLUME interpolations a number, the value of the
+        operation. For LINE interpolations a table with the value of the
+        first field function at each point, indexed from 1. Points outside
+        the mesh have the value 0.
+
 ###Note:
-Currently only the Volume interpolation supports obtaining a value.
+Currently only the Volume and Line interpolations support obtaining a
+value.
 
 \ingroup LuaFFInterpol
 \author Jan*/
@@ -44,11 +50,26 @@ int chiFFInterpolationGetValue(lua_State *L)
     exit(EXIT_FAILURE);
   }
 
-  if (typeid(*cur_ffi) != typeid(chi_mesh::FieldFunctionInterpolationVolume))
+  if (typeid(*cur_ffi) == typeid(chi_mesh::FieldFunctionInterpolationLine))
+  {
+    auto cur_ffi_line = (chi_mesh::FieldFunctionInterpolationLine*)cur_ffi;
+    std::vector<double> values = cur_ffi_line->GetPointValues();
+
+    lua_newtable(L);
+    for (size_t p=0; p<values.size(); ++p)
+    {
+      lua_pushnumber(L,p+1);
+      lua_pushnumber(L,values[p]);
+      lua_settable(L,-3);
+    }
+    return 1;
+  }
+  else if (typeid(*cur_ffi) !=
+           typeid(chi_mesh::FieldFunctionInterpolationVolume))
   {
     chi_log.Log(LOG_0WARNING)
       << "chiFFInterpolationGetValue is currently only supported for "
-      << " VOLUME interpolator types.";
+      << " VOLUME and LINE interpolator types.";
   }
   else
   {
@@ -2,8 +2,11 @@
 #define _chi_mesh_logicalvolume_h
 
 #include "../chi_mesh.h"
+#include "../Raytrace/raytrace_bvh.h"
 #include <chi_log.h>
 
+#include <algorithm>
+
 extern ChiLog chi_log;
 
 #define SPHERE        1
@@ -29,6 +32,24 @@ public:
   {
     return false;
   }
+
+  /**Supplies an axis-aligned box enclosing the volume. Returns false if
+   * no such box is known, in which case callers cannot cull.*/
+  virtual bool GetBoundingBox(chi_mesh::BoundingBox& box)
+  {
+    return false;
+  }
+
+  /**Evaluates Inside for a batch of points supplied as coordinate arrays.
+   * inside[i] is set to 1 if point i is inside and to 0 otherwise. The
+   * default calls the single-point Inside.*/
+  virtual void InsideBatch(size_t num_points,
+                           const double* x, const double* y, const double* z,
+                           char* inside)
+  {
+    for (size_t i=0; i<num_points; ++i)
+      inside[i] = Inside(chi_mesh::Vector3(x[i],y[i],z[i])) ? 1 : 0;
+  }
 };
 
 //###################################################################
@@ -73,6 +94,27 @@ public:
     else
       return false;
   }
+
+  bool GetBoundingBox(chi_mesh::BoundingBox& box)
+  {
+    box.min = chi_mesh::Vector3(x0 - r, y0 - r, z0 - r);
+    box.max = chi_mesh::Vector3(x0 + r, y0 + r, z0 + r);
+    return true;
+  }
+
+  void InsideBatch(size_t num_points,
+                   const double* x, const double* y, const double* z,
+                   char* inside)
+  {
+    const double r2 = r*r;
+    for (size_t i=0; i<num_points; ++i)
+    {
+      double dx = x[i] - x0;
+      double dy = y[i] - y0;
+      double dz = z[i] - z0;
+      inside[i] = (dx*dx + dy*dy + dz*dz) <= r2;
+    }
+  }
 };
 
 //###################################################################
@@ -113,12 +155,32 @@ public:
     else
       return false;
   }
+
+  bool GetBoundingBox(chi_mesh::BoundingBox& box)
+  {
+    box.min = chi_mesh::Vector3(xmin, ymin, zmin);
+    box.max = chi_mesh::Vector3(xmax, ymax, zmax);
+    return true;
+  }
+
+  void InsideBatch(size_t num_points,
+                   const double* x, const double* y, const double* z,
+                   char* inside)
+  {
+    for (size_t i=0; i<num_points; ++i)
+      inside[i] = (x[i] <= xmax) & (x[i] >= xmin) &
+                  (y[i] <= ymax) & (y[i] >= ymin) &
+                  (z[i] <= zmax) & (z[i] >= zmin);
+  }
 };
 
 //###################################################################
 /**Right Circular Cylinder (RCC) logical volume.
  *
- * Determining whether a point is within an RCC is tricky.
+ * The cylinder has its base centered at (x0,y0,z0) and extends along the
+ * vector (vx,vy,vz), the length of which is the height of the cylinder. A
+ * point is inside if its projection onto the axis falls within the
+ * height and its distance from the axis is less than r.
  * */
 class chi_mesh::RCCLogicalVolume : public LogicalVolume
 {
@@ -147,55 +209,50 @@ public:
 
   bool Inside(chi_mesh::Vector3 p1)
   {
-    chi_mesh::Vector3 p0(x0, y0, z0);
-    chi_mesh::Vector3 vd(vx, vy, vz);
-    chi_mesh::Vector3 k(0.0, 0.0, 1.0);
-
-    chi_mesh::Vector3 p01 = p1 - p0;
+    char inside = 0;
+    InsideBatch(1, &p1.x, &p1.y, &p1.z, &inside);
+    return inside != 0;
+  }
 
-    //====================================== Building rotation matrix
-    chi_mesh::Vector3 binorm;
-    chi_mesh::Vector3 tangent;
-    if (abs(vd.Dot(k)/vd.Norm())>(1.0-1.0e-12))
-    {
-      binorm = chi_mesh::Vector3(0.0, 1.0, 0.0);
-      tangent = chi_mesh::Vector3(1.0, 0.0, 0.0);
-    }
-    else
+  void InsideBatch(size_t num_points,
+                   const double* x, const double* y, const double* z,
+                   char* inside)
+  {
+    const double vd_norm2 = vx*vx + vy*vy + vz*vz;
+    const double r2 = r*r;
+    for (size_t i=0; i<num_points; ++i)
     {
-      binorm = k.Cross(vd);
-      binorm = binorm/binorm.Norm();
-      tangent = binorm.Cross(vd);
-      tangent = tangent/tangent.Norm();
-    }
-
-    chi_mesh::Matrix3x3 R;
-
-    R.SetColJVec(0,tangent);
-    R.SetColJVec(1,binorm);
-    R.SetColJVec(2,vd);
+      double dx = x[i] - x0;
+      double dy = y[i] - y0;
+      double dz = z[i] - z0;
 
-    //====================================== Rotate point to ref coords
-    chi_mesh::Matrix3x3 Rinv = R.Inverse();
-    chi_mesh::Vector3 p01T = Rinv * p01;
+      //====================================== Fraction along the axis
+      double t = (dx*vx + dy*vy + dz*vz)/vd_norm2;
 
-    chi_log.Log(LOG_0) << "Inverted p: \n" << p01T.PrintS();
+      //====================================== Distance from the axis
+      double px = dx - t*vx;
+      double py = dy - t*vy;
+      double pz = dz - t*vz;
 
-    //====================================== Determine if point is within cylinder
-    bool in_cylinder = false;
-    double r2 = p01T.x*p01T.x + p01T.y*p01T.y;
-
-    if (r2 <(this->r*this->r))
-      in_cylinder = true;
-    else
-      return false;
-
-    //====================================== Determine if point is within extents
-    double dotP = p01T.Dot(vd);
-    if ((dotP>=0.0) and (dotP<=1.0))
-      return true;
+      inside[i] = (t >= 0.0) & (t <= 1.0) & ((px*px + py*py + pz*pz) < r2);
+    }
+  }
 
-    return false;
+  /**The box encloses the two end-discs. For each axis a disc of radius r
+   * with unit normal n extends r*sqrt(1-n_i^2) about its center.*/
+  bool GetBoundingBox(chi_mesh::BoundingBox& box)
+  {
+    chi_mesh::Vector3 p0(x0, y0, z0);
+    chi_mesh::Vector3 vd(vx, vy, vz);
+    chi_mesh::Vector3 n = vd/vd.Norm();
+    chi_mesh::Vector3 e(r*sqrt(std::max(0.0, 1.0 - n.x*n.x)),
+                        r*sqrt(std::max(0.0, 1.0 - n.y*n.y)),
+                        r*sqrt(std::max(0.0, 1.0 - n.z*n.z)));
+
+    box = chi_mesh::BoundingBox();
+    box.Expand(p0 - e);      box.Expand(p0 + e);
+    box.Expand(p0 + vd - e); box.Expand(p0 + vd + e);
+    return true;
   }
 };
 
@@ -213,6 +270,13 @@ public:
   SurfaceMeshLogicalVolume(chi_mesh::SurfaceMesh* in_surf_mesh);
 
   bool Inside(chi_mesh::Vector3 point);
+
+  bool GetBoundingBox(chi_mesh::BoundingBox& box)
+  {
+    box.min = chi_mesh::Vector3(xbounds[0], ybounds[0], zbounds[0]);
+    box.max = chi_mesh::Vector3(xbounds[1], ybounds[1], zbounds[1]);
+    return true;
+  }
 private:
   bool CheckPlaneLineIntersect(chi_mesh::Normal plane_normal,
                                chi_mesh::Vector3 plane_point,
@@ -239,6 +303,33 @@ public:
     }
     return true;
   }
+
+  /**The volume lies within the intersection of the boxes of all its
+   * parts that are required to be inside.*/
+  bool GetBoundingBox(chi_mesh::BoundingBox& box)
+  {
+    bool bounded = false;
+    for (auto& part : parts)
+    {
+      chi_mesh::BoundingBox part_box;
+      if (not (part.first and part.second->GetBoundingBox(part_box)))
+        continue;
+
+      if (not bounded)
+        box = part_box;
+      else
+      {
+        box.min.x = std::max(box.min.x, part_box.min.x);
+        box.min.y = std::max(box.min.y, part_box.min.y);
+        box.min.z = std::max(box.min.z, part_box.min.z);
+        box.max.x = std::min(box.max.x, part_box.max.x);
+        box.max.y = std::min(box.max.y, part_box.max.y);
+        box.max.z = std::min(box.max.z, part_box.max.z);
+      }
+      bounded = true;
+    }
+    return bounded;
+  }
 };
 
 
@@ -76,13 +76,16 @@ public:
   {
   private:
     LocalCells& local_cells;
+    MeshContinuum& grid;
     std::set<std::pair<int,int>> global_cell_native_index_set;
     std::set<std::pair<int,int>> global_cell_foreign_index_set;
 
 
   public:
-    explicit GlobalCellHandler(LocalCells& local_cell_object_ref) :
-     local_cells(local_cell_object_ref)
+    GlobalCellHandler(LocalCells& local_cell_object_ref,
+                      MeshContinuum& in_grid) :
+     local_cells(local_cell_object_ref),
+     grid(in_grid)
     {}
 
     void push_back(chi_mesh::Cell* new_cell);
@@ -112,15 +115,26 @@ private:
 
   ChiMPICommunicatorSet commicator_set;
 
+  chi_mesh::CellBVH*    cell_bvh = nullptr;
+
+  //Serialized cells received from neighboring partitions. Cached so that
+  //the exchange happens only once and can be persisted to file.
+  std::vector<int>      partition_neighbor_cell_data;
+  bool                  partition_neighbor_cell_data_available = false;
+
+  void GatherPartitionNeighborCellData();
+
 public:
   MeshContinuum() :
     local_cells(local_cell_glob_indices),
-    cells(local_cells)
+    cells(local_cells,*this)
   {
     surface_mesh = nullptr;
     line_mesh    = nullptr;
   }
 
+  ~MeshContinuum();
+
   //01
   void ExportCellsToPython(const char* fileName,
                            bool surface_only=true,
@@ -148,6 +162,25 @@ public:
     std::vector<chi_mesh::Cell*>& neighbor_cells);
 
   ChiMPICommunicatorSet& GetCommunicator();
+
+  chi_mesh::CellBVH& GetCellBVH();
+  void InvalidateCellBVH();
+
+  //03
+  /**Mesher information stored in the header of partition files. The
+   * mesher type is a chi_mesh::VolumeMesherType.*/
+  struct PartitionFileInfo
+  {
+    int mesher_type = 0;
+    int partition_x = 1;
+    int partition_y = 1;
+    int partition_z = 1;
+  };
+  static std::string PartitionFileName(const std::string& base_name,
+                                       int location_id);
+  void ExportPartitionToFile(const std::string& base_name,
+                             const PartitionFileInfo& info);
+  PartitionFileInfo ImportPartitionFromFile(const std::string& base_name);
 };
 
 
@@ -10,12 +10,11 @@ extern ChiLog chi_log;
 extern ChiMPI chi_mpi;
 
 //###################################################################
-/**Communicates neighboring cells to this location for use by methods
- * such as the interior penalty method. The method populates the
- * supplied vector neighbor_cells. The complete cell is
- * not populated, the face neighbors are not transferred.*/
-void chi_mesh::MeshContinuum::CommunicatePartitionNeighborCells(
-  std::vector<chi_mesh::Cell*>& neighbor_cells)
+/**Exchanges the serialized border cells with neighboring partitions
+ * and stores the received data. This only needs to happen once per
+ * grid and is skipped when the data was imported from a partition
+ * file.*/
+void chi_mesh::MeshContinuum::GatherPartitionNeighborCellData()
 {
   std::set<int> local_neighboring_cell_indices;
   std::set<int> neighboring_partitions;
@@ -164,7 +163,7 @@ void chi_mesh::MeshContinuum::CommunicatePartitionNeighborCells(
   std::vector<int> recv_counts(chi_mpi.process_count,0);
 
   MPI_Alltoall(send_counts.data(), 1, MPI_INT,
-               recv_counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+               recv_counts.data(), 1, MPI_INT, chi_mpi.comm);
 
   //============================================= Build receive displacements
   std::vector<int> recv_displs(chi_mpi.process_count,0);
@@ -178,7 +177,8 @@ void chi_mesh::MeshContinuum::CommunicatePartitionNeighborCells(
   }
 
   //============================================= Receive serialized data
-  std::vector<int> global_receive_data(total_receive_size,0);
+  std::vector<int>& global_receive_data = partition_neighbor_cell_data;
+  global_receive_data.assign(total_receive_size,0);
   MPI_Alltoallv(global_serialized_data.data(),
                 send_counts.data(),
                 send_displs.data(),
@@ -187,7 +187,23 @@ void chi_mesh::MeshContinuum::CommunicatePartitionNeighborCells(
                 recv_counts.data(),
                 recv_displs.data(),
                 MPI_INT,
-                MPI_COMM_WORLD);
+                chi_mpi.comm);
+
+  partition_neighbor_cell_data_available = true;
+}
+
+//###################################################################
+/**Communicates neighboring cells to this location for use by methods
+ * such as the interior penalty method. The method populates the
+ * supplied vector neighbor_cells. The complete cell is
+ * not populated, the face neighbors are not transferred.*/
+void chi_mesh::MeshContinuum::CommunicatePartitionNeighborCells(
+  std::vector<chi_mesh::Cell*>& neighbor_cells)
+{
+  if (not partition_neighbor_cell_data_available)
+    GatherPartitionNeighborCellData();
+
+  const auto& global_receive_data = partition_neighbor_cell_data;
 
   //============================================= Deserialize
   {
@@ -54,7 +54,7 @@ ChiMPICommunicatorSet& chi_mesh::MeshContinuum::GetCommunicator()
     //If chi_mpi.location_id == locI then this call will
     //act like a send instead of receive. Otherwise
     //It receives the count.
-    MPI_Bcast(&locI_num_connections,1,MPI_INT,locI,MPI_COMM_WORLD);
+    MPI_Bcast(&locI_num_connections,1,MPI_INT,locI,chi_mpi.comm);
 
     if (chi_mpi.location_id != locI)
     {global_graph[locI].resize(locI_num_connections,-1);}
@@ -76,7 +76,7 @@ ChiMPICommunicatorSet& chi_mesh::MeshContinuum::GetCommunicator()
     //It receives the count.
     MPI_Bcast(global_graph[locI].data(),
               global_graph[locI].size(),
-              MPI_INT,locI,MPI_COMM_WORLD);
+              MPI_INT,locI,chi_mpi.comm);
   }
 
   chi_log.Log(LOG_0VERBOSE_1)
@@ -84,7 +84,7 @@ ChiMPICommunicatorSet& chi_mesh::MeshContinuum::GetCommunicator()
 
 
   //============================================= Build groups
-  MPI_Comm_group(MPI_COMM_WORLD,&commicator_set.world_group);
+  MPI_Comm_group(chi_mpi.comm,&commicator_set.world_group);
   commicator_set.location_groups.resize(chi_mpi.process_count,MPI_Group());
 
   for (int locI=0;locI<chi_mpi.process_count; locI++)
@@ -102,7 +102,7 @@ ChiMPICommunicatorSet& chi_mesh::MeshContinuum::GetCommunicator()
 
   for (int locI=0;locI<chi_mpi.process_count; locI++)
   {
-    int err = MPI_Comm_create_group(MPI_COMM_WORLD,
+    int err = MPI_Comm_create_group(chi_mpi.comm,
                                     commicator_set.location_groups[locI],
                                     0, //tag
                                     &commicator_set.communicators[locI]);
@@ -19,6 +19,8 @@ extern ChiLog chi_log;
 void chi_mesh::MeshContinuum::
  ExportCellsToObj(const char* fileName, bool per_material, int options)
 {
+  if (chi_mpi.team_id != 0) return;
+
   if (!per_material)
   {
     FILE* of = fopen(fileName,"w");
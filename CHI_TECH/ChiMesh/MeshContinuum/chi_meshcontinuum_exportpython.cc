@@ -16,6 +16,8 @@ ExportCellsToPython(const char* fileName, bool surface_only,
                     std::vector<int>* cell_flags,
                     int options)
 {
+  if (chi_mpi.team_id != 0) return;
+
   FILE* of = fopen(fileName,"w");
 
   if (of==NULL)
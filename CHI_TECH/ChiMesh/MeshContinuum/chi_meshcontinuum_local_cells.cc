@@ -27,10 +27,13 @@ operator[](int cell_local_index)
 }
 
 //###################################################################
-/**Adds a new cell to grid registry.*/
+/**Adds a new cell to grid registry. The spatial index of the grid no
+ * longer covers all cells and is discarded.*/
 void chi_mesh::MeshContinuum::GlobalCellHandler::
   push_back(chi_mesh::Cell *new_cell)
 {
+  grid.InvalidateCellBVH();
+
 //  local_cells.cell_references.push_back(new_cell);
 
   if (new_cell->partition_id == chi_mpi.location_id)
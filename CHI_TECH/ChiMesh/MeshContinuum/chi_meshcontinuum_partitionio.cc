@@ -0,0 +1,286 @@
+#include "chi_meshcontinuum.h"
+
+#include "ChiMesh/Cell/cell_slab.h"
+#include "ChiMesh/Cell/cell_polygon.h"
+#include "ChiMesh/Cell/cell_polyhedron.h"
+
+#include <chi_log.h>
+#include <chi_mpi.h>
+extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
+
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+
+namespace
+{
+const char     CHI_PARTITION_MAGIC[8] = {'C','H','I','P','A','R','T','\0'};
+const uint32_t CHI_PARTITION_VERSION  = 2;
+
+template<typename T>
+void WriteValue(std::ofstream& file, const T& value)
+{
+  file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+T ReadValue(std::ifstream& file)
+{
+  T value;
+  file.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return value;
+}
+
+void WriteVector3(std::ofstream& file, const chi_mesh::Vector3& v)
+{
+  WriteValue(file, v.x);
+  WriteValue(file, v.y);
+  WriteValue(file, v.z);
+}
+
+chi_mesh::Vector3 ReadVector3(std::ifstream& file)
+{
+  double x = ReadValue<double>(file);
+  double y = ReadValue<double>(file);
+  double z = ReadValue<double>(file);
+  return chi_mesh::Vector3(x,y,z);
+}
+
+void WriteIntVector(std::ofstream& file, const std::vector<int>& values)
+{
+  WriteValue(file, static_cast<uint64_t>(values.size()));
+  file.write(reinterpret_cast<const char*>(values.data()),
+             values.size()*sizeof(int));
+}
+
+void ReadIntVector(std::ifstream& file, std::vector<int>& values)
+{
+  auto size = ReadValue<uint64_t>(file);
+  values.resize(size);
+  file.read(reinterpret_cast<char*>(values.data()), size*sizeof(int));
+}
+
+/**Writes a complete cell, including face geometry.*/
+void WriteCell(std::ofstream& file, const chi_mesh::Cell& cell)
+{
+  WriteValue(file, static_cast<int>(cell.Type()));
+  WriteValue(file, cell.global_id);
+  WriteValue(file, cell.partition_id);
+  WriteValue(file, cell.material_id);
+  WriteVector3(file, cell.centroid);
+  WriteIntVector(file, cell.vertex_ids);
+
+  WriteValue(file, static_cast<uint64_t>(cell.faces.size()));
+  for (auto& face : cell.faces)
+  {
+    WriteValue(file, face.neighbor);
+    WriteIntVector(file, face.vertex_ids);
+    WriteVector3(file, face.normal);
+    WriteVector3(file, face.centroid);
+  }
+}
+
+/**Reads a complete cell written by WriteCell.*/
+chi_mesh::Cell* ReadCell(std::ifstream& file)
+{
+  auto cell_type = static_cast<chi_mesh::CellType>(ReadValue<int>(file));
+
+  chi_mesh::Cell* cell;
+  switch (cell_type)
+  {
+    case chi_mesh::CellType::SLAB:
+      cell = new chi_mesh::CellSlab; break;
+    case chi_mesh::CellType::POLYGON:
+      cell = new chi_mesh::CellPolygon; break;
+    case chi_mesh::CellType::POLYHEDRON:
+      cell = new chi_mesh::CellPolyhedron; break;
+    case chi_mesh::CellType::GHOST:
+      cell = new chi_mesh::Cell(chi_mesh::CellType::GHOST); break;
+    default:
+      chi_log.Log(LOG_ALLERROR)
+        << "chi_mesh::MeshContinuum::ImportPartitionFromFile: "
+        << "unsupported cell type encountered.";
+      exit(EXIT_FAILURE);
+  }
+
+  cell->global_id    = ReadValue<int>(file);
+  cell->partition_id = ReadValue<int>(file);
+  cell->material_id  = ReadValue<int>(file);
+  cell->centroid     = ReadVector3(file);
+  ReadIntVector(file, cell->vertex_ids);
+
+  auto num_faces = ReadValue<uint64_t>(file);
+  cell->faces.resize(num_faces);
+  for (auto& face : cell->faces)
+  {
+    face.neighbor = ReadValue<int>(file);
+    ReadIntVector(file, face.vertex_ids);
+    face.normal   = ReadVector3(file);
+    face.centroid = ReadVector3(file);
+  }
+
+  return cell;
+}
+}
+
+//###################################################################
+/**Returns the name of the partition file for a given location. The
+ * process count is part of the name so that decompositions for
+ * different process counts can coexist.*/
+std::string chi_mesh::MeshContinuum::
+  PartitionFileName(const std::string& base_name, int location_id)
+{
+  return base_name + "_np" + std::to_string(chi_mpi.process_count) +
+         "_" + std::to_string(location_id) + ".cpart";
+}
+
+//###################################################################
+/**Writes this location's portion of the grid to a partition file. The
+ * file contains all the vertices, the local cells, the ghost cells and
+ * the serialized cells of neighboring partitions, allowing a later run
+ * with the same number of processes to skip meshing and partitioning
+ * entirely. The header also stores the type of the mesher that produced
+ * the grid and its partition counts, which the solvers need to identify
+ * the mesh dimension. This call is collective.*/
+void chi_mesh::MeshContinuum::
+  ExportPartitionToFile(const std::string& base_name,
+                        const PartitionFileInfo& info)
+{
+  if (not partition_neighbor_cell_data_available)
+    GatherPartitionNeighborCellData();
+
+  //======================================== Teams hold identical data
+  if (chi_mpi.team_id != 0) return;
+
+  std::string file_name = PartitionFileName(base_name, chi_mpi.location_id);
+
+  std::ofstream file(file_name, std::ios::out | std::ios::binary);
+  if (!file.is_open())
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Failed to open file: "<< file_name <<" in call "
+      << "to ExportPartitionToFile \n";
+    exit(EXIT_FAILURE);
+  }
+
+  //======================================== Header
+  file.write(CHI_PARTITION_MAGIC, 8);
+  WriteValue(file, CHI_PARTITION_VERSION);
+  WriteValue(file, chi_mpi.process_count);
+  WriteValue(file, chi_mpi.location_id);
+  WriteValue(file, info.mesher_type);
+  WriteValue(file, info.partition_x);
+  WriteValue(file, info.partition_y);
+  WriteValue(file, info.partition_z);
+
+  //======================================== Vertices
+  WriteValue(file, static_cast<uint64_t>(vertices.size()));
+  for (auto vertex : vertices)
+    WriteVector3(file, *vertex);
+
+  //======================================== Cells
+  auto& native_cells  = local_cells.native_cells;
+  auto& foreign_cells = local_cells.foreign_cells;
+
+  WriteValue(file, static_cast<uint64_t>(native_cells.size()));
+  for (auto cell : native_cells)
+    WriteCell(file, *cell);
+
+  WriteValue(file, static_cast<uint64_t>(foreign_cells.size()));
+  for (auto cell : foreign_cells)
+    WriteCell(file, *cell);
+
+  //======================================== Neighbor partition cells
+  WriteIntVector(file, partition_neighbor_cell_data);
+
+  file.close();
+
+  chi_log.Log(LOG_0)
+    << "Exported partitioned mesh to " << PartitionFileName(base_name,0)
+    << " and siblings.";
+}
+
+//###################################################################
+/**Populates an empty grid from the partition file of this location,
+ * as written by ExportPartitionToFile, and returns the mesher information
+ * stored in its header.*/
+chi_mesh::MeshContinuum::PartitionFileInfo chi_mesh::MeshContinuum::
+  ImportPartitionFromFile(const std::string& base_name)
+{
+  std::string file_name = PartitionFileName(base_name, chi_mpi.location_id);
+
+  std::ifstream file(file_name, std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Failed to open file: "<< file_name <<" in call "
+      << "to ImportPartitionFromFile. The file must have been exported "
+      << "with the same number of processes.";
+    exit(EXIT_FAILURE);
+  }
+
+  //======================================== Header
+  char magic[8];
+  file.read(magic, 8);
+  auto version       = ReadValue<uint32_t>(file);
+  auto process_count = ReadValue<int>(file);
+  auto location_id   = ReadValue<int>(file);
+
+  if ((std::memcmp(magic, CHI_PARTITION_MAGIC, 8) != 0) or
+      (version != CHI_PARTITION_VERSION))
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "File " << file_name << " is not a valid partition file "
+      << "of version " << CHI_PARTITION_VERSION
+      << " in call to ImportPartitionFromFile. Partition files of older "
+      << "versions must be exported again.";
+    exit(EXIT_FAILURE);
+  }
+
+  if ((process_count != chi_mpi.process_count) or
+      (location_id != chi_mpi.location_id))
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Partition file " << file_name << " was written for location "
+      << location_id << " of " << process_count << " processes.";
+    exit(EXIT_FAILURE);
+  }
+
+  PartitionFileInfo info;
+  info.mesher_type = ReadValue<int>(file);
+  info.partition_x = ReadValue<int>(file);
+  info.partition_y = ReadValue<int>(file);
+  info.partition_z = ReadValue<int>(file);
+
+  //======================================== Vertices
+  InvalidateCellBVH();
+  auto num_vertices = ReadValue<uint64_t>(file);
+  vertices.reserve(num_vertices);
+  for (uint64_t v=0; v<num_vertices; ++v)
+    vertices.push_back(new chi_mesh::Node(ReadVector3(file)));
+
+  //======================================== Cells
+  auto num_native_cells = ReadValue<uint64_t>(file);
+  for (uint64_t c=0; c<num_native_cells; ++c)
+    cells.push_back(ReadCell(file));
+
+  auto num_foreign_cells = ReadValue<uint64_t>(file);
+  for (uint64_t c=0; c<num_foreign_cells; ++c)
+    cells.push_back(ReadCell(file));
+
+  //======================================== Neighbor partition cells
+  ReadIntVector(file, partition_neighbor_cell_data);
+  partition_neighbor_cell_data_available = true;
+
+  if (!file.good())
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Partition file " << file_name << " is truncated.";
+    exit(EXIT_FAILURE);
+  }
+
+  file.close();
+
+  return info;
+}
@@ -1,5 +1,6 @@
 #include "chi_meshcontinuum.h"
 #include "ChiMesh/Cell/cell_slab.h"
+#include "ChiMesh/Raytrace/raytrace_bvh.h"
 
 #include <boost/graph/bandwidth.hpp>
 
@@ -259,4 +260,37 @@ chi_mesh::Vector3 chi_mesh::MeshContinuum::
     centroid = centroid + *vertices[node_id];
 
   return centroid/list.size();
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Destructor. Frees the spatial index, which is defined out of line since
+ * the header only forward declares it.*/
+chi_mesh::MeshContinuum::~MeshContinuum()
+{
+  delete cell_bvh;
+}
+
+//###################################################################
+/**Returns the spatial index over the local cells. The index is built on
+ * first use and is shared by all objects querying this grid, e.g. field
+ * function interpolators and logical volume tagging.*/
+chi_mesh::CellBVH& chi_mesh::MeshContinuum::GetCellBVH()
+{
+  if (cell_bvh == nullptr)
+  {
+    chi_log.Log(LOG_0VERBOSE_1) << "Building cell bounding-volume hierarchy.";
+    cell_bvh = new chi_mesh::CellBVH(this);
+  }
+
+  return *cell_bvh;
+}
+
+//###################################################################
+/**Discards the spatial index over the local cells, to be rebuilt on next
+ * use. Must be called whenever cells are added or their partitioning or
+ * vertices change.*/
+void chi_mesh::MeshContinuum::InvalidateCellBVH()
+{
+  delete cell_bvh;
+  cell_bvh = nullptr;
+}
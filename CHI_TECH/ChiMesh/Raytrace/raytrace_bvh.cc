@@ -0,0 +1,572 @@
+#include "raytrace_bvh.h"
+
+#include <ChiMesh/MeshContinuum/chi_meshcontinuum.h>
+
+#include <chi_log.h>
+
+#include <algorithm>
+
+extern ChiLog chi_log;
+
+namespace
+{
+/**Returns a vector component by axis index (0=x, 1=y, 2=z).*/
+double Component(const chi_mesh::Vector3& v, int axis)
+{
+  if (axis == 0) return v.x;
+  if (axis == 1) return v.y;
+  return v.z;
+}
+}
+
+//###################################################################
+/**Grows the box to include the given point.*/
+void chi_mesh::BoundingBox::Expand(const chi_mesh::Vector3& point)
+{
+  min.x = std::min(min.x, point.x); max.x = std::max(max.x, point.x);
+  min.y = std::min(min.y, point.y); max.y = std::max(max.y, point.y);
+  min.z = std::min(min.z, point.z); max.z = std::max(max.z, point.z);
+}
+
+//###################################################################
+/**Grows the box to include another box.*/
+void chi_mesh::BoundingBox::Expand(const chi_mesh::BoundingBox& other)
+{
+  Expand(other.min);
+  Expand(other.max);
+}
+
+//###################################################################
+/**Checks whether a point lies inside the box.*/
+bool chi_mesh::BoundingBox::
+  Contains(const chi_mesh::Vector3& point, double tolerance) const
+{
+  return (point.x >= min.x - tolerance) and (point.x <= max.x + tolerance) and
+         (point.y >= min.y - tolerance) and (point.y <= max.y + tolerance) and
+         (point.z >= min.z - tolerance) and (point.z <= max.z + tolerance);
+}
+
+//###################################################################
+/**Checks whether two boxes overlap.*/
+bool chi_mesh::BoundingBox::Overlaps(const chi_mesh::BoundingBox& other) const
+{
+  return (min.x <= other.max.x) and (max.x >= other.min.x) and
+         (min.y <= other.max.y) and (max.y >= other.min.y) and
+         (min.z <= other.max.z) and (max.z >= other.min.z);
+}
+
+//###################################################################
+/**Checks whether a plane, defined by a normal and a point on it, cuts
+ * through the box.*/
+bool chi_mesh::BoundingBox::IntersectsPlane(const chi_mesh::Normal& normal,
+                                            const chi_mesh::Vector3& point) const
+{
+  Vector3 half_extent = (max - min)*0.5;
+  double radius = half_extent.x*std::fabs(normal.x) +
+                  half_extent.y*std::fabs(normal.y) +
+                  half_extent.z*std::fabs(normal.z);
+  double distance = normal.Dot(Center() - point);
+
+  return std::fabs(distance) <= radius;
+}
+
+//###################################################################
+/**Slab test of a ray against the box. The ray direction is supplied as
+ * its component-wise inverse so that it can be reused across many boxes.
+ * Returns true if the ray line intersects the box, with the entry and exit
+ * distances in t_near and t_far.*/
+bool chi_mesh::BoundingBox::IntersectRay(const chi_mesh::Vector3& pos,
+                                         const chi_mesh::Vector3& inv_omega,
+                                         double& t_near, double& t_far) const
+{
+  t_near = -1.0e32;
+  t_far  =  1.0e32;
+  for (int d=0; d<3; ++d)
+  {
+    double p     = Component(pos, d);
+    double inv_o = Component(inv_omega, d);
+    double t0 = (Component(min, d) - p)*inv_o;
+    double t1 = (Component(max, d) - p)*inv_o;
+    if (t0 > t1) std::swap(t0,t1);
+
+    //NaNs arise from 0*inf when the ray lies on a slab plane
+    if (t0 == t0) t_near = std::max(t_near, t0);
+    if (t1 == t1) t_far  = std::min(t_far , t1);
+
+    if (t_near > t_far) return false;
+  }
+  return true;
+}
+
+//###################################################################
+/**Returns the axis (0=x, 1=y, 2=z) along which the box is the longest.*/
+int chi_mesh::BoundingBox::LongestAxis() const
+{
+  Vector3 extent = max - min;
+  if ((extent.x >= extent.y) and (extent.x >= extent.z)) return 0;
+  if (extent.y >= extent.z) return 1;
+  return 2;
+}
+
+//###################################################################
+/**Computes the axis-aligned bounding box of a cell from its vertices.*/
+chi_mesh::BoundingBox chi_mesh::
+  ComputeCellBoundingBox(const chi_mesh::MeshContinuum* grid,
+                         const chi_mesh::Cell& cell)
+{
+  BoundingBox box;
+  for (auto vid : cell.vertex_ids)
+    box.Expand(*grid->vertices[vid]);
+  return box;
+}
+
+//###################################################################
+/**Checks whether a point is inside a cell. The cell is treated as convex,
+ * i.e., the point is inside if it is behind every face plane.*/
+bool chi_mesh::IsPointInCell(const chi_mesh::MeshContinuum* grid,
+                             const chi_mesh::Cell& cell,
+                             const chi_mesh::Vector3& point,
+                             double tolerance)
+{
+  for (const auto& face : cell.faces)
+  {
+    const auto& v0 = *grid->vertices[face.vertex_ids[0]];
+    if ((point - v0).Dot(face.normal) > tolerance)
+      return false;
+  }
+  return true;
+}
+
+//###################################################################
+/**Clips a ray against the face planes of a (convex) cell. Returns true
+ * if the ray line passes through the cell, with the entry and exit
+ * distances, along the ray, in t_near and t_far.*/
+bool chi_mesh::RayCellIntersect(const chi_mesh::MeshContinuum* grid,
+                                const chi_mesh::Cell& cell,
+                                const chi_mesh::Vector3& pos,
+                                const chi_mesh::Vector3& omega,
+                                double& t_near, double& t_far)
+{
+  const double epsilon = 1.0e-12;
+  t_near = -1.0e32;
+  t_far  =  1.0e32;
+  for (const auto& face : cell.faces)
+  {
+    const auto& v0 = *grid->vertices[face.vertex_ids[0]];
+    double num   = face.normal.Dot(v0 - pos);
+    double denom = face.normal.Dot(omega);
+
+    if (std::fabs(denom) < epsilon)
+    {
+      if (num < -epsilon) return false; //Parallel and outside
+      continue;
+    }
+
+    double t = num/denom;
+    if (denom < 0.0) t_near = std::max(t_near, t);
+    else             t_far  = std::min(t_far , t);
+
+    if (t_near > t_far) return false;
+  }
+  return true;
+}
+
+//###################################################################
+/**Builds the hierarchy over the local cells of the grid.
+ *
+ * \param in_grid      The grid whose local cells are to be indexed.
+ * \param in_leaf_size Maximum number of cells per leaf. Default 4.*/
+chi_mesh::CellBVH::CellBVH(chi_mesh::MeshContinuum* in_grid, int in_leaf_size) :
+  grid(in_grid),
+  leaf_size(std::max(in_leaf_size,1))
+{
+  size_t num_local_cells = grid->local_cells.size();
+
+  cell_boxes.reserve(num_local_cells);
+  cell_ids.reserve(num_local_cells);
+  for (const auto& cell : grid->local_cells)
+  {
+    cell_boxes.push_back(ComputeCellBoundingBox(grid, cell));
+    cell_ids.push_back(cell.local_id);
+  }
+
+  //Worst case is a full binary tree with single-cell leaves
+  nodes.reserve(2*num_local_cells + 1);
+  if (num_local_cells == 0)
+    nodes.emplace_back();
+  else
+    Build(0, static_cast<int>(num_local_cells));
+
+  //Axes without extent, e.g. z for 2D and x,y for 1D meshes
+  const BoundingBox& root = nodes[0].box;
+  double max_extent = 0.0;
+  for (int axis=0; axis<3; ++axis)
+    max_extent = std::max(max_extent,
+                          Component(root.max,axis) - Component(root.min,axis));
+  for (int axis=0; axis<3; ++axis)
+    collapsed_axes[axis] = (num_local_cells > 0) and
+      (Component(root.max,axis) - Component(root.min,axis) <=
+       1.0e-12*std::max(1.0,max_extent));
+
+  chi_log.Log(LOG_ALLVERBOSE_1)
+    << "Cell BVH built with " << nodes.size() << " nodes over "
+    << num_local_cells << " local cells.";
+}
+
+//###################################################################
+/**Recursively builds the node covering cell_ids[first,first+count).
+ * Cells are split at the median of their box centers along the longest
+ * axis of the centers' extent. Returns the index of the created node.*/
+int chi_mesh::CellBVH::Build(int first, int count)
+{
+  int node_index = static_cast<int>(nodes.size());
+  nodes.emplace_back();
+
+  BoundingBox box;
+  BoundingBox center_box;
+  for (int i=first; i<first+count; ++i)
+  {
+    box.Expand(cell_boxes[cell_ids[i]]);
+    center_box.Expand(cell_boxes[cell_ids[i]].Center());
+  }
+  nodes[node_index].box = box;
+
+  if (count <= leaf_size)
+  {
+    nodes[node_index].first = first;
+    nodes[node_index].count = count;
+    return node_index;
+  }
+
+  int axis = center_box.LongestAxis();
+  int half = count/2;
+  std::nth_element(cell_ids.begin() + first,
+                   cell_ids.begin() + first + half,
+                   cell_ids.begin() + first + count,
+                   [this,axis](int a, int b)
+                   {
+                     return Component(cell_boxes[a].Center(), axis) <
+                            Component(cell_boxes[b].Center(), axis);
+                   });
+
+  int left  = Build(first, half);
+  int right = Build(first + half, count - half);
+
+  //nodes may have been reallocated during recursion
+  nodes[node_index].left  = left;
+  nodes[node_index].right = right;
+
+  return node_index;
+}
+
+//###################################################################
+/**Projects a point onto the axes along which the local cells have no
+ * extent, i.e., onto the plane of a 2D mesh or the axis of a 1D mesh.
+ * Other components are returned unchanged.*/
+chi_mesh::Vector3 chi_mesh::CellBVH::
+  ProjectToMeshDimension(const chi_mesh::Vector3& point) const
+{
+  chi_mesh::Vector3 projected = point;
+  const chi_mesh::Vector3 center = nodes[0].box.Center();
+  if (collapsed_axes[0]) projected.x = center.x;
+  if (collapsed_axes[1]) projected.y = center.y;
+  if (collapsed_axes[2]) projected.z = center.z;
+  return projected;
+}
+
+//###################################################################
+/**Finds the local cell containing a point. Returns -1 if the point is
+ * not within any local cell. Points off the plane of a 2D mesh, or off the
+ * axis of a 1D mesh, are located by their projection onto it.*/
+int chi_mesh::CellBVH::FindCell(const chi_mesh::Vector3& in_point,
+                                double tolerance) const
+{
+  if (cell_ids.empty()) return -1;
+
+  const chi_mesh::Vector3 point = ProjectToMeshDimension(in_point);
+
+  std::vector<int> stack;
+  stack.reserve(64);
+  stack.push_back(0);
+  while (not stack.empty())
+  {
+    const Node& node = nodes[stack.back()];
+    stack.pop_back();
+
+    if (not node.box.Contains(point, tolerance)) continue;
+
+    if (node.left < 0)
+    {
+      for (int i=node.first; i<node.first+node.count; ++i)
+      {
+        int c = cell_ids[i];
+        if (not cell_boxes[c].Contains(point, tolerance)) continue;
+        if (IsPointInCell(grid, grid->local_cells[c], point, tolerance))
+          return c;
+      }
+      continue;
+    }
+
+    stack.push_back(node.right);
+    stack.push_back(node.left);
+  }
+
+  return -1;
+}
+
+//###################################################################
+/**Batched point location. Fills cell_local_ids with the local cell
+ * containing each point, or -1 if a point is not local.*/
+void chi_mesh::CellBVH::FindCells(const std::vector<Vector3>& points,
+                                  std::vector<int>& cell_local_ids,
+                                  double tolerance) const
+{
+  cell_local_ids.resize(points.size());
+  for (size_t p=0; p<points.size(); ++p)
+    cell_local_ids[p] = FindCell(points[p], tolerance);
+}
+
+//###################################################################
+/**Collects the local ids of all cells whose bounding boxes overlap
+ * the supplied box. The list is appended to.*/
+void chi_mesh::CellBVH::
+  FindCellsOverlapping(const chi_mesh::BoundingBox& box,
+                       std::vector<int>& cell_local_ids) const
+{
+  if (cell_ids.empty()) return;
+
+  std::vector<int> stack;
+  stack.reserve(64);
+  stack.push_back(0);
+  while (not stack.empty())
+  {
+    const Node& node = nodes[stack.back()];
+    stack.pop_back();
+
+    if (not node.box.Overlaps(box)) continue;
+
+    if (node.left < 0)
+    {
+      for (int i=node.first; i<node.first+node.count; ++i)
+        if (cell_boxes[cell_ids[i]].Overlaps(box))
+          cell_local_ids.push_back(cell_ids[i]);
+      continue;
+    }
+
+    stack.push_back(node.right);
+    stack.push_back(node.left);
+  }
+}
+
+//###################################################################
+/**Collects the local ids of all cells whose bounding boxes are cut by
+ * a plane. The list is appended to.*/
+void chi_mesh::CellBVH::
+  FindCellsIntersectingPlane(const chi_mesh::Normal& normal,
+                             const chi_mesh::Vector3& point,
+                             std::vector<int>& cell_local_ids) const
+{
+  if (cell_ids.empty()) return;
+
+  std::vector<int> stack;
+  stack.reserve(64);
+  stack.push_back(0);
+  while (not stack.empty())
+  {
+    const Node& node = nodes[stack.back()];
+    stack.pop_back();
+
+    if (not node.box.IntersectsPlane(normal, point)) continue;
+
+    if (node.left < 0)
+    {
+      for (int i=node.first; i<node.first+node.count; ++i)
+        if (cell_boxes[cell_ids[i]].IntersectsPlane(normal, point))
+          cell_local_ids.push_back(cell_ids[i]);
+      continue;
+    }
+
+    stack.push_back(node.right);
+    stack.push_back(node.left);
+  }
+}
+
+//###################################################################
+/**Finds the first local cell hit by a ray. Nodes are visited nearest
+ * first and pruned against the closest hit found so far.
+ *
+ * \param pos        Ray origin.
+ * \param omega      Ray direction (normalized).
+ * \param d_to_entry Receives the distance from the origin to the point
+ *                   where the ray enters the cell (0 if the origin is
+ *                   inside it).
+ *
+ * \return The local id of the cell, or -1 if no local cell is hit.*/
+int chi_mesh::CellBVH::FirstHitCell(const chi_mesh::Vector3& pos,
+                                    const chi_mesh::Vector3& omega,
+                                    double& d_to_entry) const
+{
+  d_to_entry = 1.0e32;
+  if (cell_ids.empty()) return -1;
+
+  chi_mesh::Vector3 inv_omega(1.0/omega.x, 1.0/omega.y, 1.0/omega.z);
+
+  int    best_cell = -1;
+  double best_d    = 1.0e32;
+
+  std::vector<std::pair<double,int>> stack;
+  stack.reserve(64);
+
+  double t_near, t_far;
+  if (nodes[0].box.IntersectRay(pos, inv_omega, t_near, t_far) and t_far >= 0.0)
+    stack.emplace_back(std::max(t_near,0.0), 0);
+
+  while (not stack.empty())
+  {
+    double node_d = stack.back().first;
+    const Node& node = nodes[stack.back().second];
+    stack.pop_back();
+
+    if (node_d > best_d) continue;
+
+    if (node.left < 0)
+    {
+      for (int i=node.first; i<node.first+node.count; ++i)
+      {
+        int c = cell_ids[i];
+        if (not RayCellIntersect(grid, grid->local_cells[c],
+                                 pos, omega, t_near, t_far)) continue;
+        if (t_far < 0.0) continue;
+
+        double d = std::max(t_near, 0.0);
+        if (d < best_d) {best_d = d; best_cell = c;}
+      }
+      continue;
+    }
+
+    //Push the farther child first so that the nearer one is popped next
+    double tl_near, tl_far, tr_near, tr_far;
+    bool hit_l = nodes[node.left ].box.IntersectRay(pos,inv_omega,tl_near,tl_far);
+    bool hit_r = nodes[node.right].box.IntersectRay(pos,inv_omega,tr_near,tr_far);
+    hit_l = hit_l and (tl_far >= 0.0);
+    hit_r = hit_r and (tr_far >= 0.0);
+    tl_near = std::max(tl_near, 0.0);
+    tr_near = std::max(tr_near, 0.0);
+
+    if (hit_l and hit_r)
+    {
+      if (tl_near <= tr_near)
+      {
+        stack.emplace_back(tr_near, node.right);
+        stack.emplace_back(tl_near, node.left);
+      }
+      else
+      {
+        stack.emplace_back(tl_near, node.left);
+        stack.emplace_back(tr_near, node.right);
+      }
+    }
+    else if (hit_l) stack.emplace_back(tl_near, node.left);
+    else if (hit_r) stack.emplace_back(tr_near, node.right);
+  }
+
+  d_to_entry = best_d;
+  return best_cell;
+}
+
+//###################################################################
+/**Traces a ray through the local cells of a grid. The starting cell is
+ * located with the BVH. If the origin is not inside a local cell, the
+ * ray is advanced to the first local cell it hits. The ray is then traced
+ * cell-by-cell with chi_mesh::RayTrace until it leaves the local domain,
+ * hits a boundary or reaches max_distance.*/
+chi_mesh::RayTraceResult chi_mesh::TraceRay(chi_mesh::MeshContinuum* grid,
+                                            const chi_mesh::CellBVH& bvh,
+                                            const chi_mesh::Vector3& pos,
+                                            const chi_mesh::Vector3& omega,
+                                            double max_distance)
+{
+  RayTraceResult result;
+  result.exit_point = pos;
+
+  chi_mesh::Vector3 omega_n = omega.Normalized();
+  chi_mesh::Vector3 pos_i = pos;
+  double d_traveled = 0.0;
+
+  //================================================== Find starting cell
+  int cell_local_id = bvh.FindCell(pos);
+  if (cell_local_id < 0)
+  {
+    double d_to_entry = 0.0;
+    cell_local_id = bvh.FirstHitCell(pos, omega_n, d_to_entry);
+    if ((cell_local_id < 0) or (d_to_entry >= max_distance))
+      return result;
+
+    d_traveled = d_to_entry;
+    pos_i = pos + omega_n*d_to_entry;
+  }
+
+  //================================================== Trace cell-by-cell
+  //Convex cells are each crossed at most once
+  size_t max_segments = grid->local_cells.size();
+  while (result.cell_local_ids.size() < max_segments)
+  {
+    auto& cell = grid->local_cells[cell_local_id];
+
+    double d_to_surface = 0.0;
+    chi_mesh::Vector3 pos_f;
+    auto dest_info = RayTrace(grid, &cell, pos_i, omega_n, d_to_surface, pos_f);
+
+    result.cell_local_ids.push_back(cell_local_id);
+    if ((d_traveled + d_to_surface) >= max_distance)
+    {
+      double d_remaining = max_distance - d_traveled;
+      result.segment_lengths.push_back(d_remaining);
+      result.exit_point = pos_i + omega_n*d_remaining;
+      result.exit_face_neighbor = -1;
+      break;
+    }
+
+    result.segment_lengths.push_back(d_to_surface);
+    result.exit_point = pos_f;
+    result.exit_face_neighbor = dest_info.destination_face_neighbor;
+    d_traveled += d_to_surface;
+    pos_i = pos_f;
+
+    if (dest_info.destination_face_neighbor < 0) break;
+
+    auto& face = cell.faces[dest_info.destination_face_index];
+    if (not face.IsNeighborLocal(grid)) break;
+
+    cell_local_id = face.GetNeighborLocalID(grid);
+  }
+
+  return result;
+}
+
+//###################################################################
+/**Traces a batch of rays. positions and directions must have the
+ * same size. The hierarchy is shared by all rays.*/
+void chi_mesh::TraceRays(chi_mesh::MeshContinuum* grid,
+                         const chi_mesh::CellBVH& bvh,
+                         const std::vector<chi_mesh::Vector3>& positions,
+                         const std::vector<chi_mesh::Vector3>& directions,
+                         std::vector<chi_mesh::RayTraceResult>& results,
+                         double max_distance)
+{
+  if (positions.size() != directions.size())
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "chi_mesh::TraceRays: Number of ray positions ("
+      << positions.size() << ") does not match number of directions ("
+      << directions.size() << ").";
+    exit(EXIT_FAILURE);
+  }
+
+  size_t num_rays = positions.size();
+  results.clear();
+  results.reserve(num_rays);
+  for (size_t r=0; r<num_rays; ++r)
+    results.push_back(TraceRay(grid, bvh, positions[r], directions[r],
+                               max_distance));
+}
@@ -0,0 +1,120 @@
+#ifndef _chi_mesh_raytrace_bvh_h
+#define _chi_mesh_raytrace_bvh_h
+
+#include "raytracing.h"
+
+namespace chi_mesh
+{
+
+//######################################################### Struct def
+/**Axis-aligned bounding box.*/
+struct BoundingBox
+{
+  Vector3 min;
+  Vector3 max;
+
+  BoundingBox() :
+    min( 1.0e32, 1.0e32, 1.0e32),
+    max(-1.0e32,-1.0e32,-1.0e32)
+  {}
+
+  void Expand(const Vector3& point);
+  void Expand(const BoundingBox& other);
+  bool Contains(const Vector3& point, double tolerance=0.0) const;
+  bool Overlaps(const BoundingBox& other) const;
+  bool IntersectsPlane(const Normal& normal, const Vector3& point) const;
+  bool IntersectRay(const Vector3& pos,
+                    const Vector3& inv_omega,
+                    double& t_near, double& t_far) const;
+  Vector3 Center() const {return (min + max)*0.5;}
+  int LongestAxis() const;
+};
+
+//######################################################### Class def
+/**Bounding-volume hierarchy over the bounding boxes of the local cells of
+ * a grid. Used for point location, box queries and first-hit ray queries.
+ * The hierarchy is stored as a flat array of nodes, with leaves referencing
+ * contiguous ranges in a permuted list of cell local ids.*/
+class CellBVH
+{
+public:
+  struct Node
+  {
+    BoundingBox box;
+    int left  = -1;  ///< Child node indices (<0 for leaves)
+    int right = -1;
+    int first = 0;   ///< First index into cell_ids (leaves only)
+    int count = 0;   ///< Number of cells in the leaf
+  };
+
+private:
+  chi_mesh::MeshContinuum* grid;
+  std::vector<Node>        nodes;
+  std::vector<BoundingBox> cell_boxes;
+  std::vector<int>         cell_ids;
+  int                      leaf_size;
+  bool                     collapsed_axes[3] = {false,false,false};
+
+public:
+  explicit CellBVH(chi_mesh::MeshContinuum* in_grid, int in_leaf_size=4);
+
+  int FindCell(const Vector3& point, double tolerance=1.0e-12) const;
+  void FindCells(const std::vector<Vector3>& points,
+                 std::vector<int>& cell_local_ids,
+                 double tolerance=1.0e-12) const;
+  void FindCellsOverlapping(const BoundingBox& box,
+                            std::vector<int>& cell_local_ids) const;
+  void FindCellsIntersectingPlane(const Normal& normal,
+                                  const Vector3& point,
+                                  std::vector<int>& cell_local_ids) const;
+  int FirstHitCell(const Vector3& pos,
+                   const Vector3& omega,
+                   double& d_to_entry) const;
+
+  const BoundingBox& GetCellBoundingBox(int cell_local_id) const
+  {return cell_boxes[cell_local_id];}
+  const BoundingBox& GetRootBoundingBox() const {return nodes[0].box;}
+  Vector3 ProjectToMeshDimension(const Vector3& point) const;
+  size_t NumberOfNodes() const {return nodes.size();}
+
+private:
+  int Build(int first, int count);
+};
+
+//######################################################### Struct def
+/**Result of tracing a single ray through the local cells of a grid.*/
+struct RayTraceResult
+{
+  std::vector<int>    cell_local_ids;   ///< Cells traversed, in order
+  std::vector<double> segment_lengths;  ///< Track length in each cell
+  Vector3             exit_point;       ///< Point where tracing stopped
+  int exit_face_neighbor = -1;          ///< Neighbor of the exit face
+};
+
+BoundingBox ComputeCellBoundingBox(const chi_mesh::MeshContinuum* grid,
+                                   const Cell& cell);
+bool IsPointInCell(const chi_mesh::MeshContinuum* grid,
+                   const Cell& cell,
+                   const Vector3& point,
+                   double tolerance=1.0e-12);
+bool RayCellIntersect(const chi_mesh::MeshContinuum* grid,
+                      const Cell& cell,
+                      const Vector3& pos,
+                      const Vector3& omega,
+                      double& t_near, double& t_far);
+
+RayTraceResult TraceRay(chi_mesh::MeshContinuum* grid,
+                        const CellBVH& bvh,
+                        const Vector3& pos,
+                        const Vector3& omega,
+                        double max_distance=1.0e15);
+void TraceRays(chi_mesh::MeshContinuum* grid,
+               const CellBVH& bvh,
+               const std::vector<Vector3>& positions,
+               const std::vector<Vector3>& directions,
+               std::vector<RayTraceResult>& results,
+               double max_distance=1.0e15);
+
+}
+
+#endif
@@ -3,6 +3,8 @@
 #include "../chi_region.h"
 #include "../../SurfaceMesh/chi_surfacemesh.h"
 #include "../../MeshHandler/chi_meshhandler.h"
+#include "../../SurfaceMesher/surfacemesher.h"
+#include "../../VolumeMesher/chi_volumemesher.h"
 #include "../../Boundary/chi_boundary.h"
 
 #include <chi_log.h>
@@ -167,4 +169,72 @@ int chiRegionExportMeshToVTK(lua_State *L)
   vol_cont->ExportCellsToVTK(base_name);
 
   return 0;
-}
\ No newline at end of file
+}
+//#############################################################################
+/** Exports each location's portion of the mesh, including ghost cells and
+ * neighboring partition cells, to a binary partition file. A later run with
+ * the same number of processes can load these files directly with a
+ * VOLUMEMESHER_PARTITION_FILE volume mesher, skipping meshing and
+ * partitioning. The files are named BaseName_npN_L.cpart where N is the
+ * process count and L the location id. The type of the current volume
+ * mesher and the x, y and z partition counts are stored with the files.
+
+\param RegionHandle int Handle to the region.
+\param BaseName char Base name of the partition files.
+
+\code
+chiRegionExportPartitionToFile(region1,"mesh_decomp")
+-- In a later run
+chiVolumeMesherCreate(VOLUMEMESHER_PARTITION_FILE,"mesh_decomp")
+chiVolumeMesherExecute()
+\endcode
+
+\ingroup LuaRegion*/
+int chiRegionExportPartitionToFile(lua_State *L)
+{
+  //============================================= Check arguments
+  int num_args = lua_gettop(L);
+  if (num_args != 2)
+    LuaPostArgAmountError("chiRegionExportPartitionToFile",2,num_args);
+
+  int region_index = lua_tonumber(L,1);
+  const char* base_name = lua_tostring(L,2);
+
+  //============================================= Get current handler
+  chi_mesh::MeshHandler* cur_hndlr = chi_mesh::GetCurrentHandler();
+
+  //============================================= Attempt to obtain region
+  chi_mesh::Region* cur_region;
+  try{
+    cur_region = cur_hndlr->region_stack.at(region_index);
+  }
+  catch(const std::out_of_range& o)
+  {
+    chi_log.Log(LOG_ALLERROR) << "ERROR: Invalid index to region in "
+                                 "chiRegionExportPartitionToFile.";
+    exit(EXIT_FAILURE);
+  }
+
+  if (cur_hndlr->volume_mesher == nullptr)
+  {
+    chi_log.Log(LOG_ALLERROR) << "ERROR: No volume mesher in "
+                                 "chiRegionExportPartitionToFile.";
+    exit(EXIT_FAILURE);
+  }
+
+  //============================================= Mesher information
+  chi_mesh::MeshContinuum::PartitionFileInfo info;
+  info.mesher_type = cur_hndlr->volume_mesher->Type();
+  info.partition_z = cur_hndlr->volume_mesher->options.partition_z;
+  if (cur_hndlr->surface_mesher != nullptr)
+  {
+    info.partition_x = cur_hndlr->surface_mesher->partitioning_x;
+    info.partition_y = cur_hndlr->surface_mesher->partitioning_y;
+  }
+
+  auto vol_cont = cur_region->GetGrid();
+
+  vol_cont->ExportPartitionToFile(base_name,info);
+
+  return 0;
+}
@@ -3,6 +3,9 @@
 #include <chi_log.h>
 extern ChiLog chi_log;
 
+#include <chi_mpi.h>
+extern ChiMPI chi_mpi;
+
 #include <set>
 #include <fstream>
 
@@ -10,6 +13,8 @@ extern ChiLog chi_log;
 /**Extract open edges to wavefront obj format.*/
 void chi_mesh::SurfaceMesh::ExtractOpenEdgesToObj(const char *fileName)
 {
+  if (chi_mpi.team_id != 0) return;
+
   std::vector<std::pair<int,int>> edges;
   for (auto face : poly_faces)
   {
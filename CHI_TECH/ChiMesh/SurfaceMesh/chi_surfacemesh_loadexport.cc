@@ -1,4 +1,5 @@
 #include"chi_surfacemesh.h"
+#include "chi_surfacemesh_mappedfile.h"
 #include<iostream>
 #include<fstream>
 #include <algorithm>
@@ -6,20 +7,26 @@
 #include <chi_log.h>
 extern ChiLog chi_log;
 
+#include <chi_mpi.h>
+extern ChiMPI chi_mpi;
+
 #include <ChiTimer/chi_timer.h>
 extern ChiTimer    chi_program_timer;
 
 //#########################################################
-/** Loads a surface mesh from a wavefront .obj file.*/
+/** Loads a surface mesh from a wavefront .obj file.
+ *
+ * The file is memory mapped. A first pass counts the vertices and
+ * faces so that containers can be sized once, and a second pass parses
+ * them with a hand-written number scanner. Face corners may be given as
+ * v, v/vt, v//vn or v/vt/vn and negative (relative) indices are
+ * supported.*/
 int chi_mesh::SurfaceMesh::
     ImportFromOBJFile(const char* fileName, bool as_poly=false)
 {
-
-
-  //===================================================== Opening the file
-  std::ifstream file;
-  file.open(fileName);
-  if (!file.is_open())
+  //===================================================== Map the file
+  mesh_io::MappedFile file;
+  if (!file.Open(fileName))
   {
     chi_log.Log(LOG_ALLERROR)
       << "Failed to open file: "<< fileName<<" in call "
@@ -27,312 +34,165 @@ int chi_mesh::SurfaceMesh::
     exit(EXIT_FAILURE);
   }
 
-  //===================================================== Reading every line and determining size
-  std::string file_line;
-  std::string delimiter = " ";
-  int counter=0;
-  while (std::getline(file,file_line))
+  //===================================================== Counting pass
+  size_t num_v = 0, num_vt = 0, num_vn = 0, num_f = 0, num_l = 0;
   {
-    counter++;
-
-    //===================================================== Get the first word
-    size_t beg_of_word = file_line.find_first_not_of(delimiter);
-    size_t end_of_word = file_line.find(delimiter,beg_of_word-beg_of_word);
-    std::string first_word = file_line.substr(beg_of_word,end_of_word);
-    std::string sub_word;
-
-    //===================================================== Keyword "v" for Vertex
-    if (first_word.compare("v")==0) {
-      chi_mesh::Vertex* newVertex = new chi_mesh::Vertex;
-      for (int k=1;k<=3;k++)
-      {
-        //================================== Extract sub word
-        beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-        end_of_word = file_line.find(delimiter, beg_of_word);
-        sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-        //============================= Convert word to number
-        try{ double numValue = std::stod(sub_word);
-          //*newVertex->value[k-1] = numValue;
-          if (k==1)
-          {
-            newVertex->x = numValue;
-          }
-          else if (k==2)
-          {
-            newVertex->y = numValue;
-          }
-          else if (k==3)
-          {
-            newVertex->z = numValue;
-          }
-        }
+    mesh_io::TextScanner scanner(file.Begin(), file.End());
+    while (!scanner.AtEnd())
+    {
+      if      (scanner.MatchWord("v"))  ++num_v;
+      else if (scanner.MatchWord("vt")) ++num_vt;
+      else if (scanner.MatchWord("vn")) ++num_vn;
+      else if (scanner.MatchWord("f"))  ++num_f;
+      else if (scanner.MatchWord("l"))  ++num_l;
+      scanner.SkipLine();
+    }
+  }
 
-        //============================= Catch conversion error
-        catch(const std::invalid_argument& ia)
-        {
-          //*newVertex->value[k-1] = 0.0;
-          std::cout<<"Exception caught!"<<std::endl;
-        }
+  vertices.reserve(vertices.size() + num_v);
+  tex_vertices.reserve(tex_vertices.size() + num_vt);
+  normals.reserve(normals.size() + num_vn);
+  if (as_poly) poly_faces.reserve(poly_faces.size() + num_f);
+  else         faces.reserve(faces.size() + num_f);
+  lines.reserve(lines.size() + num_l);
 
-        //============================= Stop word extraction on line end
-        if (end_of_word==std::string::npos) {break;}
-      }
-      this->vertices.push_back(*newVertex);
-    }
+  //===================================================== Parsing pass
+  std::vector<int> corner_v, corner_vt, corner_vn;
 
-    //===================================================== Keyword "vt" for Vertex
-    if (first_word.compare("vt")==0) {
-      chi_mesh::Vertex* newVertex = new chi_mesh::Vertex;
-      for (int k=1;k<=2;k++)
-      {
-        //================================== Extract sub word
-        beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-        end_of_word = file_line.find(delimiter, beg_of_word);
-        sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-        //============================= Convert word to number
-        try{ double numValue = std::stod(sub_word);
-          //*newVertex->value[k-1] = numValue;
-          if (k==1)
-          {
-            newVertex->x = numValue;
-          }
-          else if (k==2)
-          {
-            newVertex->y = numValue;
-          }
-          else if (k==3)
-          {
-            newVertex->z = numValue;
-          }
-        }
+  //Converts a 1-based or negative (relative) index to 0-based
+  auto ResolveIndex = [](long long index, size_t count)
+  {
+    return (index < 0)? static_cast<int>(count + index) :
+                        static_cast<int>(index - 1);
+  };
 
-        //============================= Catch conversion error
-        catch(const std::invalid_argument& ia)
-        {
-          //*newVertex->value[k-1] = 0.0;
-          std::cout<<"Exception caught!"<<std::endl;
-        }
+  mesh_io::TextScanner scanner(file.Begin(), file.End());
+  int line_number = 0;
+  while (!scanner.AtEnd())
+  {
+    ++line_number;
+    bool line_ok = true;
 
-        //============================= Stop word extraction on line end
-        if (end_of_word==std::string::npos) {break;}
-      }
-      this->tex_vertices.push_back(*newVertex);
+    //=================================================== Keyword "v" for Vertex
+    if (scanner.MatchWord("v"))
+    {
+      chi_mesh::Vertex vertex;
+      line_ok = scanner.ReadDouble(vertex.x) and
+                scanner.ReadDouble(vertex.y) and
+                scanner.ReadDouble(vertex.z);
+      vertices.push_back(vertex);
     }
-
-    //===================================================== Keyword "vn" for normal
-    if (first_word.compare("vn")==0) {
-      chi_mesh::Normal* newNormal = new chi_mesh::Normal;
-      for (int k=1;k<=3;k++)
+    //=================================================== Keyword "vt" for Vertex
+    else if (scanner.MatchWord("vt"))
+    {
+      chi_mesh::Vertex vertex;
+      line_ok = scanner.ReadDouble(vertex.x) and
+                scanner.ReadDouble(vertex.y);
+      tex_vertices.push_back(vertex);
+    }
+    //=================================================== Keyword "vn" for normal
+    else if (scanner.MatchWord("vn"))
+    {
+      chi_mesh::Normal normal;
+      line_ok = scanner.ReadDouble(normal.x) and
+                scanner.ReadDouble(normal.y) and
+                scanner.ReadDouble(normal.z);
+      normals.push_back(normal);
+    }
+    //=================================================== Keyword "f" for face
+    else if (scanner.MatchWord("f"))
+    {
+      corner_v.clear(); corner_vt.clear(); corner_vn.clear();
+      while (line_ok and !scanner.AtEndOfLine())
       {
-        //================================== Extract sub word
-        beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-        end_of_word = file_line.find(delimiter, beg_of_word);
-        sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-        //============================= Convert word to number
-        try{ double numValue = std::stod(sub_word);
-          //*newNormal->value[k-1] = numValue;
-          if (k==1)
-          {
-            newNormal->x = numValue;
-          }
-          else if (k==2)
-          {
-            newNormal->y = numValue;
-          }
-          else if (k==3)
+        long long v = 0, vt = 0, vn = 0;
+        line_ok = scanner.ReadInt(v);
+        if (line_ok and !scanner.AtEnd() and (*scanner.cur == '/'))
+        {
+          ++scanner.cur;
+          if (!scanner.AtEnd() and (*scanner.cur != '/'))
+            line_ok = scanner.ReadInt(vt);
+          if (line_ok and !scanner.AtEnd() and (*scanner.cur == '/'))
           {
-            newNormal->z = numValue;
+            ++scanner.cur;
+            line_ok = scanner.ReadInt(vn);
           }
         }
-
-        //============================= Catch conversion error
-        catch(const std::invalid_argument& ia)
-        {
-          //*newNormal->value[k-1] = 0.0;
-          std::cout<<"Exception caught!"<<std::endl;
-        }
-
-        //============================= Stop word extraction on line end
-        if (end_of_word==std::string::npos) {break;}
+        corner_v.push_back(ResolveIndex(v, vertices.size()));
+        corner_vt.push_back((vt == 0)? -1 : ResolveIndex(vt, tex_vertices.size()));
+        corner_vn.push_back((vn == 0)? -1 : ResolveIndex(vn, normals.size()));
       }
-      this->normals.push_back(*newNormal);
-    }
+      if (corner_v.size() < 3) line_ok = false;
 
-    //===================================================== Keyword "f" for face
-    if (first_word.compare("f")==0)
-    {
-      int number_of_verts = std::count(file_line.begin(),file_line.end(),'/')/2;
-      if ((number_of_verts==3) && (!as_poly))
+      if (line_ok and (corner_v.size() == 3) and (!as_poly))
       {
-        chi_mesh::Face* newFace = new chi_mesh::Face;
-
-        for (int k=1;k<=3;k++)
+        chi_mesh::Face new_face;
+        for (int k=0; k<3; ++k)
         {
-          //================================== Extract sub word
-          beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-          end_of_word = file_line.find(delimiter, beg_of_word);
-          sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-          //============================= Extract locations of hiphens
-          size_t first_dash = sub_word.find("/");
-          size_t last_dash  = sub_word.find_last_of("/");
-
-          //============================= Extract the words ass. w vertex and normal
-          std::string vert_word = sub_word.substr(0,first_dash-0);
-          std::string norm_word = sub_word.substr(last_dash+1,sub_word.length()-last_dash-1);
-
-          //============================= Convert word to number (Vertex)
-          try{ int numValue = std::stoi(vert_word);
-            newFace->v_index[k-1] = numValue-1;
-          }
-          catch(const std::invalid_argument& ia){std::cout<<"Exception caught!"<<std::endl; }
-
-          //============================= Convert word to number (Normal)
-          try{ int numValue = std::stoi(norm_word);
-            newFace->n_index[k-1] = numValue-1;
-          }
-          catch(const std::invalid_argument& ia){std::cout<<"Exception caught!"<<std::endl; }
-
-          //============================= Convert word to number (Texture Vertex)
-          if (last_dash>(first_dash+1)){
-            std::string tvert_word = sub_word.substr(first_dash+1,last_dash-first_dash-1);
-            try{ int numValue = std::stoi(tvert_word);
-              newFace->vt_index[k-1] = numValue-1;
-            }
-            catch(const std::invalid_argument& ia)
-            {
-              std::cout<<"Exception caught!"<<std::endl;
-            }
-          }
-
-          //============================= Stop word extraction on line end
-          if (end_of_word==std::string::npos) {break;}
+          new_face.v_index[k]  = corner_v[k];
+          new_face.vt_index[k] = corner_vt[k];
+          new_face.n_index[k]  = corner_vn[k];
         }
 
-
         //==================================== Set edges
-        newFace->e_index[0][0] = newFace->v_index[0];
-        newFace->e_index[0][1] = newFace->v_index[1];
-
-        newFace->e_index[1][0] = newFace->v_index[1];
-        newFace->e_index[1][1] = newFace->v_index[2];
-
-        newFace->e_index[2][0] = newFace->v_index[2];
-        newFace->e_index[2][1] = newFace->v_index[0];
+        for (int k=0; k<3; ++k)
+        {
+          new_face.e_index[k][0] = new_face.v_index[k];
+          new_face.e_index[k][1] = new_face.v_index[(k+1)%3];
+        }
 
-        this->faces.push_back(*newFace);
+        faces.push_back(new_face);
       }
-      else
+      else if (line_ok)
       {
-        chi_mesh::PolyFace* newFace = new chi_mesh::PolyFace;
-
-        for (int k=1;k<=number_of_verts;k++)
-        {
-          //================================== Extract sub word
-          beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-          end_of_word = file_line.find(delimiter, beg_of_word);
-          sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-          //============================= Extract locations of hiphens
-          size_t first_dash = sub_word.find("/");
-          size_t last_dash  = sub_word.find_last_of("/");
-
-          //============================= Extract the words ass. w vertex and normal
-          std::string vert_word = sub_word.substr(0,first_dash-0);
-          std::string norm_word = sub_word.substr(last_dash+1,sub_word.length()-last_dash-1);
-
-          //============================= Convert word to number (Vertex)
-          try{ int numValue = std::stoi(vert_word);
-            newFace->v_indices.push_back(numValue-1);
-          }
-          catch(const std::invalid_argument& ia){std::cout<<"Exception caught!"<<std::endl; }
-
-          //============================= Convert word to number (Normal)
-          try{ int numValue = std::stoi(norm_word);
-            //newFace->n_indices.push_back(numValue-1);
-          }
-          catch(const std::invalid_argument& ia){std::cout<<"Exception caught!"<<std::endl; }
-
-          //============================= Convert word to number (Texture Vertex)
-          if (last_dash>(first_dash+1)){
-            std::string tvert_word = sub_word.substr(first_dash+1,last_dash-first_dash-1);
-            try{ int numValue = std::stoi(tvert_word);
-              //newFace->vt_indices.push_back(numValue-1);
-            }
-            catch(const std::invalid_argument& ia)
-            {
-              std::cout<<"Exception caught!"<<std::endl;
-            }
-          }
-
-          //============================= Stop word extraction on line end
-          if (end_of_word==std::string::npos) {break;}
-        }
+        auto new_face = new chi_mesh::PolyFace;
+        new_face->v_indices = corner_v;
 
-        for (int v=0;v<(newFace->v_indices.size());v++)
+        size_t num_verts = corner_v.size();
+        new_face->edges.reserve(num_verts);
+        for (size_t v=0; v<num_verts; ++v)
         {
           int* side_indices = new int[4];
 
-          side_indices[0] = newFace->v_indices[v];
-          side_indices[1] = newFace->v_indices[v+1];
+          side_indices[0] = corner_v[v];
+          side_indices[1] = corner_v[(v+1)%num_verts];
           side_indices[2] = -1;
           side_indices[3] = -1;
 
-          if ((v+1)>=newFace->v_indices.size())
-          {
-            side_indices[1] = newFace->v_indices[0];
-          }
-
-          newFace->edges.push_back(side_indices);
+          new_face->edges.push_back(side_indices);
         }
 
-
-        this->poly_faces.push_back(newFace);
+        poly_faces.push_back(new_face);
       }
-
-
     }
-
-
     //=================================================== Keyword "l" for line
-    if (first_word.compare("l")==0){
-      chi_mesh::Edge newEdge;
-
-      //================================== Extract sub word
-      beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-      end_of_word = file_line.find(delimiter, beg_of_word);
-      sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-      //================================== Convert to number
-      try{ int numValue = std::stoi(sub_word);
-        newEdge.v_index[0] = numValue-1;
-      }
-      catch(const std::invalid_argument& ia){std::cout<<"Exception caught!"<<std::endl; }
+    else if (scanner.MatchWord("l"))
+    {
+      long long a = 0, b = 0;
+      line_ok = scanner.ReadInt(a) and scanner.ReadInt(b);
+      if (line_ok)
+      {
+        chi_mesh::Edge new_edge;
+        new_edge.v_index[0] = ResolveIndex(a, vertices.size());
+        new_edge.v_index[1] = ResolveIndex(b, vertices.size());
 
-      //================================== Extract sub word
-      beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-      end_of_word = file_line.find(delimiter, beg_of_word);
-      sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
+        new_edge.vertices[0] = vertices.at(new_edge.v_index[0]);
+        new_edge.vertices[1] = vertices.at(new_edge.v_index[1]);
 
-      //================================== Convert to number
-      try{ int numValue = std::stoi(sub_word);
-        newEdge.v_index[1] = numValue-1;
+        lines.push_back(new_edge);
       }
-      catch(const std::invalid_argument& ia){std::cout<<"Exception caught!"<<std::endl; }
-
-      newEdge.vertices[0] = this->vertices.at(newEdge.v_index[0]);
-      newEdge.vertices[1] = this->vertices.at(newEdge.v_index[1]);
-
-      this->lines.push_back(newEdge);
+    }
 
-      //printf("line %d->%d\n",newEdge.v_index[0],newEdge.v_index[1]);
+    if (!line_ok)
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Failed to parse line " << line_number << " of file "
+        << fileName << " in call to ImportFromOBJFile.";
+      exit(EXIT_FAILURE);
     }
 
+    scanner.SkipLine();
   }
-  file.close();
 
   //======================================================= Calculate face properties
   std::vector<chi_mesh::Face>::iterator curFace;
@@ -350,14 +210,21 @@ int chi_mesh::SurfaceMesh::
     curFace->geometric_normal = curFace->geometric_normal/curFace->geometric_normal.Norm();
 
     //=========================================== Calculate Assigned normal
-    chi_mesh::Vertex nA = this->normals.at(curFace->n_index[0]);
-    chi_mesh::Vertex nB = this->normals.at(curFace->n_index[1]);
-    chi_mesh::Vertex nC = this->normals.at(curFace->n_index[2]);
+    //Faces without vertex normals use the geometric normal
+    if ((curFace->n_index[0] < 0) or (curFace->n_index[1] < 0) or
+        (curFace->n_index[2] < 0))
+      curFace->assigned_normal = curFace->geometric_normal;
+    else
+    {
+      chi_mesh::Vertex nA = this->normals.at(curFace->n_index[0]);
+      chi_mesh::Vertex nB = this->normals.at(curFace->n_index[1]);
+      chi_mesh::Vertex nC = this->normals.at(curFace->n_index[2]);
 
-    chi_mesh::Vector3 nAvg = (nA + nB + nC) / 3.0;
-    nAvg = nAvg/nAvg.Norm();
+      chi_mesh::Vector3 nAvg = (nA + nB + nC) / 3.0;
+      nAvg = nAvg/nAvg.Norm();
 
-    curFace->assigned_normal = nAvg;
+      curFace->assigned_normal = nAvg;
+    }
 
     //=========================================== Compute face center
     curFace->face_centroid = (vA+vB+vC)/3.0;
@@ -504,14 +371,21 @@ ImportFromTriangleFiles(const char* fileName, bool as_poly=false)
     curFace->geometric_normal = curFace->geometric_normal/curFace->geometric_normal.Norm();
 
     //=========================================== Calculate Assigned normal
-    chi_mesh::Vertex nA = this->normals.at(curFace->n_index[0]);
-    chi_mesh::Vertex nB = this->normals.at(curFace->n_index[1]);
-    chi_mesh::Vertex nC = this->normals.at(curFace->n_index[2]);
+    //Faces without vertex normals use the geometric normal
+    if ((curFace->n_index[0] < 0) or (curFace->n_index[1] < 0) or
+        (curFace->n_index[2] < 0))
+      curFace->assigned_normal = curFace->geometric_normal;
+    else
+    {
+      chi_mesh::Vertex nA = this->normals.at(curFace->n_index[0]);
+      chi_mesh::Vertex nB = this->normals.at(curFace->n_index[1]);
+      chi_mesh::Vertex nC = this->normals.at(curFace->n_index[2]);
 
-    chi_mesh::Vector3 nAvg = (nA + nB + nC) / 3.0;
-    nAvg = nAvg/nAvg.Norm();
+      chi_mesh::Vector3 nAvg = (nA + nB + nC) / 3.0;
+      nAvg = nAvg/nAvg.Norm();
 
-    curFace->assigned_normal = nAvg;
+      curFace->assigned_normal = nAvg;
+    }
 
     //=========================================== Compute face center
     curFace->face_centroid = (vA+vB+vC)/3.0;
@@ -668,21 +542,94 @@ chi_mesh::SurfaceMesh* chi_mesh::SurfaceMesh::
   return surf_mesh;
 }
 
-//#########################################################
-/** Loads a surface mesh from gmsh's file format.*/
-int chi_mesh::SurfaceMesh::
-ImportFromMshFiles(const char* fileName, bool as_poly=false)
+namespace
 {
-  const std::string node_section_name="$Nodes";
-  const std::string elements_section_name = "$Elements";
+/**Number of nodes of a gmsh element type, or -1 if unknown. Binary
+ * element blocks are skipped by node count, so every fixed-size type
+ * gmsh writes is listed even though only triangles and quadrangles are
+ * loaded.*/
+int GmshElementNumNodes(int elem_type)
+{
+  switch (elem_type)
+  {
+    case 1:  return 2;   //2-node line
+    case 2:  return 3;   //3-node triangle
+    case 3:  return 4;   //4-node quadrangle
+    case 4:  return 4;   //4-node tetrahedron
+    case 5:  return 8;   //8-node hexahedron
+    case 6:  return 6;   //6-node prism
+    case 7:  return 5;   //5-node pyramid
+    case 8:  return 3;   //3-node line
+    case 9:  return 6;   //6-node triangle
+    case 10: return 9;   //9-node quadrangle
+    case 11: return 10;  //10-node tetrahedron
+    case 12: return 27;  //27-node hexahedron
+    case 13: return 18;  //18-node prism
+    case 14: return 14;  //14-node pyramid
+    case 15: return 1;   //1-node point
+    case 16: return 8;   //8-node quadrangle
+    case 17: return 20;  //20-node hexahedron
+    case 18: return 15;  //15-node prism
+    case 19: return 13;  //13-node pyramid
+    case 20: return 9;   //9-node incomplete triangle
+    case 21: return 10;  //10-node triangle
+    case 22: return 12;  //12-node incomplete triangle
+    case 23: return 15;  //15-node triangle
+    case 24: return 15;  //15-node incomplete triangle
+    case 25: return 21;  //21-node triangle
+    case 26: return 4;   //4-node line
+    case 27: return 5;   //5-node line
+    case 28: return 6;   //6-node line
+    case 29: return 20;  //20-node tetrahedron
+    case 30: return 35;  //35-node tetrahedron
+    case 31: return 56;  //56-node tetrahedron
+    case 92: return 64;  //64-node hexahedron
+    case 93: return 125; //125-node hexahedron
+    default: return -1;
+  }
+}
 
-  std::istringstream iss;
-  std::string line;
+/**Creates a polygon face from gmsh triangles and quadrangles.*/
+chi_mesh::PolyFace* GmshMakePolyFace(const int* nodes, int num_nodes)
+{
+  auto new_face = new chi_mesh::PolyFace;
+  new_face->v_indices.resize(num_nodes);
+  for (int i=0; i<num_nodes; i++)
+    new_face->v_indices[i] = nodes[i]-1;
 
-  std::ifstream file;
-  file.open(std::string(fileName));
+  new_face->edges.reserve(num_nodes);
+  for (int e=0; e<num_nodes; e++)
+  {
+    int* side_indices = new int[4];
+    side_indices[0] = new_face->v_indices[e];
+    side_indices[1] = new_face->v_indices[(e+1)%num_nodes];
+    side_indices[2] = -1;
+    side_indices[3] = -1;
 
-  if (!file.is_open())
+    new_face->edges.push_back(side_indices);
+  }
+  return new_face;
+}
+
+void GmshParseError(const char* message)
+{
+  chi_log.Log(LOG_ALLERROR)
+    << "ImportFromMshFiles: " << message;
+  exit(EXIT_FAILURE);
+}
+}
+
+//#########################################################
+/** Loads a surface mesh from gmsh's file format.
+ *
+ * The file is memory mapped and parsed with a hand-written scanner.
+ * Supported are the ASCII version 2 format and the version 4.1 format,
+ * ASCII or binary. Only triangle and quadrangle elements are loaded.*/
+int chi_mesh::SurfaceMesh::
+ImportFromMshFiles(const char* fileName, bool as_poly=false)
+{
+  mesh_io::MappedFile file;
+  if (!file.Open(fileName))
   {
     chi_log.Log(LOG_ALLERROR)
       << "Failed to open file: "<< fileName <<" in call "
@@ -690,148 +637,284 @@ ImportFromMshFiles(const char* fileName, bool as_poly=false)
     exit(EXIT_FAILURE);
   }
 
-  //=================================================== Find section with node information
-  //                                                    and then read information
-  while (std::getline(file, line))
+  //=================================================== Determine format
+  double version = 2.2;
+  int    file_type = 0;
   {
-    if ( node_section_name.compare(line)==0 )
-      break;
-  }
-
-  std::getline(file, line);
-  iss = std::istringstream(line);
-  int num_nodes;
-  if ( !(iss >> num_nodes) )
-  {
-    chi_log.Log(LOG_ALLERROR)<<"Failed while trying to read the number of nodes.\n";
-    exit(EXIT_FAILURE);
-  }
-
-  vertices.resize(num_nodes);
+    mesh_io::TextScanner scanner(file.Begin(), file.End());
+    if (scanner.FindLine("$MeshFormat"))
+    {
+      int data_size = 0;
+      if (!(scanner.ReadDouble(version) and scanner.ReadInt(file_type) and
+            scanner.ReadInt(data_size)))
+        GmshParseError("Failed to read the mesh format.");
 
-  for (int n=0; n<num_nodes; n++)
-  {
-    std::getline(file, line);
-    iss = std::istringstream(line);
+      if ((file_type == 1) and (data_size != sizeof(size_t)))
+        GmshParseError("Unsupported binary data size.");
 
-    chi_mesh::Vertex vertex;
-    int vert_index;
-    if ( !(iss >> vert_index) )
-    {
-      chi_log.Log(LOG_ALLERROR)<<"Failed to read vertex index.\n";
-      exit(EXIT_FAILURE);
+      if (file_type == 1)
+      {
+        scanner.SkipLine();
+        int one = 0;
+        if (!scanner.ReadBinary(one) or (one != 1))
+          GmshParseError("Binary file endianness does not match.");
+      }
     }
+  }
 
-    if (!(iss >> vertex.x >> vertex.y >> vertex.z))
-    {
-      chi_log.Log(LOG_ALLERROR)<<"Failed while reading the vertex coordinates.\n";
-      exit(EXIT_FAILURE);
-    }
+  bool is_v4 = (version >= 4.0);
+  bool is_binary = (file_type == 1);
 
-    vertices[vert_index-1] = vertex;
-  }
+  if (is_binary and !is_v4)
+    GmshParseError("Binary files are only supported for version 4.1.");
+  if (is_v4 and (version < 4.1))
+    GmshParseError("Version 4.0 files are not supported, use 4.1.");
 
+  //=================================================== Nodes
+  mesh_io::TextScanner scanner(file.Begin(), file.End());
+  if (!scanner.FindLine("$Nodes"))
+    GmshParseError("No $Nodes section found.");
 
-  //=================================================== Find the element listing section
-  //                                                    and first read the boundary data
-  file.seekg(0);
-  while (std::getline(file, line))
+  if (!is_v4)
   {
-    if ( elements_section_name.compare(line)==0 )
-      break;
-  }
+    int num_nodes;
+    if (!scanner.ReadInt(num_nodes))
+      GmshParseError("Failed while trying to read the number of nodes.");
+    scanner.SkipLine();
 
-  std::getline(file, line);
-  iss = std::istringstream(line);
-  int num_elems;
-  if (!(iss >> num_elems))
-  {
-    chi_log.Log(LOG_ALLERROR)<<"Failed to read number of elements.\n";
-    exit(EXIT_FAILURE);
+    vertices.resize(num_nodes);
+    for (int n=0; n<num_nodes; n++)
+    {
+      int vert_index;
+      chi_mesh::Vertex vertex;
+      if (!(scanner.ReadInt(vert_index) and
+            scanner.ReadDouble(vertex.x) and
+            scanner.ReadDouble(vertex.y) and
+            scanner.ReadDouble(vertex.z)))
+        GmshParseError("Failed while reading the vertex coordinates.");
+      if ((vert_index < 1) or (vert_index > num_nodes))
+        GmshParseError("Vertex index out of range.");
+      scanner.SkipLine();
+
+      vertices[vert_index-1] = vertex;
+    }
   }
-
-  for (int n=0; n<num_elems; n++)
+  else
   {
-    int elem_type, num_tags, tag, element_index;
-    chi_mesh::PolyFace* newFace = new chi_mesh::PolyFace;
-    std::getline(file, line);
-    iss = std::istringstream(line);
-
-    if ( !(iss >> element_index >> elem_type >> num_tags) )
+    size_t header[4]; //num blocks, num nodes, min tag, max tag
+    if (is_binary)
     {
-      chi_log.Log(LOG_ALLERROR)<<"Failed while reading element index, element type, and number of tags.\n";
-      exit(EXIT_FAILURE);
+      if (!scanner.ReadBinary(header, sizeof(header)))
+        GmshParseError("Failed to read the node section header.");
     }
-
-    for (int i=0; i<num_tags; i++)
-      if( !(iss >> tag) )
+    else
+      for (auto& value : header)
       {
-        chi_log.Log(LOG_ALLERROR)<<"Failed when reading tags.\n";
-        exit(EXIT_FAILURE);
+        long long v;
+        if (!scanner.ReadInt(v))
+          GmshParseError("Failed to read the node section header.");
+        value = v;
       }
 
-    if (elem_type == 2)
+    vertices.resize(header[3]);
+
+    std::vector<size_t> tags;
+    for (size_t b=0; b<header[0]; ++b)
     {
-      const int num_nodes = 3;
+      int entity_dim, entity_tag, parametric;
+      size_t num_in_block;
+      if (is_binary)
+      {
+        if (!(scanner.ReadBinary(entity_dim) and
+              scanner.ReadBinary(entity_tag) and
+              scanner.ReadBinary(parametric) and
+              scanner.ReadBinary(num_in_block)))
+          GmshParseError("Failed to read a node block header.");
+      }
+      else
+      {
+        long long n;
+        scanner.SkipWhitespace();
+        if (!(scanner.ReadInt(entity_dim) and scanner.ReadInt(entity_tag) and
+              scanner.ReadInt(parametric) and scanner.ReadInt(n)))
+          GmshParseError("Failed to read a node block header.");
+        num_in_block = n;
+      }
 
-      int nodes[num_nodes];
-      for (int i=0; i<num_nodes; i++)
-        if ( !(iss >> nodes[i]) )
+      tags.resize(num_in_block);
+      if (is_binary)
+      {
+        if (!scanner.ReadBinary(tags.data(), num_in_block*sizeof(size_t)))
+          GmshParseError("Failed to read node tags.");
+      }
+      else
+        for (auto& tag : tags)
         {
-          chi_log.Log(LOG_ALLERROR)<<"Failed when reading element node index.\n";
-          exit(EXIT_FAILURE);
+          long long v;
+          if (!(scanner.SkipWhitespace(), scanner.ReadInt(v)))
+            GmshParseError("Failed to read node tags.");
+          tag = v;
         }
 
-      newFace->v_indices.resize(num_nodes);
-      for (int i=0; i<num_nodes; i++)
-        newFace->v_indices[i] = nodes[i]-1;
-
-    } else if (elem_type == 3)
-    {
-      const int num_nodes = 4;
-
-      int nodes[num_nodes];
-      for (int i=0; i<num_nodes; i++)
-        if ( !(iss >> nodes[i]) )
+      int num_params = parametric? entity_dim : 0;
+      for (size_t n=0; n<num_in_block; ++n)
+      {
+        double xyz[6] = {0.0,0.0,0.0,0.0,0.0,0.0};
+        if (is_binary)
         {
-          chi_log.Log(LOG_ALLERROR)<<"Failed when reading element node index.\n";
-          exit(EXIT_FAILURE);
+          if (!scanner.ReadBinary(xyz, (3+num_params)*sizeof(double)))
+            GmshParseError("Failed to read node coordinates.");
+        }
+        else
+        {
+          scanner.SkipWhitespace();
+          for (int i=0; i<3+num_params; ++i)
+            if (!scanner.ReadDouble(xyz[i]))
+              GmshParseError("Failed to read node coordinates.");
         }
 
-      newFace->v_indices.resize(num_nodes);
-      for (int i=0; i<num_nodes; i++)
-        newFace->v_indices[i] = nodes[i]-1;
+        if ((tags[n] < 1) or (tags[n] > vertices.size()))
+          GmshParseError("Vertex index out of range.");
+        vertices[tags[n]-1] = chi_mesh::Vertex(xyz[0],xyz[1],xyz[2]);
+      }
+    }
+  }
+
+  //=================================================== Elements
+  if (!scanner.FindLine("$Elements"))
+    GmshParseError("No $Elements section found.");
 
-    } else
+  int nodes[32];
+  if (!is_v4)
+  {
+    int num_elems;
+    if (!scanner.ReadInt(num_elems))
+      GmshParseError("Failed to read number of elements.");
+    scanner.SkipLine();
+
+    poly_faces.reserve(poly_faces.size() + num_elems);
+    for (int n=0; n<num_elems; n++)
     {
+      int elem_type, num_tags, tag, element_index;
+      if (!(scanner.ReadInt(element_index) and scanner.ReadInt(elem_type) and
+            scanner.ReadInt(num_tags)))
+        GmshParseError("Failed while reading element index, element type, "
+                       "and number of tags.");
 
-      continue;
-    }
+      for (int i=0; i<num_tags; i++)
+        if (!scanner.ReadInt(tag))
+          GmshParseError("Failed when reading tags.");
 
-    const int total_nodes = newFace->v_indices.size();
+      if ((elem_type == 2) or (elem_type == 3))
+      {
+        int num_nodes = GmshElementNumNodes(elem_type);
+        for (int i=0; i<num_nodes; i++)
+          if (!scanner.ReadInt(nodes[i]))
+            GmshParseError("Failed when reading element node index.");
 
-    for (int e=0; e<total_nodes; e++)
+        poly_faces.push_back(GmshMakePolyFace(nodes, num_nodes));
+      }
+      scanner.SkipLine();
+    }
+  }
+  else
+  {
+    size_t header[4]; //num blocks, num elements, min tag, max tag
+    if (is_binary)
     {
-      int* side_indices = new int[total_nodes];
-      side_indices[0] = newFace->v_indices[e];
+      if (!scanner.ReadBinary(header, sizeof(header)))
+        GmshParseError("Failed to read the element section header.");
+    }
+    else
+      for (auto& value : header)
+      {
+        long long v;
+        if (!scanner.ReadInt(v))
+          GmshParseError("Failed to read the element section header.");
+        value = v;
+      }
 
-      if (e<total_nodes-1)
-        side_indices[1] = newFace->v_indices[e+1];
+    std::vector<size_t> block_data;
+    for (size_t b=0; b<header[0]; ++b)
+    {
+      int entity_dim, entity_tag, elem_type;
+      size_t num_in_block;
+      if (is_binary)
+      {
+        if (!(scanner.ReadBinary(entity_dim) and
+              scanner.ReadBinary(entity_tag) and
+              scanner.ReadBinary(elem_type) and
+              scanner.ReadBinary(num_in_block)))
+          GmshParseError("Failed to read an element block header.");
+      }
       else
-        side_indices[1] = newFace->v_indices[0];
+      {
+        long long n;
+        scanner.SkipWhitespace();
+        if (!(scanner.ReadInt(entity_dim) and scanner.ReadInt(entity_tag) and
+              scanner.ReadInt(elem_type) and scanner.ReadInt(n)))
+          GmshParseError("Failed to read an element block header.");
+        num_in_block = n;
+      }
 
-      side_indices[2] = -1;
-      side_indices[3] = -1;
+      int num_nodes = GmshElementNumNodes(elem_type);
+      bool keep = (elem_type == 2) or (elem_type == 3);
 
-      newFace->edges.push_back(side_indices);
-    }
-
-    poly_faces.push_back(newFace);
+      if (is_binary)
+      {
+        //The size of a block of unknown elements can not be determined.
+        //As the last block it is skipped like in ASCII files, otherwise
+        //the blocks that follow can not be located.
+        if (num_nodes < 0)
+        {
+          if ((b+1 == header[0]) and scanner.FindLine("$EndElements"))
+          {
+            chi_log.Log(LOG_0WARNING)
+              << "ImportFromMshFiles: Skipped the last element block of "
+              << "unknown element type " << elem_type << ".";
+            break;
+          }
+          chi_log.Log(LOG_ALLERROR)
+            << "ImportFromMshFiles: Element type " << elem_type
+            << " has an unknown number of nodes and is followed by "
+            << "further element blocks in the binary file.";
+          exit(EXIT_FAILURE);
+        }
+        block_data.resize(num_in_block*(1+num_nodes));
+        if (!scanner.ReadBinary(block_data.data(),
+                                block_data.size()*sizeof(size_t)))
+          GmshParseError("Failed to read element data.");
 
+        if (keep)
+          for (size_t e=0; e<num_in_block; ++e)
+          {
+            const size_t* elem = &block_data[e*(1+num_nodes)];
+            for (int i=0; i<num_nodes; ++i)
+              nodes[i] = static_cast<int>(elem[1+i]);
+            poly_faces.push_back(GmshMakePolyFace(nodes, num_nodes));
+          }
+      }
+      else
+      {
+        scanner.SkipLine();
+        for (size_t e=0; e<num_in_block; ++e)
+        {
+          if (keep)
+          {
+            long long elem_tag;
+            if (!scanner.ReadInt(elem_tag))
+              GmshParseError("Failed to read element tag.");
+            for (int i=0; i<num_nodes; i++)
+              if (!scanner.ReadInt(nodes[i]))
+                GmshParseError("Failed when reading element node index.");
+            poly_faces.push_back(GmshMakePolyFace(nodes, num_nodes));
+          }
+          scanner.SkipLine();
+        }
+      }
+    }
   }
 
-  file.close();
-
   //======================================================= Calculate face properties
   std::vector<chi_mesh::Face>::iterator curFace;
   std::vector<chi_mesh::PolyFace*>::iterator curPFace;
@@ -868,6 +951,7 @@ ImportFromMshFiles(const char* fileName, bool as_poly=false)
  * wavefront .obj files.*/
 void chi_mesh::SurfaceMesh::ExportToOBJFile(const char *fileName)
 {
+  if (chi_mpi.team_id != 0) return;
 
 //  if (this->faces.empty())
 //  {
@@ -943,6 +1027,8 @@ void chi_mesh::SurfaceMesh::ExportToOBJFile(const char *fileName)
 /**Exports a PSLG to triangle1.6's .poly format.*/
 void chi_mesh::SurfaceMesh::ExportToPolyFile(const char *fileName)
 {
+  if (chi_mpi.team_id != 0) return;
+
   FILE* outputFile = fopen(fileName,"w");
   if (outputFile==NULL)
   {
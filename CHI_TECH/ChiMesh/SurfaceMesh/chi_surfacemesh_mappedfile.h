@@ -0,0 +1,260 @@
+#ifndef _chi_surfacemesh_mappedfile_h
+#define _chi_surfacemesh_mappedfile_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace chi_mesh
+{
+namespace mesh_io
+{
+
+//###################################################################
+/**Read-only memory mapping of an entire file.*/
+class MappedFile
+{
+private:
+  void*  map  = nullptr;
+  size_t size = 0;
+
+public:
+  MappedFile() = default;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile()
+  {
+    if (map != nullptr) munmap(map, size);
+  }
+
+  /**Maps the file. Returns false if it cannot be opened or is empty.*/
+  bool Open(const char* file_name)
+  {
+    int fd = open(file_name, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat file_stat;
+    if ((fstat(fd, &file_stat) != 0) or (file_stat.st_size <= 0))
+    {
+      close(fd);
+      return false;
+    }
+
+    size = static_cast<size_t>(file_stat.st_size);
+    map  = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (map == MAP_FAILED) {map = nullptr; size = 0; return false;}
+
+    madvise(map, size, MADV_SEQUENTIAL);
+    return true;
+  }
+
+  const char* Begin() const {return static_cast<const char*>(map);}
+  const char* End()   const {return static_cast<const char*>(map) + size;}
+};
+
+//###################################################################
+/**Forward-only scanner over a character range, with hand-written
+ * number parsing. The range need not be null terminated.*/
+class TextScanner
+{
+public:
+  const char* cur;
+  const char* end;
+
+  TextScanner(const char* in_begin, const char* in_end) :
+    cur(in_begin), end(in_end)
+  {}
+
+  bool AtEnd() const {return cur >= end;}
+
+  /**Skips spaces, tabs and carriage returns but not newlines.*/
+  void SkipBlanks()
+  {
+    while ((cur < end) and ((*cur == ' ') or (*cur == '\t') or (*cur == '\r')))
+      ++cur;
+  }
+
+  /**Skips all whitespace including newlines.*/
+  void SkipWhitespace()
+  {
+    while ((cur < end) and ((*cur == ' ') or (*cur == '\t') or
+                            (*cur == '\r') or (*cur == '\n')))
+      ++cur;
+  }
+
+  /**Moves to the beginning of the next line.*/
+  void SkipLine()
+  {
+    const void* eol = std::memchr(cur, '\n', end - cur);
+    cur = (eol == nullptr)? end : static_cast<const char*>(eol) + 1;
+  }
+
+  bool AtEndOfLine()
+  {
+    SkipBlanks();
+    return (cur >= end) or (*cur == '\n');
+  }
+
+  /**Reads a whitespace delimited word on the current line.*/
+  bool ReadWord(const char*& word, size_t& length)
+  {
+    SkipBlanks();
+    word = cur;
+    while ((cur < end) and (*cur != ' ') and (*cur != '\t') and
+           (*cur != '\r') and (*cur != '\n'))
+      ++cur;
+    length = cur - word;
+    return length > 0;
+  }
+
+  /**Returns true and advances if the line continues with the word.*/
+  bool MatchWord(const char* keyword)
+  {
+    SkipBlanks();
+    size_t length = std::strlen(keyword);
+    if ((static_cast<size_t>(end - cur) < length) or
+        (std::memcmp(cur, keyword, length) != 0))
+      return false;
+    const char* after = cur + length;
+    if ((after < end) and (*after != ' ') and (*after != '\t') and
+        (*after != '\r') and (*after != '\n'))
+      return false;
+    cur = after;
+    return true;
+  }
+
+  /**Advances past the next line that consists of the given word,
+   * e.g. a gmsh section tag. Returns false if there is none.*/
+  bool FindLine(const char* line_word)
+  {
+    while (cur < end)
+    {
+      bool found = MatchWord(line_word) and AtEndOfLine();
+      SkipLine();
+      if (found) return true;
+    }
+    return false;
+  }
+
+  /**Reads a signed integer.*/
+  bool ReadInt(long long& value)
+  {
+    SkipBlanks();
+    bool negative = false;
+    if ((cur < end) and ((*cur == '-') or (*cur == '+')))
+      negative = (*cur++ == '-');
+
+    if ((cur >= end) or (*cur < '0') or (*cur > '9')) return false;
+
+    long long result = 0;
+    while ((cur < end) and (*cur >= '0') and (*cur <= '9'))
+      result = result*10 + (*cur++ - '0');
+
+    value = negative? -result : result;
+    return true;
+  }
+
+  bool ReadInt(int& value)
+  {
+    long long v;
+    if (not ReadInt(v)) return false;
+    value = static_cast<int>(v);
+    return true;
+  }
+
+  /**Reads a floating point number. Numbers with at most 15 significant
+   * digits and small exponents are converted exactly with a single
+   * multiplication or division; others fall back to strtod.*/
+  bool ReadDouble(double& value)
+  {
+    static const double powers_of_ten[] =
+      {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+       1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+       1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    SkipBlanks();
+    const char* start = cur;
+
+    bool negative = false;
+    if ((cur < end) and ((*cur == '-') or (*cur == '+')))
+      negative = (*cur++ == '-');
+
+    uint64_t mantissa = 0;
+    int num_digits = 0;
+    int exponent   = 0;
+    bool any_digit = false;
+
+    while ((cur < end) and (*cur >= '0') and (*cur <= '9'))
+    {
+      any_digit = true;
+      if ((mantissa != 0) or (*cur != '0')) ++num_digits;
+      if (num_digits <= 19) mantissa = mantissa*10 + (*cur - '0');
+      else ++exponent;
+      ++cur;
+    }
+    if ((cur < end) and (*cur == '.'))
+    {
+      ++cur;
+      while ((cur < end) and (*cur >= '0') and (*cur <= '9'))
+      {
+        any_digit = true;
+        if ((mantissa != 0) or (*cur != '0')) ++num_digits;
+        if (num_digits <= 19) {mantissa = mantissa*10 + (*cur - '0'); --exponent;}
+        ++cur;
+      }
+    }
+    if (not any_digit) {cur = start; return false;}
+
+    if ((cur < end) and ((*cur == 'e') or (*cur == 'E')))
+    {
+      ++cur;
+      long long exp_value = 0;
+      if (not ReadInt(exp_value)) {cur = start; return false;}
+      exponent += static_cast<int>(exp_value);
+    }
+
+    if ((num_digits <= 15) and (exponent >= -22) and (exponent <= 22))
+    {
+      double result = static_cast<double>(mantissa);
+      if (exponent < 0) result /= powers_of_ten[-exponent];
+      else              result *= powers_of_ten[exponent];
+      value = negative? -result : result;
+      return true;
+    }
+
+    //=================================== Slow path
+    char buffer[128];
+    size_t length = cur - start;
+    if (length >= sizeof(buffer)) return false;
+    std::memcpy(buffer, start, length);
+    buffer[length] = '\0';
+    value = std::strtod(buffer, nullptr);
+    return true;
+  }
+
+  /**Copies raw bytes, used for binary file sections.*/
+  bool ReadBinary(void* destination, size_t num_bytes)
+  {
+    if (static_cast<size_t>(end - cur) < num_bytes) return false;
+    std::memcpy(destination, cur, num_bytes);
+    cur += num_bytes;
+    return true;
+  }
+
+  template<typename T>
+  bool ReadBinary(T& value) {return ReadBinary(&value, sizeof(T));}
+};
+
+}
+}
+
+#endif
@@ -3,6 +3,9 @@
 
 extern ChiMath chi_math_handler;
 
+#include <chi_mpi.h>
+extern ChiMPI chi_mpi;
+
 //###################################################################
 /**Determine the orientation of point c relative to point a and b.
  *
@@ -248,6 +251,7 @@ void chi_mesh::SurfaceMesherDelaunay::
 void chi_mesh::SurfaceMesherDelaunay::
   DelaunayPatch::DumpToScilab(const char *file_name, bool verbose)
 {
+  if (chi_mpi.team_id != 0) return;
   if (this->triangles.empty())
   {
     std::cout << "Cannot export empty SurfaceMesh to scilab format\n";
@@ -1,11 +1,15 @@
 #include "delaunay_mesher.h"
 
+#include <chi_mpi.h>
+extern ChiMPI chi_mpi;
+
 //###################################################################
 /**Exports a delaunay patch to file. This is meant to be used for
  * debug purposes only.*/
 void chi_mesh::SurfaceMesherDelaunay::DelaunayPatch::ExportAsObj(
   const char *fileName)
 {
+  if (chi_mpi.team_id != 0) return;
   if (this->triangles.empty())
   {
     std::cout << "Cannot export empty DelaunayPatch\n";
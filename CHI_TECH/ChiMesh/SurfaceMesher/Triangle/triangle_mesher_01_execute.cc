@@ -66,6 +66,6 @@ void chi_mesh::SurfaceMesherTriangle::Execute()
                                          "completed. "
                                       << tmesh_timer.GetTime()/1000.0
                                       << " s";
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
 }
\ No newline at end of file
@@ -25,7 +25,7 @@ double chi_mesh::sweep_management::AngleAggregation::GetDelayedPsiNorm()
 
   double ret_val = 0.0;
 
-  MPI_Allreduce(&loc_ret_val,&ret_val,1,MPI_DOUBLE,MPI_MAX,MPI_COMM_WORLD);
+  MPI_Allreduce(&loc_ret_val,&ret_val,1,MPI_DOUBLE,MPI_MAX,chi_mpi.comm);
   return ret_val;
 }
 
@@ -230,7 +230,7 @@ std::pair<int,int> chi_mesh::sweep_management::AngleAggregation::
                 1,
                 MPI_INT,
                 MPI_SUM,
-                MPI_COMM_WORLD);
+                chi_mpi.comm);
 
   chi_log.Log(LOG_0) << "Number of angular unknowns: " << global_ang_unknowns;
 
@@ -1,8 +1,10 @@
 #include "sweepscheduler.h"
 
 #include <chi_log.h>
+#include <chi_mpi.h>
 
 extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
 
 //###################################################################
 /**Sweep scheduler constructor*/
@@ -45,7 +47,7 @@ chi_mesh::sweep_management::SweepScheduler::SweepScheduler(
   MPI_Allreduce(&local_max_num_messages,
                 &global_max_num_messages,
                 1, MPI_INT,
-                MPI_MAX, MPI_COMM_WORLD);
+                MPI_MAX, chi_mpi.comm);
 
   //=================================== Propogate items back to sweep buffers
   for (auto angsetgrp : in_angle_agg->angle_set_groups)
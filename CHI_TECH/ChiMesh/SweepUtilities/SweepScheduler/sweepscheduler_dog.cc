@@ -205,7 +205,7 @@ void chi_mesh::sweep_management::SweepScheduler::ScheduleAlgoDOG()
   }
 
   //================================================== Receive delayed data
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
   for (auto sorted_angleset : rule_values)
   {
     TAngleSet *angleset = sorted_angleset.angle_set;
@@ -110,7 +110,7 @@ chi_mesh::sweep_management::SPDS* chi_mesh::sweep_management::
     MPI_Bcast(&dependency_count_per_location[locI], //Buffer
               1, MPI_INT,                           //Count and type
               locI,                                 //Sending location
-              MPI_COMM_WORLD);                      //Communicator
+              chi_mpi.comm);                      //Communicator
 
   //============================================= Broadcast dependencies
   for (int locI=0; locI<P; locI++)
@@ -131,7 +131,7 @@ chi_mesh::sweep_management::SPDS* chi_mesh::sweep_management::
               dependency_count_per_location[locI],     //Count
               MPI_INT,                                 //Type
               locI,                                    //Sending location
-              MPI_COMM_WORLD);                         //Communicator
+              chi_mpi.comm);                         //Communicator
   }
 
   //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Build task
@@ -249,7 +249,7 @@ chi_mesh::sweep_management::SPDS* chi_mesh::sweep_management::
     }
   }
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
   chi_log.Log(LOG_0VERBOSE_1)
     << chi_program_timer.GetTimeString()
@@ -26,6 +26,7 @@ namespace sweep_management
   class  AngleAggregation;
 
   class SweepChunk;
+  class FaceCurrentTally;
 
   class SweepScheduler;
 
@@ -1,6 +1,23 @@
 #ifndef _chi_sweepchunk_base_h
 #define _chi_sweepchunk_base_h
 
+//###################################################################
+/**Receives the partial currents crossing cell faces during a sweep, e.g.,
+ * for coarse-mesh acceleration. Currents are given for a contiguous range
+ * of groups.*/
+class chi_mesh::sweep_management::FaceCurrentTally
+{
+public:
+  virtual ~FaceCurrentTally() = default;
+
+  /**Adds the outgoing partial current of a face.*/
+  virtual void TallyOutgoing(int cell_local_id, int f, int first_group,
+                             int num_grps, const double* current) = 0;
+  /**Adds the incoming partial current of a boundary face.*/
+  virtual void TallyIncoming(int cell_local_id, int f, int first_group,
+                             int num_grps, const double* current) = 0;
+};
+
 //###################################################################
 /**Sweep work function*/
 class chi_mesh::sweep_management::SweepChunk
@@ -11,12 +28,18 @@ public:
   bool                        suppress_surface_src;
 
 public:
+  virtual ~SweepChunk() = default;
+
   /**Sets the location where flux moments are to be written.*/
   void SetDestinationPhi(std::vector<double>* destination_phi)
   {
     x = destination_phi;
   }
 
+  /**Sets the object face currents are tallied into, nullptr for none.
+   * Sweep chunks that can tally currents should override this.*/
+  virtual void SetCurrentTally(FaceCurrentTally* tally) {}
+
 public:
   /**Sweep chunks should override this.*/
   virtual void Sweep(AngleSet* angle_set)
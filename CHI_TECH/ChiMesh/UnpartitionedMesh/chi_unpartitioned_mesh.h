@@ -5,6 +5,8 @@
 
 #include <vtkCell.h>
 
+#include <cstdint>
+
 //###################################################################
 /**This object is intented for unpartitioned meshes that still require
  * partitioning.*/
@@ -24,10 +26,57 @@ private:
     std::vector<int> vertex_ids;
     std::vector<LightWeightFace> faces;
   };
+public:
+  /**Header of the native binary mesh format. The header is followed by
+   * contiguous arrays, each 8-byte aligned and located at the listed
+   * byte offsets from the start of the file:
+   *  - vertices          double[3*num_vertices]
+   *  - cell centroids    double[3*num_cells]
+   *  - cell material ids int32[num_cells]
+   *  - cell vertex offs  uint64[num_cells+1]
+   *  - cell vertex ids   int32[num_cell_vertex_ids]
+   *  - cell face offs    uint64[num_cells+1]
+   *  - face vertex offs  uint64[num_faces+1]
+   *  - face vertex ids   int32[num_face_vertex_ids]
+   *  - face neighbors    int32[num_faces]
+   *
+   * Face neighbors are global cell ids (or negative for boundaries) so
+   * that connectivity need not be re-established when reading.*/
+  struct BinaryHeader
+  {
+    char     magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t num_vertices;
+    uint64_t num_cells;
+    uint64_t num_cell_vertex_ids;
+    uint64_t num_faces;
+    uint64_t num_face_vertex_ids;
+    double   bound_box[6];
+    uint64_t vertices_offset;
+    uint64_t centroids_offset;
+    uint64_t material_ids_offset;
+    uint64_t cell_vertex_offsets_offset;
+    uint64_t cell_vertex_ids_offset;
+    uint64_t cell_face_offsets_offset;
+    uint64_t face_vertex_offsets_offset;
+    uint64_t face_vertex_ids_offset;
+    uint64_t face_neighbors_offset;
+  };
+
 private:
   std::vector<chi_mesh::Vertex*>  vertices;
   std::vector<LightWeightCell*>    raw_cells;
 
+  bool connectivity_built = false;
+
+  //Native binary file mapping. When mapped, raw_cells are only
+  //materialized on demand and unloaded entries are nullptr. Every
+  //consumer of raw_cells must skip these (or LoadCells first).
+  void*               binary_map      = nullptr;
+  size_t              binary_map_size = 0;
+  const BinaryHeader* binary_header   = nullptr;
+
 public:
   enum class ParallelMethod
   {
@@ -53,6 +102,19 @@ public:
 
   void ReadFromVTU(const Options& options);
   void ReadFromEnsightGold(const Options& options);
+
+  //03 Native binary
+  void ReadFromBinary(const Options& options);
+  void WriteToBinary(const std::string& file_name);
+  bool IsLoadedOnDemand() const {return binary_map != nullptr;}
+  size_t GetNumberOfCells() const {return raw_cells.size();}
+  chi_mesh::Vertex GetCellCentroid(size_t global_id) const;
+  void LoadCells(const std::vector<int>& global_ids);
+  void CloseBinary();
+
+  //04
+  void BuildMeshConnectivity();
+  void ComputeCentroids();
 };
 
 
@@ -3,6 +3,9 @@
 #include "../chi_unpartitioned_mesh.h"
 #include "ChiMesh/MeshHandler/chi_meshhandler.h"
 
+#include "chi_log.h"
+extern ChiLog chi_log;
+
 /** \defgroup LuaUnpartitionedMesh Unpartitioned Mesh-Reader
  * \ingroup LuaMesh
  */
@@ -71,3 +74,81 @@ int chiUnpartitionedMeshFromEnsightGold(lua_State* L)
 
   return 1;
 }
+
+//###################################################################
+/**Creates an unpartitioned mesh from a file in the native binary mesh
+ * format. The file is memory mapped and each location only reads the
+ * cells it owns, plus their neighbors, when the mesh is partitioned.
+ *
+ * \param file_name char Filename of the binary mesh file.
+ *
+ * \ingroup LuaUnpartitionedMesh
+ *
+ * \return A handle to the newly created UnpartitionedMesh*/
+int chiUnpartitionedMeshFromBinary(lua_State* L)
+{
+  const char func_name[] = "chiUnpartitionedMeshFromBinary";
+  int num_args = lua_gettop(L);
+  if (num_args != 1)
+    LuaPostArgAmountError(func_name,1,num_args);
+
+  const char* temp = lua_tostring(L,1);
+  auto new_object = new chi_mesh::UnpartitionedMesh;
+
+  chi_mesh::UnpartitionedMesh::Options options;
+  options.file_name = std::string(temp);
+
+  new_object->ReadFromBinary(options);
+
+  auto handler = chi_mesh::GetCurrentHandler();
+  handler->unpartitionedmesh_stack.push_back(new_object);
+
+  lua_pushnumber(L,handler->unpartitionedmesh_stack.size()-1);
+
+  return 1;
+}
+
+//###################################################################
+/**Writes an unpartitioned mesh to the native binary mesh format. This
+ * is typically used once to convert a VTU or Ensight Gold mesh so that
+ * subsequent runs can use chiUnpartitionedMeshFromBinary.
+ *
+ * \param handle int Handle to the unpartitioned mesh.
+ * \param file_name char Filename of the binary mesh file.
+ *
+ * \ingroup LuaUnpartitionedMesh
+ *
+ * \code
+ * umesh = chiUnpartitionedMeshFromVTU("mesh.vtu")
+ * chiUnpartitionedMeshExportToBinary(umesh,"mesh.cmsh")
+ * \endcode*/
+int chiUnpartitionedMeshExportToBinary(lua_State* L)
+{
+  const char func_name[] = "chiUnpartitionedMeshExportToBinary";
+  int num_args = lua_gettop(L);
+  if (num_args != 2)
+    LuaPostArgAmountError(func_name,2,num_args);
+
+  LuaCheckNilValue(func_name,L,1);
+  LuaCheckNilValue(func_name,L,2);
+
+  int handle = lua_tonumber(L,1);
+  const char* temp = lua_tostring(L,2);
+
+  auto handler = chi_mesh::GetCurrentHandler();
+
+  chi_mesh::UnpartitionedMesh* umesh;
+  try {
+    umesh = handler->unpartitionedmesh_stack.at(handle);
+  }
+  catch (const std::out_of_range& o)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << func_name << ": Invalid unpartitioned mesh handle.";
+    exit(EXIT_FAILURE);
+  }
+
+  umesh->WriteToBinary(std::string(temp));
+
+  return 0;
+}
@@ -0,0 +1,375 @@
+#include "chi_unpartitioned_mesh.h"
+
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
+
+#include <fstream>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+const char     CHI_BINARY_MESH_MAGIC[8] = {'C','H','I','M','E','S','H','\0'};
+const uint32_t CHI_BINARY_MESH_VERSION  = 1;
+
+/**Rounds a byte offset up to the next multiple of 8.*/
+uint64_t Align8(uint64_t offset) {return (offset + 7) & ~uint64_t(7);}
+
+/**Writes an array to the stream at the given offset, zero padding the
+ * gap from the current position.*/
+template<typename T>
+void WriteArray(std::ofstream& file, uint64_t offset,
+                const std::vector<T>& data)
+{
+  auto pos = static_cast<uint64_t>(file.tellp());
+  static const char zeros[8] = {0};
+  if (offset > pos) file.write(zeros, offset - pos);
+  file.write(reinterpret_cast<const char*>(data.data()),
+             data.size()*sizeof(T));
+}
+
+/**Checks that an array of num_items items of the given size, starting at
+ * the given byte offset, lies within the file after the header.*/
+bool ArrayInFile(uint64_t offset, uint64_t num_items, uint64_t item_size,
+                 uint64_t header_size, uint64_t file_size)
+{
+  if ((offset < header_size) or (offset > file_size) or (offset % 8 != 0))
+    return false;
+  return num_items <= (file_size - offset)/item_size;
+}
+}
+
+//###################################################################
+/**Writes the mesh in the native binary format. Connectivity and
+ * centroids are established before writing so that readers need not
+ * recompute them. Only the home location of team 0 writes the file.*/
+void chi_mesh::UnpartitionedMesh::WriteToBinary(const std::string& file_name)
+{
+  if (IsLoadedOnDemand())
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "UnpartitionedMesh::WriteToBinary: Cannot write a mesh that "
+         "is itself mapped from a binary file.";
+    exit(EXIT_FAILURE);
+  }
+
+  BuildMeshConnectivity();
+  ComputeCentroids();
+
+  if (chi_mpi.world_location_id != 0) return;
+
+  //======================================== Flatten arrays
+  std::vector<double>   vertex_data;
+  std::vector<double>   centroid_data;
+  std::vector<int32_t>  material_ids;
+  std::vector<uint64_t> cell_vertex_offsets(1,0);
+  std::vector<int32_t>  cell_vertex_ids;
+  std::vector<uint64_t> cell_face_offsets(1,0);
+  std::vector<uint64_t> face_vertex_offsets(1,0);
+  std::vector<int32_t>  face_vertex_ids;
+  std::vector<int32_t>  face_neighbors;
+
+  vertex_data.reserve(3*vertices.size());
+  for (auto vert : vertices)
+  {
+    vertex_data.push_back(vert->x);
+    vertex_data.push_back(vert->y);
+    vertex_data.push_back(vert->z);
+  }
+
+  centroid_data.reserve(3*raw_cells.size());
+  material_ids.reserve(raw_cells.size());
+  for (auto cell : raw_cells)
+  {
+    centroid_data.push_back(cell->centroid.x);
+    centroid_data.push_back(cell->centroid.y);
+    centroid_data.push_back(cell->centroid.z);
+    material_ids.push_back(cell->material_id);
+
+    for (auto vid : cell->vertex_ids)
+      cell_vertex_ids.push_back(vid);
+    cell_vertex_offsets.push_back(cell_vertex_ids.size());
+
+    for (auto& face : cell->faces)
+    {
+      for (auto fvid : face.vertex_ids)
+        face_vertex_ids.push_back(fvid);
+      face_vertex_offsets.push_back(face_vertex_ids.size());
+      face_neighbors.push_back(face.neighbor);
+    }
+    cell_face_offsets.push_back(face_neighbors.size());
+  }
+
+  //======================================== Build header
+  BinaryHeader header;
+  std::memset(&header, 0, sizeof(BinaryHeader));
+  std::memcpy(header.magic, CHI_BINARY_MESH_MAGIC, 8);
+  header.version             = CHI_BINARY_MESH_VERSION;
+  header.num_vertices        = vertices.size();
+  header.num_cells           = raw_cells.size();
+  header.num_cell_vertex_ids = cell_vertex_ids.size();
+  header.num_faces           = face_neighbors.size();
+  header.num_face_vertex_ids = face_vertex_ids.size();
+  header.bound_box[0] = bound_box.xmin; header.bound_box[1] = bound_box.xmax;
+  header.bound_box[2] = bound_box.ymin; header.bound_box[3] = bound_box.ymax;
+  header.bound_box[4] = bound_box.zmin; header.bound_box[5] = bound_box.zmax;
+
+  uint64_t offset = Align8(sizeof(BinaryHeader));
+  auto Place = [&offset](uint64_t& field, uint64_t num_bytes)
+  {
+    field  = offset;
+    offset = Align8(offset + num_bytes);
+  };
+  Place(header.vertices_offset,           vertex_data.size()*8);
+  Place(header.centroids_offset,          centroid_data.size()*8);
+  Place(header.material_ids_offset,       material_ids.size()*4);
+  Place(header.cell_vertex_offsets_offset,cell_vertex_offsets.size()*8);
+  Place(header.cell_vertex_ids_offset,    cell_vertex_ids.size()*4);
+  Place(header.cell_face_offsets_offset,  cell_face_offsets.size()*8);
+  Place(header.face_vertex_offsets_offset,face_vertex_offsets.size()*8);
+  Place(header.face_vertex_ids_offset,    face_vertex_ids.size()*4);
+  Place(header.face_neighbors_offset,     face_neighbors.size()*4);
+
+  //======================================== Write file
+  std::ofstream file(file_name, std::ios::out | std::ios::binary);
+  if (!file.is_open())
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Failed to open file: "<< file_name <<" in call "
+      << "to WriteToBinary \n";
+    exit(EXIT_FAILURE);
+  }
+
+  file.write(reinterpret_cast<const char*>(&header), sizeof(BinaryHeader));
+  WriteArray(file, header.vertices_offset,            vertex_data);
+  WriteArray(file, header.centroids_offset,           centroid_data);
+  WriteArray(file, header.material_ids_offset,        material_ids);
+  WriteArray(file, header.cell_vertex_offsets_offset, cell_vertex_offsets);
+  WriteArray(file, header.cell_vertex_ids_offset,     cell_vertex_ids);
+  WriteArray(file, header.cell_face_offsets_offset,   cell_face_offsets);
+  WriteArray(file, header.face_vertex_offsets_offset, face_vertex_offsets);
+  WriteArray(file, header.face_vertex_ids_offset,     face_vertex_ids);
+  WriteArray(file, header.face_neighbors_offset,      face_neighbors);
+  file.close();
+
+  chi_log.Log(LOG_0)
+    << "Wrote binary mesh " << file_name << ": "
+    << header.num_vertices << " vertices, "
+    << header.num_cells << " cells.";
+}
+
+//###################################################################
+/**Maps a mesh in the native binary format. The vertices are loaded
+ * immediately but cells are only materialized by LoadCells, allowing
+ * each location to read only the cells it will own or reference.*/
+void chi_mesh::UnpartitionedMesh::
+  ReadFromBinary(const chi_mesh::UnpartitionedMesh::Options &options)
+{
+  //======================================== Map the file
+  int fd = open(options.file_name.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Failed to open file: "<< options.file_name <<" in call "
+      << "to ReadFromBinary \n";
+    exit(EXIT_FAILURE);
+  }
+
+  struct stat file_stat;
+  fstat(fd, &file_stat);
+  auto file_size = static_cast<size_t>(file_stat.st_size);
+
+  void* map = nullptr;
+  if (file_size >= sizeof(BinaryHeader))
+    map = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (map == nullptr or map == MAP_FAILED)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Failed to map file: "<< options.file_name <<" in call "
+      << "to ReadFromBinary \n";
+    exit(EXIT_FAILURE);
+  }
+
+  //======================================== Validate header
+  //Every array must lie within the file and the last entry of every
+  //offset array must match the length of the array it indexes.
+  auto header = static_cast<const BinaryHeader*>(map);
+  bool valid = (std::memcmp(header->magic, CHI_BINARY_MESH_MAGIC, 8) == 0) and
+               (header->version == CHI_BINARY_MESH_VERSION);
+  if (valid)
+  {
+    const uint64_t hs = sizeof(BinaryHeader);
+    const uint64_t fs = file_size;
+    const uint64_t num_cells = header->num_cells;
+    const uint64_t num_faces = header->num_faces;
+    valid =
+      (header->num_vertices <= fs/24) and (num_cells <= fs/24) and
+      (num_faces <= fs/8) and
+      ArrayInFile(header->vertices_offset,
+                  3*header->num_vertices, 8, hs, fs) and
+      ArrayInFile(header->centroids_offset,
+                  3*num_cells, 8, hs, fs) and
+      ArrayInFile(header->material_ids_offset,
+                  num_cells, 4, hs, fs) and
+      ArrayInFile(header->cell_vertex_offsets_offset,
+                  num_cells+1, 8, hs, fs) and
+      ArrayInFile(header->cell_vertex_ids_offset,
+                  header->num_cell_vertex_ids, 4, hs, fs) and
+      ArrayInFile(header->cell_face_offsets_offset,
+                  num_cells+1, 8, hs, fs) and
+      ArrayInFile(header->face_vertex_offsets_offset,
+                  num_faces+1, 8, hs, fs) and
+      ArrayInFile(header->face_vertex_ids_offset,
+                  header->num_face_vertex_ids, 4, hs, fs) and
+      ArrayInFile(header->face_neighbors_offset,
+                  num_faces, 4, hs, fs);
+  }
+  if (valid)
+  {
+    auto base = static_cast<const char*>(map);
+    auto LastOffset = [base](uint64_t array_offset, uint64_t index)
+    {
+      return reinterpret_cast<const uint64_t*>(base + array_offset)[index];
+    };
+    valid =
+      (LastOffset(header->cell_vertex_offsets_offset, header->num_cells) ==
+       header->num_cell_vertex_ids) and
+      (LastOffset(header->cell_face_offsets_offset, header->num_cells) ==
+       header->num_faces) and
+      (LastOffset(header->face_vertex_offsets_offset, header->num_faces) ==
+       header->num_face_vertex_ids);
+  }
+
+  if (not valid)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "File " << options.file_name << " is not a valid binary mesh "
+         "in call to ReadFromBinary \n";
+    exit(EXIT_FAILURE);
+  }
+
+  mesh_options    = options;
+  binary_map      = map;
+  binary_map_size = file_size;
+  binary_header   = header;
+
+  madvise(map, file_size, MADV_RANDOM);
+
+  //======================================== Load vertices
+  auto base = static_cast<const char*>(binary_map);
+  auto vertex_data =
+    reinterpret_cast<const double*>(base + header->vertices_offset);
+
+  vertices.reserve(header->num_vertices);
+  for (uint64_t v=0; v<header->num_vertices; ++v)
+    vertices.push_back(new chi_mesh::Vertex(vertex_data[3*v + 0],
+                                            vertex_data[3*v + 1],
+                                            vertex_data[3*v + 2]));
+
+  bound_box.xmin = header->bound_box[0]; bound_box.xmax = header->bound_box[1];
+  bound_box.ymin = header->bound_box[2]; bound_box.ymax = header->bound_box[3];
+  bound_box.zmin = header->bound_box[4]; bound_box.zmax = header->bound_box[5];
+
+  //======================================== Defer cells
+  raw_cells.assign(header->num_cells, nullptr);
+  connectivity_built = true;
+
+  chi_log.Log(LOG_0)
+    << "Mapped binary mesh " << options.file_name << ": "
+    << header->num_vertices << " vertices, "
+    << header->num_cells << " cells.";
+}
+
+//###################################################################
+/**Returns the centroid of a cell, reading it from the binary file
+ * mapping if the cell has not been materialized.*/
+chi_mesh::Vertex chi_mesh::UnpartitionedMesh::
+  GetCellCentroid(size_t global_id) const
+{
+  if (raw_cells[global_id] != nullptr)
+    return raw_cells[global_id]->centroid;
+
+  auto base = static_cast<const char*>(binary_map);
+  auto centroid_data =
+    reinterpret_cast<const double*>(base + binary_header->centroids_offset);
+
+  return chi_mesh::Vertex(centroid_data[3*global_id + 0],
+                          centroid_data[3*global_id + 1],
+                          centroid_data[3*global_id + 2]);
+}
+
+//###################################################################
+/**Materializes the listed cells from the binary file mapping. Cells
+ * that are already loaded are skipped.*/
+void chi_mesh::UnpartitionedMesh::LoadCells(const std::vector<int>& global_ids)
+{
+  if (not IsLoadedOnDemand()) return;
+
+  auto base   = static_cast<const char*>(binary_map);
+  auto header = binary_header;
+
+  auto centroid_data =
+    reinterpret_cast<const double*>(base + header->centroids_offset);
+  auto material_ids =
+    reinterpret_cast<const int32_t*>(base + header->material_ids_offset);
+  auto cell_vertex_offsets =
+    reinterpret_cast<const uint64_t*>(base + header->cell_vertex_offsets_offset);
+  auto cell_vertex_ids =
+    reinterpret_cast<const int32_t*>(base + header->cell_vertex_ids_offset);
+  auto cell_face_offsets =
+    reinterpret_cast<const uint64_t*>(base + header->cell_face_offsets_offset);
+  auto face_vertex_offsets =
+    reinterpret_cast<const uint64_t*>(base + header->face_vertex_offsets_offset);
+  auto face_vertex_ids =
+    reinterpret_cast<const int32_t*>(base + header->face_vertex_ids_offset);
+  auto face_neighbors =
+    reinterpret_cast<const int32_t*>(base + header->face_neighbors_offset);
+
+  for (auto c : global_ids)
+  {
+    if (raw_cells[c] != nullptr) continue;
+
+    auto cell = new LightWeightCell;
+    cell->centroid = chi_mesh::Vertex(centroid_data[3*c + 0],
+                                      centroid_data[3*c + 1],
+                                      centroid_data[3*c + 2]);
+    cell->material_id = material_ids[c];
+    cell->vertex_ids.assign(cell_vertex_ids + cell_vertex_offsets[c],
+                            cell_vertex_ids + cell_vertex_offsets[c+1]);
+
+    auto f_begin = cell_face_offsets[c];
+    auto f_end   = cell_face_offsets[c+1];
+    cell->faces.resize(f_end - f_begin);
+    for (uint64_t f=f_begin; f<f_end; ++f)
+    {
+      auto& face = cell->faces[f - f_begin];
+      face.neighbor = face_neighbors[f];
+      face.vertex_ids.assign(face_vertex_ids + face_vertex_offsets[f],
+                             face_vertex_ids + face_vertex_offsets[f+1]);
+    }
+
+    raw_cells[c] = cell;
+  }
+}
+
+//###################################################################
+/**Releases the binary file mapping. Cells that have not been loaded
+ * can no longer be accessed afterwards.*/
+void chi_mesh::UnpartitionedMesh::CloseBinary()
+{
+  if (binary_map == nullptr) return;
+
+  munmap(binary_map, binary_map_size);
+  binary_map      = nullptr;
+  binary_map_size = 0;
+  binary_header   = nullptr;
+}
@@ -0,0 +1,86 @@
+#include "chi_unpartitioned_mesh.h"
+
+#include <set>
+
+//###################################################################
+/**Establishes the face neighbors of all the raw cells. Faces that
+ * already have a neighbor are left untouched, so this can safely be
+ * called more than once. Cells that are not loaded (nullptr entries of
+ * a mesh mapped from a binary file) are skipped.*/
+void chi_mesh::UnpartitionedMesh::BuildMeshConnectivity()
+{
+  if (connectivity_built) return;
+
+  //======================================== Populate vertex
+  //                                                   subscriptions
+  std::vector<std::set<int>> vertex_subs(vertices.size());
+  int c=-1;
+  for (auto cell : raw_cells)
+  {
+    ++c;
+    if (cell == nullptr) continue;
+    for (auto vid : cell->vertex_ids)
+      vertex_subs[vid].insert(c);
+  }
+
+  //======================================== Establish connectivity
+  c=-1;
+  for (auto cell : raw_cells)
+  {
+    ++c;
+    if (cell == nullptr) continue;
+    for (auto& face : cell->faces)
+    {
+      if (face.neighbor >= 0) continue;
+
+      bool stop_searching = false;
+      for (auto cfvid : face.vertex_ids)
+      {
+        for (auto& adj_cell_id : vertex_subs[cfvid])
+        {
+          if (adj_cell_id == c) continue;
+          auto adj_cell = raw_cells[adj_cell_id];
+
+          //Assume it matches now disprove
+          bool adj_cell_matches = true;
+          for (auto afvid : face.vertex_ids)
+          {
+            bool vertex_found=false;
+            for (auto acvid : adj_cell->vertex_ids)
+              if (afvid == acvid) {vertex_found = true; break;}
+
+            if (not vertex_found) { adj_cell_matches = false; break;}
+          }
+
+          if (adj_cell_matches)
+          {
+            face.neighbor = adj_cell_id;
+            stop_searching = true;
+          }
+
+          if (stop_searching) break;
+        }//cell id
+        if (stop_searching) break;
+      }//face vertex
+    }//for face
+  }//for cell
+
+  connectivity_built = true;
+}
+
+//###################################################################
+/**Computes the centroids of all the raw cells as the average of their
+ * vertices. Cells that are not loaded are skipped, their centroids are
+ * read from the binary file.*/
+void chi_mesh::UnpartitionedMesh::ComputeCentroids()
+{
+  for (auto cell : raw_cells)
+  {
+    if (cell == nullptr) continue;
+    cell->centroid = chi_mesh::Vertex(0.0,0.0,0.0);
+    for (auto vid : cell->vertex_ids)
+      cell->centroid = cell->centroid + *vertices[vid];
+
+    cell->centroid = cell->centroid/(cell->vertex_ids.size());
+  }
+}
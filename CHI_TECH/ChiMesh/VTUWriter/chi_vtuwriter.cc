@@ -0,0 +1,399 @@
+#include "chi_vtuwriter.h"
+
+#include "ChiMesh/MeshContinuum/chi_meshcontinuum.h"
+#include "ChiMesh/MeshHandler/chi_meshhandler.h"
+#include "ChiMesh/VolumeMesher/chi_volumemesher.h"
+
+#include <chi_log.h>
+#include <chi_mpi.h>
+
+extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#ifdef CHI_USE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace
+{
+//VTK cell type identifiers
+const uint8_t VTU_LINE       = 3;
+const uint8_t VTU_POLYGON    = 7;
+const uint8_t VTU_POLYHEDRON = 42;
+
+/**Uncompressed size of the blocks of compressed arrays.*/
+const uint64_t VTU_COMPRESSION_BLOCK_SIZE = 1 << 20;
+
+/**Piece file name of a location.*/
+std::string PieceFileName(const std::string& base_name, int location_id)
+{
+  return base_name + "_" + std::to_string(location_id) + ".vtu";
+}
+
+/**Description of one appended array for the XML header.*/
+struct ArrayInfo
+{
+  std::string type;
+  std::string name;
+  int         num_components;
+  uint64_t    offset;
+};
+
+void WriteDataArrayTag(std::ostream& ostr, const ArrayInfo& info,
+                       const std::string& indent)
+{
+  ostr << indent << "<DataArray type=\"" << info.type << "\"";
+  if (not info.name.empty())
+    ostr << " Name=\"" << info.name << "\"";
+  if (info.num_components > 1)
+    ostr << " NumberOfComponents=\"" << info.num_components << "\"";
+  ostr << " format=\"appended\" offset=\"" << info.offset << "\"/>\n";
+}
+}
+
+//###################################################################
+/**Constructor. Compression requires zlib support at build time and is
+ * otherwise ignored.*/
+chi_mesh::VTUWriter::VTUWriter(bool compress_data) :
+  compress(compress_data)
+{
+#ifndef CHI_USE_ZLIB
+  if (compress)
+  {
+    chi_log.Log(LOG_0WARNING)
+      << "VTUWriter: compression requested but ChiTech was built "
+      << "without zlib. Data will be written uncompressed.";
+    compress = false;
+  }
+#endif
+}
+
+//###################################################################
+/**Adds all the local cells of the grid, along with their material
+ * and partition ids.*/
+void chi_mesh::VTUWriter::AddGridCells(chi_mesh::MeshContinuum* grid)
+{
+  //======================================== Size everything
+  size_t num_new_points = 0;
+  size_t num_new_cells  = 0;
+  for (const auto& cell : grid->local_cells)
+  {
+    num_new_points += cell.vertex_ids.size();
+    ++num_new_cells;
+  }
+
+  points.reserve(points.size() + 3*num_new_points);
+  connectivity.reserve(connectivity.size() + num_new_points);
+  offsets.reserve(offsets.size() + num_new_cells);
+  types.reserve(types.size() + num_new_cells);
+  material_ids.reserve(material_ids.size() + num_new_cells);
+  partition_ids.reserve(partition_ids.size() + num_new_cells);
+
+  //======================================== Populate cells
+  for (const auto& cell : grid->local_cells)
+  {
+    auto first_point = static_cast<int64_t>(num_points);
+    size_t num_verts = cell.vertex_ids.size();
+
+    for (size_t v=0; v<num_verts; ++v)
+    {
+      const auto& vertex = *grid->vertices[cell.vertex_ids[v]];
+      points.push_back(vertex.x);
+      points.push_back(vertex.y);
+      points.push_back(vertex.z);
+      connectivity.push_back(first_point + v);
+    }
+    num_points += num_verts;
+    offsets.push_back(static_cast<int64_t>(connectivity.size()));
+
+    material_ids.push_back(cell.material_id);
+    partition_ids.push_back(cell.partition_id);
+
+    if (cell.Type() == chi_mesh::CellType::SLAB)
+      types.push_back(VTU_LINE);
+    else if (cell.Type() == chi_mesh::CellType::POLYGON)
+      types.push_back(VTU_POLYGON);
+    else if (cell.Type() == chi_mesh::CellType::POLYHEDRON)
+    {
+      types.push_back(VTU_POLYHEDRON);
+
+      //Earlier cells need face offsets of -1 once the
+      //first polyhedron is encountered
+      face_offsets.resize(num_cells, -1);
+
+      faces.push_back(static_cast<int64_t>(cell.faces.size()));
+      for (const auto& face : cell.faces)
+      {
+        faces.push_back(static_cast<int64_t>(face.vertex_ids.size()));
+        for (int vid : face.vertex_ids)
+        {
+          auto v = std::find(cell.vertex_ids.begin(),
+                             cell.vertex_ids.end(), vid) -
+                   cell.vertex_ids.begin();
+          faces.push_back(first_point + v);
+        }
+      }
+      face_offsets.push_back(static_cast<int64_t>(faces.size()));
+    }
+    else
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "VTUWriter: unsupported cell type encountered.";
+      exit(EXIT_FAILURE);
+    }
+
+    ++num_cells;
+    if (not face_offsets.empty())
+      face_offsets.resize(num_cells, -1);
+  }
+}
+
+//###################################################################
+/**Adds a point data array and returns a reference to its values,
+ * sized to the number of points. The reference remains valid when
+ * further arrays are added.*/
+std::vector<double>& chi_mesh::VTUWriter::AddPointData(const std::string& name)
+{
+  point_data.emplace_back();
+  point_data.back().name = name;
+  point_data.back().values.assign(num_points, 0.0);
+  return point_data.back().values;
+}
+
+//###################################################################
+/**Adds a cell data array and returns a reference to its values,
+ * sized to the number of cells.*/
+std::vector<double>& chi_mesh::VTUWriter::AddCellData(const std::string& name)
+{
+  cell_data.emplace_back();
+  cell_data.back().name = name;
+  cell_data.back().values.assign(num_cells, 0.0);
+  return cell_data.back().values;
+}
+
+//###################################################################
+/**Writes this location's piece and, on the home location, the
+ * summary file. Teams hold identical data, hence only team 0 writes.*/
+void chi_mesh::VTUWriter::Write(const std::string& base_name) const
+{
+  if (chi_mpi.team_id != 0) return;
+
+  WritePiece(PieceFileName(base_name, chi_mpi.location_id));
+
+  if (chi_mpi.location_id == 0)
+    WriteSummary(base_name);
+}
+
+//###################################################################
+/**Appends the encoding of one array to the appended data section. Raw
+ * arrays are preceded by their size in bytes. Compressed arrays are
+ * split into blocks and preceded by the block count, the block size,
+ * the size of the last block and the compressed size of each block.*/
+void chi_mesh::VTUWriter::EncodeBlock(const void* data, uint64_t num_bytes,
+                                      std::vector<char>& encoded) const
+{
+  auto AppendBytes = [&encoded](const void* bytes, size_t count)
+  {
+    auto c = static_cast<const char*>(bytes);
+    encoded.insert(encoded.end(), c, c + count);
+  };
+
+  if (not compress)
+  {
+    AppendBytes(&num_bytes, sizeof(uint64_t));
+    AppendBytes(data, num_bytes);
+    return;
+  }
+
+#ifdef CHI_USE_ZLIB
+  uint64_t block_size = VTU_COMPRESSION_BLOCK_SIZE;
+  uint64_t num_blocks = (num_bytes + block_size - 1)/block_size;
+  uint64_t last_size  = num_bytes - (num_blocks>0? (num_blocks-1)*block_size : 0);
+
+  std::vector<uint64_t> header(3 + num_blocks, 0);
+  header[0] = num_blocks;
+  header[1] = block_size;
+  header[2] = (num_blocks>0)? last_size : 0;
+
+  std::vector<char> compressed;
+  auto source = static_cast<const Bytef*>(data);
+  for (uint64_t b=0; b<num_blocks; ++b)
+  {
+    uLong src_size = (b == num_blocks-1)? last_size : block_size;
+    uLongf dst_size = compressBound(src_size);
+    size_t start = compressed.size();
+    compressed.resize(start + dst_size);
+    compress2(reinterpret_cast<Bytef*>(&compressed[start]), &dst_size,
+              source + b*block_size, src_size, Z_BEST_SPEED);
+    compressed.resize(start + dst_size);
+    header[3+b] = dst_size;
+  }
+
+  AppendBytes(header.data(), header.size()*sizeof(uint64_t));
+  AppendBytes(compressed.data(), compressed.size());
+#endif
+}
+
+//###################################################################
+/**Writes the piece file of this location.*/
+void chi_mesh::VTUWriter::WritePiece(const std::string& file_name) const
+{
+  std::vector<char>      appended;
+  std::vector<ArrayInfo> point_arrays, cell_arrays, point_coords, topology_arrays;
+
+  auto Encode = [this,&appended](const std::string& type,
+                                 const std::string& name,
+                                 int num_components,
+                                 const void* data, uint64_t num_bytes)
+  {
+    ArrayInfo info = {type, name, num_components, appended.size()};
+    EncodeBlock(data, num_bytes, appended);
+    return info;
+  };
+
+  //======================================== Encode data
+  for (const auto& array : point_data)
+    point_arrays.push_back(Encode("Float64", array.name, 1,
+      array.values.data(), array.values.size()*sizeof(double)));
+
+  cell_arrays.push_back(Encode("Int32", "Material", 1,
+    material_ids.data(), material_ids.size()*sizeof(int32_t)));
+  cell_arrays.push_back(Encode("Int32", "Partition", 1,
+    partition_ids.data(), partition_ids.size()*sizeof(int32_t)));
+  for (const auto& array : cell_data)
+    cell_arrays.push_back(Encode("Float64", array.name, 1,
+      array.values.data(), array.values.size()*sizeof(double)));
+
+  point_coords.push_back(Encode("Float64", "", 3,
+    points.data(), points.size()*sizeof(double)));
+
+  topology_arrays.push_back(Encode("Int64", "connectivity", 1,
+    connectivity.data(), connectivity.size()*sizeof(int64_t)));
+  topology_arrays.push_back(Encode("Int64", "offsets", 1,
+    offsets.data(), offsets.size()*sizeof(int64_t)));
+  topology_arrays.push_back(Encode("UInt8", "types", 1,
+    types.data(), types.size()*sizeof(uint8_t)));
+  if (not face_offsets.empty())
+  {
+    topology_arrays.push_back(Encode("Int64", "faces", 1,
+      faces.data(), faces.size()*sizeof(int64_t)));
+    topology_arrays.push_back(Encode("Int64", "faceoffsets", 1,
+      face_offsets.data(), face_offsets.size()*sizeof(int64_t)));
+  }
+
+  //======================================== XML header
+  std::stringstream header;
+  header << "<?xml version=\"1.0\"?>\n"
+         << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" "
+         << "byte_order=\"LittleEndian\" header_type=\"UInt64\"";
+  if (compress)
+    header << " compressor=\"vtkZLibDataCompressor\"";
+  header << ">\n"
+         << "  <UnstructuredGrid>\n"
+         << "    <Piece NumberOfPoints=\"" << num_points
+         << "\" NumberOfCells=\"" << num_cells << "\">\n";
+
+  header << "      <PointData>\n";
+  for (const auto& info : point_arrays)
+    WriteDataArrayTag(header, info, "        ");
+  header << "      </PointData>\n";
+
+  header << "      <CellData>\n";
+  for (const auto& info : cell_arrays)
+    WriteDataArrayTag(header, info, "        ");
+  header << "      </CellData>\n";
+
+  header << "      <Points>\n";
+  WriteDataArrayTag(header, point_coords.front(), "        ");
+  header << "      </Points>\n";
+
+  header << "      <Cells>\n";
+  for (const auto& info : topology_arrays)
+    WriteDataArrayTag(header, info, "        ");
+  header << "      </Cells>\n";
+
+  header << "    </Piece>\n"
+         << "  </UnstructuredGrid>\n"
+         << "  <AppendedData encoding=\"raw\">\n   _";
+
+  const std::string footer("\n  </AppendedData>\n</VTKFile>\n");
+
+  //======================================== Write file
+  std::ofstream file(file_name, std::ios::out | std::ios::binary);
+  if (!file.is_open())
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Failed to open file: " << file_name << " in call to "
+      << "VTUWriter::Write.";
+    exit(EXIT_FAILURE);
+  }
+
+  const std::string header_str = header.str();
+  file.write(header_str.data(), header_str.size());
+  file.write(appended.data(), appended.size());
+  file.write(footer.data(), footer.size());
+  file.close();
+}
+
+//###################################################################
+/**Writes the parallel summary file referencing all pieces.*/
+void chi_mesh::VTUWriter::WriteSummary(const std::string& base_name) const
+{
+  std::ofstream ofile(base_name + ".pvtu");
+  if (!ofile.is_open())
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Failed to open file: " << base_name << ".pvtu in call to "
+      << "VTUWriter::Write.";
+    exit(EXIT_FAILURE);
+  }
+
+  ofile << "<?xml version=\"1.0\"?>\n"
+        << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" "
+        << "byte_order=\"LittleEndian\" header_type=\"UInt64\">\n"
+        << "  <PUnstructuredGrid GhostLevel=\"0\">\n";
+
+  ofile << "    <PPointData>\n";
+  for (const auto& array : point_data)
+    ofile << "      <PDataArray type=\"Float64\" Name=\""
+          << array.name << "\"/>\n";
+  ofile << "    </PPointData>\n";
+
+  ofile << "    <PCellData>\n"
+        << "      <PDataArray type=\"Int32\" Name=\"Material\"/>\n"
+        << "      <PDataArray type=\"Int32\" Name=\"Partition\"/>\n";
+  for (const auto& array : cell_data)
+    ofile << "      <PDataArray type=\"Float64\" Name=\""
+          << array.name << "\"/>\n";
+  ofile << "    </PCellData>\n";
+
+  ofile << "    <PPoints>\n"
+        << "      <PDataArray type=\"Float64\" NumberOfComponents=\"3\"/>\n"
+        << "    </PPoints>\n";
+
+  //======================================== Pieces
+  //Only the file name relative to the summary file is referenced
+  std::string piece_base = base_name;
+  size_t slash = piece_base.find_last_of('/');
+  if (slash != std::string::npos)
+    piece_base = piece_base.substr(slash+1);
+
+  bool is_global_mesh =
+    chi_mesh::GetCurrentHandler()->volume_mesher->options.mesh_global;
+
+  for (int p=0; p<chi_mpi.process_count; ++p)
+  {
+    if (is_global_mesh and p!=0) continue;
+
+    ofile << "    <Piece Source=\"" << PieceFileName(piece_base,p) << "\"/>\n";
+  }
+
+  ofile << "  </PUnstructuredGrid>\n"
+        << "</VTKFile>\n";
+
+  ofile.close();
+}
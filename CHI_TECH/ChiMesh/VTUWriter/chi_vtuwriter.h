@@ -0,0 +1,69 @@
+#ifndef _chi_vtuwriter_h
+#define _chi_vtuwriter_h
+
+#include "../chi_mesh.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <cstdint>
+
+//###################################################################
+/**Writes the local cells of a grid, together with point and cell data,
+ * to VTK XML unstructured grid files. Every location writes its own
+ * piece, `base_name_<location>.vtu`, and the home location writes the
+ * `base_name.pvtu` summary file.
+ *
+ * Unlike the VTK library writers, arrays are filled in bulk and written
+ * directly as raw appended binary data, optionally zlib compressed.
+ * Each cell receives its own copy of its vertices so that discontinuous
+ * data can be represented. Point data arrays therefore hold, for each
+ * local cell in order, one value per cell vertex.*/
+class chi_mesh::VTUWriter
+{
+private:
+  struct DataArray
+  {
+    std::string          name;
+    std::vector<double>  values;
+  };
+
+  bool                   compress;
+
+  size_t                 num_points = 0;
+  size_t                 num_cells  = 0;
+
+  std::vector<double>    points;        ///< x,y,z per point
+  std::vector<int64_t>   connectivity;
+  std::vector<int64_t>   offsets;
+  std::vector<uint8_t>   types;
+  std::vector<int64_t>   faces;         ///< Polyhedra only
+  std::vector<int64_t>   face_offsets;  ///< Polyhedra only
+
+  std::vector<int32_t>   material_ids;
+  std::vector<int32_t>   partition_ids;
+
+  std::deque<DataArray>  point_data;
+  std::deque<DataArray>  cell_data;
+
+public:
+  explicit VTUWriter(bool compress_data=false);
+
+  void AddGridCells(chi_mesh::MeshContinuum* grid);
+
+  size_t NumPoints() const {return num_points;}
+  size_t NumCells()  const {return num_cells;}
+
+  std::vector<double>& AddPointData(const std::string& name);
+  std::vector<double>& AddCellData(const std::string& name);
+
+  void Write(const std::string& base_name) const;
+
+private:
+  void WritePiece(const std::string& file_name) const;
+  void WriteSummary(const std::string& base_name) const;
+  void EncodeBlock(const void* data, uint64_t num_bytes,
+                   std::vector<char>& encoded) const;
+};
+
+#endif
@@ -28,6 +28,8 @@ public:
 public:
   //02
   void Execute();
+  VolumeMesherType Type() const
+  {return VolumeMesherType::EXTRUDER;}
   //03
   //ReorderDOFs
   //04
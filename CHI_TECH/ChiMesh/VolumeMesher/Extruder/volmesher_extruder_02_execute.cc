@@ -114,7 +114,7 @@ void chi_mesh::VolumeMesherExtruder::Execute()
         //================================== Create extruded item_id
         chi_log.Log(LOG_0)
           << "VolumeMesherExtruder: Extruding cells" << std::endl;
-        MPI_Barrier(MPI_COMM_WORLD);
+        MPI_Barrier(chi_mpi.comm);
         ExtrudeCells(temp_grid, grid);
 
         int total_local_cells = grid->local_cells.size();
@@ -124,7 +124,7 @@ void chi_mesh::VolumeMesherExtruder::Execute()
                       1,
                       MPI_INT,
                       MPI_SUM,
-                      MPI_COMM_WORLD);
+                      chi_mpi.comm);
 
         chi_log.Log(LOG_0)
           << "VolumeMesherExtruder: Cells extruded = "
@@ -194,5 +194,5 @@ void chi_mesh::VolumeMesherExtruder::Execute()
     exit(EXIT_FAILURE);
   }
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 }
\ No newline at end of file
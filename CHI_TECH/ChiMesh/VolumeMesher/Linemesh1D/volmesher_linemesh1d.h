@@ -15,6 +15,8 @@ public:
     num_slab_cells = 0;
   }
   void Execute();
+  VolumeMesherType Type() const
+  {return VolumeMesherType::LINEMESH1D;}
 };
 
 #endif
\ No newline at end of file
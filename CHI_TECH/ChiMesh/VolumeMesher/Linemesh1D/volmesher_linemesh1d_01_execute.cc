@@ -160,7 +160,7 @@ void chi_mesh::VolumeMesherLinemesh1D::Execute()
                       1,
                       MPI_INT,
                       MPI_SUM,
-                      MPI_COMM_WORLD);
+                      chi_mpi.comm);
 
         chi_log.Log(LOG_0)
           << "VolumeMesherLinemesh1D: Number of cells in region = "
@@ -177,5 +177,5 @@ void chi_mesh::VolumeMesherLinemesh1D::Execute()
     }//for bndry
   }//for regions
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 }
\ No newline at end of file
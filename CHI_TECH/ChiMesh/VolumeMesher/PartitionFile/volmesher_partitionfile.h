@@ -0,0 +1,27 @@
+#ifndef _chi_volumemesher_partitionfile_h
+#define _chi_volumemesher_partitionfile_h
+
+#include "../chi_volumemesher.h"
+
+//###################################################################
+/**Volume mesher that loads each location's cells directly from the
+ * partition files written by MeshContinuum::ExportPartitionToFile,
+ * bypassing surface meshing, connectivity and partitioning. After
+ * execution the mesher reports the type of the mesher that produced the
+ * files, as stored in their header.*/
+class chi_mesh::VolumeMesherPartitionFile : public chi_mesh::VolumeMesher
+{
+private:
+  const std::string base_name;
+  VolumeMesherType  source_type = VolumeMesherType::PARTITION_FILE;
+
+public:
+  explicit VolumeMesherPartitionFile(const std::string& in_base_name) :
+    base_name(in_base_name)
+  {}
+
+  void Execute();
+  VolumeMesherType Type() const {return source_type;}
+};
+
+#endif
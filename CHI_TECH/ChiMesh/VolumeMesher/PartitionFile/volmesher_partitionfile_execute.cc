@@ -0,0 +1,78 @@
+#include "volmesher_partitionfile.h"
+
+#include "ChiMesh/MeshHandler/chi_meshhandler.h"
+#include "ChiMesh/SurfaceMesher/surfacemesher.h"
+#include "ChiMesh/MeshContinuum/chi_meshcontinuum.h"
+#include "ChiMesh/Region/chi_region.h"
+
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
+
+#include <ChiTimer/chi_timer.h>
+extern ChiTimer chi_program_timer;
+
+//###################################################################
+/**Executes the partition-file mesher.*/
+void chi_mesh::VolumeMesherPartitionFile::Execute()
+{
+  chi_log.Log(LOG_0)
+    << chi_program_timer.GetTimeString()
+    << " VolumeMesherPartitionFile executed.";
+
+  //================================================== Get the current handler
+  auto mesh_handler = chi_mesh::GetCurrentHandler();
+
+  //======================================== Check empty region list
+  if (mesh_handler->region_stack.empty())
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "VolumeMesherPartitionFile: No region added.";
+    exit(EXIT_FAILURE);
+  }
+
+  //======================================== Load the partition
+  auto grid = new chi_mesh::MeshContinuum;
+  auto info = grid->ImportPartitionFromFile(base_name);
+
+  switch (info.mesher_type)
+  {
+    case VolumeMesherType::LINEMESH1D:
+    case VolumeMesherType::PREDEFINED2D:
+    case VolumeMesherType::EXTRUDER:
+    case VolumeMesherType::PREDEFINED3D:
+      source_type = (VolumeMesherType)info.mesher_type; break;
+    default:
+      chi_log.Log(LOG_ALLERROR)
+        << "VolumeMesherPartitionFile: Partition files " << base_name
+        << " store an unsupported mesher type " << info.mesher_type << ".";
+      exit(EXIT_FAILURE);
+  }
+
+  //======================================== Restore partition counts
+  options.partition_z = info.partition_z;
+  if (mesh_handler->surface_mesher != nullptr)
+  {
+    mesh_handler->surface_mesher->partitioning_x = info.partition_x;
+    mesh_handler->surface_mesher->partitioning_y = info.partition_y;
+  }
+
+  AddContinuumToRegion(grid, *mesh_handler->region_stack.back());
+
+  int total_local_cells = grid->local_cells.size();
+  int total_global_cells = 0;
+
+  MPI_Allreduce(&total_local_cells,
+                &total_global_cells,
+                1,
+                MPI_INT,
+                MPI_SUM,
+                chi_mpi.comm);
+
+  chi_log.Log(LOG_0)
+    << "VolumeMesherPartitionFile: Cells loaded = "
+    << total_global_cells
+    << std::endl;
+}
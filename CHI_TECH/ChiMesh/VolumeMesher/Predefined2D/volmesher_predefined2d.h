@@ -15,6 +15,8 @@ public:
 
   //02
   void Execute();
+  VolumeMesherType Type() const
+  {return VolumeMesherType::PREDEFINED2D;}
   //03
 
 };
@@ -87,7 +87,7 @@ void chi_mesh::VolumeMesherPredefined2D::Execute()
                       1,
                       MPI_INT,
                       MPI_SUM,
-                      MPI_COMM_WORLD);
+                      chi_mpi.comm);
 
 
         if (no_boundary_cells>0)
@@ -146,5 +146,5 @@ void chi_mesh::VolumeMesherPredefined2D::Execute()
     } //for boundaries
   } //for regions
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 }
\ No newline at end of file
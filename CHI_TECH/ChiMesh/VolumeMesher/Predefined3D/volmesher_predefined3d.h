@@ -9,8 +9,11 @@ class chi_mesh::VolumeMesherPredefined3D : public chi_mesh::VolumeMesher
 public:
   int GetPartitionIDFromCentroid(const chi_mesh::Vertex& centroid);
   bool IsRawCellNeighborToPartition(
-    const chi_mesh::UnpartitionedMesh::LightWeightCell& lwcell);
+    const chi_mesh::UnpartitionedMesh::LightWeightCell& lwcell,
+    const std::vector<int>& cell_partition_ids);
   void Execute();
+  VolumeMesherType Type() const
+  {return VolumeMesherType::PREDEFINED3D;}
 };
 
 
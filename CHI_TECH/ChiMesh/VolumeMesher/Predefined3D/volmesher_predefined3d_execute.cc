@@ -21,6 +21,8 @@ extern ChiTimer chi_program_timer;
 #include <ChiConsole/chi_console.h>
 extern ChiConsole  chi_console;
 
+#include <algorithm>
+
 //###################################################################
 /**Gets the partition ID from a centroid.*/
 int chi_mesh::VolumeMesherPredefined3D::
@@ -48,24 +50,19 @@ int chi_mesh::VolumeMesherPredefined3D::
 /**Determines if a chi_mesh::UnpartitionedMesh::LightWeightCell is a
  * neighbor to the current partition.
  * This method loops over the faces of the lightweight cell and
- * determines the partition-id of each the neighbors. If the neighbor
+ * looks up the partition-id of each the neighbors. If the neighbor
  * has a partition id equal to that of the current process then
  * it means this reference cell is a neighbor.*/
 bool chi_mesh::VolumeMesherPredefined3D::
   IsRawCellNeighborToPartition(
-    const chi_mesh::UnpartitionedMesh::LightWeightCell& lwcell)
+    const chi_mesh::UnpartitionedMesh::LightWeightCell& lwcell,
+    const std::vector<int>& cell_partition_ids)
 {
-  auto handler = chi_mesh::GetCurrentHandler();
-
-  auto umesh = handler->unpartitionedmesh_stack.back();
-
   bool is_neighbor = false;
   for (const auto& face : lwcell.faces)
   {
     if (face.neighbor < 0) continue;
-    auto adj_cell = umesh->raw_cells[face.neighbor];
-    int partition_id = GetPartitionIDFromCentroid(adj_cell->centroid);
-    if (partition_id == chi_mpi.location_id)
+    if (cell_partition_ids[face.neighbor] == chi_mpi.location_id)
     {
       is_neighbor = true;
       break;
@@ -129,90 +126,57 @@ void chi_mesh::VolumeMesherPredefined3D::Execute()
     }
   }
 
-  //======================================== Populate vertex
-  //                                                   subscriptionns
   auto umesh = mesh_handler->unpartitionedmesh_stack.back();
-  std::vector<std::set<int>> vertex_subs(umesh->vertices.size());
-  int c=-1;
-  for (auto cell : umesh->raw_cells)
-  {
-    ++c;
-    for (auto vid : cell->vertex_ids)
-      vertex_subs[vid].insert(c);
-  }
-
-  int num_bndry_faces = 0;
-  for (auto cell : umesh->raw_cells)
-    for (auto& face : cell->faces)
-      if (face.neighbor < 0) ++num_bndry_faces;
-
-  chi_log.Log(LOG_0) << "Number of bndry faces: " << num_bndry_faces;
+  int loc_id = chi_mpi.location_id;
 
   //======================================== Establish connectivity
-  std::vector<std::set<int>> cells_to_search;
-  c=-1;
-  for (auto cell : umesh->raw_cells)
+  //                                                   and centroids
+  //Meshes mapped from the native binary format already carry both.
+  if (not umesh->IsLoadedOnDemand())
   {
-    ++c;
-    for (auto& face : cell->faces)
-    {
-      if (face.neighbor >= 0) continue;
+    umesh->BuildMeshConnectivity();
+    umesh->ComputeCentroids();
 
-      cells_to_search.clear();
-      for (auto cfvid : face.vertex_ids)
-        cells_to_search.push_back(vertex_subs[cfvid]);
+    int num_bndry_faces = 0;
+    for (auto cell : umesh->raw_cells)
+      for (auto& face : cell->faces)
+        if (face.neighbor < 0) ++num_bndry_faces;
 
-      bool stop_searching = false;
-      for (auto& adj_cell_id_set : cells_to_search)
-      {
-        for (auto& adj_cell_id : adj_cell_id_set)
-        {
-          if (adj_cell_id == c) continue;
-          auto adj_cell = umesh->raw_cells[adj_cell_id];
-
-          //Assume it matches now disprove
-          bool adj_cell_matches = true;
-          for (auto cfvid : face.vertex_ids)
-          {
-            bool vertex_found=false;
-            for (auto acvid : adj_cell->vertex_ids)
-              if (cfvid == acvid) {vertex_found = true; break;}
-
-            if (not vertex_found) { adj_cell_matches = false; break;}
-          }
-
-          if (adj_cell_matches)
-          {
-            face.neighbor = adj_cell_id;
-            stop_searching = true;
-          }
-
-          if (stop_searching) break;
-        }//cell id
-        if (stop_searching) break;
-      }//cell id set
-    }//for face
-  }//for cell
-
-  num_bndry_faces = 0;
-  for (auto cell : umesh->raw_cells)
-    for (auto& face : cell->faces)
-      if (face.neighbor < 0) ++num_bndry_faces;
-
-  chi_log.Log(LOG_0) << "Number of bndry faces: " << num_bndry_faces;
-
-  //======================================== Compute centroid
-  for (auto cell : umesh->raw_cells)
-  {
-    cell->centroid = chi_mesh::Vertex(0.0,0.0,0.0);
-    for (auto vid : cell->vertex_ids)
-      cell->centroid = cell->centroid + *umesh->vertices[vid];
-
-    cell->centroid = cell->centroid/(cell->vertex_ids.size());
+    chi_log.Log(LOG_0) << "Number of bndry faces: " << num_bndry_faces;
+    chi_log.Log(LOG_0) << "Computed centroids";
   }
 
-  chi_log.Log(LOG_0) << "Computed centroids";
-  MPI_Barrier(MPI_COMM_WORLD);
+  //======================================== Determine partition ids
+  int num_raw_cells = umesh->GetNumberOfCells();
+  std::vector<int> cell_partition_ids(num_raw_cells);
+  for (int c=0; c<num_raw_cells; ++c)
+    cell_partition_ids[c] =
+      GetPartitionIDFromCentroid(umesh->GetCellCentroid(c));
+
+  //======================================== Load local and ghost cells
+  //Only the cells owned by this location and their face neighbors are
+  //read from the mapped file.
+  if (umesh->IsLoadedOnDemand())
+  {
+    std::vector<int> local_ids;
+    for (int c=0; c<num_raw_cells; ++c)
+      if (cell_partition_ids[c] == loc_id)
+        local_ids.push_back(c);
+    umesh->LoadCells(local_ids);
+
+    std::vector<int> ghost_ids;
+    for (auto c : local_ids)
+      for (auto& face : umesh->raw_cells[c]->faces)
+        if (face.neighbor >= 0 and cell_partition_ids[face.neighbor] != loc_id)
+          ghost_ids.push_back(face.neighbor);
+    std::sort(ghost_ids.begin(), ghost_ids.end());
+    ghost_ids.erase(std::unique(ghost_ids.begin(), ghost_ids.end()),
+                    ghost_ids.end());
+    umesh->LoadCells(ghost_ids);
+
+    chi_log.Log(LOG_0) << "Local and ghost cells loaded from file.";
+  }
+  MPI_Barrier(chi_mpi.comm);
 
 
   //======================================== Load up the vertices
@@ -221,19 +185,19 @@ void chi_mesh::VolumeMesherPredefined3D::Execute()
     grid->vertices.push_back(new chi_mesh::Vertex(*vert));
 
   chi_log.Log(LOG_0) << "Vertices loaded.";
-  MPI_Barrier(MPI_COMM_WORLD);
-
-  int loc_id = chi_mpi.location_id;
+  MPI_Barrier(chi_mpi.comm);
 
   //======================================== Load up the cells
   int global_id=-1;
   for (auto raw_cell : umesh->raw_cells)
   {
     ++global_id;
+    if (raw_cell == nullptr) continue;
+
     auto temp_cell = new chi_mesh::Cell(chi_mesh::CellType::GHOST);
     temp_cell->centroid = raw_cell->centroid;
     temp_cell->global_id = global_id;
-    temp_cell->partition_id = GetPartitionIDFromCentroid(temp_cell->centroid);
+    temp_cell->partition_id = cell_partition_ids[global_id];
     temp_cell->material_id = raw_cell->material_id;
 
 //    printf("[%d] Bla\n",loc_id);
@@ -241,7 +205,7 @@ void chi_mesh::VolumeMesherPredefined3D::Execute()
     if (temp_cell->partition_id != chi_mpi.location_id)
     {
 //      printf("[%d] Bla1\n",loc_id);
-      if (IsRawCellNeighborToPartition(*raw_cell))
+      if (IsRawCellNeighborToPartition(*raw_cell, cell_partition_ids))
         grid->cells.push_back(temp_cell);
       else
         delete temp_cell;
@@ -305,7 +269,7 @@ void chi_mesh::VolumeMesherPredefined3D::Execute()
   }
 
   chi_log.Log(LOG_0) << "Cells loaded.";
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
   AddContinuumToRegion(grid, *mesh_handler->region_stack.back());
 
@@ -329,7 +293,7 @@ void chi_mesh::VolumeMesherPredefined3D::Execute()
                 1,
                 MPI_INT,
                 MPI_SUM,
-                MPI_COMM_WORLD);
+                chi_mpi.comm);
 
   chi_log.Log(LOG_0)
     << "VolumeMesherPredefined3D: Cells created = "
@@ -15,7 +15,8 @@ namespace chi_mesh
     LINEMESH1D   = 1,
     PREDEFINED2D = 3,
     EXTRUDER     = 4,
-    PREDEFINED3D = 5
+    PREDEFINED3D   = 5,
+    PARTITION_FILE = 6
   };
   enum VolumeMesherProperty
   {
@@ -95,8 +96,14 @@ public:
                                           bool sense, int mat_id);
   void                SetBndryIDFromLogical(chi_mesh::LogicalVolume* log_vol,
                                           bool sense, int bndry_id);
+  void                SetMatIDsFromLogicals(
+    const std::vector<std::pair<chi_mesh::LogicalVolume*,int>>& volume_ids);
+  void                SetBndryIDsFromLogicals(
+    const std::vector<std::pair<chi_mesh::LogicalVolume*,int>>& volume_ids);
   //02
   virtual void Execute();
+  /**Returns the type of mesh produced by this mesher.*/
+  virtual VolumeMesherType Type() const = 0;
   int          MapNode(int iref);
   int          ReverseMapNode(int i);
   
@@ -471,10 +471,120 @@ void chi_mesh::VolumeMesher::
 /**Sets material id's using a logical volume.*/
 void chi_mesh::VolumeMesher::
   SetMatIDFromLogical(chi_mesh::LogicalVolume *log_vol,bool sense, int mat_id)
+{
+  std::vector<std::pair<chi_mesh::LogicalVolume*,int>> volume_ids;
+  if (sense)
+    volume_ids.emplace_back(log_vol,mat_id);
+
+  SetMatIDsFromLogicals(volume_ids);
+}
+
+//###################################################################
+/**Sets boundary id's using a logical volume.*/
+void chi_mesh::VolumeMesher::
+ SetBndryIDFromLogical(chi_mesh::LogicalVolume *log_vol,bool sense, int bndry_id)
+{
+  std::vector<std::pair<chi_mesh::LogicalVolume*,int>> volume_ids;
+  if (sense)
+    volume_ids.emplace_back(log_vol,bndry_id);
+
+  SetBndryIDsFromLogicals(volume_ids);
+}
+
+namespace
+{
+//###################################################################
+/**Determines, for each volume in turn, which of the supplied points
+ * lie inside it. Points are culled against the volume's bounding box
+ * through the grid's cell index before the volume's batched Inside is
+ * called. point_owner[i] receives the index of the last volume
+ * containing point i, or is left untouched.
+ *
+ * \param grid         The grid whose cells own the points.
+ * \param volume_ids   List of (volume,id) pairs.
+ * \param cell_offsets Offsets of each local cell's points into the flat
+ *                     point arrays (size num_local_cells+1).
+ * \param px,py,pz     Flat point coordinate arrays.
+ * \param point_owner  Receives the owning volume index of each point.*/
+void TagPointsFromLogicals(
+  chi_mesh::MeshContinuum* grid,
+  const std::vector<std::pair<chi_mesh::LogicalVolume*,int>>& volume_ids,
+  const std::vector<size_t>& cell_offsets,
+  const std::vector<double>& px,
+  const std::vector<double>& py,
+  const std::vector<double>& pz,
+  std::vector<int>& point_owner)
+{
+  auto& cell_bvh = grid->GetCellBVH();
+
+  std::vector<int>    candidate_cells;
+  std::vector<size_t> candidate_points;
+  std::vector<double> cx, cy, cz;
+  std::vector<char>   inside;
+
+  int num_volumes = static_cast<int>(volume_ids.size());
+  for (int v=0; v<num_volumes; ++v)
+  {
+    chi_mesh::LogicalVolume* log_vol = volume_ids[v].first;
+
+    //================================= Cull cells by bounding box
+    candidate_cells.clear();
+    chi_mesh::BoundingBox lv_box;
+    bool bounded = log_vol->GetBoundingBox(lv_box);
+    if (bounded)
+      cell_bvh.FindCellsOverlapping(lv_box, candidate_cells);
+    else
+    {
+      candidate_cells.reserve(grid->local_cells.size());
+      for (const auto& cell : grid->local_cells)
+        candidate_cells.push_back(cell.local_id);
+    }
+
+    //================================= Gather candidate points
+    candidate_points.clear();
+    cx.clear(); cy.clear(); cz.clear();
+    for (int c : candidate_cells)
+      for (size_t i=cell_offsets[c]; i<cell_offsets[c+1]; ++i)
+      {
+        if (bounded and
+            not lv_box.Contains(chi_mesh::Vector3(px[i],py[i],pz[i])))
+          continue;
+        candidate_points.push_back(i);
+        cx.push_back(px[i]);
+        cy.push_back(py[i]);
+        cz.push_back(pz[i]);
+      }
+
+    //================================= Batched inside test
+    size_t num_candidates = candidate_points.size();
+    inside.assign(num_candidates, 0);
+    if (num_candidates > 0)
+      log_vol->InsideBatch(num_candidates,
+                           cx.data(), cy.data(), cz.data(),
+                           inside.data());
+
+    for (size_t k=0; k<num_candidates; ++k)
+      if (inside[k])
+        point_owner[candidate_points[k]] = v;
+  }//for volume
+}
+}
+
+//###################################################################
+/**Sets material id's from a list of logical volumes in a single pass
+ * over the cells. Volumes later in the list take precedence, i.e.,
+ * the result is the same as calling SetMatIDFromLogical for each
+ * pair in order.
+ *
+ * \param volume_ids List of pairs of logical volume and material id.*/
+void chi_mesh::VolumeMesher::
+  SetMatIDsFromLogicals(
+    const std::vector<std::pair<chi_mesh::LogicalVolume*,int>>& volume_ids)
 {
   chi_log.Log(LOG_0)
     << chi_program_timer.GetTimeString()
-    << " Setting material id from logical volume.";
+    << " Setting material id from " << volume_ids.size()
+    << " logical volume(s).";
   //============================================= Get current mesh handler
   chi_mesh::MeshHandler* handler = chi_mesh::GetCurrentHandler();
 
@@ -482,29 +592,54 @@ void chi_mesh::VolumeMesher::
   chi_mesh::Region* cur_region = handler->region_stack.back();
   chi_mesh::MeshContinuum* vol_cont = cur_region->GetGrid();
 
+  //============================================= Gather cell centroids
+  size_t num_local_cells = vol_cont->local_cells.size();
+  std::vector<size_t> cell_offsets(num_local_cells+1);
+  std::vector<double> px(num_local_cells), py(num_local_cells), pz(num_local_cells);
+  for (const auto& cell : vol_cont->local_cells)
+  {
+    int c = cell.local_id;
+    cell_offsets[c] = c;
+    px[c] = cell.centroid.x;
+    py[c] = cell.centroid.y;
+    pz[c] = cell.centroid.z;
+  }
+  cell_offsets[num_local_cells] = num_local_cells;
+
+  std::vector<int> cell_owner(num_local_cells, -1);
+  TagPointsFromLogicals(vol_cont, volume_ids, cell_offsets,
+                        px, py, pz, cell_owner);
+
+  //============================================= Apply ids
   int num_cells_modified = 0;
   for (auto& cell : vol_cont->local_cells)
   {
-    if (log_vol->Inside(cell.centroid) && sense){
-      cell.material_id = mat_id;
-      ++num_cells_modified;
-    }
+    int v = cell_owner[cell.local_id];
+    if (v < 0) continue;
+    cell.material_id = volume_ids[v].second;
+    ++num_cells_modified;
   }
-  MPI_Barrier(MPI_COMM_WORLD);
+
+  MPI_Barrier(chi_mpi.comm);
   chi_log.Log(LOG_0)
     << chi_program_timer.GetTimeString()
-    << " Done setting material id from logical volume. "
+    << " Done setting material id from logical volume(s). "
     << "Number of cells modified = " << num_cells_modified << ".";
 }
 
 //###################################################################
-/**Sets material id's using a logical volume.*/
+/**Sets boundary id's from a list of logical volumes in a single pass
+ * over the faces. Volumes later in the list take precedence.
+ *
+ * \param volume_ids List of pairs of logical volume and boundary id.*/
 void chi_mesh::VolumeMesher::
- SetBndryIDFromLogical(chi_mesh::LogicalVolume *log_vol,bool sense, int bndry_id)
+  SetBndryIDsFromLogicals(
+    const std::vector<std::pair<chi_mesh::LogicalVolume*,int>>& volume_ids)
 {
   chi_log.Log(LOG_0)
     << chi_program_timer.GetTimeString()
-    << " Setting boundary id from logical volume.";
+    << " Setting boundary id from " << volume_ids.size()
+    << " logical volume(s).";
   //============================================= Get current mesh handler
   chi_mesh::MeshHandler* handler = chi_mesh::GetCurrentHandler();
 
@@ -512,18 +647,48 @@ void chi_mesh::VolumeMesher::
   chi_mesh::Region* cur_region = handler->region_stack.back();
   chi_mesh::MeshContinuum* vol_cont = cur_region->GetGrid();
 
+  //============================================= Gather face centroids
+  size_t num_local_cells = vol_cont->local_cells.size();
+  std::vector<size_t> cell_offsets(num_local_cells+1, 0);
+  for (const auto& cell : vol_cont->local_cells)
+    cell_offsets[cell.local_id+1] = cell.faces.size();
+  for (size_t c=0; c<num_local_cells; ++c)
+    cell_offsets[c+1] += cell_offsets[c];
+
+  size_t num_faces = cell_offsets[num_local_cells];
+  std::vector<double> px(num_faces), py(num_faces), pz(num_faces);
+  for (const auto& cell : vol_cont->local_cells)
+  {
+    size_t i = cell_offsets[cell.local_id];
+    for (const auto& face : cell.faces)
+    {
+      px[i] = face.centroid.x;
+      py[i] = face.centroid.y;
+      pz[i] = face.centroid.z;
+      ++i;
+    }
+  }
+
+  std::vector<int> face_owner(num_faces, -1);
+  TagPointsFromLogicals(vol_cont, volume_ids, cell_offsets,
+                        px, py, pz, face_owner);
+
+  //============================================= Apply ids
   int num_faces_modified = 0;
   for (auto& cell : vol_cont->local_cells)
   {
+    size_t i = cell_offsets[cell.local_id];
     for (auto& face : cell.faces)
-      if (log_vol->Inside(face.centroid) && sense){
-        face.neighbor = -1*(abs(bndry_id)+1);
-        ++num_faces_modified;
-      }
+    {
+      int v = face_owner[i++];
+      if (v < 0) continue;
+      face.neighbor = -1*(abs(volume_ids[v].second)+1);
+      ++num_faces_modified;
+    }
   }
 
   chi_log.Log(LOG_0)
     << chi_program_timer.GetTimeString()
-    << " Done setting boundary id from logical volume. "
+    << " Done setting boundary id from logical volume(s). "
     << "Number of faces modified = " << num_faces_modified << ".";
-}
\ No newline at end of file
+}
@@ -4,6 +4,7 @@
 #include "../Predefined2D/volmesher_predefined2d.h"
 #include "../Extruder/volmesher_extruder.h"
 #include "../Predefined3D/volmesher_predefined3d.h"
+#include "../PartitionFile/volmesher_partitionfile.h"
 
 #include "../../MeshHandler/chi_meshhandler.h"
 
@@ -56,6 +57,9 @@ Remesher types:\n
  VOLUMEMESHER_PREDEFINED2D = No remeshing is performed.\n
  VOLUMEMESHER_EXTRUDER = Extruder the first surface mesh found.\n
  VOLUMEMESHER_PREDEFINED3D = Create the mesh from the latest UnpartitionedMesh.\n
+ VOLUMEMESHER_PARTITION_FILE = Load each location's cells directly from
+ partition files written by chiRegionExportPartitionToFile. Requires the
+ base name of the files as a second argument.\n
 
 \ingroup LuaVolumeMesher
 \author Jan*/
@@ -82,14 +86,23 @@ int chiVolumeMesherCreate(lua_State *L)
   {
     new_mesher = new chi_mesh::VolumeMesherPredefined3D;
   }
+  else if (type==chi_mesh::VolumeMesherType::PARTITION_FILE)  //VOLUMEMESHER_PARTITION_FILE
+  {
+    if (lua_gettop(L) != 2)
+      LuaPostArgAmountError("chiVolumeMesherCreate",2,lua_gettop(L));
+
+    const char* base_name = lua_tostring(L,2);
+    new_mesher = new chi_mesh::VolumeMesherPartitionFile(base_name);
+  }
   else
   {
     chi_log.Log(LOG_0ERROR) << "Invalid Volume mesher type in function "
                                "chiVolumeMesherCreate. Allowed options are"
                                "VOLUMEMESHER_LINEMESH1D, "
                                "VOLUMEMESHER_PREDEFINED2D, "
-                               "VOLUMEMESHER_EXTRUDER or "
-                               "VOLUMEMESHER_PREDEFINED3D";
+                               "VOLUMEMESHER_EXTRUDER, "
+                               "VOLUMEMESHER_PREDEFINED3D or "
+                               "VOLUMEMESHER_PARTITION_FILE";
     exit(EXIT_FAILURE);
   }
 
@@ -9,6 +9,61 @@
 #include <chi_log.h>
 extern ChiLog chi_log;
 
+namespace
+{
+//#############################################################################
+/**Reads a lua table, at stack index 2, of {LogicalVolumeHandle,id} pairs.*/
+std::vector<std::pair<chi_mesh::LogicalVolume*,int>>
+  GetLogicalVolumeIDPairs(lua_State* L, chi_mesh::MeshHandler* cur_hndlr)
+{
+  const char fname[] = "chiVolumeMesherSetProperty";
+  int table_len = lua_rawlen(L,2);
+
+  std::vector<std::pair<chi_mesh::LogicalVolume*,int>> volume_ids;
+  volume_ids.reserve(table_len);
+
+  for (int v=0; v<table_len; ++v)
+  {
+    lua_pushnumber(L,v+1);
+    lua_gettable(L,2);
+
+    if (!lua_istable(L,-1))
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "In call to chiVolumeMesherSetProperty: "
+        << "The elements of the supplied table must themselves also "
+           "be lua tables of a logical volume handle and an id.";
+      exit(EXIT_FAILURE);
+    }
+
+    lua_pushinteger(L,1);
+    lua_gettable(L,-2);
+    LuaCheckNilValue(fname,L,-1);
+    int volume_hndl = lua_tonumber(L,-1); lua_pop(L,1);
+
+    lua_pushinteger(L,2);
+    lua_gettable(L,-2);
+    LuaCheckNilValue(fname,L,-1);
+    int id = lua_tonumber(L,-1); lua_pop(L,1);
+
+    lua_pop(L,1); //pop off table
+
+    if ((volume_hndl < 0) or
+        (volume_hndl >= cur_hndlr->logicvolume_stack.size()))
+    {
+      chi_log.Log(LOG_ALLERROR) << "Invalid logical volume specified in "
+                                   "chiVolumeMesherSetProperty. Handle "
+                                << volume_hndl << ".";
+      exit(EXIT_FAILURE);
+    }
+
+    volume_ids.emplace_back(cur_hndlr->logicvolume_stack[volume_hndl],id);
+  }
+
+  return volume_ids;
+}
+}
+
 //#############################################################################
 /** Sets a volume mesher property.
 
@@ -37,12 +92,20 @@ extern ChiLog chi_log;
  MATID_FROMLOGICAL = <B>LogicalVolumeHandle:[int],Mat_id:[int],
                      Sense:[bool](Optional, default:true)</B> Sets the material
                      id of cells that meet the sense requirement for the given
-                     logical volume.\n
+                     logical volume. Alternatively accepts a single table of
+                     {LogicalVolumeHandle,Mat_id} pairs, which are all
+                     applied in one pass with later pairs taking
+                     precedence.\n
  BNDRYID_FROMLOGICAL = <B>LogicalVolumeHandle:[int],Bndry_id:[int],
                      Sense:[bool](Optional, default:true)</B> Sets the cell
                      boundary id to the specified value for cells
                      that meet the sense requirement for the given
-                     logical volume.\n
+                     logical volume. Also accepts a table of
+                     {LogicalVolumeHandle,Bndry_id} pairs.\n
+
+\code
+chiVolumeMesherSetProperty(MATID_FROMLOGICAL, {{vol0,1},{vol1,2},{vol2,3}})
+\endcode
 
 
 \ingroup LuaVolumeMesher
@@ -148,6 +211,20 @@ int chiVolumeMesherSetProperty(lua_State *L)
 
   }
 
+  else if ((property_index == VMP::MATID_FROMLOGICAL) and
+           (num_args == 2) and lua_istable(L,2))
+  {
+    auto volume_ids = GetLogicalVolumeIDPairs(L, cur_hndlr);
+    cur_hndlr->volume_mesher->SetMatIDsFromLogicals(volume_ids);
+  }
+
+  else if ((property_index == VMP::BNDRYID_FROMLOGICAL) and
+           (num_args == 2) and lua_istable(L,2))
+  {
+    auto volume_ids = GetLogicalVolumeIDPairs(L, cur_hndlr);
+    cur_hndlr->volume_mesher->SetBndryIDsFromLogicals(volume_ids);
+  }
+
   else if (property_index == VMP::MATID_FROMLOGICAL)
   {
     if (!((num_args == 3) || (num_args == 4)))
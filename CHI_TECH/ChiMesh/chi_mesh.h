@@ -49,6 +49,10 @@ namespace chi_mesh
 //  class CellPolygon;
 //  class CellPolyhedron;
 
+  //=================================== Ray tracing
+  struct BoundingBox;
+  class CellBVH;
+
   //=================================== Field function interpolation
   class FieldFunctionInterpolation;
   class FieldFunctionInterpolationSlice;
@@ -61,6 +65,9 @@ namespace chi_mesh
   class UnpartitionedMesh;
   class MeshContinuum;
 
+  //=================================== Output
+  class VTUWriter;
+
   //=================================== Logical Volumes
   class LogicalVolume;
   class SphereLogicalVolume;
@@ -91,6 +98,7 @@ namespace chi_mesh
   class VolumeMesherPredefined2D;
   class VolumeMesherExtruder;
   class VolumeMesherPredefined3D;
+  class VolumeMesherPartitionFile;
 
 
 
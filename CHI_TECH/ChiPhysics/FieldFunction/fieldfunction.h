@@ -118,26 +118,50 @@ public:
 
   //01
   void ExportToVTK(const std::string& base_name,
-                   const std::string& field_name);
+                   const std::string& field_name,
+                   bool compress=false);
   void ExportToVTKG(const std::string& base_name,
-                    const std::string& field_name);
+                    const std::string& field_name,
+                    bool compress=false);
   //01a
   void ExportToVTKFV(const std::string& base_name,
-                     const std::string& field_name);
+                     const std::string& field_name,
+                     bool compress);
   void ExportToVTKFVG(const std::string& base_name,
-                      const std::string& field_name);
+                      const std::string& field_name,
+                      bool compress);
+  void AddFVComponentToVTU(chi_mesh::VTUWriter& writer,
+                           int component,
+                           const std::string& avg_name);
   //01b
   void ExportToVTKPWLC(const std::string& base_name,
-                       const std::string& field_name);
+                       const std::string& field_name,
+                       bool compress);
   void ExportToVTKPWLCG(const std::string& base_name,
-                        const std::string& field_name);
+                        const std::string& field_name,
+                        bool compress);
+  void AddPWLCComponentToVTU(chi_mesh::VTUWriter& writer,
+                             int component,
+                             const std::string& point_name,
+                             const std::string& avg_name);
   //01c
   void ExportToVTKPWLD(const std::string& base_name,
-                       const std::string& field_name);
+                       const std::string& field_name,
+                       bool compress);
   void ExportToVTKPWLDG(const std::string& base_name,
-                        const std::string& field_name);
+                        const std::string& field_name,
+                        bool compress);
+  void CreatePWLDExportMapping(std::vector<int>& mapping);
+  void AddPWLDComponentToVTU(chi_mesh::VTUWriter& writer,
+                             const std::vector<int>& mapping,
+                             int component,
+                             const std::string& point_name,
+                             const std::string& avg_name);
 
-  void WritePVTU(std::string base_filename, std::string field_name, int num_grps=0);
+  //02
+  static void ExportMultipleToVTK(const std::string& base_name,
+                                  const std::vector<FieldFunction*>& ff_list,
+                                  bool compress=false);
 };
 
 
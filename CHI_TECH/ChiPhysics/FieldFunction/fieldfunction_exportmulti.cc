@@ -0,0 +1,85 @@
+#include "fieldfunction.h"
+
+#include <ChiMesh/VTUWriter/chi_vtuwriter.h>
+
+#include <chi_log.h>
+#include <chi_mpi.h>
+
+extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
+
+#include <map>
+#include <tuple>
+
+//###################################################################
+/**Exports a list of field functions to a single set of VTK files.
+ * The geometry is written only once and each field function is
+ * attached as its own point and/or cell array, named after the field
+ * function. All the field functions must be defined on the same grid.
+ *
+ * PWLD field functions sharing the same dof layout and reference set,
+ * e.g. the group-wise flux field functions of a transport solver,
+ * also share a single dof mapping.*/
+void chi_physics::FieldFunction::
+  ExportMultipleToVTK(const std::string& base_name,
+                      const std::vector<FieldFunction*>& ff_list,
+                      bool compress)
+{
+  if (ff_list.empty())
+  {
+    chi_log.Log(LOG_0WARNING)
+      << "FieldFunction::ExportMultipleToVTK: no field functions supplied.";
+    return;
+  }
+
+  chi_log.Log(LOG_0)
+    << "Exporting " << ff_list.size() << " field functions"
+    << " to files with base name " << base_name;
+
+  auto grid = ff_list.front()->grid;
+  for (auto ff : ff_list)
+    if (ff->grid != grid)
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "FieldFunction::ExportMultipleToVTK: all field functions must "
+        << "be defined on the same grid. Field function \""
+        << ff->text_name << "\" is not.";
+      exit(EXIT_FAILURE);
+    }
+
+  //======================================== Geometry
+  chi_mesh::VTUWriter writer(compress);
+  writer.AddGridCells(grid);
+
+  //======================================== Fields
+  typedef std::tuple<std::vector<int>*,int,int,int> PWLDMappingKey;
+  std::map<PWLDMappingKey,std::vector<int>> pwld_mappings;
+
+  for (auto ff : ff_list)
+  {
+    const std::string& name = ff->text_name;
+    std::string avg_name = name + std::string("-Avg");
+
+    if (ff->type == FieldFunctionType::FV)
+      ff->AddFVComponentToVTU(writer, ff->ref_component, avg_name);
+    else if (ff->type == FieldFunctionType::CFEM_PWL)
+      ff->AddPWLCComponentToVTU(writer, ff->ref_component, name, avg_name);
+    else if (ff->type == FieldFunctionType::DFEM_PWL)
+    {
+      PWLDMappingKey key(&ff->spatial_discretization->cell_dfem_block_address,
+                         ff->num_components, ff->num_sets, ff->ref_set);
+
+      auto mapping = pwld_mappings.find(key);
+      if (mapping == pwld_mappings.end())
+      {
+        mapping = pwld_mappings.emplace(key, std::vector<int>()).first;
+        ff->CreatePWLDExportMapping(mapping->second);
+      }
+
+      ff->AddPWLDComponentToVTU(writer, mapping->second, ff->ref_component,
+                                name, avg_name);
+    }
+  }
+
+  writer.Write(base_name);
+}
@@ -14,20 +14,28 @@ extern ChiLog     chi_log;
  *
 \param FFHandle int Global handle to the field function.
 \param BaseName char Base name for the exported file.
+\param FieldName char Optional. Name of the field. Defaults to BaseName.
+\param Compress bool Optional. Compresses the data with zlib. Default false.
+
+Each process writes a binary piece, BaseName_<location>.vtu, and the home
+location writes BaseName.pvtu which references all pieces.
 
 \ingroup LuaFieldFunc
 \author Jan*/
 int chiExportFieldFunctionToVTK(lua_State *L)
 {
   int num_args = lua_gettop(L);
-  if ((num_args < 2) or (num_args>3))
+  if ((num_args < 2) or (num_args>4))
     LuaPostArgAmountError("chiExportFieldFunctionToVTK", 2, num_args);
 
   int ff_handle = lua_tonumber(L,1);
   const char* base_name = lua_tostring(L,2);
   const char* field_name = base_name;
-  if (num_args == 3)
+  if (num_args >= 3)
     field_name = lua_tostring(L,3);
+  bool compress = false;
+  if (num_args == 4)
+    compress = lua_toboolean(L,4);
 
   //======================================================= Getting solver
   chi_physics::FieldFunction* ff;
@@ -41,7 +49,7 @@ int chiExportFieldFunctionToVTK(lua_State *L)
     exit(EXIT_FAILURE);
   }
 
-  ff->ExportToVTK(base_name,field_name);
+  ff->ExportToVTK(base_name,field_name,compress);
 
   return 0;
 }
@@ -51,20 +59,25 @@ int chiExportFieldFunctionToVTK(lua_State *L)
  *
 \param FFHandle int Global handle to the field function.
 \param BaseName char Base name for the exported file.
+\param FieldName char Optional. Name of the field. Defaults to BaseName.
+\param Compress bool Optional. Compresses the data with zlib. Default false.
 
 \ingroup LuaFieldFunc
 \author Jan*/
 int chiExportFieldFunctionToVTKG(lua_State *L)
 {
   int num_args = lua_gettop(L);
-  if ((num_args < 2) or (num_args>3))
+  if ((num_args < 2) or (num_args>4))
     LuaPostArgAmountError("chiExportFieldFunctionToVTK", 2, num_args);
 
   int ff_handle = lua_tonumber(L,1);
   const char* base_name = lua_tostring(L,2);
   const char* field_name = base_name;
-  if (num_args == 3)
+  if (num_args >= 3)
     field_name = lua_tostring(L,3);
+  bool compress = false;
+  if (num_args == 4)
+    compress = lua_toboolean(L,4);
 
   //======================================================= Getting solver
   chi_physics::FieldFunction* ff;
@@ -78,7 +91,7 @@ int chiExportFieldFunctionToVTKG(lua_State *L)
     exit(EXIT_FAILURE);
   }
 
-  ff->ExportToVTKG(base_name,field_name);
+  ff->ExportToVTKG(base_name,field_name,compress);
 
   return 0;
 }
@@ -130,8 +143,77 @@ int chiExportMultiFieldFunctionToVTKG(lua_State *L)
     exit(EXIT_FAILURE);
   }
 
-//  ff->ExportToVTKG(base_name,field_name);
+//  ff->ExportToVTKG(base_name,field_name,compress);
 
 //  ff->ExportMultiToVTKG(ff_slave,base_name,field_name);
   return 0;
 }
+
+//#############################################################################
+/** Exports a list of field functions to a single set of VTK files. The
+ * mesh is written only once and every field function is attached as a
+ * separate array named after the field function.
+ *
+\param FFHandles table Lua table of global field function handles.
+\param BaseName char Base name for the exported files.
+\param Compress bool Optional. Compresses the data with zlib. Default false.
+
+### Example
+Exporting all the flux moments of a transport solver:
+\code
+fflist,count = chiGetFieldFunctionList(phys1)
+chiExportMultiFieldFunctionToVTK(fflist,"ZPhi")
+\endcode
+
+\ingroup LuaFieldFunc
+\author Jan*/
+int chiExportMultiFieldFunctionToVTK(lua_State *L)
+{
+  int num_args = lua_gettop(L);
+  if ((num_args < 2) or (num_args>3))
+    LuaPostArgAmountError("chiExportMultiFieldFunctionToVTK", 2, num_args);
+
+  LuaCheckNilValue("chiExportMultiFieldFunctionToVTK", L, 1);
+  LuaCheckNilValue("chiExportMultiFieldFunctionToVTK", L, 2);
+
+  if (!lua_istable(L,1))
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "chiExportMultiFieldFunctionToVTK: First argument must be a lua "
+      << "table of field function handles.";
+    exit(EXIT_FAILURE);
+  }
+
+  const char* base_name = lua_tostring(L,2);
+  bool compress = false;
+  if (num_args == 3)
+    compress = lua_toboolean(L,3);
+
+  //======================================================= Getting field
+  //                                                        functions
+  std::vector<chi_physics::FieldFunction*> ff_list;
+  int table_len = lua_rawlen(L,1);
+  ff_list.reserve(table_len);
+  for (int i=0; i<table_len; ++i)
+  {
+    lua_pushnumber(L,i+1);
+    lua_gettable(L,1);
+    int ff_handle = lua_tonumber(L,-1);
+    lua_pop(L,1);
+
+    try{
+      ff_list.push_back(chi_physics_handler.fieldfunc_stack.at(ff_handle));
+    }
+    catch(const std::out_of_range& o)
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Invalid field function handle " << ff_handle
+        << " in chiExportMultiFieldFunctionToVTK";
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  chi_physics::FieldFunction::ExportMultipleToVTK(base_name,ff_list,compress);
+
+  return 0;
+}
@@ -4,6 +4,8 @@
 #include "chi_physicsmaterial.h"
 #include <ChiMath/SparseMatrix/chi_math_sparse_matrix.h>
 
+#include <cstdint>
+
 #define E_COLLAPSE_PARTIAL_JACOBI 1
 #define E_COLLAPSE_JACOBI         2
 #define E_COLLAPSE_PARTIAL_GAUSS  3
@@ -84,6 +86,15 @@ public:
   //05
   void PushLuaTable(lua_State* L) override;
 
+  //06
+  void MakeFromChiXSFile(const std::string &file_name);
+  void ExportToChiXSFile(const std::string &file_name) const;
+  uint64_t ComputeContentHash() const;
+  bool     HasSameContent(const TransportCrossSections& other) const;
+
+  //07
+  void MakeAdjoint(const TransportCrossSections& forward);
+
 
 };
 
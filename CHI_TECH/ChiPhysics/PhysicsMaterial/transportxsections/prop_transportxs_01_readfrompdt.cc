@@ -1,12 +1,17 @@
 #include "ChiPhysics/PhysicsMaterial/property10_transportxsections.h"
 
 #include <chi_log.h>
+#include <chi_mpi.h>
 
 extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
+
+#include <sstream>
 
 //###################################################################
 /**This method populates a transport cross-section from
- * a PDT cross-section file.*/
+ * a PDT cross-section file. The file is read by the home location
+ * only and broadcast to the other locations. This call is collective.*/
 void chi_physics::TransportCrossSections::
   MakeFromPDTxsFile(const std::string &file_name,std::string MT_TRANSFER)
 {
@@ -15,10 +20,26 @@ void chi_physics::TransportCrossSections::
 
   std::string MT_SEARCH_VAL = MT_TRANSFER + std::string(",");
 
-  //======================================== Opening the file
-  std::ifstream file;
-  file.open(file_name);
-  if (!file.is_open())
+  //======================================== Read on home location
+  //                                         and broadcast
+  std::string file_contents;
+  uint64_t    file_size = 0;
+  if (chi_mpi.location_id == 0)
+  {
+    std::ifstream in_file(file_name, std::ios::in | std::ios::binary);
+    if (in_file.is_open())
+    {
+      std::stringstream contents;
+      contents << in_file.rdbuf();
+      file_contents = contents.str();
+      file_size = file_contents.size();
+      in_file.close();
+    }
+  }
+
+  MPI_Bcast(&file_size, 1, MPI_UINT64_T, 0, chi_mpi.comm);
+
+  if (file_size == 0)
   {
     chi_log.Log(LOG_0ERROR)
       << "Failed to open PDT cross-section file \""
@@ -27,6 +48,12 @@ void chi_physics::TransportCrossSections::
     exit(EXIT_FAILURE);
   }
 
+  file_contents.resize(file_size);
+  MPI_Bcast(&file_contents[0], static_cast<int>(file_size), MPI_CHAR,
+            0, chi_mpi.comm);
+
+  std::istringstream file(file_contents);
+
   char line[250];
   std::string word;
   std::string mg_or_single_group;
@@ -54,7 +81,6 @@ void chi_physics::TransportCrossSections::
       << " read from PDT cross-section files. The file \""
       << file_name << "\" has " << mg_or_single_group << " "
       << xs_type << " cross-sections.";
-    file.close();
     exit(EXIT_FAILURE);
   }
 
@@ -87,7 +113,7 @@ void chi_physics::TransportCrossSections::
                          chi_math::SparseMatrix(num_grps_G,num_grps_G));
 
   //======================================== Lambda for advancing to MT
-  auto AdvanceToNextMT = [](std::ifstream& file,
+  auto AdvanceToNextMT = [](std::istream& file,
                             const std::string& file_name)
   {
     while (!file.eof())
@@ -109,7 +135,7 @@ void chi_physics::TransportCrossSections::
   };
 
   //======================================== Lambda for reading 1D xs
-  auto Read1DXS = [](std::vector<double>& xs, std::ifstream& file, int G)
+  auto Read1DXS = [](std::vector<double>& xs, std::istream& file, int G)
   {
     for (int g=0; g<G; g++)
     {
@@ -168,7 +194,4 @@ void chi_physics::TransportCrossSections::
       }
     }
   }
-
-
-  file.close();
 }
\ No newline at end of file
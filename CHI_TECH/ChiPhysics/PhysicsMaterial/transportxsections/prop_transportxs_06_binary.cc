@@ -0,0 +1,302 @@
+#include "ChiPhysics/PhysicsMaterial/property10_transportxsections.h"
+
+#include <chi_log.h>
+#include <chi_mpi.h>
+extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
+
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+namespace
+{
+const char     CHI_XS_MAGIC[8] = {'C','H','I','X','S','\0','\0','\0'};
+const uint64_t CHI_XS_VERSION  = 1;
+
+//###################################################################
+/**Appends the raw bytes of a value to a byte buffer.*/
+template<typename T>
+void PackValue(std::vector<char>& buffer, const T& value)
+{
+  const char* bytes = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+void PackArray(std::vector<char>& buffer, const std::vector<T>& values)
+{
+  const char* bytes = reinterpret_cast<const char*>(values.data());
+  buffer.insert(buffer.end(), bytes, bytes + values.size()*sizeof(T));
+}
+
+//###################################################################
+/**Sequential reader over a byte buffer. Reading past the end sets
+ * the failed flag instead of reading out of bounds.*/
+struct ByteReader
+{
+  const std::vector<char>& buffer;
+  size_t position = 0;
+  bool   failed   = false;
+
+  explicit ByteReader(const std::vector<char>& in_buffer) :
+    buffer(in_buffer) {}
+
+  void Read(void* destination, size_t num_bytes)
+  {
+    if (failed or (buffer.size() - position < num_bytes))
+    {
+      failed = true;
+      return;
+    }
+    std::memcpy(destination, buffer.data() + position, num_bytes);
+    position += num_bytes;
+  }
+
+  template<typename T>
+  T Read()
+  {
+    T value = T();
+    Read(&value, sizeof(T));
+    return value;
+  }
+
+  template<typename T>
+  void ReadArray(std::vector<T>& values, size_t count)
+  {
+    if (failed or ((buffer.size() - position)/sizeof(T) < count))
+    {
+      failed = true;
+      return;
+    }
+    values.resize(count);
+    Read(values.data(), count*sizeof(T));
+  }
+};
+
+//###################################################################
+/**64-bit FNV-1a hash accumulation.*/
+void HashBytes(uint64_t& hash, const void* data, size_t num_bytes)
+{
+  const auto bytes = static_cast<const unsigned char*>(data);
+  for (size_t i=0; i<num_bytes; ++i)
+  {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+template<typename T>
+void HashArray(uint64_t& hash, const std::vector<T>& values)
+{
+  uint64_t size = values.size();
+  HashBytes(hash, &size, sizeof(uint64_t));
+  HashBytes(hash, values.data(), values.size()*sizeof(T));
+}
+}
+
+//###################################################################
+/**Populates the cross-section from a binary cross-section file written
+ * by ExportToChiXSFile. The file is read by the home location only and
+ * broadcast to all other locations. This call is collective.
+ *
+ * The format is
+ *  - magic "CHIXS", version, G, L, number of transfer moments,
+ *  - sigma_t, sigma_f, sigma_capt, chi, nu_sigma_f, each G doubles,
+ *  - for every transfer moment and every row, the number of entries
+ *    followed by the column indices and the values.*/
+void chi_physics::TransportCrossSections::
+  MakeFromChiXSFile(const std::string &file_name)
+{
+  chi_log.Log(LOG_0)
+    << "Reading binary cross-section file \"" << file_name << "\"";
+
+  //======================================== Read and broadcast
+  std::vector<char> buffer;
+  uint64_t file_size = 0;
+  if (chi_mpi.location_id == 0)
+  {
+    std::ifstream file(file_name, std::ios::in | std::ios::binary |
+                                  std::ios::ate);
+    if (file.is_open())
+    {
+      file_size = static_cast<uint64_t>(file.tellg());
+      buffer.resize(file_size);
+      file.seekg(0);
+      file.read(buffer.data(), file_size);
+      if (!file.good()) file_size = 0;
+      file.close();
+    }
+  }
+
+  MPI_Bcast(&file_size, 1, MPI_UINT64_T, 0, chi_mpi.comm);
+
+  if (file_size == 0)
+  {
+    chi_log.Log(LOG_0ERROR)
+      << "Failed to read binary cross-section file \""
+      << file_name << "\" in call to "
+      << "TransportCrossSections::MakeFromChiXSFile";
+    exit(EXIT_FAILURE);
+  }
+
+  buffer.resize(file_size);
+  MPI_Bcast(buffer.data(), static_cast<int>(file_size), MPI_CHAR,
+            0, chi_mpi.comm);
+
+  //======================================== Header
+  ByteReader reader(buffer);
+
+  char magic[8];
+  reader.Read(magic, 8);
+  auto version       = reader.Read<uint64_t>();
+  auto num_grps_G    = reader.Read<uint64_t>();
+  auto scat_order    = reader.Read<uint64_t>();
+  auto num_moments   = reader.Read<uint64_t>();
+
+  if (reader.failed or (std::memcmp(magic, CHI_XS_MAGIC, 8) != 0) or
+      (version != CHI_XS_VERSION))
+  {
+    chi_log.Log(LOG_0ERROR)
+      << "File \"" << file_name << "\" is not a valid binary "
+      << "cross-section file.";
+    exit(EXIT_FAILURE);
+  }
+
+  //======================================== 1D cross-sections
+  G = static_cast<int>(num_grps_G);
+  L = static_cast<int>(scat_order);
+
+  reader.ReadArray(sigma_tg   , num_grps_G);
+  reader.ReadArray(sigma_fg   , num_grps_G);
+  reader.ReadArray(sigma_captg, num_grps_G);
+  reader.ReadArray(chi_g      , num_grps_G);
+  reader.ReadArray(nu_sigma_fg, num_grps_G);
+
+  //======================================== Transfer matrices
+  transfer_matrix.clear();
+  if (not reader.failed)
+    transfer_matrix.resize(num_moments,
+                           chi_math::SparseMatrix(num_grps_G,num_grps_G));
+
+  for (auto& matrix : transfer_matrix)
+    for (size_t g=0; g<num_grps_G; ++g)
+    {
+      auto num_entries = reader.Read<uint64_t>();
+      reader.ReadArray(matrix.rowI_indices[g], num_entries);
+      reader.ReadArray(matrix.rowI_values[g] , num_entries);
+    }
+
+  if (reader.failed)
+  {
+    chi_log.Log(LOG_0ERROR)
+      << "Binary cross-section file \"" << file_name << "\" is truncated.";
+    exit(EXIT_FAILURE);
+  }
+
+  diffusion_initialized = false;
+  scattering_initialized = false;
+}
+
+//###################################################################
+/**Writes the cross-section to a binary cross-section file. Only the
+ * home location of team 0 writes.*/
+void chi_physics::TransportCrossSections::
+  ExportToChiXSFile(const std::string &file_name) const
+{
+  if (chi_mpi.world_location_id != 0) return;
+
+  std::vector<char> buffer;
+
+  PackArray(buffer, std::vector<char>(CHI_XS_MAGIC, CHI_XS_MAGIC + 8));
+  PackValue(buffer, CHI_XS_VERSION);
+  PackValue(buffer, static_cast<uint64_t>(G));
+  PackValue(buffer, static_cast<uint64_t>(L));
+  PackValue(buffer, static_cast<uint64_t>(transfer_matrix.size()));
+
+  //======================================== 1D cross-sections
+  //Padded with zeros for cross-sections that were never set
+  for (auto xs : {&sigma_tg, &sigma_fg, &sigma_captg, &chi_g, &nu_sigma_fg})
+  {
+    std::vector<double> values(G,0.0);
+    std::copy(xs->begin(), xs->begin() + std::min<size_t>(xs->size(),G),
+              values.begin());
+    PackArray(buffer, values);
+  }
+
+  //======================================== Transfer matrices
+  for (auto& matrix : transfer_matrix)
+    for (int g=0; g<G; ++g)
+    {
+      uint64_t num_entries = matrix.rowI_indices[g].size();
+      PackValue(buffer, num_entries);
+      PackArray(buffer, std::vector<uint64_t>(matrix.rowI_indices[g].begin(),
+                                              matrix.rowI_indices[g].end()));
+      PackArray(buffer, matrix.rowI_values[g]);
+    }
+
+  std::ofstream file(file_name, std::ios::out | std::ios::binary);
+  if (!file.is_open())
+  {
+    chi_log.Log(LOG_0ERROR)
+      << "Failed to open file \"" << file_name << "\" in call to "
+      << "TransportCrossSections::ExportToChiXSFile";
+    exit(EXIT_FAILURE);
+  }
+  file.write(buffer.data(), buffer.size());
+  file.close();
+
+  chi_log.Log(LOG_0)
+    << "Exported binary cross-section file \"" << file_name << "\"";
+}
+
+//###################################################################
+/**Computes a hash of the cross-section data, used to find identical
+ * cross-sections.*/
+uint64_t chi_physics::TransportCrossSections::ComputeContentHash() const
+{
+  uint64_t hash = 14695981039346656037ULL;
+
+  HashBytes(hash, &G, sizeof(int));
+  HashBytes(hash, &L, sizeof(int));
+  HashArray(hash, sigma_tg);
+  HashArray(hash, sigma_fg);
+  HashArray(hash, sigma_captg);
+  HashArray(hash, chi_g);
+  HashArray(hash, nu_sigma_fg);
+
+  for (auto& matrix : transfer_matrix)
+    for (size_t i=0; i<matrix.NumRows(); ++i)
+    {
+      HashArray(hash, matrix.rowI_indices[i]);
+      HashArray(hash, matrix.rowI_values[i]);
+    }
+
+  return hash;
+}
+
+//###################################################################
+/**Compares the cross-section data of two cross-sections exactly.*/
+bool chi_physics::TransportCrossSections::
+  HasSameContent(const TransportCrossSections& other) const
+{
+  if ((G != other.G) or (L != other.L) or
+      (sigma_tg    != other.sigma_tg)    or
+      (sigma_fg    != other.sigma_fg)    or
+      (sigma_captg != other.sigma_captg) or
+      (chi_g       != other.chi_g)       or
+      (nu_sigma_fg != other.nu_sigma_fg) or
+      (transfer_matrix.size() != other.transfer_matrix.size()))
+    return false;
+
+  for (size_t m=0; m<transfer_matrix.size(); ++m)
+  {
+    if ((transfer_matrix[m].rowI_indices !=
+         other.transfer_matrix[m].rowI_indices) or
+        (transfer_matrix[m].rowI_values !=
+         other.transfer_matrix[m].rowI_values))
+      return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,38 @@
+#include "ChiPhysics/PhysicsMaterial/property10_transportxsections.h"
+
+//###################################################################
+/**Makes these cross-sections the adjoint of forward cross-sections.
+ *
+ * The transfer matrices are transposed, i.e., the adjoint transfer from
+ * g' to g is the forward transfer from g to g'. The fission spectrum and
+ * nu-sigma_f are exchanged, which transposes the rank-one fission
+ * matrix \f$ \chi_g \nu\sigma_{f,g'} \f$. Derived diffusion and scattering
+ * data is recomputed from the adjoint data when requested.*/
+void chi_physics::TransportCrossSections::
+  MakeAdjoint(const TransportCrossSections& forward)
+{
+  G = forward.G;
+  L = forward.L;
+
+  sigma_tg    = forward.sigma_tg;
+  sigma_fg    = forward.sigma_fg;
+  sigma_captg = forward.sigma_captg;
+  chi_g       = forward.nu_sigma_fg;
+  nu_sigma_fg = forward.chi_g;
+
+  transfer_matrix.clear();
+  for (const auto& forward_matrix : forward.transfer_matrix)
+  {
+    chi_math::SparseMatrix adjoint_matrix(forward_matrix.NumCols(),
+                                          forward_matrix.NumRows());
+    for (size_t g=0; g<forward_matrix.rowI_indices.size(); g++)
+      for (size_t t=0; t<forward_matrix.rowI_indices[g].size(); t++)
+        adjoint_matrix.Insert(forward_matrix.rowI_indices[g][t],g,
+                              forward_matrix.rowI_values[g][t]);
+
+    transfer_matrix.push_back(adjoint_matrix);
+  }
+
+  diffusion_initialized = false;
+  scattering_initialized = false;
+}
@@ -2,6 +2,8 @@
 #define CHI_PHYSICS_H
 
 #include<iostream>
+#include<map>
+#include<cstdint>
 
 
 #include "SolverBase/chi_solver.h"
@@ -23,6 +25,18 @@ class ChiPhysics
   std::vector<chi_physics::TransportCrossSections*> trnsprt_xs_stack;
   std::vector<chi_physics::FieldFunction*> fieldfunc_stack;
 
+  /**Cross-sections loaded from files, indexed by content hash. Entries
+   * may be shared by several materials and handles and must not be
+   * modified.*/
+  std::multimap<uint64_t,chi_physics::TransportCrossSections*>
+                                           shared_xs_index;
+
+  /**Materials assigned a cross-section handle with the EXISTING
+   * operation, indexed by handle. Pairs of material and property
+   * location.*/
+  std::multimap<int,std::pair<chi_physics::Material*,int>>
+                                           xs_handle_bindings;
+
 	public:
 	//00
 			ChiPhysics() noexcept;
@@ -31,6 +45,17 @@ class ChiPhysics
 	void	RunPhysicsLoop();
 	//02
 	void    PrintPerformanceData(char* fileName);
+  //03
+  chi_physics::TransportCrossSections*
+          DeduplicateTransportXS(chi_physics::TransportCrossSections* xs);
+  bool    IsSharedTransportXS(chi_physics::TransportCrossSections* xs);
+  void    BindTransportXSHandle(int handle,
+                                chi_physics::Material* material,
+                                int property_location);
+  void    UnbindTransportXSHandle(chi_physics::Material* material,
+                                  int property_location);
+  void    ReplaceHandleTransportXS(int handle,
+                                   chi_physics::TransportCrossSections* xs);
 
 };
 
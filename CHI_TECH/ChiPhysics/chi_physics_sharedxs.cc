@@ -0,0 +1,107 @@
+#include "chi_physics.h"
+#include "PhysicsMaterial/property10_transportxsections.h"
+
+#include <chi_log.h>
+extern ChiLog chi_log;
+
+//###################################################################
+/**Looks for a previously loaded cross-section with identical data.
+ * If one exists, all references to the given cross-section, in the
+ * materials and in the cross-section stack, are replaced by the
+ * existing one, the given cross-section is deleted and the existing
+ * one is returned. Otherwise the given cross-section is registered as
+ * shared and returned.
+ *
+ * This is used for cross-sections loaded from files so that large
+ * libraries with many identical materials only store one copy of the
+ * data. Shared cross-sections must not be modified afterwards.*/
+chi_physics::TransportCrossSections* ChiPhysics::
+  DeduplicateTransportXS(chi_physics::TransportCrossSections* xs)
+{
+  uint64_t hash = xs->ComputeContentHash();
+
+  auto range = shared_xs_index.equal_range(hash);
+  for (auto it=range.first; it!=range.second; ++it)
+  {
+    auto existing = it->second;
+    if (existing == xs) return xs;
+    if (not existing->HasSameContent(*xs)) continue;
+
+    for (auto material : material_stack)
+      for (auto& property : material->properties)
+        if (property == xs) property = existing;
+
+    for (auto& stack_xs : trnsprt_xs_stack)
+      if (stack_xs == xs) stack_xs = existing;
+
+    delete xs;
+
+    chi_log.Log(LOG_0VERBOSE_1)
+      << "Cross-section data identical to an already loaded "
+      << "cross-section. The data will be shared.";
+
+    return existing;
+  }
+
+  shared_xs_index.emplace(hash, xs);
+  return xs;
+}
+
+//###################################################################
+/**Determines whether a cross-section is shared and therefore
+ * immutable.*/
+bool ChiPhysics::IsSharedTransportXS(chi_physics::TransportCrossSections* xs)
+{
+  for (auto& entry : shared_xs_index)
+    if (entry.second == xs) return true;
+
+  return false;
+}
+
+//###################################################################
+/**Records that a material property was assigned the cross-section of a
+ * handle, replacing any previous assignment of the property.*/
+void ChiPhysics::BindTransportXSHandle(int handle,
+                                       chi_physics::Material* material,
+                                       int property_location)
+{
+  UnbindTransportXSHandle(material,property_location);
+  xs_handle_bindings.emplace(handle,
+                             std::make_pair(material,property_location));
+}
+
+//###################################################################
+/**Removes the handle assignment of a material property, if any.*/
+void ChiPhysics::UnbindTransportXSHandle(chi_physics::Material* material,
+                                         int property_location)
+{
+  for (auto it=xs_handle_bindings.begin(); it!=xs_handle_bindings.end();)
+  {
+    if ((it->second.first == material) and
+        (it->second.second == property_location))
+      it = xs_handle_bindings.erase(it);
+    else
+      ++it;
+  }
+}
+
+//###################################################################
+/**Replaces the cross-section of a handle, e.g., before modifying a
+ * shared one. The materials that were assigned the handle and still use
+ * its cross-section are rebound to the new one. Other handles and
+ * materials sharing the old cross-section are left unchanged.*/
+void ChiPhysics::
+  ReplaceHandleTransportXS(int handle,
+                           chi_physics::TransportCrossSections* xs)
+{
+  auto old_xs = trnsprt_xs_stack[handle];
+
+  auto range = xs_handle_bindings.equal_range(handle);
+  for (auto it=range.first; it!=range.second; ++it)
+  {
+    auto& property = it->second.first->properties[it->second.second];
+    if (property == old_xs) property = xs;
+  }
+
+  trnsprt_xs_stack[handle] = xs;
+}
@@ -240,6 +240,13 @@ an additional text field can be supplied specifying the transfer matrix to
 
 ####_
 
+CHI_XSFILE\n
+Loads transport cross-sections from a binary cross-section file as written
+by chiPhysicsTransportXSExportToChiXSFile. Expects to be followed by the
+filepath. Binary files load considerably faster than PDT files.
+
+####_
+
 EXISTING\n
 Supply handle to an existing cross-section and simply swap them out.
 
@@ -421,6 +428,18 @@ int chiPhysicsMaterialSetProperty(lua_State *L)
       auto prop = (chi_physics::TransportCrossSections*)
                   cur_material->properties[location_of_prop];
 
+      //========================== Never modify shared cross-sections
+      if (chi_physics_handler.IsSharedTransportXS(prop) and
+          (operation_index != static_cast<int>(OpType::EXISTING)))
+      {
+        auto new_prop = new chi_physics::TransportCrossSections;
+        new_prop->property_name = prop->property_name;
+        prop = new_prop;
+        cur_material->properties[location_of_prop] = prop;
+        chi_physics_handler.UnbindTransportXSHandle(cur_material,
+                                                    location_of_prop);
+      }
+
       //========================== Process operation
       if (operation_index == static_cast<int>(OpType::SIMPLEXS0))
       {
@@ -455,6 +474,17 @@ int chiPhysicsMaterialSetProperty(lua_State *L)
           MT_TRANSFER = std::string(lua_tostring(L,5));
 
         prop->MakeFromPDTxsFile(std::string(file_name_c),MT_TRANSFER);
+        chi_physics_handler.DeduplicateTransportXS(prop);
+      }
+      else if (operation_index == static_cast<int>(OpType::CHI_XSFILE))
+      {
+        if (numArgs != 4)
+          LuaPostArgAmountError("chiPhysicsMaterialSetProperty",4,numArgs);
+
+        const char* file_name_c = lua_tostring(L,4);
+
+        prop->MakeFromChiXSFile(std::string(file_name_c));
+        chi_physics_handler.DeduplicateTransportXS(prop);
       }
       else if (operation_index == static_cast<int>(OpType::EXISTING))
       {
@@ -478,6 +508,8 @@ int chiPhysicsMaterialSetProperty(lua_State *L)
         prop = xs;
 
         cur_material->properties[location_of_prop] = prop;
+        chi_physics_handler.BindTransportXSHandle(handle,cur_material,
+                                                  location_of_prop);
 
 //        delete old_prop; //Still debating if this should be deleted
       }
@@ -750,6 +782,21 @@ will attempt to build a transfer matrix from reaction type MT 2501, however,
 an additional text field can be supplied specifying the transfer matrix to
  use.
 
+####_
+
+CHI_XSFILE\n
+Loads transport cross-sections from a binary cross-section file as written
+by chiPhysicsTransportXSExportToChiXSFile. Expects to be followed by the
+filepath.
+
+Cross-sections loaded from files are compared with all previously loaded
+ones. Identical cross-sections are stored only once and shared by all
+handles and materials referring to them.
+
+Materials that were assigned the handle with the EXISTING operation use
+the new data. Handles and materials that only shared identical data with
+the handle are not changed.
+
 ##_
 ### Example\n
 Example lua code:
@@ -789,6 +836,15 @@ int chiPhysicsTransportXSSet(lua_State* L)
     exit(EXIT_FAILURE);
   }
 
+  //========================== Never modify shared cross-sections
+  if (chi_physics_handler.IsSharedTransportXS(xs))
+  {
+    auto new_xs = new chi_physics::TransportCrossSections;
+    new_xs->property_name = xs->property_name;
+    chi_physics_handler.ReplaceHandleTransportXS(handle,new_xs);
+    xs = new_xs;
+  }
+
   //========================== Process operation
   using OpType = chi_physics::OperationType;
   if (operation_index == static_cast<int>(OpType::SIMPLEXS0))
@@ -824,6 +880,17 @@ int chiPhysicsTransportXSSet(lua_State* L)
       MT_TRANSFER = std::string(lua_tostring(L,4));
 
     xs->MakeFromPDTxsFile(std::string(file_name_c),MT_TRANSFER);
+    chi_physics_handler.DeduplicateTransportXS(xs);
+  }
+  else if (operation_index == static_cast<int>(OpType::CHI_XSFILE))
+  {
+    if (num_args != 3)
+      LuaPostArgAmountError("chiPhysicsTransportXSSet",3,num_args);
+
+    const char* file_name_c = lua_tostring(L,3);
+
+    xs->MakeFromChiXSFile(std::string(file_name_c));
+    chi_physics_handler.DeduplicateTransportXS(xs);
   }
   else
   {
@@ -937,4 +1004,51 @@ int chiPhysicsTransportXSMakeCombined(lua_State* L)
   lua_pushnumber(L,chi_physics_handler.trnsprt_xs_stack.size()-1);
 
   return 1;
-}
\ No newline at end of file
+}
+//###################################################################
+/**Writes a transport cross-section to a binary cross-section file that
+ * can be loaded with the CHI_XSFILE operation. This is the converter
+ * for PDT cross-section files.
+ *
+ * \param XS_handle int Handle to the cross-section to be exported.
+ * \param FileName char Name of the binary file to write.
+ *
+ * ##_
+ *
+###Example:\n
+\code
+xs = chiPhysicsTransportXSCreate()
+chiPhysicsTransportXSSet(xs,PDT_XSFILE,"xs_3_170.data")
+chiPhysicsTransportXSExportToChiXSFile(xs,"xs_3_170.cxs")
+\endcode
+ *
+ * \ingroup LuaPhysicsMaterials
+ * */
+int chiPhysicsTransportXSExportToChiXSFile(lua_State* L)
+{
+  int num_args = lua_gettop(L);
+  if (num_args != 2)
+    LuaPostArgAmountError("chiPhysicsTransportXSExportToChiXSFile",2,num_args);
+
+  LuaCheckNilValue("chiPhysicsTransportXSExportToChiXSFile",L,1);
+  LuaCheckNilValue("chiPhysicsTransportXSExportToChiXSFile",L,2);
+
+  int handle = lua_tonumber(L,1);
+  const char* file_name_c = lua_tostring(L,2);
+
+  chi_physics::TransportCrossSections* xs;
+  try {
+    xs = chi_physics_handler.trnsprt_xs_stack.at(handle);
+  }
+  catch(const std::out_of_range& o){
+    chi_log.Log(LOG_ALLERROR)
+      << "ERROR: Invalid cross-section handle"
+      << " in call to chiPhysicsTransportXSExportToChiXSFile."
+      << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  xs->ExportToChiXSFile(std::string(file_name_c));
+
+  return 0;
+}
@@ -82,6 +82,24 @@ void ChiTech::ParseArguments(int argc, char** argv)
       }
 
     }//-v
+    //================================================ Process teams
+    if (argument == "-teams")
+    {
+      int num_teams = 0;
+      if ((i+1) < argc)
+      {
+        try {num_teams = std::stoi(std::string(argv[i+1]));}
+        catch (const std::invalid_argument& e) {num_teams = 0;}
+      }
+      if (num_teams < 1)
+      {
+        std::cerr << "Invalid option used with command line argument "
+                     "-teams. Must be a positive integer."
+                  << std::endl;
+        exit(EXIT_FAILURE);
+      }
+      chi_mpi.num_teams = num_teams;
+    }//-teams
   }//for argument
 }
 
@@ -100,12 +118,15 @@ int ChiTech::Initialize(int argc, char** argv)
   MPI_Comm_rank (MPI_COMM_WORLD, &location_id);      /* get current process id */
   MPI_Comm_size (MPI_COMM_WORLD, &number_processes); /* get number of processes */
 
-  chi_mpi.location_id = location_id;
-  chi_mpi.process_count = number_processes;
+  chi_mpi.world_location_id = location_id;
+  chi_mpi.world_process_count = number_processes;
+  chi_mpi.SplitTeams();
 
-  chi_console.PostMPIInfo(location_id, number_processes);
+  chi_console.PostMPIInfo(chi_mpi.location_id, chi_mpi.process_count);
   chi_mpi.Initialize();
 
+  //PETSc objects only ever span a team
+  PETSC_COMM_WORLD = chi_mpi.comm;
   chi_physics_handler.InitPetSc(argc,argv);
 
   return 0;
@@ -127,7 +148,10 @@ int ChiTech::RunInteractive(int argc, char** argv)
   chi_log.Log(LOG_0)
     << chi_program_timer.GetLocalDateTimeString()
     << " Running ChiTech in interactive-mode with "
-    << chi_mpi.process_count << " processes.";
+    << chi_mpi.world_process_count << " processes"
+    << ((chi_mpi.num_teams > 1)?
+        " in " + std::to_string(chi_mpi.num_teams) +
+        " teams." : std::string("."));
 
   chi_log.Log(LOG_0)
     << "ChiTech number of arguments supplied: "
@@ -155,7 +179,10 @@ int ChiTech::RunBatch(int argc, char** argv)
   chi_log.Log(LOG_0)
     << chi_program_timer.GetLocalDateTimeString()
     << " Running ChiTech in batch-mode with "
-    << chi_mpi.process_count << " processes.";
+    << chi_mpi.world_process_count << " processes"
+    << ((chi_mpi.num_teams > 1)?
+        " in " + std::to_string(chi_mpi.num_teams) +
+        " teams." : std::string("."));
 
   chi_log.Log(LOG_0)
     << "ChiTech number of arguments supplied: "
@@ -166,6 +193,8 @@ int ChiTech::RunBatch(int argc, char** argv)
       << "\nUsage: exe inputfile [options values]\n"
       << "\n"
       << "     -v    Level of verbosity. Default 0. Can be either 0, 1 or 2.\n"
+      << "     -teams n  Number of process teams for angular or energy\n"
+      << "               decomposition. Default 1.\n"
       << "     a=b   Executes argument as a lua string.\n\n\n";
 
   int error_code = 0;
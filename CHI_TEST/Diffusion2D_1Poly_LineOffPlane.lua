@@ -0,0 +1,107 @@
+print("############################################### LuaTest")
+--dofile(CHI_LIBRARY)
+
+-- Samples a 2D solution with line interpolators in the plane of the mesh
+-- and off it. Points off the plane must be located by their projection
+-- onto the mesh, hence both lines must give the same values.
+
+--############################################### Setup mesh
+chiMeshHandlerCreate()
+
+newSurfMesh = chiSurfaceMeshCreate();
+chiSurfaceMeshImportFromOBJFile(newSurfMesh,
+        "CHI_RESOURCES/TestObjects/SquareMesh2x2Quads.obj",true)
+
+--############################################### Extract edges from surface mesh
+loops,loop_count = chiSurfaceMeshGetEdgeLoopsPoly(newSurfMesh)
+
+line_mesh = {};
+line_mesh_count = 0;
+
+for k=1,loop_count do
+    split_loops,split_count = chiEdgeLoopSplitByAngle(loops,k-1);
+    for m=1,split_count do
+        line_mesh_count = line_mesh_count + 1;
+        line_mesh[line_mesh_count] =
+        chiLineMeshCreateFromLoop(split_loops,m-1);
+    end
+
+end
+
+--############################################### Setup Regions
+region1 = chiRegionCreate()
+chiRegionAddSurfaceBoundary(region1,newSurfMesh);
+for k=1,line_mesh_count do
+    chiRegionAddLineBoundary(region1,line_mesh[k]);
+end
+
+--############################################### Create meshers
+chiSurfaceMesherCreate(SURFACEMESHER_PREDEFINED);
+chiVolumeMesherCreate(VOLUMEMESHER_PREDEFINED2D);
+
+chiVolumeMesherSetProperty(FORCE_POLYGONS,true);
+
+--############################################### Execute meshing
+chiSurfaceMesherExecute();
+chiVolumeMesherExecute();
+
+--############################################### Set Material IDs
+vol0 = chiLogicalVolumeCreate(RPP,-1000,1000,-1000,1000,-1000,1000)
+chiVolumeMesherSetProperty(MATID_FROMLOGICAL,vol0,0)
+
+
+--############################################### Add materials
+materials = {}
+materials[0] = chiPhysicsAddMaterial("Test Material");
+
+chiPhysicsMaterialAddProperty(materials[0],SCALAR_VALUE)
+chiPhysicsMaterialSetProperty(materials[0],SCALAR_VALUE,SINGLE_VALUE,1.0)
+
+
+
+--############################################### Setup Physics
+phys1 = chiDiffusionCreateSolver();
+chiSolverAddRegion(phys1,region1)
+chiDiffusionSetProperty(phys1,DISCRETIZATION_METHOD,PWLC);
+chiDiffusionSetProperty(phys1,RESIDUAL_TOL,1.0e-4)
+
+--############################################### Initialize Solver
+chiDiffusionInitialize(phys1)
+fftemp,count = chiGetFieldFunctionList(phys1)
+chiDiffusionExecute(phys1)
+
+--############################################### Line in the mesh plane
+line0 = chiFFInterpolationCreate(LINE)
+chiFFInterpolationSetProperty(line0,LINE_FIRSTPOINT,-1.0,0.1,0.0)
+chiFFInterpolationSetProperty(line0,LINE_SECONDPOINT, 1.0,0.1,0.0)
+chiFFInterpolationSetProperty(line0,LINE_NUMBEROFPOINTS, 100)
+chiFFInterpolationSetProperty(line0,ADD_FIELDFUNCTION,fftemp[1])
+
+chiFFInterpolationInitialize(line0)
+chiFFInterpolationExecute(line0)
+
+--############################################### Line off the mesh plane
+line1 = chiFFInterpolationCreate(LINE)
+chiFFInterpolationSetProperty(line1,LINE_FIRSTPOINT,-1.0,0.1,0.5)
+chiFFInterpolationSetProperty(line1,LINE_SECONDPOINT, 1.0,0.1,0.5)
+chiFFInterpolationSetProperty(line1,LINE_NUMBEROFPOINTS, 100)
+chiFFInterpolationSetProperty(line1,ADD_FIELDFUNCTION,fftemp[1])
+
+chiFFInterpolationInitialize(line1)
+chiFFInterpolationExecute(line1)
+
+--############################################### Compare
+values0 = chiFFInterpolationGetValue(line0)
+values1 = chiFFInterpolationGetValue(line1)
+
+max_value = 0.0
+max_diff  = 0.0
+for k=1,#values0 do
+    max_value = math.max(max_value,math.abs(values0[k]))
+    max_diff  = math.max(max_diff,math.abs(values0[k]-values1[k]))
+end
+if (max_value == 0.0) then
+    max_diff = 1.0
+end
+
+chiLog(LOG_0,string.format("Line-difference=%.5e", max_diff))
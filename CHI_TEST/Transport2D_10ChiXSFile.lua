@@ -0,0 +1,146 @@
+-- Binary cross-section files. Cross-sections loaded from a PDT file are
+-- exported to the binary cross-section format and loaded back. The problem
+-- solved with the binary cross-sections must match the one solved with the
+-- PDT cross-sections.
+chiMPIBarrier()
+if (chi_location_id == 0) then
+    print("############################################### LuaTest")
+end
+
+--############################################### Setup mesh
+chiMeshHandlerCreate()
+
+newSurfMesh = chiSurfaceMeshCreate();
+chiSurfaceMeshImportFromOBJFile(newSurfMesh,
+        "CHI_RESOURCES/TestObjects/SquareMesh2x2Quads.obj",true)
+
+--############################################### Setup Regions
+region1 = chiRegionCreate()
+chiRegionAddSurfaceBoundary(region1,newSurfMesh);
+
+--############################################### Create meshers
+chiSurfaceMesherCreate(SURFACEMESHER_PREDEFINED);
+chiVolumeMesherCreate(VOLUMEMESHER_PREDEFINED2D);
+
+chiSurfaceMesherSetProperty(PARTITION_X,2)
+chiSurfaceMesherSetProperty(PARTITION_Y,2)
+chiSurfaceMesherSetProperty(CUT_X,0.0)
+chiSurfaceMesherSetProperty(CUT_Y,0.0)
+
+chiVolumeMesherSetProperty(FORCE_POLYGONS,true);
+
+--############################################### Execute meshing
+chiSurfaceMesherExecute();
+chiVolumeMesherExecute();
+
+--############################################### Set Material IDs
+vol0 = chiLogicalVolumeCreate(RPP,-1000,1000,-1000,1000,-1000,1000)
+chiVolumeMesherSetProperty(MATID_FROMLOGICAL,vol0,0)
+
+--############################################### Add materials
+num_groups = 168
+chixs_file = "CHI_TEST/Transport2D_10ChiXSFile.cxs"
+
+xs_pdt = chiPhysicsTransportXSCreate()
+chiPhysicsTransportXSSet(xs_pdt,PDT_XSFILE,"CHI_TEST/xs_graphite_pure.data")
+chiPhysicsTransportXSExportToChiXSFile(xs_pdt,chixs_file)
+chiMPIBarrier()
+
+materials = {}
+materials[1] = chiPhysicsAddMaterial("Test Material");
+
+chiPhysicsMaterialAddProperty(materials[1],TRANSPORT_XSECTIONS)
+chiPhysicsMaterialAddProperty(materials[1],ISOTROPIC_MG_SOURCE)
+
+src={}
+for g=1,num_groups do
+    src[g] = 0.0
+end
+src[1] = 1.0
+chiPhysicsMaterialSetProperty(materials[1],ISOTROPIC_MG_SOURCE,FROM_ARRAY,src)
+
+pquad = chiCreateProductQuadrature(GAUSS_LEGENDRE_CHEBYSHEV,2,2)
+
+--############################################### Solver factory
+function CreateSolver()
+    local phys = chiLBSCreateSolver()
+    chiSolverAddRegion(phys,region1)
+
+    for g=1,num_groups do
+        chiLBSCreateGroup(phys)
+    end
+
+    local gs = chiLBSCreateGroupset(phys)
+    chiLBSGroupsetAddGroups(phys,gs,0,num_groups-1)
+    chiLBSGroupsetSetQuadrature(phys,gs,pquad)
+    chiLBSGroupsetSetAngleAggDiv(phys,gs,1)
+    chiLBSGroupsetSetGroupSubsets(phys,gs,2)
+    chiLBSGroupsetSetIterativeMethod(phys,gs,NPT_GMRES)
+    chiLBSGroupsetSetResidualTolerance(phys,gs,1.0e-8)
+    chiLBSGroupsetSetMaxIterations(phys,gs,300)
+    chiLBSGroupsetSetGMRESRestartIntvl(phys,gs,100)
+
+    chiLBSSetProperty(phys,PARTITION_METHOD,FROM_SURFACE)
+    chiLBSSetProperty(phys,DISCRETIZATION_METHOD,PWLD3D)
+    chiLBSSetProperty(phys,SCATTERING_ORDER,1)
+
+    chiLBSInitialize(phys)
+    chiLBSExecute(phys)
+
+    return phys
+end
+
+--############################################### Line values of all groups
+function GetLineValues(phys)
+    local fflist,count = chiLBSGetScalarFieldFunctionList(phys)
+    local all_values = {}
+    for g=1,num_groups do
+        local line = chiFFInterpolationCreate(LINE)
+        chiFFInterpolationSetProperty(line,LINE_FIRSTPOINT,-1.0,0.1,0.0)
+        chiFFInterpolationSetProperty(line,LINE_SECONDPOINT, 1.0,0.1,0.0)
+        chiFFInterpolationSetProperty(line,LINE_NUMBEROFPOINTS, 50)
+        chiFFInterpolationSetProperty(line,ADD_FIELDFUNCTION,fflist[g])
+
+        chiFFInterpolationInitialize(line)
+        chiFFInterpolationExecute(line)
+
+        local values = chiFFInterpolationGetValue(line)
+        for k=1,#values do
+            all_values[#all_values+1] = values[k]
+        end
+    end
+    return all_values
+end
+
+--############################################### Relative max difference
+function RelativeDifference(values_a,values_b)
+    local max_value = 0.0
+    local max_diff  = 0.0
+    for k=1,#values_a do
+        max_value = math.max(max_value,math.abs(values_a[k]))
+        max_diff  = math.max(max_diff,math.abs(values_a[k]-values_b[k]))
+    end
+    if (max_value == 0.0) then
+        return 1.0
+    end
+    return max_diff/max_value
+end
+
+--############################################### Solve and compare
+chiPhysicsMaterialSetProperty(materials[1],TRANSPORT_XSECTIONS,
+                              EXISTING,xs_pdt)
+phys_pdt = CreateSolver()
+values_pdt = GetLineValues(phys_pdt)
+
+chiPhysicsMaterialSetProperty(materials[1],TRANSPORT_XSECTIONS,
+                              CHI_XSFILE,chixs_file)
+phys_chixs = CreateSolver()
+values_chixs = GetLineValues(phys_chixs)
+
+chiLog(LOG_0,string.format("ChiXSFile-difference=%.5e",
+                           RelativeDifference(values_pdt,values_chixs)))
+
+chiMPIBarrier()
+if (chi_location_id == 0) then
+    os.remove(chixs_file)
+end
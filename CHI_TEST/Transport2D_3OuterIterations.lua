@@ -0,0 +1,151 @@
+-- Multigroup outer iterations. A problem with upscattering is solved once
+-- with all groups in a single groupset and again with the groups split
+-- over two groupsets, coupled with Gauss-Seidel and with Jacobi outer
+-- iterations. The split solutions must match the single groupset one.
+chiMPIBarrier()
+if (chi_location_id == 0) then
+    print("############################################### LuaTest")
+end
+
+--############################################### Setup mesh
+chiMeshHandlerCreate()
+
+newSurfMesh = chiSurfaceMeshCreate();
+chiSurfaceMeshImportFromOBJFile(newSurfMesh,
+        "CHI_RESOURCES/TestObjects/SquareMesh2x2Quads.obj",true)
+
+--############################################### Setup Regions
+region1 = chiRegionCreate()
+chiRegionAddSurfaceBoundary(region1,newSurfMesh);
+
+--############################################### Create meshers
+chiSurfaceMesherCreate(SURFACEMESHER_PREDEFINED);
+chiVolumeMesherCreate(VOLUMEMESHER_PREDEFINED2D);
+
+chiSurfaceMesherSetProperty(PARTITION_X,2)
+chiSurfaceMesherSetProperty(PARTITION_Y,2)
+chiSurfaceMesherSetProperty(CUT_X,0.0)
+chiSurfaceMesherSetProperty(CUT_Y,0.0)
+
+chiVolumeMesherSetProperty(FORCE_POLYGONS,true);
+
+--############################################### Execute meshing
+chiSurfaceMesherExecute();
+chiVolumeMesherExecute();
+
+--############################################### Set Material IDs
+vol0 = chiLogicalVolumeCreate(RPP,-1000,1000,-1000,1000,-1000,1000)
+chiVolumeMesherSetProperty(MATID_FROMLOGICAL,vol0,0)
+
+--############################################### Add materials
+num_groups = 6
+
+materials = {}
+materials[1] = chiPhysicsAddMaterial("Test Material");
+
+chiPhysicsMaterialAddProperty(materials[1],TRANSPORT_XSECTIONS)
+chiPhysicsMaterialAddProperty(materials[1],ISOTROPIC_MG_SOURCE)
+
+-- SIMPLEXS1 upscatters into the upper half of the groups, so group 5
+-- feeds group 4 and the two groupsets below are coupled both ways.
+chiPhysicsMaterialSetProperty(materials[1],TRANSPORT_XSECTIONS,
+                              SIMPLEXS1,num_groups,1.0,0.9)
+
+src={}
+for g=1,num_groups do
+    src[g] = 0.0
+end
+src[1] = 1.0
+chiPhysicsMaterialSetProperty(materials[1],ISOTROPIC_MG_SOURCE,FROM_ARRAY,src)
+
+pquad = chiCreateProductQuadrature(GAUSS_LEGENDRE_CHEBYSHEV,2,2)
+
+--############################################### Solver factory
+function CreateSolver(group_ranges,outer_scheme)
+    local phys = chiLBSCreateSolver()
+    chiSolverAddRegion(phys,region1)
+
+    for g=1,num_groups do
+        chiLBSCreateGroup(phys)
+    end
+
+    for _,range in pairs(group_ranges) do
+        local gs = chiLBSCreateGroupset(phys)
+        chiLBSGroupsetAddGroups(phys,gs,range[1],range[2])
+        chiLBSGroupsetSetQuadrature(phys,gs,pquad)
+        chiLBSGroupsetSetAngleAggDiv(phys,gs,1)
+        chiLBSGroupsetSetGroupSubsets(phys,gs,1)
+        chiLBSGroupsetSetIterativeMethod(phys,gs,NPT_GMRES)
+        chiLBSGroupsetSetResidualTolerance(phys,gs,1.0e-10)
+        chiLBSGroupsetSetMaxIterations(phys,gs,300)
+        chiLBSGroupsetSetGMRESRestartIntvl(phys,gs,100)
+    end
+
+    chiLBSSetProperty(phys,PARTITION_METHOD,FROM_SURFACE)
+    chiLBSSetProperty(phys,DISCRETIZATION_METHOD,PWLD3D)
+    chiLBSSetProperty(phys,SCATTERING_ORDER,0)
+
+    if (outer_scheme ~= nil) then
+        chiLBSSetProperty(phys,OUTER_SCHEME,outer_scheme)
+        chiLBSSetProperty(phys,MAX_OUTER_ITERATIONS,500)
+        chiLBSSetProperty(phys,OUTER_TOLERANCE,1.0e-10)
+    end
+
+    chiLBSInitialize(phys)
+    chiLBSExecute(phys)
+
+    return phys
+end
+
+--############################################### Line values of all groups
+function GetLineValues(phys)
+    local fflist,count = chiLBSGetScalarFieldFunctionList(phys)
+    local all_values = {}
+    for g=1,num_groups do
+        local line = chiFFInterpolationCreate(LINE)
+        chiFFInterpolationSetProperty(line,LINE_FIRSTPOINT,-1.0,0.1,0.0)
+        chiFFInterpolationSetProperty(line,LINE_SECONDPOINT, 1.0,0.1,0.0)
+        chiFFInterpolationSetProperty(line,LINE_NUMBEROFPOINTS, 50)
+        chiFFInterpolationSetProperty(line,ADD_FIELDFUNCTION,fflist[g])
+
+        chiFFInterpolationInitialize(line)
+        chiFFInterpolationExecute(line)
+
+        local values = chiFFInterpolationGetValue(line)
+        for k=1,#values do
+            all_values[#all_values+1] = values[k]
+        end
+    end
+    return all_values
+end
+
+--############################################### Relative max difference
+function RelativeDifference(values_a,values_b)
+    local max_value = 0.0
+    local max_diff  = 0.0
+    for k=1,#values_a do
+        max_value = math.max(max_value,math.abs(values_a[k]))
+        max_diff  = math.max(max_diff,math.abs(values_a[k]-values_b[k]))
+    end
+    if (max_value == 0.0) then
+        return 1.0
+    end
+    return max_diff/max_value
+end
+
+--############################################### Solve and compare
+phys_ref = CreateSolver({{0,num_groups-1}},nil)
+values_ref = GetLineValues(phys_ref)
+
+phys_gs = CreateSolver({{0,num_groups-2},{num_groups-1,num_groups-1}},
+                       OUTER_GAUSS_SEIDEL)
+values_gs = GetLineValues(phys_gs)
+
+phys_jac = CreateSolver({{0,num_groups-2},{num_groups-1,num_groups-1}},
+                        OUTER_JACOBI)
+values_jac = GetLineValues(phys_jac)
+
+chiLog(LOG_0,string.format("GS-difference=%.5e",
+                           RelativeDifference(values_ref,values_gs)))
+chiLog(LOG_0,string.format("Jacobi-difference=%.5e",
+                           RelativeDifference(values_ref,values_jac)))
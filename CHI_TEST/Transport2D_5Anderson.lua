@@ -0,0 +1,148 @@
+-- Anderson acceleration of the within-groupset iterations. The same problem
+-- is solved with GMRES, classic Richardson and Anderson acceleration, the
+-- latter with the default depth and with a damped depth-3 variant. All
+-- solutions must match the GMRES reference.
+chiMPIBarrier()
+if (chi_location_id == 0) then
+    print("############################################### LuaTest")
+end
+
+--############################################### Setup mesh
+chiMeshHandlerCreate()
+
+newSurfMesh = chiSurfaceMeshCreate();
+chiSurfaceMeshImportFromOBJFile(newSurfMesh,
+        "CHI_RESOURCES/TestObjects/SquareMesh2x2Quads.obj",true)
+
+--############################################### Setup Regions
+region1 = chiRegionCreate()
+chiRegionAddSurfaceBoundary(region1,newSurfMesh);
+
+--############################################### Create meshers
+chiSurfaceMesherCreate(SURFACEMESHER_PREDEFINED);
+chiVolumeMesherCreate(VOLUMEMESHER_PREDEFINED2D);
+
+chiSurfaceMesherSetProperty(PARTITION_X,2)
+chiSurfaceMesherSetProperty(PARTITION_Y,2)
+chiSurfaceMesherSetProperty(CUT_X,0.0)
+chiSurfaceMesherSetProperty(CUT_Y,0.0)
+
+chiVolumeMesherSetProperty(FORCE_POLYGONS,true);
+
+--############################################### Execute meshing
+chiSurfaceMesherExecute();
+chiVolumeMesherExecute();
+
+--############################################### Set Material IDs
+vol0 = chiLogicalVolumeCreate(RPP,-1000,1000,-1000,1000,-1000,1000)
+chiVolumeMesherSetProperty(MATID_FROMLOGICAL,vol0,0)
+
+--############################################### Add materials
+num_groups = 6
+
+materials = {}
+materials[1] = chiPhysicsAddMaterial("Test Material");
+
+chiPhysicsMaterialAddProperty(materials[1],TRANSPORT_XSECTIONS)
+chiPhysicsMaterialAddProperty(materials[1],ISOTROPIC_MG_SOURCE)
+
+chiPhysicsMaterialSetProperty(materials[1],TRANSPORT_XSECTIONS,
+                              SIMPLEXS1,num_groups,1.0,0.9)
+
+src={}
+for g=1,num_groups do
+    src[g] = 0.0
+end
+src[1] = 1.0
+chiPhysicsMaterialSetProperty(materials[1],ISOTROPIC_MG_SOURCE,FROM_ARRAY,src)
+
+pquad = chiCreateProductQuadrature(GAUSS_LEGENDRE_CHEBYSHEV,2,2)
+
+--############################################### Solver factory
+function CreateSolver(method,anderson_depth,anderson_damping)
+    local phys = chiLBSCreateSolver()
+    chiSolverAddRegion(phys,region1)
+
+    for g=1,num_groups do
+        chiLBSCreateGroup(phys)
+    end
+
+    local gs = chiLBSCreateGroupset(phys)
+    chiLBSGroupsetAddGroups(phys,gs,0,num_groups-1)
+    chiLBSGroupsetSetQuadrature(phys,gs,pquad)
+    chiLBSGroupsetSetAngleAggDiv(phys,gs,1)
+    chiLBSGroupsetSetGroupSubsets(phys,gs,1)
+    chiLBSGroupsetSetIterativeMethod(phys,gs,method)
+    chiLBSGroupsetSetResidualTolerance(phys,gs,1.0e-10)
+    chiLBSGroupsetSetMaxIterations(phys,gs,1000)
+    chiLBSGroupsetSetGMRESRestartIntvl(phys,gs,100)
+    if (anderson_depth ~= nil) then
+        chiLBSGroupsetSetAndersonParameters(phys,gs,
+                                            anderson_depth,anderson_damping)
+    end
+
+    chiLBSSetProperty(phys,PARTITION_METHOD,FROM_SURFACE)
+    chiLBSSetProperty(phys,DISCRETIZATION_METHOD,PWLD3D)
+    chiLBSSetProperty(phys,SCATTERING_ORDER,0)
+
+    chiLBSInitialize(phys)
+    chiLBSExecute(phys)
+
+    return phys
+end
+
+--############################################### Line values of all groups
+function GetLineValues(phys)
+    local fflist,count = chiLBSGetScalarFieldFunctionList(phys)
+    local all_values = {}
+    for g=1,num_groups do
+        local line = chiFFInterpolationCreate(LINE)
+        chiFFInterpolationSetProperty(line,LINE_FIRSTPOINT,-1.0,0.1,0.0)
+        chiFFInterpolationSetProperty(line,LINE_SECONDPOINT, 1.0,0.1,0.0)
+        chiFFInterpolationSetProperty(line,LINE_NUMBEROFPOINTS, 50)
+        chiFFInterpolationSetProperty(line,ADD_FIELDFUNCTION,fflist[g])
+
+        chiFFInterpolationInitialize(line)
+        chiFFInterpolationExecute(line)
+
+        local values = chiFFInterpolationGetValue(line)
+        for k=1,#values do
+            all_values[#all_values+1] = values[k]
+        end
+    end
+    return all_values
+end
+
+--############################################### Relative max difference
+function RelativeDifference(values_a,values_b)
+    local max_value = 0.0
+    local max_diff  = 0.0
+    for k=1,#values_a do
+        max_value = math.max(max_value,math.abs(values_a[k]))
+        max_diff  = math.max(max_diff,math.abs(values_a[k]-values_b[k]))
+    end
+    if (max_value == 0.0) then
+        return 1.0
+    end
+    return max_diff/max_value
+end
+
+--############################################### Solve and compare
+phys_ref = CreateSolver(NPT_GMRES)
+values_ref = GetLineValues(phys_ref)
+
+phys_rich = CreateSolver(NPT_CLASSICRICHARDSON)
+values_rich = GetLineValues(phys_rich)
+
+phys_and = CreateSolver(NPT_ANDERSON)
+values_and = GetLineValues(phys_and)
+
+phys_and3 = CreateSolver(NPT_ANDERSON,3,0.8)
+values_and3 = GetLineValues(phys_and3)
+
+chiLog(LOG_0,string.format("Richardson-difference=%.5e",
+                           RelativeDifference(values_ref,values_rich)))
+chiLog(LOG_0,string.format("Anderson-difference=%.5e",
+                           RelativeDifference(values_ref,values_and)))
+chiLog(LOG_0,string.format("Anderson3-difference=%.5e",
+                           RelativeDifference(values_ref,values_and3)))
@@ -0,0 +1,168 @@
+-- Batched right-hand sides. Two sources, one in each half of the domain,
+-- are solved one at a time with the material sources and then together as
+-- batched right-hand sides. Each batched solution must match the solution
+-- of its individual solve.
+chiMPIBarrier()
+if (chi_location_id == 0) then
+    print("############################################### LuaTest")
+end
+
+--############################################### Setup mesh
+chiMeshHandlerCreate()
+
+newSurfMesh = chiSurfaceMeshCreate();
+chiSurfaceMeshImportFromOBJFile(newSurfMesh,
+        "CHI_RESOURCES/TestObjects/SquareMesh2x2Quads.obj",true)
+
+--############################################### Setup Regions
+region1 = chiRegionCreate()
+chiRegionAddSurfaceBoundary(region1,newSurfMesh);
+
+--############################################### Create meshers
+chiSurfaceMesherCreate(SURFACEMESHER_PREDEFINED);
+chiVolumeMesherCreate(VOLUMEMESHER_PREDEFINED2D);
+
+chiSurfaceMesherSetProperty(PARTITION_X,2)
+chiSurfaceMesherSetProperty(PARTITION_Y,2)
+chiSurfaceMesherSetProperty(CUT_X,0.0)
+chiSurfaceMesherSetProperty(CUT_Y,0.0)
+
+chiVolumeMesherSetProperty(FORCE_POLYGONS,true);
+
+--############################################### Execute meshing
+chiSurfaceMesherExecute();
+chiVolumeMesherExecute();
+
+--############################################### Set Material IDs
+vol0 = chiLogicalVolumeCreate(RPP,-1000,1000,-1000,1000,-1000,1000)
+chiVolumeMesherSetProperty(MATID_FROMLOGICAL,vol0,0)
+vol1 = chiLogicalVolumeCreate(RPP,0.0,1000,-1000,1000,-1000,1000)
+chiVolumeMesherSetProperty(MATID_FROMLOGICAL,vol1,1)
+
+--############################################### Add materials
+num_groups = 6
+
+materials = {}
+materials[1] = chiPhysicsAddMaterial("Left Material");
+materials[2] = chiPhysicsAddMaterial("Right Material");
+
+for m=1,2 do
+    chiPhysicsMaterialAddProperty(materials[m],TRANSPORT_XSECTIONS)
+    chiPhysicsMaterialAddProperty(materials[m],ISOTROPIC_MG_SOURCE)
+
+    chiPhysicsMaterialSetProperty(materials[m],TRANSPORT_XSECTIONS,
+                                  SIMPLEXS1,num_groups,1.0,0.9)
+end
+
+zero_src = {}
+src_left = {}
+src_right = {}
+for g=1,num_groups do
+    zero_src[g] = 0.0
+    src_left[g] = 0.0
+    src_right[g] = 0.0
+end
+src_left[1] = 1.0
+src_right[3] = 0.5
+
+pquad = chiCreateProductQuadrature(GAUSS_LEGENDRE_CHEBYSHEV,2,2)
+
+--############################################### Solver factory
+function CreateSolver(batch_sources)
+    local phys = chiLBSCreateSolver()
+    chiSolverAddRegion(phys,region1)
+
+    for g=1,num_groups do
+        chiLBSCreateGroup(phys)
+    end
+
+    local gs = chiLBSCreateGroupset(phys)
+    chiLBSGroupsetAddGroups(phys,gs,0,num_groups-1)
+    chiLBSGroupsetSetQuadrature(phys,gs,pquad)
+    chiLBSGroupsetSetAngleAggDiv(phys,gs,1)
+    chiLBSGroupsetSetGroupSubsets(phys,gs,1)
+    chiLBSGroupsetSetIterativeMethod(phys,gs,NPT_CLASSICRICHARDSON)
+    chiLBSGroupsetSetResidualTolerance(phys,gs,1.0e-10)
+    chiLBSGroupsetSetMaxIterations(phys,gs,1000)
+
+    chiLBSSetProperty(phys,PARTITION_METHOD,FROM_SURFACE)
+    chiLBSSetProperty(phys,DISCRETIZATION_METHOD,PWLD3D)
+    chiLBSSetProperty(phys,SCATTERING_ORDER,0)
+
+    local rhs = {}
+    if (batch_sources ~= nil) then
+        for k,sources in pairs(batch_sources) do
+            rhs[k] = chiLBSAddBatchSource(phys,sources)
+        end
+    end
+
+    chiLBSInitialize(phys)
+    chiLBSExecute(phys)
+
+    return phys,rhs
+end
+
+--############################################### Line values of all groups
+function GetLineValues(phys)
+    local fflist,count = chiLBSGetScalarFieldFunctionList(phys)
+    local all_values = {}
+    for g=1,num_groups do
+        local line = chiFFInterpolationCreate(LINE)
+        chiFFInterpolationSetProperty(line,LINE_FIRSTPOINT,-1.0,0.1,0.0)
+        chiFFInterpolationSetProperty(line,LINE_SECONDPOINT, 1.0,0.1,0.0)
+        chiFFInterpolationSetProperty(line,LINE_NUMBEROFPOINTS, 50)
+        chiFFInterpolationSetProperty(line,ADD_FIELDFUNCTION,fflist[g])
+
+        chiFFInterpolationInitialize(line)
+        chiFFInterpolationExecute(line)
+
+        local values = chiFFInterpolationGetValue(line)
+        for k=1,#values do
+            all_values[#all_values+1] = values[k]
+        end
+    end
+    return all_values
+end
+
+--############################################### Relative max difference
+function RelativeDifference(values_a,values_b)
+    local max_value = 0.0
+    local max_diff  = 0.0
+    for k=1,#values_a do
+        max_value = math.max(max_value,math.abs(values_a[k]))
+        max_diff  = math.max(max_diff,math.abs(values_a[k]-values_b[k]))
+    end
+    if (max_value == 0.0) then
+        return 1.0
+    end
+    return max_diff/max_value
+end
+
+--############################################### Individual solves
+chiPhysicsMaterialSetProperty(materials[1],ISOTROPIC_MG_SOURCE,
+                              FROM_ARRAY,src_left)
+chiPhysicsMaterialSetProperty(materials[2],ISOTROPIC_MG_SOURCE,
+                              FROM_ARRAY,zero_src)
+phys_left = CreateSolver(nil)
+values_left = GetLineValues(phys_left)
+
+chiPhysicsMaterialSetProperty(materials[1],ISOTROPIC_MG_SOURCE,
+                              FROM_ARRAY,zero_src)
+chiPhysicsMaterialSetProperty(materials[2],ISOTROPIC_MG_SOURCE,
+                              FROM_ARRAY,src_right)
+phys_right = CreateSolver(nil)
+values_right = GetLineValues(phys_right)
+
+--############################################### Batched solve
+phys_batch,rhs = CreateSolver({{[0]=src_left},{[1]=src_right}})
+
+chiLBSSelectBatchSolution(phys_batch,rhs[1])
+values_batch_left = GetLineValues(phys_batch)
+
+chiLBSSelectBatchSolution(phys_batch,rhs[2])
+values_batch_right = GetLineValues(phys_batch)
+
+chiLog(LOG_0,string.format("Batch0-difference=%.5e",
+                           RelativeDifference(values_left,values_batch_left)))
+chiLog(LOG_0,string.format("Batch1-difference=%.5e",
+                           RelativeDifference(values_right,values_batch_right)))
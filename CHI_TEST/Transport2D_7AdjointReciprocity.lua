@@ -0,0 +1,125 @@
+-- Adjoint reciprocity. A forward solve with a source in the left half of
+-- the domain gives the response of a detector in the right half. An adjoint
+-- solve with the detector as source must give the same response when the
+-- adjoint flux is weighted with the forward source.
+chiMPIBarrier()
+if (chi_location_id == 0) then
+    print("############################################### LuaTest")
+end
+
+--############################################### Setup mesh
+chiMeshHandlerCreate()
+
+newSurfMesh = chiSurfaceMeshCreate();
+chiSurfaceMeshImportFromOBJFile(newSurfMesh,
+        "CHI_RESOURCES/TestObjects/SquareMesh2x2Quads.obj",true)
+
+--############################################### Setup Regions
+region1 = chiRegionCreate()
+chiRegionAddSurfaceBoundary(region1,newSurfMesh);
+
+--############################################### Create meshers
+chiSurfaceMesherCreate(SURFACEMESHER_PREDEFINED);
+chiVolumeMesherCreate(VOLUMEMESHER_PREDEFINED2D);
+
+chiSurfaceMesherSetProperty(PARTITION_X,2)
+chiSurfaceMesherSetProperty(PARTITION_Y,2)
+chiSurfaceMesherSetProperty(CUT_X,0.0)
+chiSurfaceMesherSetProperty(CUT_Y,0.0)
+
+chiVolumeMesherSetProperty(FORCE_POLYGONS,true);
+
+--############################################### Execute meshing
+chiSurfaceMesherExecute();
+chiVolumeMesherExecute();
+
+--############################################### Set Material IDs
+vol0 = chiLogicalVolumeCreate(RPP,-1000,1000,-1000,1000,-1000,1000)
+chiVolumeMesherSetProperty(MATID_FROMLOGICAL,vol0,0)
+vol1 = chiLogicalVolumeCreate(RPP,0.0,1000,-1000,1000,-1000,1000)
+chiVolumeMesherSetProperty(MATID_FROMLOGICAL,vol1,1)
+
+--############################################### Add materials
+num_groups = 6
+
+materials = {}
+materials[1] = chiPhysicsAddMaterial("Source Material");
+materials[2] = chiPhysicsAddMaterial("Detector Material");
+
+for m=1,2 do
+    chiPhysicsMaterialAddProperty(materials[m],TRANSPORT_XSECTIONS)
+    chiPhysicsMaterialAddProperty(materials[m],ISOTROPIC_MG_SOURCE)
+
+    chiPhysicsMaterialSetProperty(materials[m],TRANSPORT_XSECTIONS,
+                                  SIMPLEXS1,num_groups,1.0,0.9)
+end
+
+zero_src = {}
+src_fwd = {}
+src_det = {}
+for g=1,num_groups do
+    zero_src[g] = 0.0
+    src_fwd[g] = 0.0
+    src_det[g] = 0.0
+end
+src_fwd[1] = 1.0
+src_det[num_groups-1] = 0.5
+src_det[num_groups] = 1.0
+
+pquad = chiCreateProductQuadrature(GAUSS_LEGENDRE_CHEBYSHEV,2,2)
+
+--############################################### Solver factory
+function CreateSolver(adjoint)
+    local phys = chiLBSCreateSolver()
+    chiSolverAddRegion(phys,region1)
+
+    for g=1,num_groups do
+        chiLBSCreateGroup(phys)
+    end
+
+    local gs = chiLBSCreateGroupset(phys)
+    chiLBSGroupsetAddGroups(phys,gs,0,num_groups-1)
+    chiLBSGroupsetSetQuadrature(phys,gs,pquad)
+    chiLBSGroupsetSetAngleAggDiv(phys,gs,1)
+    chiLBSGroupsetSetGroupSubsets(phys,gs,1)
+    chiLBSGroupsetSetIterativeMethod(phys,gs,NPT_GMRES)
+    chiLBSGroupsetSetResidualTolerance(phys,gs,1.0e-10)
+    chiLBSGroupsetSetMaxIterations(phys,gs,300)
+    chiLBSGroupsetSetGMRESRestartIntvl(phys,gs,100)
+
+    chiLBSSetProperty(phys,PARTITION_METHOD,FROM_SURFACE)
+    chiLBSSetProperty(phys,DISCRETIZATION_METHOD,PWLD3D)
+    chiLBSSetProperty(phys,SCATTERING_ORDER,0)
+    chiLBSSetProperty(phys,ADJOINT,adjoint)
+
+    chiLBSInitialize(phys)
+    chiLBSExecute(phys)
+
+    return phys
+end
+
+--############################################### Forward solve
+chiPhysicsMaterialSetProperty(materials[1],ISOTROPIC_MG_SOURCE,
+                              FROM_ARRAY,src_fwd)
+chiPhysicsMaterialSetProperty(materials[2],ISOTROPIC_MG_SOURCE,
+                              FROM_ARRAY,zero_src)
+phys_fwd = CreateSolver(false)
+response_fwd = chiLBSComputeResponse(phys_fwd,{[1]=src_det})
+
+--############################################### Adjoint solve
+chiPhysicsMaterialSetProperty(materials[1],ISOTROPIC_MG_SOURCE,
+                              FROM_ARRAY,zero_src)
+chiPhysicsMaterialSetProperty(materials[2],ISOTROPIC_MG_SOURCE,
+                              FROM_ARRAY,src_det)
+phys_adj = CreateSolver(true)
+response_adj = chiLBSComputeResponse(phys_adj,{[0]=src_fwd})
+
+chiLog(LOG_0,string.format("Forward-response=%.8e",response_fwd))
+chiLog(LOG_0,string.format("Adjoint-response=%.8e",response_adj))
+
+reciprocity_diff = 1.0
+if (response_fwd ~= 0.0) then
+    reciprocity_diff = math.abs(response_fwd-response_adj)/
+                       math.abs(response_fwd)
+end
+chiLog(LOG_0,string.format("Reciprocity-difference=%.5e",reciprocity_diff))
@@ -0,0 +1,147 @@
+-- Binary mesh round trip. The Ensight Gold sphere is solved, exported to
+-- the native binary mesh format and read back, on demand, in a second mesh
+-- handler where the same problem is solved again. Both solutions must be
+-- identical.
+chiMPIBarrier()
+if (chi_location_id == 0) then
+    print("############################################### LuaTest")
+end
+
+binary_file = "CHI_TEST/Transport3D_6BinaryMesh.cmsh"
+
+--############################################### Add materials
+num_groups = 5
+
+materials = {}
+materials[1] = chiPhysicsAddMaterial("Test Material");
+materials[2] = chiPhysicsAddMaterial("Test Material2");
+
+chiPhysicsMaterialAddProperty(materials[1],TRANSPORT_XSECTIONS)
+chiPhysicsMaterialAddProperty(materials[2],TRANSPORT_XSECTIONS)
+
+chiPhysicsMaterialAddProperty(materials[1],ISOTROPIC_MG_SOURCE)
+chiPhysicsMaterialAddProperty(materials[2],ISOTROPIC_MG_SOURCE)
+
+chiPhysicsMaterialSetProperty(materials[1],TRANSPORT_XSECTIONS,
+        PDT_XSFILE,"CHI_TEST/xs_graphite_pure.data")
+chiPhysicsMaterialSetProperty(materials[2],TRANSPORT_XSECTIONS,
+        PDT_XSFILE,"CHI_TEST/xs_graphite_pure.data")
+
+src={}
+for g=1,num_groups do
+    src[g] = 0.0
+end
+
+chiPhysicsMaterialSetProperty(materials[1],ISOTROPIC_MG_SOURCE,FROM_ARRAY,src)
+src[1]=1.0
+chiPhysicsMaterialSetProperty(materials[2],ISOTROPIC_MG_SOURCE,FROM_ARRAY,src)
+
+pquad = chiCreateProductQuadrature(GAUSS_LEGENDRE_CHEBYSHEV,2,2)
+
+--############################################### Mesh the loaded mesh
+function CreateMesh()
+    local region = chiRegionCreate()
+    chiRegionAddEmptyBoundary(region)
+
+    chiSurfaceMesherCreate(SURFACEMESHER_PREDEFINED)
+    chiVolumeMesherCreate(VOLUMEMESHER_PREDEFINED3D)
+
+    chiVolumeMesherSetProperty(VOLUMEPARTITION_X,2)
+    chiVolumeMesherSetProperty(VOLUMEPARTITION_Y,2)
+    chiVolumeMesherSetProperty(CUTS_X,0.0)
+    chiVolumeMesherSetProperty(CUTS_Y,0.0)
+
+    chiSurfaceMesherExecute()
+    chiVolumeMesherExecute()
+
+    return region
+end
+
+--############################################### Solver factory
+function CreateSolver(region)
+    local phys = chiLBSCreateSolver()
+    chiSolverAddRegion(phys,region)
+
+    for g=1,num_groups do
+        chiLBSCreateGroup(phys)
+    end
+
+    local gs = chiLBSCreateGroupset(phys)
+    chiLBSGroupsetAddGroups(phys,gs,0,num_groups-1)
+    chiLBSGroupsetSetQuadrature(phys,gs,pquad)
+    chiLBSGroupsetSetAngleAggregationType(phys,gs,LBSGroupset.ANGLE_AGG_SINGLE)
+    chiLBSGroupsetSetAngleAggDiv(phys,gs,1)
+    chiLBSGroupsetSetGroupSubsets(phys,gs,1)
+    chiLBSGroupsetSetIterativeMethod(phys,gs,NPT_GMRES_CYCLES)
+    chiLBSGroupsetSetResidualTolerance(phys,gs,1.0e-8)
+    chiLBSGroupsetSetGMRESRestartIntvl(phys,gs,100)
+
+    chiLBSSetProperty(phys,SCATTERING_ORDER,0)
+    chiLBSSetProperty(phys,DISCRETIZATION_METHOD,PWLD3D)
+
+    chiLBSInitialize(phys)
+    chiLBSExecute(phys)
+
+    return phys
+end
+
+--############################################### Volume sums of all groups
+function GetGroupSums(phys)
+    local fflist,count = chiLBSGetScalarFieldFunctionList(phys)
+    local vol = chiLogicalVolumeCreate(RPP,-1000,1000,-1000,1000,-1000,1000)
+    local sums = {}
+    for g=1,num_groups do
+        local ffi = chiFFInterpolationCreate(VOLUME)
+        chiFFInterpolationSetProperty(ffi,OPERATION,OP_SUM)
+        chiFFInterpolationSetProperty(ffi,LOGICAL_VOLUME,vol)
+        chiFFInterpolationSetProperty(ffi,ADD_FIELDFUNCTION,fflist[g])
+
+        chiFFInterpolationInitialize(ffi)
+        chiFFInterpolationExecute(ffi)
+        sums[g] = chiFFInterpolationGetValue(ffi)
+    end
+    return sums
+end
+
+--############################################### Relative max difference
+function RelativeDifference(values_a,values_b)
+    local max_value = 0.0
+    local max_diff  = 0.0
+    for k=1,#values_a do
+        max_value = math.max(max_value,math.abs(values_a[k]))
+        max_diff  = math.max(max_diff,math.abs(values_a[k]-values_b[k]))
+    end
+    if (max_value == 0.0) then
+        return 1.0
+    end
+    return max_diff/max_value
+end
+
+--############################################### Ensight Gold mesh
+chiMeshHandlerCreate()
+
+umesh = chiUnpartitionedMeshFromEnsightGold(
+        "CHI_RESOURCES/TestObjects/Sphere.case")
+chiUnpartitionedMeshExportToBinary(umesh,binary_file)
+
+region1 = CreateMesh()
+phys1 = CreateSolver(region1)
+sums1 = GetGroupSums(phys1)
+
+--############################################### Binary mesh
+chiMPIBarrier()
+chiMeshHandlerCreate()
+
+chiUnpartitionedMeshFromBinary(binary_file)
+
+region2 = CreateMesh()
+phys2 = CreateSolver(region2)
+sums2 = GetGroupSums(phys2)
+
+chiLog(LOG_0,string.format("BinaryMesh-difference=%.5e",
+                           RelativeDifference(sums1,sums2)))
+
+chiMPIBarrier()
+if (chi_location_id == 0) then
+    os.remove(binary_file)
+end
@@ -134,6 +134,43 @@ else:
     print(" - FAILED!")
     num_failed += 1
 
+#=========================================== Test
+test_number += 1
+test_name = "2D Line Interpolation Off-Plane Test - CFEM 1 MPI Processes"
+print("Running Test " + format3(test_number) + " " + test_name,end='',flush=True)
+process = subprocess.Popen(["mpiexec","-np","1",kpath_to_exe,
+                            "CHI_TEST/Diffusion2D_1Poly_LineOffPlane.lua",
+                            "master_export=false"],
+                           cwd=kchi_src_pth,
+                           stdout=subprocess.PIPE,
+                           universal_newlines=True)
+process.wait()
+out,err = process.communicate()
+
+#string to find in output
+find_str          = "[0]  Line-difference="
+#start of the string (<0 if not found)
+test_str_start    = out.find(find_str)
+#end of the string to find
+test_str_end      = test_str_start + len(find_str)
+#end of the line at which string was found
+test_str_line_end = out.find("\n",test_str_start)
+
+test_passed = False
+if (test_str_start >= 0):
+    #convert value to number
+    test_val = float(out[test_str_end:test_str_line_end])
+    if (abs(test_val) < 1.0e-10):
+        test_passed = True
+else:
+    test_passed = False
+
+if (test_passed):
+    print(" - Passed")
+else:
+    print(" - FAILED!")
+    num_failed += 1
+
 #=========================================== Test
 test_number += 1
 test_name = "2D Diffusion Test - DFEM 4 MPI Processes"
@@ -837,6 +874,424 @@ else:
   num_failed += 1
 
 
+#=========================================== Test
+test_number += 1
+test_name = "2D LinearBSolver Test - Multigroup Outer Iterations 4 MPI Processes"
+print("Running Test " + format3(test_number) + " " + test_name,end='',flush=True)
+process = subprocess.Popen(["mpiexec","-np","4",kpath_to_exe,
+                            "CHI_TEST/Transport2D_3OuterIterations.lua", "master_export=false"],
+                           cwd=kchi_src_pth,
+                           stdout=subprocess.PIPE,
+                           universal_newlines=True)
+process.wait()
+out,err = process.communicate()
+
+test_passed = True
+#string to find in output
+find_str          = "[0]  GS-difference="
+#start of the string (<0 if not found)
+test_str_start    = out.find(find_str)
+#end of the string to find
+test_str_end      = test_str_start + len(find_str)
+#end of the line at which string was found
+test_str_line_end = out.find("\n",test_str_start)
+
+if (test_str_start >= 0):
+  #convert value to number
+  test_val = float(out[test_str_end:test_str_line_end])
+  if (not abs(test_val) < 1.0e-6):
+    test_passed = False
+else:
+  test_passed = False
+
+#string to find in output
+find_str          = "[0]  Jacobi-difference="
+#start of the string (<0 if not found)
+test_str_start    = out.find(find_str)
+#end of the string to find
+test_str_end      = test_str_start + len(find_str)
+#end of the line at which string was found
+test_str_line_end = out.find("\n",test_str_start)
+
+if (test_str_start >= 0):
+  #convert value to number
+  test_val = float(out[test_str_end:test_str_line_end])
+  if (not abs(test_val) < 1.0e-6):
+    test_passed = False
+else:
+  test_passed = False
+
+if (test_passed):
+  print(" - Passed")
+else:
+  print(" - FAILED!")
+  num_failed += 1
+
+
+#=========================================== Test
+test_number += 1
+test_name = "2D LinearBSolver Test - CMFD Outer Acceleration 4 MPI Processes"
+print("Running Test " + format3(test_number) + " " + test_name,end='',flush=True)
+process = subprocess.Popen(["mpiexec","-np","4",kpath_to_exe,
+                            "CHI_TEST/Transport2D_4CMFD.lua", "master_export=false"],
+                           cwd=kchi_src_pth,
+                           stdout=subprocess.PIPE,
+                           universal_newlines=True)
+process.wait()
+out,err = process.communicate()
+
+test_passed = True
+#string to find in output
+find_str          = "[0]  CMFD-Richardson-difference="
+#start of the string (<0 if not found)
+test_str_start    = out.find(find_str)
+#end of the string to find
+test_str_end      = test_str_start + len(find_str)
+#end of the line at which string was found
+test_str_line_end = out.find("\n",test_str_start)
+
+if (test_str_start >= 0):
+  #convert value to number
+  test_val = float(out[test_str_end:test_str_line_end])
+  if (not abs(test_val) < 1.0e-6):
+    test_passed = False
+else:
+  test_passed = False
+
+#string to find in output
+find_str          = "[0]  CMFD-WGDSA-difference="
+#start of the string (<0 if not found)
+test_str_start    = out.find(find_str)
+#end of the string to find
+test_str_end      = test_str_start + len(find_str)
+#end of the line at which string was found
+test_str_line_end = out.find("\n",test_str_start)
+
+if (test_str_start >= 0):
+  #convert value to number
+  test_val = float(out[test_str_end:test_str_line_end])
+  if (not abs(test_val) < 1.0e-6):
+    test_passed = False
+else:
+  test_passed = False
+
+if (test_passed):
+  print(" - Passed")
+else:
+  print(" - FAILED!")
+  num_failed += 1
+
+
+#=========================================== Test
+test_number += 1
+test_name = "2D LinearBSolver Test - Anderson Acceleration 4 MPI Processes"
+print("Running Test " + format3(test_number) + " " + test_name,end='',flush=True)
+process = subprocess.Popen(["mpiexec","-np","4",kpath_to_exe,
+                            "CHI_TEST/Transport2D_5Anderson.lua", "master_export=false"],
+                           cwd=kchi_src_pth,
+                           stdout=subprocess.PIPE,
+                           universal_newlines=True)
+process.wait()
+out,err = process.communicate()
+
+test_passed = True
+#string to find in output
+find_str          = "[0]  Richardson-difference="
+#start of the string (<0 if not found)
+test_str_start    = out.find(find_str)
+#end of the string to find
+test_str_end      = test_str_start + len(find_str)
+#end of the line at which string was found
+test_str_line_end = out.find("\n",test_str_start)
+
+if (test_str_start >= 0):
+  #convert value to number
+  test_val = float(out[test_str_end:test_str_line_end])
+  if (not abs(test_val) < 1.0e-6):
+    test_passed = False
+else:
+  test_passed = False
+
+#string to find in output
+find_str          = "[0]  Anderson-difference="
+#start of the string (<0 if not found)
+test_str_start    = out.find(find_str)
+#end of the string to find
+test_str_end      = test_str_start + len(find_str)
+#end of the line at which string was found
+test_str_line_end = out.find("\n",test_str_start)
+
+if (test_str_start >= 0):
+  #convert value to number
+  test_val = float(out[test_str_end:test_str_line_end])
+  if (not abs(test_val) < 1.0e-6):
+    test_passed = False
+else:
+  test_passed = False
+
+#string to find in output
+find_str          = "[0]  Anderson3-difference="
+#start of the string (<0 if not found)
+test_str_start    = out.find(find_str)
+#end of the string to find
+test_str_end      = test_str_start + len(find_str)
+#end of the line at which string was found
+test_str_line_end = out.find("\n",test_str_start)
+
+if (test_str_start >= 0):
+  #convert value to number
+  test_val = float(out[test_str_end:test_str_line_end])
+  if (not abs(test_val) < 1.0e-6):
+    test_passed = False
+else:
+  test_passed = False
+
+if (test_passed):
+  print(" - Passed")
+else:
+  print(" - FAILED!")
+  num_failed += 1
+
+
+#=========================================== Test
+test_number += 1
+test_name = "2D LinearBSolver Test - Batched Sources 4 MPI Processes"
+print("Running Test " + format3(test_number) + " " + test_name,end='',flush=True)
+process = subprocess.Popen(["mpiexec","-np","4",kpath_to_exe,
+                            "CHI_TEST/Transport2D_6Batched.lua", "master_export=false"],
+                           cwd=kchi_src_pth,
+                           stdout=subprocess.PIPE,
+                           universal_newlines=True)
+process.wait()
+out,err = process.communicate()
+
+test_passed = True
+#string to find in output
+find_str          = "[0]  Batch0-difference="
+#start of the string (<0 if not found)
+test_str_start    = out.find(find_str)
+#end of the string to find
+test_str_end      = test_str_start + len(find_str)
+#end of the line at which string was found
+test_str_line_end = out.find("\n",test_str_start)
+
+if (test_str_start >= 0):
+  #convert value to number
+  test_val = float(out[test_str_end:test_str_line_end])
+  if (not abs(test_val) < 1.0e-6):
+    test_passed = False
+else:
+  test_passed = False
+
+#string to find in output
+find_str          = "[0]  Batch1-difference="
+#start of the string (<0 if not found)
+test_str_start    = out.find(find_str)
+#end of the string to find
+test_str_end      = test_str_start + len(find_str)
+#end of the line at which string was found
+test_str_line_end = out.find("\n",test_str_start)
+
+if (test_str_start >= 0):
+  #convert value to number
+  test_val = float(out[test_str_end:test_str_line_end])
+  if (not abs(test_val) < 1.0e-6):
+    test_passed = False
+else:
+  test_passed = False
+
+if (test_passed):
+  print(" - Passed")
+else:
+  print(" - FAILED!")
+  num_failed += 1
+
+
+#=========================================== Test
+test_number += 1
+test_name = "2D LinearBSolver Test - Adjoint Reciprocity 4 MPI Processes"
+print("Running Test " + format3(test_number) + " " + test_name,end='',flush=True)
+process = subprocess.Popen(["mpiexec","-np","4",kpath_to_exe,
+                            "CHI_TEST/Transport2D_7AdjointReciprocity.lua", "master_export=false"],
+                           cwd=kchi_src_pth,
+                           stdout=subprocess.PIPE,
+                           universal_newlines=True)
+process.wait()
+out,err = process.communicate()
+
+test_passed = True
+#string to find in output
+find_str          = "[0]  Reciprocity-difference="
+#start of the string (<0 if not found)
+test_str_start    = out.find(find_str)
+#end of the string to find
+test_str_end      = test_str_start + len(find_str)
+#end of the line at which string was found
+test_str_line_end = out.find("\n",test_str_start)
+
+if (test_str_start >= 0):
+  #convert value to number
+  test_val = float(out[test_str_end:test_str_line_end])
+  if (not abs(test_val) < 1.0e-6):
+    test_passed = False
+else:
+  test_passed = False
+
+if (test_passed):
+  print(" - Passed")
+else:
+  print(" - FAILED!")
+  num_failed += 1
+
+
+#=========================================== Test
+test_number += 1
+test_name = "3D LinearBSolver Test - Binary Mesh Round Trip 4 MPI Processes"
+print("Running Test " + format3(test_number) + " " + test_name,end='',flush=True)
+process = subprocess.Popen(["mpiexec","-np","4",kpath_to_exe,
+                            "CHI_TEST/Transport3D_6BinaryMesh.lua", "master_export=false"],
+                           cwd=kchi_src_pth,
+                           stdout=subprocess.PIPE,
+                           universal_newlines=True)
+process.wait()
+out,err = process.communicate()
+
+test_passed = True
+#string to find in output
+find_str          = "[0]  BinaryMesh-difference="
+#start of the string (<0 if not found)
+test_str_start    = out.find(find_str)
+#end of the string to find
+test_str_end      = test_str_start + len(find_str)
+#end of the line at which string was found
+test_str_line_end = out.find("\n",test_str_start)
+
+if (test_str_start >= 0):
+  #convert value to number
+  test_val = float(out[test_str_end:test_str_line_end])
+  if (not abs(test_val) < 1.0e-8):
+    test_passed = False
+else:
+  test_passed = False
+
+if (test_passed):
+  print(" - Passed")
+else:
+  print(" - FAILED!")
+  num_failed += 1
+
+
+#=========================================== Test
+test_number += 1
+test_name = "2D LinearBSolver Test - Partition File Round Trip 4 MPI Processes"
+print("Running Test " + format3(test_number) + " " + test_name,end='',flush=True)
+process = subprocess.Popen(["mpiexec","-np","4",kpath_to_exe,
+                            "CHI_TEST/Transport2D_8PartitionFile.lua", "master_export=false"],
+                           cwd=kchi_src_pth,
+                           stdout=subprocess.PIPE,
+                           universal_newlines=True)
+process.wait()
+out,err = process.communicate()
+
+test_passed = True
+#string to find in output
+find_str          = "[0]  PartitionFile-difference="
+#start of the string (<0 if not found)
+test_str_start    = out.find(find_str)
+#end of the string to find
+test_str_end      = test_str_start + len(find_str)
+#end of the line at which string was found
+test_str_line_end = out.find("\n",test_str_start)
+
+if (test_str_start >= 0):
+  #convert value to number
+  test_val = float(out[test_str_end:test_str_line_end])
+  if (not abs(test_val) < 1.0e-8):
+    test_passed = False
+else:
+  test_passed = False
+
+if (test_passed):
+  print(" - Passed")
+else:
+  print(" - FAILED!")
+  num_failed += 1
+
+
+#=========================================== Test
+test_number += 1
+test_name = "2D LinearBSolver Test - Restart Data Round Trip 4 MPI Processes"
+print("Running Test " + format3(test_number) + " " + test_name,end='',flush=True)
+process = subprocess.Popen(["mpiexec","-np","4",kpath_to_exe,
+                            "CHI_TEST/Transport2D_9Restart.lua", "master_export=false"],
+                           cwd=kchi_src_pth,
+                           stdout=subprocess.PIPE,
+                           universal_newlines=True)
+process.wait()
+out,err = process.communicate()
+
+test_passed = True
+#string to find in output
+find_str          = "[0]  Restart-difference="
+#start of the string (<0 if not found)
+test_str_start    = out.find(find_str)
+#end of the string to find
+test_str_end      = test_str_start + len(find_str)
+#end of the line at which string was found
+test_str_line_end = out.find("\n",test_str_start)
+
+if (test_str_start >= 0):
+  #convert value to number
+  test_val = float(out[test_str_end:test_str_line_end])
+  if (not abs(test_val) < 1.0e-6):
+    test_passed = False
+else:
+  test_passed = False
+
+if (test_passed):
+  print(" - Passed")
+else:
+  print(" - FAILED!")
+  num_failed += 1
+
+
+#=========================================== Test
+test_number += 1
+test_name = "2D LinearBSolver Test - Binary Cross-Section File 4 MPI Processes"
+print("Running Test " + format3(test_number) + " " + test_name,end='',flush=True)
+process = subprocess.Popen(["mpiexec","-np","4",kpath_to_exe,
+                            "CHI_TEST/Transport2D_10ChiXSFile.lua", "master_export=false"],
+                           cwd=kchi_src_pth,
+                           stdout=subprocess.PIPE,
+                           universal_newlines=True)
+process.wait()
+out,err = process.communicate()
+
+test_passed = True
+#string to find in output
+find_str          = "[0]  ChiXSFile-difference="
+#start of the string (<0 if not found)
+test_str_start    = out.find(find_str)
+#end of the string to find
+test_str_end      = test_str_start + len(find_str)
+#end of the line at which string was found
+test_str_line_end = out.find("\n",test_str_start)
+
+if (test_str_start >= 0):
+  #convert value to number
+  test_val = float(out[test_str_end:test_str_line_end])
+  if (not abs(test_val) < 1.0e-8):
+    test_passed = False
+else:
+  test_passed = False
+
+if (test_passed):
+  print(" - Passed")
+else:
+  print(" - FAILED!")
+  num_failed += 1
+
+
 #$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$ END OF TESTS
 print("")
 if (num_failed == 0):
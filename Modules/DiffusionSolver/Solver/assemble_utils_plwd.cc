@@ -43,7 +43,7 @@ void chi_diffusion::Solver::ReorderNodesPWLD()
   global_dof_count=0;
   MPI_Allreduce(&local_dof_count,    //Send buffer
                 &global_dof_count,   //Recv buffer
-                1,MPI_INT,MPI_SUM,MPI_COMM_WORLD);
+                1,MPI_INT,MPI_SUM,chi_mpi.comm);
 
   //================================================== Ring communicate DOF start
   pwld_local_dof_start = 0;
@@ -53,7 +53,7 @@ void chi_diffusion::Solver::ReorderNodesPWLD()
              1,MPI_INT,              //Count and type
              chi_mpi.location_id-1,  //Source
              111,                    //Tag
-             MPI_COMM_WORLD,MPI_STATUS_IGNORE);
+             chi_mpi.comm,MPI_STATUS_IGNORE);
   }
 
   if (chi_mpi.location_id != (chi_mpi.process_count-1))
@@ -63,7 +63,7 @@ void chi_diffusion::Solver::ReorderNodesPWLD()
              1,MPI_INT,
              chi_mpi.location_id+1,
              111,
-             MPI_COMM_WORLD);
+             chi_mpi.comm);
   }
 
   chi_log.Log(LOG_ALLVERBOSE_2)
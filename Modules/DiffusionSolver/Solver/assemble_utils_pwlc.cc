@@ -139,7 +139,7 @@ extern ChiMPI chi_mpi;
 //  {
 //    //world.send(1,123,nonexclus_nodes);
 //    MPI_Send(nonexclus_nodes.data(),nonexclus_nodes.size(),
-//             MPI_INT,1,123,MPI_COMM_WORLD);
+//             MPI_INT,1,123,chi_mpi.comm);
 //  }
 //  //=================================== Location n=1..(N-1) first receives
 //  //                                    n-1
@@ -148,13 +148,13 @@ extern ChiMPI chi_mpi;
 //    std::vector<int> upstream_nonex;
 //    //world.recv(chi_mpi.location_id-1,123,upstream_nonex);
 //    MPI_Status status;
-//    MPI_Probe(chi_mpi.location_id-1,123,MPI_COMM_WORLD,&status);
+//    MPI_Probe(chi_mpi.location_id-1,123,chi_mpi.comm,&status);
 //    int num_to_recv=0;
 //    MPI_Get_count(&status,MPI_INT,&num_to_recv);
 //    upstream_nonex.resize(num_to_recv,-1);
 //    MPI_Recv(upstream_nonex.data(),num_to_recv,
 //             MPI_INT,chi_mpi.location_id-1,123,
-//             MPI_COMM_WORLD,MPI_STATUS_IGNORE);
+//             chi_mpi.comm,MPI_STATUS_IGNORE);
 //
 //    //============================ Run through location n non-exclusive nodes
 //    // if a non-exclusive node is not in the upstream list then
@@ -173,7 +173,7 @@ extern ChiMPI chi_mpi;
 //    {
 //      //world.send(chi_mpi.location_id+1,123,upstream_nonex);
 //      MPI_Send(upstream_nonex.data(),upstream_nonex.size(),
-//               MPI_INT,chi_mpi.location_id+1,123,MPI_COMM_WORLD);
+//               MPI_INT,chi_mpi.location_id+1,123,chi_mpi.comm);
 //    }
 //    //============================ On the last location send the completed
 //    // upstream_nonex back to all other locations
@@ -186,7 +186,7 @@ extern ChiMPI chi_mpi;
 //      {
 ////        world.send(loc,124,global_ghost_nodes);
 //        MPI_Send(global_ghost_nodes.data(),global_ghost_nodes.size(),
-//                 MPI_INT,loc,124,MPI_COMM_WORLD);
+//                 MPI_INT,loc,124,chi_mpi.comm);
 //      }
 //
 //    }
@@ -199,20 +199,20 @@ extern ChiMPI chi_mpi;
 //  {
 ////    world.recv(chi_mpi.process_count-1,124,global_ghost_nodes);
 //    MPI_Status status;
-//    MPI_Probe(chi_mpi.process_count-1,124,MPI_COMM_WORLD,&status);
+//    MPI_Probe(chi_mpi.process_count-1,124,chi_mpi.comm,&status);
 //    int num_to_recv=0;
 //    MPI_Get_count(&status,MPI_INT,&num_to_recv);
 //    global_ghost_nodes.resize(num_to_recv,-1);
 //    MPI_Recv(global_ghost_nodes.data(),num_to_recv,
 //             MPI_INT,chi_mpi.process_count-1,124,
-//             MPI_COMM_WORLD,MPI_STATUS_IGNORE);
+//             chi_mpi.comm,MPI_STATUS_IGNORE);
 //  }
 //
 //
 //
 //  chi_log.Log(LOG_ALLVERBOSE_1) << "Total number of ghost nodes: "
 //                            << global_ghost_nodes.size() << std::endl;
-//  MPI_Barrier(MPI_COMM_WORLD);
+//  MPI_Barrier(chi_mpi.comm);
 //
 //  chi_log.Log(LOG_0VERBOSE_1) << "*** Reordering stage 3 time: "
 //                            << t_stage[3].GetTime()/1000.0;
@@ -257,7 +257,7 @@ extern ChiMPI chi_mpi;
 //  chi_log.Log(LOG_ALLVERBOSE_1) << "Local ghost ownership: "
 //                                      << g_from << "->" << g_to
 //                                      << "(" << num_g_loc << ")" << std::endl;
-//  MPI_Barrier(MPI_COMM_WORLD);
+//  MPI_Barrier(chi_mpi.comm);
 //
 //  //================================================== Ring Compute local portion
 //  //The local portion of the nodes are the exclusive nodes
@@ -278,14 +278,14 @@ extern ChiMPI chi_mpi;
 //    local_to = exclusive_nodes.size() - 1 + num_g_loc;
 //    //world.send(chi_mpi.location_id+1,125,local_to);
 //    MPI_Send(&local_to,1,
-//             MPI_INT,chi_mpi.location_id+1,125,MPI_COMM_WORLD);
+//             MPI_INT,chi_mpi.location_id+1,125,chi_mpi.comm);
 //  }
 //  else
 //  {
 //    int upstream_loc_end = 0;
 //    MPI_Recv(&upstream_loc_end,1,
 //             MPI_INT,chi_mpi.location_id-1,125,
-//             MPI_COMM_WORLD,MPI_STATUS_IGNORE);
+//             chi_mpi.comm,MPI_STATUS_IGNORE);
 //
 //    local_from = upstream_loc_end + 1;
 //    local_to = local_from + exclusive_nodes.size() - 1 + num_g_loc;
@@ -293,7 +293,7 @@ extern ChiMPI chi_mpi;
 //    if (chi_mpi.location_id<(chi_mpi.process_count-1))
 //    {
 //      MPI_Send(&local_to,1,
-//               MPI_INT,chi_mpi.location_id+1,125,MPI_COMM_WORLD);
+//               MPI_INT,chi_mpi.location_id+1,125,chi_mpi.comm);
 //    }
 //
 //  }
@@ -303,10 +303,10 @@ extern ChiMPI chi_mpi;
 //                                      << "(" << tot_local_nodes << ")"
 //                                      << std::endl;
 ////  usleep(1000000);
-//  MPI_Barrier(MPI_COMM_WORLD);
+//  MPI_Barrier(chi_mpi.comm);
 //  chi_log.Log(LOG_0VERBOSE_1) << "*** Reordering stage 4 time: "
 //                            << t_stage[4].GetTime()/1000.0;
-//  MPI_Barrier(MPI_COMM_WORLD);
+//  MPI_Barrier(chi_mpi.comm);
 //
 //  t_stage[5].Reset();
 //
@@ -329,20 +329,20 @@ extern ChiMPI chi_mpi;
 //    }
 //    //world.send(chi_mpi.location_id+1,126,ghost_mapping);
 //    MPI_Send(ghost_mapping.data(),ghost_mapping.size(),
-//             MPI_INT,chi_mpi.location_id+1,126,MPI_COMM_WORLD);
+//             MPI_INT,chi_mpi.location_id+1,126,chi_mpi.comm);
 //  }
 //  else
 //  {
 //    std::vector<int> upstream_ghost_mapping;
 //    //world.recv(chi_mpi.location_id-1,126,upstream_ghost_mapping);
 //    MPI_Status status;
-//    MPI_Probe(chi_mpi.location_id-1,126,MPI_COMM_WORLD,&status);
+//    MPI_Probe(chi_mpi.location_id-1,126,chi_mpi.comm,&status);
 //    int num_to_recv=0;
 //    MPI_Get_count(&status,MPI_INT,&num_to_recv);
 //    upstream_ghost_mapping.resize(num_to_recv,-1);
 //    MPI_Recv(upstream_ghost_mapping.data(),num_to_recv,
 //             MPI_INT,chi_mpi.location_id-1,126,
-//             MPI_COMM_WORLD,MPI_STATUS_IGNORE);
+//             chi_mpi.comm,MPI_STATUS_IGNORE);
 //
 ////    ghost_mapping = upstream_ghost_mapping;
 //    std::copy(upstream_ghost_mapping.begin(),
@@ -357,7 +357,7 @@ extern ChiMPI chi_mpi;
 //    {
 ////      world.send(chi_mpi.location_id+1,126,ghost_mapping);
 //      MPI_Send(ghost_mapping.data(),ghost_mapping.size(),
-//               MPI_INT,chi_mpi.location_id+1,126,MPI_COMM_WORLD);
+//               MPI_INT,chi_mpi.location_id+1,126,chi_mpi.comm);
 //    }
 //    else
 //    {
@@ -365,7 +365,7 @@ extern ChiMPI chi_mpi;
 //      {
 //        //world.send(loc,127,ghost_mapping);//
 //        MPI_Send(ghost_mapping.data(),ghost_mapping.size(),
-//                 MPI_INT,loc,127,MPI_COMM_WORLD);
+//                 MPI_INT,loc,127,chi_mpi.comm);
 //      }
 //    }
 //  }
@@ -376,13 +376,13 @@ extern ChiMPI chi_mpi;
 //  {
 ////    world.recv(chi_mpi.process_count-1,127,ghost_mapping);
 //    MPI_Status status;
-//    MPI_Probe(chi_mpi.process_count-1,127,MPI_COMM_WORLD,&status);
+//    MPI_Probe(chi_mpi.process_count-1,127,chi_mpi.comm,&status);
 //    int num_to_recv=0;
 //    MPI_Get_count(&status,MPI_INT,&num_to_recv);
 //    ghost_mapping.resize(num_to_recv,-1);
 //    MPI_Recv(ghost_mapping.data(),num_to_recv,
 //             MPI_INT,chi_mpi.process_count-1,127,
-//             MPI_COMM_WORLD,MPI_STATUS_IGNORE);
+//             chi_mpi.comm,MPI_STATUS_IGNORE);
 //  }
 //
 //
@@ -428,7 +428,7 @@ extern ChiMPI chi_mpi;
 //
 //  chi_log.Log(LOG_0VERBOSE_1) << "*** Reordering stage 5 time: "
 //                            << t_stage[5].GetTime()/1000.0;
-//  MPI_Barrier(MPI_COMM_WORLD);
+//  MPI_Barrier(chi_mpi.comm);
 //
 //
 //  //================================================== Push up these mappings
@@ -453,7 +453,7 @@ extern ChiMPI chi_mpi;
 //
 //  chi_log.Log(LOG_0VERBOSE_1) << "*** Reordering stages complete time: "
 //                            << t_stage[5].GetTime()/1000.0;
-//  MPI_Barrier(MPI_COMM_WORLD);
+//  MPI_Barrier(chi_mpi.comm);
 ////  exit(0);
 //}
 
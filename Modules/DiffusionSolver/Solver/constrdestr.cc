@@ -1,7 +1,9 @@
 #include "diffusion_solver.h"
 
 #include <chi_log.h>
+#include <chi_mpi.h>
 extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
 
 chi_diffusion::Solver::Solver()
 {
@@ -10,6 +12,7 @@ chi_diffusion::Solver::Solver()
   common_items_initialized = false;
   max_iters = 500;
   residual_tolerance = 1.0e-8;
+  last_num_iterations = 0;
 
   gi = 0;
   G = 1;
@@ -33,7 +36,7 @@ chi_diffusion::Solver::Solver(std::string in_solver_name):Solver()
 
 chi_diffusion::Solver::~Solver()
 {
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
   chi_log.Log(LOG_0)
     << "Cleaning up diffusion solver: " << solver_name;
   VecDestroy(&x);
@@ -60,7 +63,7 @@ chi_diffusion::Solver::~Solver()
     for (auto val : loc_border_ipview)
       delete val;
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
   chi_log.Log(LOG_0)
     << "Done cleaning up diffusion solver: " << solver_name;
 }
\ No newline at end of file
@@ -135,6 +135,7 @@ public:
 
   int    max_iters;
   double residual_tolerance;
+  int    last_num_iterations;     ///< Iterations of the latest solve
   int    gi;
   int    G;
   std::string options_string;
@@ -180,6 +181,7 @@ public:
 
   //02a
   int ExecuteS(bool suppress_assembly = false, bool suppress_solve = false);
+  void SetResidualTolerance(double tolerance);
 
 
 
@@ -116,6 +116,7 @@ int chi_diffusion::Solver::ExecutePWLC(bool suppress_assembly,
     //=================================== Get convergence reason
     KSPConvergedReason reason;
     KSPGetConvergedReason(ksp,&reason);
+    KSPGetIterationNumber(ksp,&last_num_iterations);
     chi_log.Log(LOG_0) << "Convergence reason: " << reason;
 
 
@@ -169,6 +169,7 @@ int chi_diffusion::Solver::ExecutePWLD_MIP(bool suppress_assembly,
     //=================================== Get convergence reason
     KSPConvergedReason reason;
     KSPGetConvergedReason(ksp,&reason);
+    KSPGetIterationNumber(ksp,&last_num_iterations);
     if (verbose_info || reason != KSP_CONVERGED_RTOL)
       chi_log.Log(LOG_0) << "Convergence reason: " << reason;
 
@@ -127,6 +127,7 @@ int chi_diffusion::Solver::ExecutePWLD_MIP_GRPS(bool suppress_assembly,
   {
     chi_log.Log(LOG_0) << "Diffusion Solver: Solving system\n";
 
+    last_num_iterations = 0;
     for (int gr=0; gr<G; gr++)
     {
       t_solve.Reset();
@@ -149,6 +150,9 @@ int chi_diffusion::Solver::ExecutePWLD_MIP_GRPS(bool suppress_assembly,
       //=================================== Get convergence reason
       KSPConvergedReason reason;
       KSPGetConvergedReason(kspg[gr],&reason);
+      int gr_its;
+      KSPGetIterationNumber(kspg[gr],&gr_its);
+      last_num_iterations += gr_its;
       //chi_log.Log(LOG_0) << "Convergence reason: " << reason;
 
 
@@ -35,7 +35,7 @@ int chi_diffusion::Solver::InitializePWLC(bool verbose)
     chi_log.Log(LOG_0) << "Computing cell matrices";
   pwl_sdm = ((SpatialDiscretization_PWL*)(this->discretization));
   pwl_sdm->AddViewOfLocalContinuum(grid);
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
   //================================================== Reorder nodes
   if (verbose)
@@ -46,7 +46,7 @@ int chi_diffusion::Solver::InitializePWLC(bool verbose)
   local_dof_count = domain_ownership.first;
   global_dof_count   = domain_ownership.second;
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
   if (verbose)
     chi_log.Log(LOG_0) << "Time taken during nodal reordering "
                        << t_reorder.GetTime()/1000.0;
@@ -34,7 +34,7 @@ int chi_diffusion::Solver::InitializePWLD(bool verbose)
   pwl_sdm = ((SpatialDiscretization_PWL*)(this->discretization));
   pwl_sdm->AddViewOfLocalContinuum(grid);
   pwl_sdm->AddViewOfNeighborContinuums(grid);
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
   //================================================== Reorder nodes
   if (verbose)
@@ -45,7 +45,7 @@ int chi_diffusion::Solver::InitializePWLD(bool verbose)
   local_dof_count = domain_ownership.first;
   global_dof_count   = domain_ownership.second;
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
   if (verbose)
     chi_log.Log(LOG_0) << "Time taken during nodal reordering "
                        << t_reorder.GetTime()/1000.0;
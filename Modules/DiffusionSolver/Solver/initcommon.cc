@@ -25,7 +25,7 @@ void chi_diffusion::Solver::InitializeCommonItems()
   chi_mesh::MeshHandler*    mesh_handler = chi_mesh::GetCurrentHandler();
   chi_mesh::VolumeMesher*         mesher = mesh_handler->volume_mesher;
 
-  if (typeid(*mesher) == typeid(chi_mesh::VolumeMesherExtruder))
+  if (mesher->Type() == chi_mesh::VolumeMesherType::EXTRUDER)
   {
     for (int b=0; b<(region->boundaries.size()-2); b++)
     {
@@ -47,7 +47,7 @@ void chi_diffusion::Solver::InitializeCommonItems()
     chi_log.Log(LOG_0VERBOSE_1)
       << "Reflecting boundary added (index " << boundaries.size()-1 <<  ").";
   }
-  else if (typeid(*mesher) == typeid(chi_mesh::VolumeMesherLinemesh1D))
+  else if (mesher->Type() == chi_mesh::VolumeMesherType::LINEMESH1D)
   {
     chi_diffusion::Boundary* new_bndry =
       new chi_diffusion::BoundaryDirichlet;
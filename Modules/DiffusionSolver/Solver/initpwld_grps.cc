@@ -35,7 +35,7 @@ int chi_diffusion::Solver::InitializePWLDGroups(bool verbose)
     chi_log.Log(LOG_0) << "Computing cell matrices";
   pwl_sdm = ((SpatialDiscretization_PWL*)(this->discretization));
   pwl_sdm->AddViewOfLocalContinuum(grid);
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
   //================================================== Reorder nodes
   if (verbose)
@@ -43,7 +43,7 @@ int chi_diffusion::Solver::InitializePWLDGroups(bool verbose)
   ChiTimer t_reorder; t_reorder.Reset();
   ReorderNodesPWLD();
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
   if (verbose)
     chi_log.Log(LOG_0) << "Time taken during nodal reordering "
                        << t_reorder.GetTime()/1000.0;
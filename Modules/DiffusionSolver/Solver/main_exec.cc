@@ -29,4 +29,20 @@ int chi_diffusion::Solver::ExecuteS(bool suppress_assembly,
   }
 
   return 0;
+}
+
+//###################################################################
+/**Changes the relative residual tolerance of an initialized solver
+ * without re-initializing it.*/
+void chi_diffusion::Solver::SetResidualTolerance(double tolerance)
+{
+  residual_tolerance = tolerance;
+
+  if (fem_method == PWLD_MIP_GRPS)
+  {
+    for (int gr=0; gr<G; gr++)
+      KSPSetTolerances(kspg[gr],1.e-50,residual_tolerance,1.0e50,max_iters);
+  }
+  else
+    KSPSetTolerances(ksp,1.e-50,residual_tolerance,1.0e50,max_iters);
 }
\ No newline at end of file
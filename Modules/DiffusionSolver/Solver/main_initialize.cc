@@ -53,7 +53,7 @@ int chi_diffusion::Solver::Initialize(bool verbose)
          "method not specified.";
     exit(EXIT_FAILURE);
   }
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
   chi_log.Log(LOG_0)
     << chi_program_timer.GetTimeString() << " "
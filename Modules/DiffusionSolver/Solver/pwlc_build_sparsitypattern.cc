@@ -90,5 +90,5 @@ extern ChiMPI chi_mpi;
 //    }//for i
 //  }
 //
-//  MPI_Barrier(MPI_COMM_WORLD);
+//  MPI_Barrier(chi_mpi.comm);
 //}
\ No newline at end of file
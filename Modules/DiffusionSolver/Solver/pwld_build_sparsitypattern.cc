@@ -59,7 +59,7 @@ void chi_diffusion::Solver::PWLDBuildSparsityPattern()
       }//if bndry
     }//for face v's
   }//for local cell
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
 
 
@@ -126,7 +126,7 @@ void chi_diffusion::Solver::PWLDBuildSparsityPattern()
   }//for local cell
 
   chi_log.Log(LOG_0) << "Broadcasting border cell information.";
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
   //================================================== Distribute border info
   std::vector<int> locI_info_size;
@@ -142,7 +142,7 @@ void chi_diffusion::Solver::PWLDBuildSparsityPattern()
     {
       locI_info_size[locI] = border_cell_info.size();
     }
-    MPI_Bcast(&locI_info_size[locI],1,MPI_INT,locI,MPI_COMM_WORLD);
+    MPI_Bcast(&locI_info_size[locI],1,MPI_INT,locI,chi_mpi.comm);
   }
 
   //======================================== Collect info
@@ -158,12 +158,12 @@ void chi_diffusion::Solver::PWLDBuildSparsityPattern()
       locI_border_cell_info[locI].resize(locI_info_size[locI]);
 
     MPI_Bcast(locI_border_cell_info[locI].data(),
-              locI_info_size[locI],MPI_INT,locI,MPI_COMM_WORLD);
+              locI_info_size[locI],MPI_INT,locI,chi_mpi.comm);
   }
 
   if (true)
     chi_log.Log(LOG_0) << "Deserializing border cell information.";
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
   //================================================== Deserialize border info
   // The vectorized values will be as follows
@@ -255,7 +255,7 @@ void chi_diffusion::Solver::PWLDBuildSparsityPattern()
       dof_count++;
     }//for v
   }//for local cell
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
 
   chi_log.Log(LOG_0) << "Done creating DFEM sparsity pattern";
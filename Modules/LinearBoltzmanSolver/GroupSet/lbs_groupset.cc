@@ -22,11 +22,17 @@ LBSGroupset::LBSGroupset()
   iterative_method = NPT_GMRES;
   angleagg_method  = LinearBoltzman::AngleAggregationType::POLAR;
   angle_agg = new AngleAgg;
+  angle_agg_max_angles = 0;
+  angle_agg_cone_angle = M_PI/6.0;
   master_num_grp_subsets = 1;
   master_num_ang_subsets = 1;
   residual_tolerance = 1.0e-6;
   max_iterations = 200;
   gmres_restart_intvl = 30;
+  krylov_type = "gmres";
+  dsa_mode = LinearBoltzman::DSAMode::IN_OPERATOR;
+  anderson_depth = 5;
+  anderson_damping = 1.0;
   apply_wgdsa = false;
   apply_tgdsa = false;
 
@@ -42,11 +48,27 @@ LBSGroupset::LBSGroupset()
   wgdsa_verbose = false;
   tgdsa_verbose = false;
 
+  dsa_inexact = false;
+  dsa_inexact_max_tol = 1.0e-1;
+
   allow_cycles = false;
 
   log_sweep_events = false;
 
+  auto_tune = false;
+  auto_tune_sweeps = 2;
+  auto_tuned = false;
+
   latest_convergence_metric = 1.0;
+
+  krylov_solver  = nullptr;
+  krylov_matrix  = nullptr;
+  krylov_x       = nullptr;
+  krylov_b       = nullptr;
+  krylov_phi_old = nullptr;
+  krylov_context = nullptr;
+  krylov_local_size = 0;
+  krylov_globl_size = 0;
 }
 
 //###################################################################
@@ -59,8 +81,10 @@ void LBSGroupset::BuildDiscMomOperator(int scatt_order)
   int num_angles = quadrature->abscissae.size();
   int num_moms = 0;
 
+  d2m_op.clear();
+
   //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% 1D Slab
-  if (typeid(*mesher) == typeid(chi_mesh::VolumeMesherLinemesh1D))
+  if (mesher->Type() == chi_mesh::VolumeMesherType::LINEMESH1D)
   {
     int mc=-1; //moment count
     for (int ell=0; ell<=scatt_order; ell++)
@@ -85,9 +109,9 @@ void LBSGroupset::BuildDiscMomOperator(int scatt_order)
     }//for ell
   }//line mesh
   //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% 2D and 3D
-  else if ( (typeid(*mesher) == typeid(chi_mesh::VolumeMesherPredefined2D)) or
-            (typeid(*mesher) == typeid(chi_mesh::VolumeMesherExtruder)) or
-            (typeid(*mesher) == typeid(chi_mesh::VolumeMesherPredefined3D)) )
+  else if ( (mesher->Type() == chi_mesh::VolumeMesherType::PREDEFINED2D) or
+            (mesher->Type() == chi_mesh::VolumeMesherType::EXTRUDER) or
+            (mesher->Type() == chi_mesh::VolumeMesherType::PREDEFINED3D) )
   {
     int mc=-1; //moment count
     for (int ell=0; ell<=scatt_order; ell++)
@@ -147,8 +171,10 @@ void LBSGroupset::BuildMomDiscOperator(int scatt_order)
   int num_angles = quadrature->abscissae.size();
   int num_moms = 0;
 
+  m2d_op.clear();
+
   //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% 1D Slab
-  if (typeid(*mesher) == typeid(chi_mesh::VolumeMesherLinemesh1D))
+  if (mesher->Type() == chi_mesh::VolumeMesherType::LINEMESH1D)
   {
     int mc=-1;
     for (int ell=0; ell<=scatt_order; ell++)
@@ -173,9 +199,9 @@ void LBSGroupset::BuildMomDiscOperator(int scatt_order)
     }//for ell
   }//line mesh
   //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% 2D and 3D
-  else if ( (typeid(*mesher) == typeid(chi_mesh::VolumeMesherPredefined2D)) or
-            (typeid(*mesher) == typeid(chi_mesh::VolumeMesherExtruder)) or
-            (typeid(*mesher) == typeid(chi_mesh::VolumeMesherPredefined3D)) )
+  else if ( (mesher->Type() == chi_mesh::VolumeMesherType::PREDEFINED2D) or
+            (mesher->Type() == chi_mesh::VolumeMesherType::EXTRUDER) or
+            (mesher->Type() == chi_mesh::VolumeMesherType::PREDEFINED3D) )
   {
     int mc=-1;
     for (int ell=0; ell<=scatt_order; ell++)
@@ -230,6 +256,13 @@ void LBSGroupset::BuildMomDiscOperator(int scatt_order)
 /**Constructs the groupset subsets.*/
 void LBSGroupset::BuildSubsets()
 {
+  grp_subsets.clear();
+  grp_subset_sizes.clear();
+  ang_subsets_top.clear();
+  ang_subset_sizes_top.clear();
+  ang_subsets_bot.clear();
+  ang_subset_sizes_bot.clear();
+
   //=================================== Groupset subsets
   int num_gs_subsets = 1;
   if (master_num_grp_subsets <= groups.size())
@@ -273,7 +306,7 @@ void LBSGroupset::BuildSubsets()
     ang_subsets_top.push_back(AngSubSet(subset_ranki,subset_ranki+subset_size-1));
     ang_subset_sizes_top.push_back(subset_size);
 
-    if (angleagg_method != LinearBoltzman::AngleAggregationType::SINGLE)
+    if (angleagg_method == LinearBoltzman::AngleAggregationType::POLAR)
       chi_log.Log(LOG_0)
         << "Top-hemi Angle subset " << ss << " "
         << subset_ranki << "->" << subset_ranki+subset_size-1;
@@ -291,18 +324,40 @@ void LBSGroupset::BuildSubsets()
     ang_subsets_bot.push_back(AngSubSet(subset_ranki,subset_ranki+subset_size-1));
     ang_subset_sizes_bot.push_back(subset_size);
 
-    if (angleagg_method != LinearBoltzman::AngleAggregationType::SINGLE)
+    if (angleagg_method == LinearBoltzman::AngleAggregationType::POLAR)
       chi_log.Log(LOG_0)
         << "Bot-hemi Angle subset " << ss << " "
         << subset_ranki << "->" << subset_ranki+subset_size-1;
   }//for ss
 }
 
+//###################################################################
+/**Returns true when the Krylov type supports a preconditioner that
+ * changes between iterations. These methods only support right
+ * preconditioning.*/
+bool LBSGroupset::KrylovTypeIsFlexible() const
+{
+  return (krylov_type == "fgmres") or (krylov_type == "pipefgmres") or
+         (krylov_type == "gcr")    or (krylov_type == "pipegcr");
+}
+
+//###################################################################
+/**Returns true when the DSA tolerance may be relaxed during the Krylov
+ * solve. A relaxed DSA solve changes the operator it is applied in, which
+ * is only safe when DSA is the preconditioner of a flexible Krylov
+ * method.*/
+bool LBSGroupset::InexactDSAAllowed() const
+{
+  return KrylovTypeIsFlexible() and
+         (dsa_mode != LinearBoltzman::DSAMode::IN_OPERATOR);
+}
+
 //###################################################################
 /**Constructs the groupset subsets.*/
 void LBSGroupset::PrintSweepInfoFile(size_t ev_tag, std::string file_name)
 {
   if (not log_sweep_events) return;
+  if (chi_mpi.team_id != 0) return;
 
   std::ofstream ofile;
   ofile.open(file_name,std::ofstream::out);
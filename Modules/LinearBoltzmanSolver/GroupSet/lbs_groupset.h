@@ -10,12 +10,62 @@
 
 #include <ChiPhysics/chi_physics_namespace.h>
 
+#include <petscksp.h>
+
 namespace LinearBoltzman
 {
   enum class AngleAggregationType
   {
     SINGLE = 1,
-    POLAR = 2
+    POLAR = 2,
+    OCTANT = 3,
+    CONE = 4
+  };
+
+  /**Determines how DSA is applied in a groupset Krylov solve. With
+   * IN_OPERATOR the DSA correction is part of the matrix action, otherwise
+   * the operator is the bare transport operator and DSA is applied as a
+   * left or right preconditioner.*/
+  enum class DSAMode
+  {
+    IN_OPERATOR          = 0,
+    LEFT_PRECONDITIONER  = 1,
+    RIGHT_PRECONDITIONER = 2
+  };
+
+  /**Counts of the DSA solves within one groupset Krylov solve. The
+   * reference counts are of applications solved at the user tolerance.*/
+  struct DSAIterationStats
+  {
+    int applications     = 0;
+    int iterations       = 0;
+    int ref_applications = 0;
+    int ref_iterations   = 0;
+  };
+
+  /**Scattering and fission data of one material sliced for the groups
+   * of one groupset, built once per groupset solve so that the source
+   * computation does not have to filter the full transfer matrices.
+   *
+   * For every Legendre order the transfer rows of the groupset groups are
+   * stored in CSR form, split into within-groupset and across-groupset
+   * source groups. Fission, \f$ \chi_g \sum_{g'} \nu\sigma_{f,g'}
+   * \phi_{g'} \f$, is rank one and is applied as a dot product followed
+   * by a scaling instead of a dense group-to-group loop.*/
+  struct GroupsetXSBlock
+  {
+    struct CSRBlock
+    {
+      std::vector<int>    row_start;   ///< Size num groupset groups + 1
+      std::vector<int>    col;         ///< Absolute source group
+      std::vector<double> val;
+    };
+
+    std::vector<CSRBlock> within;      ///< Per Legendre order
+    std::vector<CSRBlock> across;      ///< Per Legendre order
+
+    bool                fissile = false;
+    std::vector<double> chi;           ///< Groupset groups only
   };
 }
 
@@ -23,6 +73,8 @@ typedef chi_mesh::sweep_management::AngleAggregation AngleAgg;
 typedef std::pair<int,int> GsSubSet;
 typedef std::pair<int,int> AngSubSet;
 
+struct KSPDataContext;
+
 #include <vector>
 
 //################################################################### Class def
@@ -43,12 +95,19 @@ public:
   std::vector<int>                             ang_subset_sizes_top;
   std::vector<AngSubSet>                       ang_subsets_bot;
   std::vector<int>                             ang_subset_sizes_bot;
+  std::vector<std::vector<int>>                angle_clusters;
 
   int                                          iterative_method;
   LinearBoltzman::AngleAggregationType         angleagg_method;
+  int                                          angle_agg_max_angles;
+  double                                       angle_agg_cone_angle;
   double                                       residual_tolerance;
   int                                          max_iterations;
   int                                          gmres_restart_intvl;
+  std::string                                  krylov_type;
+  LinearBoltzman::DSAMode                      dsa_mode;
+  int                                          anderson_depth;
+  double                                       anderson_damping;
   bool                                         apply_wgdsa;
   bool                                         apply_tgdsa;
   int                                          wgdsa_max_iters;
@@ -57,6 +116,11 @@ public:
   double                                       tgdsa_tol;
   bool                                         wgdsa_verbose;
   bool                                         tgdsa_verbose;
+  bool                                         dsa_inexact;
+  double                                       dsa_inexact_max_tol;
+  LinearBoltzman::DSAIterationStats            dsa_stats;
+
+  std::vector<LinearBoltzman::GroupsetXSBlock> xs_blocks;
   std::string                                  wgdsa_string;
   std::string                                  tgdsa_string;
 
@@ -68,13 +132,32 @@ public:
 
   bool                                         log_sweep_events;
 
+  //Auto-tuning of the group subsets and angle aggregation
+  bool                                         auto_tune;
+  int                                          auto_tune_sweeps;
+  std::string                                  auto_tune_cache_file;
+  bool                                         auto_tuned;
+
   double                                       latest_convergence_metric;
 
+  //Krylov objects, created lazily by the Krylov solve and reused
+  //while the groupset stays initialized
+  KSP                                          krylov_solver;
+  Mat                                          krylov_matrix;
+  Vec                                          krylov_x;
+  Vec                                          krylov_b;
+  Vec                                          krylov_phi_old;
+  KSPDataContext*                              krylov_context;
+  int                                          krylov_local_size;
+  int                                          krylov_globl_size;
+
   //npt_groupset.cc
        LBSGroupset();
   void BuildDiscMomOperator(int scatt_order);
   void BuildMomDiscOperator(int scatt_order);
   void BuildSubsets();
+  bool KrylovTypeIsFlexible() const;
+  bool InexactDSAAllowed() const;
 public:
   void PrintSweepInfoFile(size_t ev_tag,std::string file_name);
 };
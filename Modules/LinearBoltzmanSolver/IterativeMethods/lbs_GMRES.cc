@@ -6,6 +6,7 @@
 #include "../Tools/kspmonitor_npt.h"
 #include "../Tools/ksp_data_context.h"
 #include "../IterativeOperations/lbs_matrixaction_Ax.h"
+#include "../IterativeOperations/lbs_preconditioner_dsa.h"
 
 #include "../../DiffusionSolver/Solver/diffusion_solver.h"
 
@@ -23,93 +24,204 @@ typedef sweep_namespace::SweepScheduler MainSweepScheduler;
 typedef sweep_namespace::SchedulingAlgorithm SchedulingAlgorithm;
 
 //###################################################################
-/**Solves a groupset using GMRES.*/
-void LinearBoltzman::Solver::GMRES(int group_set_num)
+/**Creates the shell matrix, vectors, Krylov solver and preconditioner
+ * of a groupset. These are owned by the groupset and reused by all
+ * its Krylov solves, including the Krylov basis, until destroyed by
+ * DestroyKrylovSolver or until the sizes no longer match.*/
+void LinearBoltzman::Solver::
+  InitKrylovSolver(LBSGroupset* groupset, int local_size, int globl_size)
 {
-  chi_log.Log(LOG_0)
-    << "\n\n";
-  chi_log.Log(LOG_0)
-    << "********** Solving groupset " << group_set_num
-    << " with GMRES.\n\n";
-
-  //================================================== Obtain groupset
-  LBSGroupset* groupset = group_sets[group_set_num];
-  int groupset_numgrps = groupset->groups.size();
-  chi_log.Log(LOG_0)
-    << "Quadrature number of angles: "
-    << groupset->quadrature->abscissae.size() << "\n"
-    << "Number of azimuthal angles : "
-    << groupset->quadrature->azimu_ang.size() << "\n"
-    << "Number of polar angles     : "
-    << groupset->quadrature->polar_ang.size() << "\n\n";
+  DestroyKrylovSolver(groupset);
 
-  //================================================== Setting up required
-  //                                                   sweep chunks
-  SweepChunk* sweep_chunk = SetSweepChunk(group_set_num);
-  MainSweepScheduler sweepScheduler(SchedulingAlgorithm::DEPTH_OF_GRAPH,
-                                    groupset->angle_agg);
-
-  //=================================================== Create Data context
-  //                                                    available inside
-  //                                                    Action
-  KSPDataContext data_context;
-  data_context.solver         = this;
-  data_context.sweep_chunk    = sweep_chunk;
-  data_context.group_set_num  = group_set_num;
-  data_context.groupset       = groupset;
-  data_context.sweepScheduler = &sweepScheduler;
+  bool dsa_as_pc = (groupset->apply_wgdsa || groupset->apply_tgdsa) and
+                   (groupset->dsa_mode != DSAMode::IN_OPERATOR);
 
+  groupset->krylov_context = new KSPDataContext;
+  KSPDataContext* data_context = groupset->krylov_context;
+  data_context->dsa_in_operator = not dsa_as_pc;
+  data_context->phi_zero.assign(phi_old_local.size(),0.0);
 
   //=================================================== Create the matrix
   Mat A;
-  auto num_ang_unknowns = groupset->angle_agg->GetNumberOfAngularUnknowns();
-  int local_size = local_dof_count*num_moments*groupset_numgrps +
-                   num_ang_unknowns.first;
-  int globl_size = glob_dof_count*num_moments*groupset_numgrps +
-                   num_ang_unknowns.second;
   MatCreateShell(PETSC_COMM_WORLD,local_size,
                                   local_size,
                                   globl_size,
                                   globl_size,
-                                  &data_context,&A);
+                                  data_context,&A);
 
   //================================================== Set the action-operator
   MatShellSetOperation(A, MATOP_MULT,(void (*)(void)) NPTMatrixAction_Ax);
 
   //================================================== Initial vector assembly
+  Vec phi_new;
   VecCreate(PETSC_COMM_WORLD,&phi_new);
-  VecCreate(PETSC_COMM_WORLD,&phi_old);
-  VecCreate(PETSC_COMM_WORLD,&q_fixed);
 
   VecSetSizes(phi_new,
               local_size,     //Local size
               globl_size);     //Global size
   VecSetType(phi_new,VECMPI);
   VecSet(phi_new,0.0);
-  VecDuplicate(phi_new,&phi_old);
-  VecDuplicate(phi_new,&q_fixed);
-  VecDuplicate(phi_new,&data_context.x_temp);
+  VecDuplicate(phi_new,&groupset->krylov_phi_old);
+  VecDuplicate(phi_new,&groupset->krylov_b);
+  VecDuplicate(phi_new,&data_context->x_temp);
 
   //================================================== Create Krylov Solver
   KSP ksp;
   KSPCreate(PETSC_COMM_WORLD, &ksp);
-  KSPSetType(ksp,KSPGMRES);
+  KSPSetType(ksp,groupset->krylov_type.c_str());
   KSPSetOperators(ksp,A,A);
-  data_context.krylov_solver = ksp;
+  data_context->krylov_solver = ksp;
 
   PC pc;
   KSPGetPC(ksp,&pc);
-  PCSetType(pc,PCNONE);
+  if (dsa_as_pc)
+  {
+    PCSetType(pc,PCSHELL);
+    PCShellSetApply(pc,NPTPreconditionerAction_DSA);
+    PCShellSetContext(pc,data_context);
+    PCShellSetName(pc,"DSA");
+
+    //Flexible methods only support right preconditioning
+    if (groupset->dsa_mode == DSAMode::RIGHT_PRECONDITIONER or
+        groupset->KrylovTypeIsFlexible())
+      KSPSetPCSide(ksp,PC_RIGHT);
+    else
+      KSPSetPCSide(ksp,PC_LEFT);
+  }
+  else
+    PCSetType(pc,PCNONE);
 
   KSPSetTolerances(ksp,1.e-50,
                    groupset->residual_tolerance,1.0e50,
                    groupset->max_iterations);
   KSPGMRESSetRestart(ksp,groupset->gmres_restart_intvl);
-  KSPSetApplicationContext(ksp,&data_context);
+  KSPSetApplicationContext(ksp,data_context);
   KSPSetConvergenceTest(ksp,&KSPConvergenceTestNPT,NULL,NULL);
   KSPSetInitialGuessNonzero(ksp,PETSC_TRUE);
   KSPSetUp(ksp);
 
+  groupset->krylov_solver     = ksp;
+  groupset->krylov_matrix     = A;
+  groupset->krylov_x          = phi_new;
+  groupset->krylov_local_size = local_size;
+  groupset->krylov_globl_size = globl_size;
+}
+
+//###################################################################
+/**Destroys the Krylov objects of a groupset, if any.*/
+void LinearBoltzman::Solver::DestroyKrylovSolver(LBSGroupset* groupset)
+{
+  if (groupset->krylov_solver == nullptr) return;
+
+  KSPDestroy(&groupset->krylov_solver);
+  VecDestroy(&groupset->krylov_x);
+  VecDestroy(&groupset->krylov_phi_old);
+  VecDestroy(&groupset->krylov_b);
+  VecDestroy(&groupset->krylov_context->x_temp);
+  MatDestroy(&groupset->krylov_matrix);
+  delete groupset->krylov_context;
+
+  groupset->krylov_solver  = nullptr;
+  groupset->krylov_matrix  = nullptr;
+  groupset->krylov_x       = nullptr;
+  groupset->krylov_phi_old = nullptr;
+  groupset->krylov_b       = nullptr;
+  groupset->krylov_context = nullptr;
+  groupset->krylov_local_size = 0;
+  groupset->krylov_globl_size = 0;
+}
+
+//###################################################################
+/**Solves a groupset using a PETSc Krylov method, GMRES by default.
+ *
+ * The Krylov type is the groupset's krylov_type. When DSA is applied as
+ * a preconditioner (groupset dsa_mode LEFT/RIGHT_PRECONDITIONER) the matrix
+ * action is the bare transport operator \f$ I - DLM^{-1}S \f$ and the
+ * DSA correction is applied by a PCSHELL, otherwise DSA is part of the
+ * matrix action and no preconditioner is used.*/
+void LinearBoltzman::Solver::GMRES(int group_set_num)
+{
+  //================================================== Obtain groupset
+  LBSGroupset* groupset = group_sets[group_set_num];
+  bool dsa_as_pc = (groupset->apply_wgdsa || groupset->apply_tgdsa) and
+                   (groupset->dsa_mode != DSAMode::IN_OPERATOR);
+
+  chi_log.Log(LOG_0)
+    << "\n\n";
+  chi_log.Log(LOG_0)
+    << "********** Solving groupset " << group_set_num
+    << " with Krylov method " << groupset->krylov_type
+    << (dsa_as_pc? " and DSA preconditioning" : "") << ".\n\n";
+
+  if (groupset->dsa_inexact and (not groupset->InexactDSAAllowed()))
+    chi_log.Log(LOG_0WARNING)
+      << "Inexact DSA requires a flexible Krylov method with DSA applied "
+      << "as a preconditioner. The DSA tolerance is kept fixed.";
+
+  int groupset_numgrps = groupset->groups.size();
+  chi_log.Log(LOG_0)
+    << "Quadrature number of angles: "
+    << groupset->quadrature->abscissae.size() << "\n"
+    << "Number of azimuthal angles : "
+    << groupset->quadrature->azimu_ang.size() << "\n"
+    << "Number of polar angles     : "
+    << groupset->quadrature->polar_ang.size() << "\n\n";
+
+  //================================================== Setting up required
+  //                                                   sweep chunks
+  SweepChunk* sweep_chunk = SetSweepChunk(group_set_num);
+  MainSweepScheduler sweepScheduler(SchedulingAlgorithm::DEPTH_OF_GRAPH,
+                                    groupset->angle_agg);
+
+  //=================================================== Create or reuse the
+  //                                                    Krylov objects
+  auto num_ang_unknowns = groupset->angle_agg->GetNumberOfAngularUnknowns();
+  if ((chi_mpi.num_teams > 1) and (num_ang_unknowns.second > 0) and
+      (options.team_decomposition == TeamDecomposition::ANGLE))
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Angular teams do not support Krylov solves with angular "
+         "unknowns (delayed angular fluxes).";
+    exit(EXIT_FAILURE);
+  }
+  int local_size = local_dof_count*num_moments*groupset_numgrps +
+                   num_ang_unknowns.first;
+  int globl_size = glob_dof_count*num_moments*groupset_numgrps +
+                   num_ang_unknowns.second;
+
+  if ((groupset->krylov_solver == nullptr) or
+      (groupset->krylov_local_size != local_size) or
+      (groupset->krylov_globl_size != globl_size))
+    InitKrylovSolver(groupset,local_size,globl_size);
+
+  KSP ksp        = groupset->krylov_solver;
+  Vec phi_new    = groupset->krylov_x;
+  Vec phi_old    = groupset->krylov_phi_old;
+  Vec q_fixed    = groupset->krylov_b;
+
+  //=================================================== Update Data context
+  //                                                    available inside
+  //                                                    Action
+  KSPDataContext& data_context = *groupset->krylov_context;
+  data_context.solver         = this;
+  data_context.sweep_chunk    = sweep_chunk;
+  data_context.group_set_num  = group_set_num;
+  data_context.groupset       = groupset;
+  data_context.sweepScheduler = &sweepScheduler;
+  data_context.last_iteration = -1;
+  data_context.pc_rhs_norm    = -1.0;
+
+  groupset->latest_convergence_metric = 1.0;
+  groupset->dsa_stats = DSAIterationStats();
+
+  PC pc;
+  KSPGetPC(ksp,&pc);
+
+  //Tolerances can change between solves, e.g., in outer iterations
+  KSPSetTolerances(ksp,1.e-50,
+                   groupset->residual_tolerance,1.0e50,
+                   groupset->max_iterations);
+
   //================================================== Compute b
   chi_log.Log(LOG_0) << chi_program_timer.GetTimeString() << " Computing b";
   SetSource(group_set_num,SourceFlags::USE_MATERIAL_SOURCE,
@@ -118,20 +230,21 @@ void LinearBoltzman::Solver::GMRES(int group_set_num)
 
   phi_new_local.assign(phi_new_local.size(),0.0);
   sweepScheduler.Sweep(sweep_chunk);
+  ReduceAngularMoments(groupset);
 
   //=================================================== Apply DSA
-  if (groupset->apply_wgdsa)
+  //Only when DSA is part of the operator, the preconditioner
+  //otherwise handles it.
+  if (groupset->apply_wgdsa and (not dsa_as_pc))
   {
-    std::vector<double> phi_old_gmres(phi_old_local.size(),0.0);
-    AssembleWGDSADeltaPhiVector(groupset, phi_old_gmres.data(), phi_new_local.data());
-    ((chi_diffusion::Solver*)groupset->wgdsa_solver)->ExecuteS(true,false);
+    AssembleWGDSADeltaPhiVector(groupset, data_context.phi_zero.data(), phi_new_local.data());
+    ExecuteKrylovDSA(groupset,groupset->wgdsa_solver,groupset->wgdsa_tol);
     DisAssembleWGDSADeltaPhiVector(groupset, phi_new_local.data());
   }
-  if (groupset->apply_tgdsa)
+  if (groupset->apply_tgdsa and (not dsa_as_pc))
   {
-    std::vector<double> phi_old_gmres(phi_old_local.size(),0.0);
-    AssembleTGDSADeltaPhiVector(groupset, phi_old_gmres.data(), phi_new_local.data());
-    ((chi_diffusion::Solver*)groupset->tgdsa_solver)->ExecuteS(true,false);
+    AssembleTGDSADeltaPhiVector(groupset, data_context.phi_zero.data(), phi_new_local.data());
+    ExecuteKrylovDSA(groupset,groupset->tgdsa_solver,groupset->tgdsa_tol);
     DisAssembleTGDSADeltaPhiVector(groupset, phi_new_local.data());
   }
 
@@ -139,6 +252,15 @@ void LinearBoltzman::Solver::GMRES(int group_set_num)
   AssembleVector(groupset,q_fixed,phi_new_local.data());
   AssembleVector(groupset,phi_old,phi_old_local.data());
 
+  //=================================================== Preconditioned rhs norm
+  PCSide pc_side;
+  KSPGetPCSide(ksp,&pc_side);
+  if (dsa_as_pc and (pc_side == PC_LEFT))
+  {
+    NPTPreconditionerAction_DSA(pc,q_fixed,data_context.x_temp);
+    VecNorm(data_context.x_temp,NORM_2,&data_context.pc_rhs_norm);
+  }
+
   //=================================================== Retool for GMRES
   sweep_chunk->SetDestinationPhi(&phi_new_local);
   sweep_chunk->suppress_surface_src = true; //Action of Ax specific
@@ -151,9 +273,11 @@ void LinearBoltzman::Solver::GMRES(int group_set_num)
     VecCopy(phi_old,phi_new);
     chi_log.Log(LOG_0) << "Using phi_old as initial guess.";
   }
+  else
+    VecSet(phi_new,0.0);
 
 
-  //**************** CALL GMRES SOLVE ******************
+  //**************** CALL KRYLOV SOLVE *****************
   chi_log.Log(LOG_0)
     << chi_program_timer.GetTimeString() << " Starting iterations";
   KSPSolve(ksp,q_fixed,phi_new);
@@ -163,7 +287,7 @@ void LinearBoltzman::Solver::GMRES(int group_set_num)
   KSPGetConvergedReason(ksp,&reason);
   if (reason != KSP_CONVERGED_RTOL)
     chi_log.Log(LOG_0WARNING)
-      << "GMRES solver failed. "
+      << "Krylov solver failed. "
       << "Reason: " << chi_physics::GetPETScConvergedReasonstring(reason);
 
 
@@ -171,12 +295,16 @@ void LinearBoltzman::Solver::GMRES(int group_set_num)
   DisAssembleVector(groupset, phi_new, phi_old_local.data());
 
   //==================================================== Clean up
-  KSPDestroy(&ksp);
-  VecDestroy(&phi_new);
-  VecDestroy(&phi_old);
-  VecDestroy(&q_fixed);
-  VecDestroy(&data_context.x_temp);
-  MatDestroy(&A);
+  //The Krylov objects are kept with the groupset
+  delete sweep_chunk;
+
+  //Restore the user DSA tolerances relaxed by inexact DSA
+  if (groupset->apply_wgdsa)
+    ((chi_diffusion::Solver*)groupset->wgdsa_solver)->
+      SetResidualTolerance(groupset->wgdsa_tol);
+  if (groupset->apply_tgdsa)
+    ((chi_diffusion::Solver*)groupset->tgdsa_solver)->
+      SetResidualTolerance(groupset->tgdsa_tol);
 
 
 
@@ -205,6 +333,7 @@ void LinearBoltzman::Solver::GMRES(int group_set_num)
     << sweep_time*1.0e9*chi_mpi.process_count/num_unknowns;
   chi_log.Log(LOG_0)
     << "        Number of unknowns per sweep:  " << num_unknowns;
+  LogDSAIterationStats(groupset);
   chi_log.Log(LOG_0)
     << "\n\n";
 
@@ -0,0 +1,309 @@
+#include "../lbs_linear_boltzman_solver.h"
+
+#include "ChiMesh/SweepUtilities/SweepScheduler/sweepscheduler.h"
+#include "../../DiffusionSolver/Solver/diffusion_solver.h"
+
+#include <ChiTimer/chi_timer.h>
+
+#include <chi_log.h>
+#include <chi_mpi.h>
+extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
+
+#include <deque>
+
+namespace sweep_namespace = chi_mesh::sweep_management;
+typedef sweep_namespace::SweepChunk SweepChunk;
+typedef sweep_namespace::SweepScheduler MainSweepScheduler;
+typedef sweep_namespace::SchedulingAlgorithm SchedulingAlgorithm;
+
+extern ChiTimer chi_program_timer;
+
+//###################################################################
+/**Solves a groupset using source iteration with Anderson acceleration,
+ * also known as nonlinear Krylov acceleration (NKA).
+ *
+ * A source iteration (sweep plus optional DSA) is a fixed point map
+ * \f$ x \to G(x) \f$ on the groupset flux moments. With the residuals
+ * \f$ f_k = G(x_k) - x_k \f$ and the differences
+ * \f$ \Delta F, \Delta X \f$ of the last m iterates, the update is
+ * \f[
+ *  x_{k+1} = x_k + \beta f_k - (\Delta X + \beta \Delta F)\gamma, \quad
+ *  \gamma = \arg\min \| f_k - \Delta F \gamma \|
+ * \f]
+ * where m is the groupset's anderson_depth and \f$ \beta \f$ the
+ * anderson_damping. Only 2m vectors of the groupset size are stored, in
+ * contrast to the Krylov basis of GMRES.*/
+void LinearBoltzman::Solver::Anderson(int group_set_num)
+{
+  chi_log.Log(LOG_0)
+    << "\n\n";
+  chi_log.Log(LOG_0)
+    << "********** Solving groupset " << group_set_num
+    << " with Anderson acceleration (depth "
+    << group_sets[group_set_num]->anderson_depth << ", damping "
+    << group_sets[group_set_num]->anderson_damping << ").\n\n";
+
+  //================================================== Obtain groupset
+  LBSGroupset* groupset = group_sets[group_set_num];
+  int gsi = groupset->groups.front()->id;
+  int gss = groupset->groups.size();
+  chi_log.Log(LOG_0)
+    << "Quadrature number of angles: "
+    << groupset->quadrature->abscissae.size() << "\n"
+    << "Number of azimuthal angles : "
+    << groupset->quadrature->azimu_ang.size() << "\n"
+    << "Number of polar angles     : "
+    << groupset->quadrature->polar_ang.size() << "\n"
+    << "Groups " << groupset->groups.front()->id << " "
+    << groupset->groups.back()->id << "\n\n";
+
+  //================================================== Setting up required
+  //                                                   sweep chunks
+  SweepChunk* sweep_chunk = SetSweepChunk(group_set_num);
+
+  //================================================== Set sweep scheduler
+  MainSweepScheduler sweepScheduler(SchedulingAlgorithm::DEPTH_OF_GRAPH,
+                                    groupset->angle_agg);
+
+  //================================================== Tool the sweep chunk
+  sweep_chunk->SetDestinationPhi(&phi_new_local);
+
+  //================================================== Groupset vector ops
+  size_t num_gs_dofs = (size_t)local_dof_count*num_moments*gss;
+
+  auto Gather = [this,gsi,gss](const std::vector<double>& phi,
+                               std::vector<double>& x)
+  {
+    size_t index = 0;
+    for (const auto& cell : grid->local_cells)
+    {
+      auto transport_view =
+        (LinearBoltzman::CellViewFull*)cell_transport_views[cell.local_id];
+      for (int i=0; i < cell.vertex_ids.size(); i++)
+        for (int m=0; m<num_moments; m++)
+        {
+          const double* phi_mapped = &phi[transport_view->MapDOF(i,m,gsi)];
+          for (int g=0; g<gss; g++) x[index++] = phi_mapped[g];
+        }
+    }
+  };
+
+  auto Scatter = [this,gsi,gss](const std::vector<double>& x,
+                                std::vector<double>& phi)
+  {
+    size_t index = 0;
+    for (const auto& cell : grid->local_cells)
+    {
+      auto transport_view =
+        (LinearBoltzman::CellViewFull*)cell_transport_views[cell.local_id];
+      for (int i=0; i < cell.vertex_ids.size(); i++)
+        for (int m=0; m<num_moments; m++)
+        {
+          double* phi_mapped = &phi[transport_view->MapDOF(i,m,gsi)];
+          for (int g=0; g<gss; g++) phi_mapped[g] = x[index++];
+        }
+    }
+  };
+
+  //================================================== Anderson storage
+  const int    depth = std::max(groupset->anderson_depth,0);
+  const double beta  = groupset->anderson_damping;
+
+  std::vector<double> x(num_gs_dofs,0.0), gx(num_gs_dofs,0.0);
+  std::vector<double> f(num_gs_dofs,0.0);
+  std::vector<double> x_prev, f_prev;
+  std::deque<std::vector<double>> delta_x, delta_f;
+
+  //================================================== Now start iterating
+  double pw_change = 0.0;
+  double pw_change_prev = 1.0;
+  double rho = 0.0;
+  bool converged = false;
+  for (int k=0; k<groupset->max_iterations; k++)
+  {
+    SetSource(group_set_num,SourceFlags::USE_MATERIAL_SOURCE);
+
+    groupset->angle_agg->ResetDelayedPsi();
+
+    phi_new_local.assign(phi_new_local.size(),0.0); //Ensure phi_new=0.0
+    sweepScheduler.Sweep(sweep_chunk);
+    ReduceAngularMoments(groupset);
+
+    if (groupset->apply_wgdsa)
+    {
+      AssembleWGDSADeltaPhiVector(groupset, phi_old_local.data(), phi_new_local.data());
+      ((chi_diffusion::Solver*)groupset->wgdsa_solver)->ExecuteS(true,false);
+      DisAssembleWGDSADeltaPhiVector(groupset, phi_new_local.data());
+    }
+    if (groupset->apply_tgdsa)
+    {
+      AssembleTGDSADeltaPhiVector(groupset, phi_old_local.data(), phi_new_local.data());
+      ((chi_diffusion::Solver*)groupset->tgdsa_solver)->ExecuteS(true,false);
+      DisAssembleTGDSADeltaPhiVector(groupset, phi_new_local.data());
+    }
+
+    pw_change = ComputePiecewiseChange(groupset);
+
+    //=========================================== Anderson update
+    Gather(phi_old_local,x);
+    Gather(phi_new_local,gx);
+    for (size_t i=0; i<num_gs_dofs; ++i) f[i] = gx[i] - x[i];
+
+    if ((depth > 0) and (not x_prev.empty()))
+    {
+      delta_x.emplace_back(num_gs_dofs,0.0);
+      delta_f.emplace_back(num_gs_dofs,0.0);
+      for (size_t i=0; i<num_gs_dofs; ++i)
+      {
+        delta_x.back()[i] = x[i] - x_prev[i];
+        delta_f.back()[i] = f[i] - f_prev[i];
+      }
+      if (delta_x.size() > depth)
+      {
+        delta_x.pop_front();
+        delta_f.pop_front();
+      }
+    }
+    if (depth > 0)
+    {
+      x_prev = x;
+      f_prev = f;
+    }
+
+    //Undamped/unaccelerated part
+    std::vector<double>& x_next = gx;
+    for (size_t i=0; i<num_gs_dofs; ++i) x_next[i] = x[i] + beta*f[i];
+
+    int m = delta_f.size();
+    if (m > 0)
+    {
+      //Normal equations of the least-squares problem, reduced globally
+      std::vector<double> local_sums(m*m + m,0.0);
+      for (int a=0; a<m; ++a)
+      {
+        for (int b=0; b<=a; ++b)
+        {
+          double dot = 0.0;
+          for (size_t i=0; i<num_gs_dofs; ++i)
+            dot += delta_f[a][i]*delta_f[b][i];
+          local_sums[a*m+b] = dot;
+        }
+        double dot = 0.0;
+        for (size_t i=0; i<num_gs_dofs; ++i)
+          dot += delta_f[a][i]*f[i];
+        local_sums[m*m+a] = dot;
+      }
+
+      std::vector<double> sums(m*m + m,0.0);
+      MPI_Allreduce(local_sums.data(),sums.data(),m*m + m,
+                    MPI_DOUBLE,MPI_SUM,chi_mpi.comm);
+
+      std::vector<std::vector<double>> A(m,std::vector<double>(m,0.0));
+      std::vector<double> gamma(m,0.0);
+      double max_diag = 0.0;
+      for (int a=0; a<m; ++a)
+      {
+        for (int b=0; b<=a; ++b)
+          A[a][b] = A[b][a] = sums[a*m+b];
+        gamma[a] = sums[m*m+a];
+        max_diag = std::max(max_diag,A[a][a]);
+      }
+
+      //Regularize against nearly linearly dependent differences
+      if (max_diag > 0.0)
+      {
+        for (int a=0; a<m; ++a) A[a][a] += 1.0e-12*max_diag;
+        chi_math::GaussElimination(A,gamma,m);
+
+        for (int a=0; a<m; ++a)
+        {
+          const double ga = gamma[a];
+          const auto& dx = delta_x[a];
+          const auto& df = delta_f[a];
+          for (size_t i=0; i<num_gs_dofs; ++i)
+            x_next[i] -= ga*(dx[i] + beta*df[i]);
+        }
+      }
+    }
+
+    Scatter(x_next,phi_old_local);
+    DisAssembleVectorLocalToLocal(groupset,phi_old_local.data(),
+                                           phi_new_local.data());
+
+    rho = sqrt(pw_change/pw_change_prev);
+    pw_change_prev = pw_change;
+
+    if (k==0) rho = 0.0;
+    if (pw_change<std::max(groupset->residual_tolerance*rho,1.0e-10))
+      converged = true;
+
+    //======================================== Print iteration information
+    std::string offset;
+    if (groupset->apply_wgdsa || groupset->apply_tgdsa)
+      offset = std::string("    ");
+
+    std::stringstream iter_info;
+    iter_info
+      << chi_program_timer.GetTimeString() << " "
+      << offset
+      << "WGS groups ["
+      << groupset->groups.front()->id
+      << "-"
+      << groupset->groups.back()->id
+      << "]"
+      << " Iteration " << std::setw(5) << k
+      << " Point-wise change " << std::setw(14) << pw_change
+      << " Anderson depth " << m;
+
+    if (converged)
+      iter_info << " CONVERGED\n";
+
+    chi_log.Log(LOG_0) << iter_info.str();
+
+    if (converged) break;
+
+    if (options.write_restart_data and (not EnergyTeamsActive()))
+    {
+      if ((chi_program_timer.GetTime()/60000.0) >
+          last_restart_write+options.write_restart_interval)
+      {
+        last_restart_write = chi_program_timer.GetTime()/60000.0;
+        WriteRestartData(options.write_restart_folder_name,
+                         options.write_restart_file_base);
+      }
+    }
+  }
+
+  delete sweep_chunk;
+
+  double sweep_time = sweepScheduler.GetAverageSweepTime();
+  double source_time=
+    chi_log.ProcessEvent(source_event_tag,
+                         ChiLog::EventOperation::AVERAGE_DURATION);
+  size_t num_angles = groupset->quadrature->abscissae.size();
+  long int num_unknowns = (long int)glob_dof_count*
+                          (long int)num_angles*
+                          (long int)groupset->groups.size();
+  chi_log.Log(LOG_0)
+    << "\n\n";
+  chi_log.Log(LOG_0)
+    << "        Set Src Time/sweep (s):        "
+    << source_time;
+  chi_log.Log(LOG_0)
+    << "        Average sweep time (s):        "
+    << sweep_time;
+  chi_log.Log(LOG_0)
+    << "        Sweep Time/Unknown (ns):       "
+    << sweep_time*1.0e9*chi_mpi.process_count/num_unknowns;
+  chi_log.Log(LOG_0)
+    << "        Number of unknowns per sweep:  " << num_unknowns;
+  chi_log.Log(LOG_0)
+    << "\n\n";
+
+  std::string sweep_log_file_name =
+    std::string("GS_") + std::to_string(group_set_num) +
+    std::string("_SweepLog_") + std::to_string(chi_mpi.location_id) +
+    std::string(".log");
+  groupset->PrintSweepInfoFile(sweepScheduler.sweep_event_tag,sweep_log_file_name);
+}
@@ -52,19 +52,34 @@ void LinearBoltzman::Solver::ClassicRichardson(int group_set_num)
   //================================================== Tool the sweep chunk
   sweep_chunk->SetDestinationPhi(&phi_new_local);
 
+  //The CMFD currents of every sweep replace those of the previous one,
+  //after the last iteration they belong to the groupset flux
+  bool tally_cmfd = CMFDTalliesDuringIterations(groupset);
+  if (tally_cmfd)
+    sweep_chunk->SetCurrentTally(cmfd);
+
   //================================================== Now start iterating
   double pw_change = 0.0;
   double pw_change_prev = 1.0;
   double rho = 0.0;
   bool converged = false;
+  double local_pw_change = 0.0;
+  ChiTimer check_timer;
+  double check_time = 0.0;
+  int num_iterations = 0;
+
   for (int k=0; k<groupset->max_iterations; k++)
   {
     SetSource(group_set_num,SourceFlags::USE_MATERIAL_SOURCE);
 
     groupset->angle_agg->ResetDelayedPsi();
+    if (tally_cmfd)
+      cmfd->ResetCurrentTallies(groupset->groups.front()->id,
+                                groupset_numgrps);
 
     phi_new_local.assign(phi_new_local.size(),0.0); //Ensure phi_new=0.0
     sweepScheduler.Sweep(sweep_chunk);
+    ReduceAngularMoments(groupset);
 
     if (groupset->apply_wgdsa)
     {
@@ -79,10 +94,15 @@ void LinearBoltzman::Solver::ClassicRichardson(int group_set_num)
       DisAssembleTGDSADeltaPhiVector(groupset, phi_new_local.data());
     }
 
-    pw_change = ComputePiecewiseChange(groupset);
-
-    DisAssembleVectorLocalToLocal(groupset,phi_new_local.data(),
-                                           phi_old_local.data());
+    //=========================================== Convergence check
+    //The point-wise change is computed in the same pass that copies
+    //phi_new to phi_old
+    check_timer.Reset();
+    local_pw_change = ComputeLocalPiecewiseChangeAndCopy(groupset);
+    MPI_Allreduce(&local_pw_change,&pw_change,1,MPI_DOUBLE,MPI_MAX,
+                  chi_mpi.comm);
+    check_time += check_timer.GetTime()/1000.0;
+    ++num_iterations;
 
     rho = sqrt(pw_change/pw_change_prev);
     pw_change_prev = pw_change;
@@ -115,7 +135,7 @@ void LinearBoltzman::Solver::ClassicRichardson(int group_set_num)
 
     if (converged) break;
 
-    if (options.write_restart_data)
+    if (options.write_restart_data and (not EnergyTeamsActive()))
     {
       if ((chi_program_timer.GetTime()/60000.0) >
           last_restart_write+options.write_restart_interval)
@@ -128,6 +148,8 @@ void LinearBoltzman::Solver::ClassicRichardson(int group_set_num)
   }
 
 
+  delete sweep_chunk;
+
   double sweep_time = sweepScheduler.GetAverageSweepTime();
   double source_time=
     chi_log.ProcessEvent(source_event_tag,
@@ -149,6 +171,9 @@ void LinearBoltzman::Solver::ClassicRichardson(int group_set_num)
     << sweep_time*1.0e9*chi_mpi.process_count/num_unknowns;
   chi_log.Log(LOG_0)
     << "        Number of unknowns per sweep:  " << num_unknowns;
+  chi_log.Log(LOG_0)
+    << "        Conv. check time/iteration (s):"
+    << check_time/std::max(num_iterations,1);
   chi_log.Log(LOG_0)
     << "\n\n";
 
@@ -0,0 +1,161 @@
+#include "../lbs_linear_boltzman_solver.h"
+#include "lbs_iterativemethods.h"
+
+#include "ChiMesh/SweepUtilities/SweepScheduler/sweepscheduler.h"
+#include "../../DiffusionSolver/Solver/diffusion_solver.h"
+
+#include <ChiTimer/chi_timer.h>
+
+#include <chi_log.h>
+#include <chi_mpi.h>
+extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
+
+namespace sweep_namespace = chi_mesh::sweep_management;
+typedef sweep_namespace::SweepScheduler MainSweepScheduler;
+typedef sweep_namespace::SchedulingAlgorithm SchedulingAlgorithm;
+
+extern ChiTimer chi_program_timer;
+
+//###################################################################
+/**Solves a groupset for all batched right-hand sides simultaneously
+ * using classic richardson.
+ *
+ * Every iteration sets the source of each RHS and then performs a single
+ * sweep in which the sweep chunk carries all RHS, i.e., scheduling,
+ * messaging and the cell matrix eliminations are shared. The solution of
+ * RHS r is in batch_phi_old[r]. The batch vectors are swapped with
+ * phi_old_local, phi_new_local and q_moments_local to reuse the single
+ * RHS operations (source, DSA, convergence check) per RHS. The iteration
+ * stops once all RHS have converged.*/
+void LinearBoltzman::Solver::ClassicRichardsonBatch(int group_set_num)
+{
+  LBSGroupset* groupset = group_sets[group_set_num];
+  const int R = batch_sources.size();
+
+  chi_log.Log(LOG_0)
+    << "\n\n";
+  chi_log.Log(LOG_0)
+    << "********** Solving groupset " << group_set_num
+    << " with Classic-Richardson for " << R << " right-hand sides.\n\n";
+
+  if (groupset->iterative_method != NPT_CLASSICRICHARDSON)
+    chi_log.Log(LOG_0WARNING)
+      << "Batched right-hand sides are always solved with "
+      << "Classic-Richardson.";
+
+  //================================================== Setting up required
+  //                                                   sweep chunks
+  auto sweep_chunk = SetBatchSweepChunk(group_set_num);
+
+  MainSweepScheduler sweepScheduler(SchedulingAlgorithm::DEPTH_OF_GRAPH,
+                                    groupset->angle_agg);
+
+  auto SwapRHS = [this](int r)
+  {
+    phi_old_local.swap(batch_phi_old[r]);
+    phi_new_local.swap(batch_phi_new[r]);
+    q_moments_local.swap(batch_q_moments[r]);
+  };
+
+  auto SetBatchSources = [this,R,group_set_num,&SwapRHS]()
+  {
+    for (int r=0; r<R; r++)
+    {
+      SwapRHS(r);
+      active_batch_rhs = r;
+      SetSource(group_set_num,SourceFlags::USE_MATERIAL_SOURCE);
+      active_batch_rhs = -1;
+      SwapRHS(r);
+    }
+  };
+
+  //================================================== Now start iterating
+  double pw_change = 0.0;
+  double pw_change_prev = 1.0;
+  double rho = 0.0;
+  bool converged = false;
+  for (int k=0; k<groupset->max_iterations; k++)
+  {
+    SetBatchSources();
+
+    groupset->angle_agg->ResetDelayedPsi();
+
+    for (auto& phi_new : batch_phi_new)
+      phi_new.assign(phi_new.size(),0.0);
+    sweepScheduler.Sweep(sweep_chunk);
+
+    double local_pw_change = 0.0;
+    for (int r=0; r<R; r++)
+    {
+      SwapRHS(r);
+      ReduceAngularMoments(groupset);
+
+      if (groupset->apply_wgdsa)
+      {
+        AssembleWGDSADeltaPhiVector(groupset, phi_old_local.data(), phi_new_local.data());
+        ((chi_diffusion::Solver*)groupset->wgdsa_solver)->ExecuteS(true,false);
+        DisAssembleWGDSADeltaPhiVector(groupset, phi_new_local.data());
+      }
+      if (groupset->apply_tgdsa)
+      {
+        AssembleTGDSADeltaPhiVector(groupset, phi_old_local.data(), phi_new_local.data());
+        ((chi_diffusion::Solver*)groupset->tgdsa_solver)->ExecuteS(true,false);
+        DisAssembleTGDSADeltaPhiVector(groupset, phi_new_local.data());
+      }
+
+      local_pw_change = std::max(local_pw_change,
+                                 ComputeLocalPiecewiseChangeAndCopy(groupset));
+      SwapRHS(r);
+    }
+    MPI_Allreduce(&local_pw_change,&pw_change,1,MPI_DOUBLE,MPI_MAX,
+                  chi_mpi.comm);
+
+    rho = sqrt(pw_change/pw_change_prev);
+    pw_change_prev = pw_change;
+
+    if (k==0) rho = 0.0;
+    if (pw_change<std::max(groupset->residual_tolerance*rho,1.0e-10))
+      converged = true;
+
+    //======================================== Print iteration information
+    std::stringstream iter_info;
+    iter_info
+      << chi_program_timer.GetTimeString() << " "
+      << "WGS groups ["
+      << groupset->groups.front()->id
+      << "-"
+      << groupset->groups.back()->id
+      << "]"
+      << " Iteration " << std::setw(5) << k
+      << " Max point-wise change " << std::setw(14) << pw_change;
+
+    if (converged)
+      iter_info << " CONVERGED\n";
+
+    chi_log.Log(LOG_0) << iter_info.str();
+
+    if (converged) break;
+  }
+
+  delete sweep_chunk;
+
+  double sweep_time = sweepScheduler.GetAverageSweepTime();
+  size_t num_angles = groupset->quadrature->abscissae.size();
+  long int num_unknowns = (long int)glob_dof_count*
+                          (long int)num_angles*
+                          (long int)groupset->groups.size()*
+                          (long int)R;
+  chi_log.Log(LOG_0)
+    << "\n\n";
+  chi_log.Log(LOG_0)
+    << "        Average sweep time (s):        "
+    << sweep_time;
+  chi_log.Log(LOG_0)
+    << "        Sweep Time/Unknown (ns):       "
+    << sweep_time*1.0e9*chi_mpi.process_count/num_unknowns;
+  chi_log.Log(LOG_0)
+    << "        Number of unknowns per sweep:  " << num_unknowns;
+  chi_log.Log(LOG_0)
+    << "\n\n";
+}
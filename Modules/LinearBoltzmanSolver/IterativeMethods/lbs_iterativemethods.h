@@ -7,5 +7,7 @@
 #define NPT_CLASSICRICHARDSON_CYCLES 2
 #define NPT_GMRES                    3
 #define NPT_GMRES_CYCLES             4
+#define NPT_ANDERSON                 5
+#define NPT_ANDERSON_CYCLES          6
 
 #endif
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "../lbs_linear_boltzman_solver.h"
 #include <ChiMesh/Cell/cell.h>
 
+#include <chi_mpi.h>
+extern ChiMPI chi_mpi;
+
 //###################################################################
 /**Computes the point wise change between phi_new and phi_old.*/
 double LinearBoltzman::Solver::ComputePiecewiseChange(LBSGroupset* groupset)
@@ -54,7 +57,60 @@ double LinearBoltzman::Solver::ComputePiecewiseChange(LBSGroupset* groupset)
 
   double global_pw_change = 0.0;
 
-  MPI_Allreduce(&pw_change,&global_pw_change,1,MPI_DOUBLE,MPI_MAX,MPI_COMM_WORLD);
+  MPI_Allreduce(&pw_change,&global_pw_change,1,MPI_DOUBLE,MPI_MAX,chi_mpi.comm);
 
   return global_pw_change;
-}
\ No newline at end of file
+}
+//###################################################################
+/**Computes the local point wise change between phi_new and phi_old
+ * and copies phi_new into phi_old for the groups of the groupset, all
+ * in a single pass over the flux moments. No global reduction is
+ * performed, this is left to the caller.*/
+double LinearBoltzman::Solver::
+  ComputeLocalPiecewiseChangeAndCopy(LBSGroupset* groupset)
+{
+  double pw_change = 0.0;
+
+  int gsi = groupset->groups[0]->id;
+  int deltag = groupset->groups.size();
+
+  std::vector<double> max_phi(deltag,0.0);
+
+  for (const auto& cell : grid->local_cells)
+  {
+    auto transport_view =
+      (LinearBoltzman::CellViewFull*)cell_transport_views[cell.local_id];
+
+    for (int i=0; i < cell.vertex_ids.size(); i++)
+    {
+      //Moment 0 magnitudes have to be taken before phi_old is overwritten
+      int map0 = transport_view->MapDOF(i,0,gsi);
+      const double* phi_new_m0 = &phi_new_local[map0];
+      const double* phi_old_m0 = &phi_old_local[map0];
+      for (int g=0; g<deltag; g++)
+        max_phi[g] = std::max(std::fabs(phi_new_m0[g]),
+                              std::fabs(phi_old_m0[g]));
+
+      for (int m=0; m<num_moments; m++)
+      {
+        int mapping = transport_view->MapDOF(i,m,gsi);
+        const double* phi_new_m = &phi_new_local[mapping];
+        double*       phi_old_m = &phi_old_local[mapping];
+
+        for (int g=0; g<deltag; g++)
+        {
+          double delta_phi = std::fabs(phi_new_m[g] - phi_old_m[g]);
+
+          if (max_phi[g] >= std::numeric_limits<double>::min())
+            pw_change = std::max(delta_phi/max_phi[g],pw_change);
+          else
+            pw_change = std::max(delta_phi,pw_change);
+
+          phi_old_m[g] = phi_new_m[g];
+        }//for g
+      }//for m
+    }//for i
+  }//for c
+
+  return pw_change;
+}
@@ -3,9 +3,11 @@
 
 #include <ChiTimer/chi_timer.h>
 #include <ChiLog/chi_log.h>
+#include <chi_mpi.h>
 
 
 extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
 extern ChiTimer chi_program_timer;
 
 //###################################################################
@@ -46,17 +48,18 @@ void LinearBoltzman::Solver::ConvergeCycles(
   {
     phi_new_local.assign(phi_new_local.size(),0.0); //Ensure phi_new=0.0
     sweepScheduler.Sweep(sweep_chunk);
+    ReduceAngularMoments(groupset);
 
-    max_pw_change = ComputePiecewiseChange(groupset)*
-                    groupset->angle_agg->GetDelayedPsiNorm();
+    double local_pw_change = ComputeLocalPiecewiseChangeAndCopy(groupset);
+    MPI_Allreduce(&local_pw_change,&max_pw_change,1,MPI_DOUBLE,MPI_MAX,
+                  chi_mpi.comm);
+    max_pw_change *= groupset->angle_agg->GetDelayedPsiNorm();
 
     if (convergence_opp_refl_bndries)
       for (auto bndry : sweep_boundaries)
         if (bndry->Type() == REFLECTING_BNDRY)
           max_pw_change += ((TBndryReflecting*)bndry)->pw_change;
 
-    DisAssembleVectorLocalToLocal(groupset,phi_new_local.data(), phi_old_local.data());
-
     if (apply_latest_convergence_metric)
       convergence_metric =
         std::max(cyclic_tolerance,0.8*groupset->latest_convergence_metric);
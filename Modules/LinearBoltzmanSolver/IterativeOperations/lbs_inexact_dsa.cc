@@ -0,0 +1,83 @@
+#include "../lbs_linear_boltzman_solver.h"
+
+#include "../../DiffusionSolver/Solver/diffusion_solver.h"
+
+#include <chi_log.h>
+extern ChiLog chi_log;
+
+//###################################################################
+/**Executes a DSA diffusion solve applied within a groupset Krylov
+ * iteration.
+ *
+ * When the groupset is in inexact mode the relative tolerance of the
+ * diffusion solve is relaxed as the Krylov residual drops, following the
+ * inexact Krylov bounds where the error allowed in the operator (or
+ * preconditioner) application grows inversely with the current residual:
+ * \f[
+ *  \eta_k = \min(\eta_{max}, \max(\eta_0, \eta_0 \|b\|/\|r_k\|))
+ * \f]
+ * with \f$ \eta_0 \f$ the user tolerance. The Krylov convergence test is
+ * unchanged, hence the final accuracy is preserved.
+ *
+ * A varying DSA solve is only consistent with a flexible Krylov method
+ * preconditioned by DSA (LBSGroupset::InexactDSAAllowed). In any other
+ * configuration the user tolerance is kept.*/
+void LinearBoltzman::Solver::
+  ExecuteKrylovDSA(LBSGroupset* groupset,
+                   chi_physics::Solver* dsa_solver,
+                   double user_tolerance)
+{
+  auto dsolver = (chi_diffusion::Solver*)dsa_solver;
+
+  double tolerance = user_tolerance;
+  if (groupset->dsa_inexact and groupset->InexactDSAAllowed())
+  {
+    double rel_residual = std::max(groupset->latest_convergence_metric,
+                                   1.0e-50);
+    tolerance = std::max(user_tolerance, user_tolerance/rel_residual);
+    tolerance = std::min(tolerance,
+                         std::max(user_tolerance,
+                                  groupset->dsa_inexact_max_tol));
+  }
+
+  if (tolerance != dsolver->residual_tolerance)
+    dsolver->SetResidualTolerance(tolerance);
+
+  dsolver->ExecuteS(true,false);
+
+  auto& stats = groupset->dsa_stats;
+  stats.applications += 1;
+  stats.iterations   += dsolver->last_num_iterations;
+  if (tolerance == user_tolerance)
+  {
+    stats.ref_applications += 1;
+    stats.ref_iterations   += dsolver->last_num_iterations;
+  }
+}
+
+//###################################################################
+/**Logs the DSA iteration counts of the latest groupset Krylov solve. The
+ * iterations saved by inexact DSA are estimated from the average
+ * iteration count of the applications solved at the user tolerance.*/
+void LinearBoltzman::Solver::LogDSAIterationStats(LBSGroupset* groupset)
+{
+  const auto& stats = groupset->dsa_stats;
+  if (stats.applications == 0) return;
+
+  std::stringstream info;
+  info
+    << "        DSA applications:              " << stats.applications
+    << "\n        DSA iterations:                " << stats.iterations;
+
+  if (groupset->dsa_inexact and groupset->InexactDSAAllowed() and
+      (stats.ref_applications > 0))
+  {
+    double ref_avg = double(stats.ref_iterations)/stats.ref_applications;
+    double estimate = ref_avg*stats.applications - stats.iterations;
+    info
+      << "\n        DSA iterations saved (est.):   "
+      << std::max(0,(int)std::round(estimate));
+  }
+
+  chi_log.Log(LOG_0) << info.str();
+}
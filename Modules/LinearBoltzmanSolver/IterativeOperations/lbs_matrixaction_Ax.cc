@@ -6,7 +6,8 @@
 
 typedef chi_mesh::sweep_management::SweepScheduler MainSweepScheduler;
 //###################################################################
-/**Computes the action of the transport matrix on a vector.*/
+/**Computes the action of the transport matrix on a vector. DSA is
+ * only applied here when it is not used as a preconditioner.*/
 int NPTMatrixAction_Ax(Mat matrix, Vec krylov_vector, Vec Ax)
 {
   KSPDataContext* context;
@@ -32,23 +33,26 @@ int NPTMatrixAction_Ax(Mat matrix, Vec krylov_vector, Vec Ax)
 
   solver->phi_new_local.assign(solver->phi_new_local.size(),0.0);
   sweepScheduler->Sweep(sweep_chunk);
+  solver->ReduceAngularMoments(groupset);
 
   //=================================================== Apply WGDSA
-  if (groupset->apply_wgdsa)
+  if (groupset->apply_wgdsa and context->dsa_in_operator)
   {
     solver->AssembleWGDSADeltaPhiVector(groupset,
                                         solver->phi_old_local.data(),
                                         solver->phi_new_local.data());
-    ((chi_diffusion::Solver*)groupset->wgdsa_solver)->ExecuteS(true,false);
+    solver->ExecuteKrylovDSA(groupset,groupset->wgdsa_solver,
+                             groupset->wgdsa_tol);
     solver->DisAssembleWGDSADeltaPhiVector(groupset,
                                            solver->phi_new_local.data());
   }
-  if (groupset->apply_tgdsa)
+  if (groupset->apply_tgdsa and context->dsa_in_operator)
   {
     solver->AssembleTGDSADeltaPhiVector(groupset,
                                         solver->phi_old_local.data(),
                                         solver->phi_new_local.data());
-    ((chi_diffusion::Solver*)groupset->tgdsa_solver)->ExecuteS(true,false);
+    solver->ExecuteKrylovDSA(groupset,groupset->tgdsa_solver,
+                             groupset->tgdsa_tol);
     solver->DisAssembleTGDSADeltaPhiVector(groupset,
                                            solver->phi_new_local.data());
   }
@@ -0,0 +1,49 @@
+#include "lbs_preconditioner_dsa.h"
+#include "../Tools/ksp_data_context.h"
+
+#include "../../DiffusionSolver/Solver/diffusion_solver.h"
+
+//###################################################################
+/**Applies WGDSA and/or TGDSA as a preconditioner, i.e., computes
+ * \f$ y = (I + P) r \f$ where \f$ P \f$ is the diffusion correction
+ * computed from the scattering source of \f$ r \f$. This is the same
+ * correction that is applied inside the matrix action when DSA is part
+ * of the operator, with the previous iterate taken as zero. Angular
+ * unknowns (delayed psi) are passed through unchanged.*/
+int NPTPreconditionerAction_DSA(PC pc, Vec r, Vec y)
+{
+  KSPDataContext* context;
+  PCShellGetContext(pc,(void**)&context);
+
+  LinearBoltzman::Solver* solver = context->solver;
+  LBSGroupset* groupset  = context->groupset;
+
+  //============================================= Copy input vector into local
+  solver->DisAssembleVector(groupset, r, solver->phi_new_local.data());
+
+  //=================================================== Apply WGDSA
+  if (groupset->apply_wgdsa)
+  {
+    solver->AssembleWGDSADeltaPhiVector(groupset,
+                                        context->phi_zero.data(),
+                                        solver->phi_new_local.data());
+    solver->ExecuteKrylovDSA(groupset,groupset->wgdsa_solver,
+                             groupset->wgdsa_tol);
+    solver->DisAssembleWGDSADeltaPhiVector(groupset,
+                                           solver->phi_new_local.data());
+  }
+  if (groupset->apply_tgdsa)
+  {
+    solver->AssembleTGDSADeltaPhiVector(groupset,
+                                        context->phi_zero.data(),
+                                        solver->phi_new_local.data());
+    solver->ExecuteKrylovDSA(groupset,groupset->tgdsa_solver,
+                             groupset->tgdsa_tol);
+    solver->DisAssembleTGDSADeltaPhiVector(groupset,
+                                           solver->phi_new_local.data());
+  }
+
+  solver->AssembleVector(groupset, y, solver->phi_new_local.data());
+
+  return 0;
+}
@@ -0,0 +1,6 @@
+#include <LinearBoltzmanSolver/lbs_linear_boltzman_solver.h>
+#include <petscksp.h>
+
+
+
+int NPTPreconditionerAction_DSA(PC pc, Vec r, Vec y);
@@ -1,8 +1,5 @@
 #include "../lbs_linear_boltzman_solver.h"
 
-#include <ChiMesh/MeshHandler/chi_meshhandler.h>
-#include <ChiMesh/VolumeMesher/Linemesh1D/volmesher_linemesh1d.h>
-
 #include "ChiTimer/chi_timer.h"
 
 #include <chi_mpi.h>
@@ -23,19 +20,18 @@ extern double chi_global_timings[20];
  *        On this note we also need to treat inscattering this way.
  * \param suppress_phi_old Flag indicating whether to suppress phi_old.
  *
+ * Scattering and fission use the groupset slices of the cross-sections
+ * (see BuildGroupsetXSBlocks), i.e., per node and moment a sparse
+ * product for the within- and across-groupset transfers and a rank-one
+ * update for fission.
+ *
+ * When a batched RHS is active (active_batch_rhs) its sources replace
+ * the material sources.
  * */
 void LinearBoltzman::Solver::SetSource(int group_set_num,
                                 bool apply_mat_src,
                                 bool suppress_phi_old)
 {
-  chi_mesh::MeshHandler*    mesh_handler = chi_mesh::GetCurrentHandler();
-  chi_mesh::VolumeMesher*         mesher = mesh_handler->volume_mesher;
-
-  bool OneD_Slab = false;
-
-  if (typeid(*mesher) == typeid(chi_mesh::VolumeMesherLinemesh1D))
-    OneD_Slab = true;
-
   chi_log.LogEvent(source_event_tag,ChiLog::EventType::EVENT_BEGIN);
 
   //================================================== Get reference to groupset
@@ -43,10 +39,14 @@ void LinearBoltzman::Solver::SetSource(int group_set_num,
 
   int gs_i = groupset->groups[0]->id;
   int gs_f = groupset->groups.back()->id;
+  int gss  = groupset->groups.size();
 
   int first_grp = groups.front()->id;
   int last_grp = groups.back()->id;
 
+  if (groupset->xs_blocks.size() != material_xs.size())
+    BuildGroupsetXSBlocks(groupset);
+
   std::vector<double> default_zero_src(groups.size(),0.0);
 
   //================================================== Reset source moments
@@ -54,7 +54,6 @@ void LinearBoltzman::Solver::SetSource(int group_set_num,
 
 
   //================================================== Loop over local cells
-//  for (auto& cell_g_index : grid->local_cell_glob_indices)
   for (const auto& cell : grid->local_cells)
   {
     auto full_cell_view =
@@ -73,116 +72,97 @@ void LinearBoltzman::Solver::SetSource(int group_set_num,
       exit(EXIT_FAILURE);
     }
 
-    chi_physics::TransportCrossSections* xs =
-      material_xs[xs_id];
+    chi_physics::TransportCrossSections* xs = material_xs[xs_id];
+    const auto& xs_block = groupset->xs_blocks[xs_id];
+    int num_ell = xs_block.within.size();
 
     //=========================================== Obtain material source
     double* src = default_zero_src.data();
-    if ( (src_id >= 0) && (apply_mat_src) )
+    if (active_batch_rhs >= 0)
+    {
+      auto& rhs_sources = batch_sources[active_batch_rhs];
+      auto rhs_src = rhs_sources.find(cell_matid);
+      if ( (rhs_src != rhs_sources.end()) && (apply_mat_src) )
+        src = rhs_src->second.data();
+    }
+    else if ( (src_id >= 0) && (apply_mat_src) )
     {
       src = material_srcs[src_id]->source_value_g.data();
     }
 
-
     //=========================================== Loop over dofs
-    double inscat_g = 0.0;
-    double sigma_sm = 0.0;
-    double* q_mom;
-    double* phi_oldp;
     int num_dofs = full_cell_view->dofs;
-    int gprime;
     for (int i=0; i<num_dofs; i++)
     {
       //==================================== Loop over moments
-      int m=-1;
-      for (int ell=0; ell<=options.scattering_order; ell++)
+      for (int m=0; m<num_moments; m++)
       {
-        int ellmin = -ell;
-        int ellmax =  ell;
-        if (OneD_Slab)
-          {ellmin = 0;ellmax = 0;}
-
-        for (int em=ellmin; em<=ellmax; em++)
+        int ell = moment_to_ell[m];
+        int ir = full_cell_view->MapDOF(i,m,0);
+        double*       q_mom    = &q_moments_local[ir + gs_i];
+        const double* phi_oldp = &phi_old_local[ir];
+
+        //============================= Material source
+        if (apply_mat_src && (m==0))
+          for (int r=0; r<gss; r++)
+            q_mom[r] += src[gs_i + r];
+
+        //============================= Scattering
+        if (ell < num_ell)
         {
-          m++;
-          int ir = full_cell_view->MapDOF(i,m,0);
-          q_mom    = &q_moments_local[ir];
-          phi_oldp = &phi_old_local[ir];
-
-          //============================= Loop over groupset groups
-          for (int g=gs_i; g<=gs_f; g++)
+          //====================== Across-groupset scattering
+          if (apply_mat_src)
           {
-            if (apply_mat_src && (m==0))
-              q_mom[g] += src[g];
-
-
-            inscat_g = 0.0;
-            //====================== Apply across-groupset scattering
-            if ((ell < xs->transfer_matrix.size()) && (apply_mat_src) )
-            {
-              int num_transfers = xs->transfer_matrix[ell].rowI_indices[g].size();
-              for (int t=0; t<num_transfers; t++)
-              {
-                gprime    = xs->transfer_matrix[ell].rowI_indices[g][t];
-                if ((gprime < gs_i) || (gprime > gs_f))
-                {
-                  sigma_sm  = xs->transfer_matrix[ell].rowI_values[g][t];
-                  inscat_g += sigma_sm * phi_oldp[gprime];
-                }
-              }
-            }//if moment avail
-
-            //====================== Apply within-groupset scattering
-            if ((ell < xs->transfer_matrix.size()) && (!suppress_phi_old) )
-            {
-              int num_transfers = xs->transfer_matrix[ell].rowI_indices[g].size();
-              for (int t=0; t<num_transfers; t++)
-              {
-                gprime    = xs->transfer_matrix[ell].rowI_indices[g][t];
-                if ((gprime >= gs_i) && (gprime<=gs_f))
-                {
-                  sigma_sm  = xs->transfer_matrix[ell].rowI_values[g][t];
-                  inscat_g += sigma_sm * phi_oldp[gprime];
-                }
-              }
-            }//if moment avail
-
-            q_mom[g] += inscat_g;
-
-            //====================== Apply accross-groupset fission
-            if ((ell == 0) and (apply_mat_src))
+            const auto& across = xs_block.across[ell];
+            for (int r=0; r<gss; r++)
             {
-              for (gprime=first_grp; gprime<=last_grp; ++gprime)
-              {
-                if ((gprime < gs_i) || (gprime > gs_f))
-                {
-                  q_mom[g] += xs->chi_g[g]*
-                              xs->nu_sigma_fg[gprime]*
-                              phi_oldp[gprime];
-                }
-              }//for gprime
-            }//if zeroth moment
-
-            //====================== Apply within-groupset fission
-            if ((ell == 0) and (!suppress_phi_old))
+              double inscat_g = 0.0;
+              for (int t=across.row_start[r]; t<across.row_start[r+1]; t++)
+                inscat_g += across.val[t]*phi_oldp[across.col[t]];
+              q_mom[r] += inscat_g;
+            }
+          }
+
+          //====================== Within-groupset scattering
+          if (!suppress_phi_old)
+          {
+            const auto& within = xs_block.within[ell];
+            for (int r=0; r<gss; r++)
             {
-              for (gprime=first_grp; gprime<=last_grp; ++gprime)
-              {
-                if ((gprime >= gs_i) && (gprime<=gs_f))
-                {
-                  q_mom[g] += xs->chi_g[g]*
-                              xs->nu_sigma_fg[gprime]*
-                              phi_oldp[gprime];
-                }
-              }//for gprime
-            }//if zeroth moment
-          }//for g
-        }
+              double inscat_g = 0.0;
+              for (int t=within.row_start[r]; t<within.row_start[r+1]; t++)
+                inscat_g += within.val[t]*phi_oldp[within.col[t]];
+              q_mom[r] += inscat_g;
+            }
+          }
+        }//if moment avail
+
+        //============================= Fission
+        if ((ell == 0) and xs_block.fissile)
+        {
+          const double* nu_sigma_f = xs->nu_sigma_fg.data();
+
+          double fission_rate = 0.0;
+          if (apply_mat_src)
+          {
+            for (int gprime=first_grp; gprime<gs_i; ++gprime)
+              fission_rate += nu_sigma_f[gprime]*phi_oldp[gprime];
+            for (int gprime=gs_f+1; gprime<=last_grp; ++gprime)
+              fission_rate += nu_sigma_f[gprime]*phi_oldp[gprime];
+          }
+          if (!suppress_phi_old)
+          {
+            for (int gprime=gs_i; gprime<=gs_f; ++gprime)
+              fission_rate += nu_sigma_f[gprime]*phi_oldp[gprime];
+          }
 
+          for (int r=0; r<gss; r++)
+            q_mom[r] += xs_block.chi[r]*fission_rate;
+        }//if zeroth moment
       }//for moment
     }//for dof i
 
   }//for cell
 
   chi_log.LogEvent(source_event_tag,ChiLog::EventType::EVENT_END);
-}
\ No newline at end of file
+}
@@ -1,5 +1,6 @@
 #include "../lbs_linear_boltzman_solver.h"
 #include "../SweepChunks/lbs_sweepchunk_pwl.h"
+#include "../SweepChunks/lbs_sweepchunk_pwl_batch.h"
 
 typedef chi_mesh::sweep_management::SweepChunk SweepChunk;
 
@@ -24,4 +25,29 @@ SweepChunk* LinearBoltzman::Solver::SetSweepChunk(int group_set_num)
         num_moments,max_cell_dof_count);
 
   return sweep_chunk;
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Sets up the sweep chunk that sweeps all batched right-hand sides
+ * together. Single right-hand side solves use SetSweepChunk, whose
+ * chunk keeps the flat per-group layout.*/
+SweepChunk* LinearBoltzman::Solver::SetBatchSweepChunk(int group_set_num)
+{
+  //================================================== Obtain groupset
+  LBSGroupset* groupset = group_sets[group_set_num];
+
+  //================================================== Setting up required
+  //                                                   sweep chunks
+  SweepChunk* sweep_chunk = new LBSSweepChunkPWLBatch(
+        grid,                                    //Spatial grid of cells
+        (SpatialDiscretization_PWL*)discretization, //Spatial discretization
+        &cell_transport_views,                   //Cell transport views
+        *this,
+        &batch_phi_new,                          //Destination phis
+        &batch_q_moments,                        //Source moments
+        groupset,                                //Reference groupset
+        &material_xs,                            //Material cross-sections
+        num_moments,max_cell_dof_count);
+
+  return sweep_chunk;
+}
@@ -14,6 +14,7 @@
 #include "ChiMath/chi_math.h"
 #include "../GroupSet/lbs_groupset.h"
 #include "../lbs_linear_boltzman_solver.h"
+#include "../lbs_cmfd.h"
 #include "ChiMath/Quadratures/product_quadrature.h"
 
 #include "ChiMesh/SweepUtilities/SPDS/SPDS.h"
@@ -66,6 +67,11 @@ private:
   std::vector<double> test_mg_src;
   std::vector<double> zero_mg_src;
 
+  //When set, face currents are tallied for CMFD acceleration
+  chi_mesh::sweep_management::FaceCurrentTally* cmfd_tally;
+  std::vector<double> cmfd_current;
+
+public:
 
 
 
@@ -106,6 +112,16 @@ public:
     test_mg_src.resize(G,test_source);
     test_mg_src[0] = test_source;
     zero_mg_src.resize(G,0.0);
+
+    cmfd_tally = nullptr;
+    cmfd_current.resize(G,0.0);
+  }
+
+  //################################################## Current tally
+  void SetCurrentTally(
+    chi_mesh::sweep_management::FaceCurrentTally* tally) override
+  {
+    cmfd_tally = tally;
   }
 
 
@@ -280,6 +296,28 @@ public:
               }
             };
 
+            //============================== Tally CMFD incoming current
+            if ((cmfd_tally != nullptr) and face_on_boundary)
+            {
+              double wt = groupset->d2m_op[0][angle_num];
+              cmfd_current.assign(gs_ss_size,0.0);
+              for (int fj=0; fj<num_face_indices; fj++)
+              {
+                int j = cell_fe_view->face_dof_mappings[f][fj];
+                psi = angle_set->PsiBndry(bndry_map,
+                                          angle_num,
+                                          cell->local_id,
+                                          f,fj,gs_gi,gs_ss_begin,
+                                          suppress_surface_src);
+
+                double w_mu_Sj = -wt*mu*cell_fe_view->IntS_shapeI[f][j];
+                for (int gsg=0; gsg<gs_ss_size; gsg++)
+                  cmfd_current[gsg] += w_mu_Sj*psi[gsg];
+              }
+              cmfd_tally->TallyIncoming(cell->local_id,f,gs_gi,gs_ss_size,
+                                        cmfd_current.data());
+            }
+
           }//if mu<0.0
 
         }//for f
@@ -410,6 +448,23 @@ public:
                 psi[gsg] = b[gsg][i];
             }//for fdof
           }//reflecting
+
+          //============================= Tally CMFD outgoing current
+          if (cmfd_tally != nullptr)
+          {
+            double wt_mu = groupset->d2m_op[0][angle_num]*
+                           omega.Dot(face.normal);
+            cmfd_current.assign(gs_ss_size,0.0);
+            for (int fi=0; fi<face.vertex_ids.size(); fi++)
+            {
+              int i = cell_fe_view->face_dof_mappings[f][fi];
+              double w_mu_Si = wt_mu*cell_fe_view->IntS_shapeI[f][i];
+              for (int gsg=0; gsg<gs_ss_size; gsg++)
+                cmfd_current[gsg] += w_mu_Si*b[gsg][i];
+            }
+            cmfd_tally->TallyOutgoing(cell->local_id,f,gs_gi,gs_ss_size,
+                                      cmfd_current.data());
+          }
         }//for f
 
 
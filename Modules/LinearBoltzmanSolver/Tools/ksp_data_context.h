@@ -13,4 +13,7 @@ struct KSPDataContext
   Vec              x_temp;
   chi_mesh::sweep_management::SweepScheduler* sweepScheduler;
   int last_iteration = -1;
+  bool             dsa_in_operator = true;
+  std::vector<double> phi_zero;  ///< Zero flux used for DSA of b and the PC
+  double           pc_rhs_norm = -1.0; ///< Norm of P^{-1}b for left-PC
 };
\ No newline at end of file
@@ -40,10 +40,15 @@ KSPConvergenceTestNPT(KSP ksp, PetscInt n, PetscReal rnorm,
   KSPGetApplicationContext(ksp,&context);
 
   //======================================== Compute rhs norm
-  Vec Rhs;
-  KSPGetRhs(ksp,&Rhs);
-  double rhs_norm;
-  VecNorm(Rhs,NORM_2,&rhs_norm);
+  //With left preconditioning rnorm is the preconditioned residual norm
+  //and is therefore compared to the preconditioned rhs norm.
+  double rhs_norm = context->pc_rhs_norm;
+  if (rhs_norm < 0.0)
+  {
+    Vec Rhs;
+    KSPGetRhs(ksp,&Rhs);
+    VecNorm(Rhs,NORM_2,&rhs_norm);
+  }
   if (rhs_norm < 1.0e-25)
     rhs_norm = 1.0;
 
@@ -86,7 +91,8 @@ KSPConvergenceTestNPT(KSP ksp, PetscInt n, PetscReal rnorm,
   {
     if (context->last_iteration == n)
     {
-      if (context->solver->options.write_restart_data)
+      if (context->solver->options.write_restart_data and
+          (not context->solver->EnergyTeamsActive()))
       {
         if ((chi_program_timer.GetTime()/60000.0) >
           context->solver->last_restart_write +
@@ -0,0 +1,135 @@
+#include "lbs_linear_boltzman_solver.h"
+
+#include "ChiMath/SpatialDiscretization/PiecewiseLinear/pwl.h"
+
+#include <chi_mpi.h>
+#include <chi_log.h>
+
+extern ChiMPI chi_mpi;
+extern ChiLog chi_log;
+
+//###################################################################
+/**Replaces the material cross-sections with their adjoints.
+ *
+ * The adjoint equation is solved as a forward transport problem with the
+ * transposed cross-sections in which every direction is reversed,
+ * \f$ \tilde{\psi}(\Omega) = \psi^\dagger(-\Omega) \f$. Since the
+ * scattering kernel only depends on \f$ \Omega \cdot \Omega' \f$, the sweeps,
+ * sources and acceleration schemes are used unchanged. The material and
+ * batched sources act as the adjoint source, i.e., the response function.
+ * The forward cross-sections of the material library are not modified.
+ * The adjoint cross-sections are owned by the solver and are overwritten
+ * when the materials are initialized again.*/
+void LinearBoltzman::Solver::InitAdjointMaterials()
+{
+  chi_log.Log(LOG_0) << "Transposing cross-sections for adjoint mode.";
+
+  while (adjoint_xs.size() < material_xs.size())
+    adjoint_xs.push_back(new chi_physics::TransportCrossSections);
+
+  for (size_t m=0; m<material_xs.size(); m++)
+  {
+    adjoint_xs[m]->MakeAdjoint(*material_xs[m]);
+    material_xs[m] = adjoint_xs[m];
+  }
+}
+
+//###################################################################
+/**Checks that the boundary conditions are supported in adjoint mode.
+ * Vacuum and reflecting boundaries are their own adjoints, incident
+ * boundaries would require an adjoint boundary source.*/
+void LinearBoltzman::Solver::CheckAdjointBoundaries()
+{
+  for (const auto& bndry : boundary_types)
+    if (bndry.first == BoundaryType::INCIDENT_ISOTROPIC)
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Adjoint mode does not support incident boundaries.";
+      exit(EXIT_FAILURE);
+    }
+}
+
+//###################################################################
+/**Converts the flux moments between the direction-reversed frame and the
+ * adjoint flux.
+ *
+ * Reversing the direction changes the sign of the odd Legendre order
+ * moments, \f$ \phi^\dagger_{\ell m} = (-1)^\ell \tilde{\phi}_{\ell m} \f$.
+ * The operation is its own inverse. Execute applies it after solving and
+ * undoes it before the next solve so that the iterations always start from
+ * the reversed-frame flux.*/
+void LinearBoltzman::Solver::ApplyAdjointMomentParity()
+{
+  const int num_groups = groups.size();
+
+  auto FlipOddMoments = [this,num_groups](std::vector<double>& phi)
+  {
+    if (phi.empty()) return;
+    for (const auto& cell : grid->local_cells)
+    {
+      auto transport_view =
+        (LinearBoltzman::CellViewFull*)cell_transport_views[cell.local_id];
+      for (int i=0; i < cell.vertex_ids.size(); i++)
+        for (int m=0; m<num_moments; m++)
+        {
+          if (moment_to_ell[m]%2 == 0) continue;
+          double* phi_mapped = &phi[transport_view->MapDOF(i,m,0)];
+          for (int g=0; g<num_groups; g++) phi_mapped[g] = -phi_mapped[g];
+        }
+    }
+  };
+
+  FlipOddMoments(phi_old_local);
+  FlipOddMoments(phi_new_local);
+  for (auto& phi : batch_phi_old) FlipOddMoments(phi);
+  for (auto& phi : batch_phi_new) FlipOddMoments(phi);
+
+  phi_in_adjoint_frame = not phi_in_adjoint_frame;
+}
+
+//###################################################################
+/**Computes the response of the current flux to an isotropic volumetric
+ * source,
+ * \f[
+ *  R = \sum_g \int_V q_g \phi_{0,g} dV ,
+ * \f]
+ * using the scalar flux in phi_old. With an adjoint solution this is the
+ * response of a forward source, for which the adjoint source was the
+ * response function, without a forward solve. The sum is reduced over
+ * all locations.
+ *
+ * \param sources Source strength of every group indexed by material id.
+ *                Materials without an entry have no source.*/
+double LinearBoltzman::Solver::
+  ComputeResponse(const std::map<int,std::vector<double>>& sources)
+{
+  auto pwl_discretization = (SpatialDiscretization_PWL*)discretization;
+  const int num_groups = groups.size();
+
+  double local_response = 0.0;
+  for (const auto& cell : grid->local_cells)
+  {
+    auto src = sources.find(cell.material_id);
+    if (src == sources.end()) continue;
+    const auto& q = src->second;
+    const int num_src_groups = std::min(num_groups,(int)q.size());
+
+    auto cell_fe_view = pwl_discretization->MapFeViewL(cell.local_id);
+    auto transport_view =
+      (LinearBoltzman::CellViewFull*)cell_transport_views[cell.local_id];
+
+    for (int i=0; i < cell.vertex_ids.size(); i++)
+    {
+      const double* phi_mapped = &phi_old_local[transport_view->MapDOF(i,0,0)];
+      double intV_shapeI = cell_fe_view->IntV_shapeI[i];
+      for (int g=0; g<num_src_groups; g++)
+        local_response += q[g]*phi_mapped[g]*intV_shapeI;
+    }
+  }
+
+  double response = 0.0;
+  MPI_Allreduce(&local_response,&response,1,MPI_DOUBLE,MPI_SUM,
+                chi_mpi.comm);
+
+  return response;
+}
@@ -6,8 +6,12 @@
 #include <ChiMesh/SweepUtilities/FLUDS/AUX_FLUDS.h>
 
 #include <chi_log.h>
+#include <chi_mpi.h>
 
 extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
+
+#include <map>
 
 typedef chi_mesh::sweep_management::AngleSet TAngleSet;
 typedef chi_mesh::sweep_management::AngleSetGroup TAngleSetGroup;
@@ -33,7 +37,7 @@ void LinearBoltzman::Solver::InitAngleAggPolar(LBSGroupset *groupset)
   int pa = num_pol/2;
 
   int num_angset_grps = 4; //Default Extruded and 2D
-  if (typeid(*mesher) == typeid(chi_mesh::VolumeMesherLinemesh1D))
+  if (mesher->Type() == chi_mesh::VolumeMesherType::LINEMESH1D)
     num_angset_grps = 1;
 
   //=========================================== Passing the sweep boundaries
@@ -44,6 +48,10 @@ void LinearBoltzman::Solver::InitAngleAggPolar(LBSGroupset *groupset)
   groupset->angle_agg->quadrature              = groupset->quadrature;
   groupset->angle_agg->grid                    = grid;
 
+  //Batched right-hand sides are carried as extra groups in psi
+  std::vector<int> psi_grps = groupset->grp_subset_sizes;
+  for (auto& num_grps : psi_grps) num_grps *= NumberOfBatchRHS();
+
   //=========================================== Set angle aggregation
   for (int q=0; q<num_angset_grps; q++)  //%%%%%%%%% for each top hemisphere quadrant
   {
@@ -75,7 +83,7 @@ void LinearBoltzman::Solver::InitAngleAggPolar(LBSGroupset *groupset)
           {
             make_primary = false;
             primary_fluds = new chi_mesh::sweep_management::
-                  PRIMARY_FLUDS(groupset->grp_subset_sizes[gs_ss]);
+                  PRIMARY_FLUDS(psi_grps[gs_ss]);
 
             primary_fluds->InitializeAlphaElements(sweep_orderings[a]);
             primary_fluds->InitializeBetaElements(sweep_orderings[a]);
@@ -84,11 +92,11 @@ void LinearBoltzman::Solver::InitAngleAggPolar(LBSGroupset *groupset)
           } else
           {
             fluds = new chi_mesh::sweep_management::
-              AUX_FLUDS(*primary_fluds,groupset->grp_subset_sizes[gs_ss]);
+              AUX_FLUDS(*primary_fluds,psi_grps[gs_ss]);
           }
 
           auto angleSet =
-            new TAngleSet(groupset->grp_subset_sizes[gs_ss],
+            new TAngleSet(psi_grps[gs_ss],
                           gs_ss,
                           sweep_orderings[a],
                           fluds,
@@ -132,7 +140,7 @@ void LinearBoltzman::Solver::InitAngleAggPolar(LBSGroupset *groupset)
           {
             make_primary = false;
             primary_fluds = new chi_mesh::sweep_management::
-            PRIMARY_FLUDS(groupset->grp_subset_sizes[gs_ss]);
+            PRIMARY_FLUDS(psi_grps[gs_ss]);
 
             primary_fluds->InitializeAlphaElements(sweep_orderings[a+num_azi]);
             primary_fluds->InitializeBetaElements(sweep_orderings[a+num_azi]);
@@ -141,11 +149,11 @@ void LinearBoltzman::Solver::InitAngleAggPolar(LBSGroupset *groupset)
           } else
           {
             fluds = new chi_mesh::sweep_management::
-            AUX_FLUDS(*primary_fluds,groupset->grp_subset_sizes[gs_ss]);
+            AUX_FLUDS(*primary_fluds,psi_grps[gs_ss]);
           }
 
           auto angleSet =
-            new TAngleSet(groupset->grp_subset_sizes[gs_ss],
+            new TAngleSet(psi_grps[gs_ss],
                           gs_ss,
                           sweep_orderings[a+num_azi],
                           fluds,
@@ -178,7 +186,7 @@ void LinearBoltzman::Solver::InitAngleAggSingle(LBSGroupset *groupset)
   int pa = std::max(1,num_pol/2);
 
   int num_angset_grps = 4; //Default Extruded and 2D
-  if (typeid(*mesher) == typeid(chi_mesh::VolumeMesherLinemesh1D))
+  if (mesher->Type() == chi_mesh::VolumeMesherType::LINEMESH1D)
     num_angset_grps = 1;
 
   //=========================================== Passing the sweep boundaries
@@ -189,6 +197,10 @@ void LinearBoltzman::Solver::InitAngleAggSingle(LBSGroupset *groupset)
   groupset->angle_agg->quadrature              = groupset->quadrature;
   groupset->angle_agg->grid                    = grid;
 
+  //Batched right-hand sides are carried as extra groups in psi
+  std::vector<int> psi_grps = groupset->grp_subset_sizes;
+  for (auto& num_grps : psi_grps) num_grps *= NumberOfBatchRHS();
+
   //=========================================== Set angle aggregation
   for (int q=0; q<num_angset_grps; q++)  //%%%%%%%%% for each top hemisphere quadrant
   {
@@ -216,7 +228,7 @@ void LinearBoltzman::Solver::InitAngleAggSingle(LBSGroupset *groupset)
           if (make_primary)
           {
             primary_fluds = new chi_mesh::sweep_management::
-            PRIMARY_FLUDS(groupset->grp_subset_sizes[gs_ss]);
+            PRIMARY_FLUDS(psi_grps[gs_ss]);
 
             primary_fluds->InitializeAlphaElements(sweep_orderings[angle_num]);
             primary_fluds->InitializeBetaElements(sweep_orderings[angle_num]);
@@ -225,7 +237,7 @@ void LinearBoltzman::Solver::InitAngleAggSingle(LBSGroupset *groupset)
           }
 
           auto angleSet =
-            new TAngleSet(groupset->grp_subset_sizes[gs_ss],
+            new TAngleSet(psi_grps[gs_ss],
                           gs_ss,
                           sweep_orderings[angle_num],
                           fluds,
@@ -267,7 +279,7 @@ void LinearBoltzman::Solver::InitAngleAggSingle(LBSGroupset *groupset)
           if (make_primary)
           {
             primary_fluds = new chi_mesh::sweep_management::
-            PRIMARY_FLUDS(groupset->grp_subset_sizes[gs_ss]);
+            PRIMARY_FLUDS(psi_grps[gs_ss]);
 
             primary_fluds->InitializeAlphaElements(sweep_orderings[angle_num]);
             primary_fluds->InitializeBetaElements(sweep_orderings[angle_num]);
@@ -276,7 +288,7 @@ void LinearBoltzman::Solver::InitAngleAggSingle(LBSGroupset *groupset)
           }
 
           auto angleSet =
-            new TAngleSet(groupset->grp_subset_sizes[gs_ss],
+            new TAngleSet(psi_grps[gs_ss],
                           gs_ss,
                           sweep_orderings[angle_num],
                           fluds,
@@ -291,4 +303,99 @@ void LinearBoltzman::Solver::InitAngleAggSingle(LBSGroupset *groupset)
 
     } //azi
   }//for q bot
-}
\ No newline at end of file
+}
+//###################################################################
+/**Initializes angle aggregation for a groupset from the angle clusters
+ * of the OCTANT and CONE aggregation types. Every cluster, with the sweep
+ * ordering of the same index, gives one angle set per group subset, with
+ * all group subsets sharing the FLUDS slot dynamics of the first. The
+ * angle sets of an octant form an angle set group.*/
+void LinearBoltzman::Solver::InitAngleAggClustered(LBSGroupset *groupset)
+{
+  chi_log.Log(LOG_0)
+    << chi_program_timer.GetTimeString()
+    << " Initializing angle aggregation: "
+    << ((groupset->angleagg_method == AngleAggregationType::CONE)?
+        "Cone" : "Octant");
+
+  //=========================================== Passing the sweep boundaries
+  //                                            to the angle aggregation
+  groupset->angle_agg->sim_boundaries          = sweep_boundaries;
+  groupset->angle_agg->number_of_groups        = groupset->groups.size();
+  groupset->angle_agg->number_of_group_subsets = groupset->grp_subsets.size();
+  groupset->angle_agg->quadrature              = groupset->quadrature;
+  groupset->angle_agg->grid                    = grid;
+
+  //Batched right-hand sides are carried as extra groups in psi
+  std::vector<int> psi_grps = groupset->grp_subset_sizes;
+  for (auto& num_grps : psi_grps) num_grps *= NumberOfBatchRHS();
+
+  //=========================================== Set angle aggregation
+  std::map<int,TAngleSetGroup*> octant_groups;
+  for (size_t c=0; c<groupset->angle_clusters.size(); c++)
+  {
+    std::vector<int> angle_indices = groupset->angle_clusters[c];
+    auto spds = sweep_orderings[c];
+
+    int octant = (spds->omega.x < 0.0? 1 : 0) +
+                 (spds->omega.y < 0.0? 2 : 0) +
+                 (spds->omega.z < 0.0? 4 : 0);
+    if (octant_groups.count(octant) == 0)
+    {
+      octant_groups[octant] = new TAngleSetGroup;
+      groupset->angle_agg->angle_set_groups.push_back(octant_groups[octant]);
+    }
+    auto angle_set_group = octant_groups[octant];
+
+    chi_mesh::sweep_management::PRIMARY_FLUDS* primary_fluds = nullptr;
+    for (int gs_ss=0; gs_ss<groupset->grp_subsets.size(); gs_ss++)
+    {
+      chi_mesh::sweep_management::FLUDS* fluds;
+      if (primary_fluds == nullptr)
+      {
+        primary_fluds = new chi_mesh::sweep_management::
+          PRIMARY_FLUDS(psi_grps[gs_ss]);
+
+        primary_fluds->InitializeAlphaElements(spds);
+        primary_fluds->InitializeBetaElements(spds);
+
+        fluds = primary_fluds;
+      } else
+      {
+        fluds = new chi_mesh::sweep_management::
+          AUX_FLUDS(*primary_fluds,psi_grps[gs_ss]);
+      }
+
+      auto angleSet =
+        new TAngleSet(psi_grps[gs_ss],
+                      gs_ss,
+                      spds,
+                      fluds,
+                      angle_indices,
+                      sweep_boundaries,
+                      options.sweep_eager_limit,
+                      &grid->GetCommunicator());
+
+      angle_set_group->angle_sets.push_back(angleSet);
+    }//for gs_ss
+  }//for cluster
+
+  //=========================================== Report messaging
+  //Every angle set sends at least one message per successor location
+  double local_counts[2] = {0.0,0.0};
+  for (auto angle_set_group : groupset->angle_agg->angle_set_groups)
+    for (auto angle_set : angle_set_group->angle_sets)
+    {
+      local_counts[0] += 1.0;
+      local_counts[1] += angle_set->GetSPDS()->location_successors.size();
+    }
+  double counts[2] = {0.0,0.0};
+  MPI_Allreduce(local_counts,counts,2,MPI_DOUBLE,MPI_SUM,chi_mpi.comm);
+
+  size_t num_angles = groupset->quadrature->abscissae.size();
+  chi_log.Log(LOG_0)
+    << "Angle sets per location " << counts[0]/chi_mpi.process_count
+    << " (single angle aggregation "
+    << num_angles*groupset->grp_subsets.size() << "), "
+    << "minimum messages per sweep " << counts[1];
+}
@@ -0,0 +1,139 @@
+#include "lbs_linear_boltzman_solver.h"
+
+#include <chi_mpi.h>
+#include <chi_log.h>
+#include "ChiTimer/chi_timer.h"
+
+extern ChiMPI chi_mpi;
+extern ChiLog chi_log;
+extern ChiTimer chi_program_timer;
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+
+namespace
+{
+//###################################################################
+/**64 bit finalizer of splitmix64, used to combine face orientations
+ * into direction signatures.*/
+uint64_t MixBits(uint64_t x)
+{
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+//###################################################################
+/**Octant of a direction, 0 to 7.*/
+int Octant(const chi_mesh::Vector3& omega)
+{
+  return (omega.x < 0.0? 1 : 0) +
+         (omega.y < 0.0? 2 : 0) +
+         (omega.z < 0.0? 4 : 0);
+}
+}
+
+//###################################################################
+/**Clusters the directions of a groupset into angle sets for the OCTANT
+ * and CONE angle aggregation types.
+ *
+ * The FLUDS and sweep ordering of an angle set are built from a single
+ * direction, while every direction of the set uses its own face
+ * orientations in the sweep chunk. Directions can therefore only share an
+ * angle set when every face of the mesh is incident, outgoing or parallel
+ * for all of them. Each location hashes the face orientations of every
+ * direction and the hashes are combined over all locations into a global
+ * signature. Directions with equal signatures within the same octant are
+ * compatible.
+ *
+ * With OCTANT all compatible directions of an octant form one cluster.
+ * With CONE a cluster contains the compatible directions within
+ * angle_agg_cone_angle of its first direction. Clusters are split to hold
+ * at most angle_agg_max_angles directions, when this limit is set, to
+ * bound the FLUDS memory. The first direction of a cluster defines its
+ * sweep ordering.*/
+void LinearBoltzman::Solver::ComputeAngleClusters(LBSGroupset *groupset)
+{
+  chi_log.Log(LOG_0)
+    << chi_program_timer.GetTimeString()
+    << " Computing angle clusters.";
+
+  const auto& omegas = groupset->quadrature->omegas;
+  const size_t num_angles = omegas.size();
+
+  //================================================== Local signatures
+  //Same thresholds as the FLUDS face classification
+  std::vector<uint64_t> local_signatures(num_angles,0);
+  for (size_t n=0; n<num_angles; ++n)
+  {
+    const chi_mesh::Vector3& omega = *omegas[n];
+    uint64_t signature = 0;
+    for (const auto& cell : grid->local_cells)
+      for (const auto& face : cell.faces)
+      {
+        double mu = omega.Dot(face.normal);
+        uint64_t state = 0;
+        if      (mu <  (0.0-1.0e-16)) state = 1;
+        else if (mu >= (0.0+1.0e-16)) state = 2;
+        signature = MixBits(signature*3 + state);
+      }
+    local_signatures[n] = MixBits(signature ^
+                                  MixBits(chi_mpi.location_id + 1));
+  }
+
+  std::vector<uint64_t> signatures(num_angles,0);
+  MPI_Allreduce(local_signatures.data(),signatures.data(),num_angles,
+                MPI_UNSIGNED_LONG_LONG,MPI_SUM,chi_mpi.comm);
+
+  //================================================== Cluster per octant
+  const bool cone = (groupset->angleagg_method == AngleAggregationType::CONE);
+  const double cos_cone = cos(groupset->angle_agg_cone_angle);
+  const size_t max_angles =
+    (groupset->angle_agg_max_angles > 0)?
+    groupset->angle_agg_max_angles : num_angles;
+
+  groupset->angle_clusters.clear();
+  std::vector<bool> assigned(num_angles,false);
+  for (int oct=0; oct<8; ++oct)
+  {
+    for (size_t seed=0; seed<num_angles; ++seed)
+    {
+      if (assigned[seed] or (Octant(*omegas[seed]) != oct)) continue;
+
+      //Compatible candidates, most similar direction first
+      std::vector<std::pair<double,int>> candidates;
+      for (size_t n=seed+1; n<num_angles; ++n)
+      {
+        if (assigned[n] or (signatures[n] != signatures[seed]) or
+            (Octant(*omegas[n]) != oct)) continue;
+
+        double cos_angle = omegas[n]->Dot(*omegas[seed]);
+        if (cone and (cos_angle < cos_cone)) continue;
+        candidates.emplace_back(-cos_angle,n);
+      }
+      if (cone)
+        std::stable_sort(candidates.begin(),candidates.end());
+
+      std::vector<int> cluster(1,seed);
+      assigned[seed] = true;
+      for (const auto& candidate : candidates)
+      {
+        if (cluster.size() >= max_angles) break;
+        cluster.push_back(candidate.second);
+        assigned[candidate.second] = true;
+      }
+
+      groupset->angle_clusters.push_back(cluster);
+    }
+  }
+
+  chi_log.Log(LOG_0)
+    << "Angle clusters: " << groupset->angle_clusters.size()
+    << " clusters for " << num_angles << " directions, "
+    << std::setprecision(3)
+    << (double)num_angles/groupset->angle_clusters.size()
+    << " directions per cluster on average.";
+}
@@ -0,0 +1,315 @@
+#include "lbs_linear_boltzman_solver.h"
+
+#include "ChiMesh/SweepUtilities/SweepScheduler/sweepscheduler.h"
+#include <ChiMesh/MeshHandler/chi_meshhandler.h>
+#include <ChiMesh/VolumeMesher/Linemesh1D/volmesher_linemesh1d.h>
+#include <ChiMesh/VolumeMesher/Predefined2D/volmesher_predefined2d.h>
+#include <ChiMesh/VolumeMesher/Extruder/volmesher_extruder.h>
+
+#include <chi_mpi.h>
+#include <chi_log.h>
+
+#include <fstream>
+#include <sstream>
+#include <tuple>
+#include <map>
+#include <algorithm>
+
+extern ChiMPI chi_mpi;
+extern ChiLog chi_log;
+
+namespace sweep_namespace = chi_mesh::sweep_management;
+typedef sweep_namespace::SweepScheduler MainSweepScheduler;
+typedef sweep_namespace::SchedulingAlgorithm SchedulingAlgorithm;
+
+namespace
+{
+//Group subsets, angle aggregation type and angle subsets
+typedef std::tuple<int,int,int> TuneConfig;
+
+typedef sweep_namespace::BoundaryReflecting ReflectingBndry;
+
+//###################################################################
+/**Angular fluxes and sweep state of a reflecting boundary, saved around
+ * trial sweeps.*/
+struct ReflectingBndryState
+{
+  ReflectingBndry* boundary;
+  std::vector<ReflectingBndry::AngVec> psi;
+  std::vector<ReflectingBndry::AngVec> psi_old;
+  std::vector<int>                     reflected_anglenum;
+  std::vector<std::vector<bool>>       angle_readyflags;
+  bool                                 opposing_reflected;
+  double                               pw_change;
+
+  explicit ReflectingBndryState(ReflectingBndry* in_boundary) :
+    boundary(in_boundary),
+    psi(in_boundary->hetero_boundary_flux),
+    psi_old(in_boundary->hetero_boundary_flux_old),
+    reflected_anglenum(in_boundary->reflected_anglenum),
+    angle_readyflags(in_boundary->angle_readyflags),
+    opposing_reflected(in_boundary->opposing_reflected),
+    pw_change(in_boundary->pw_change)
+  {}
+
+  void Restore()
+  {
+    boundary->hetero_boundary_flux.swap(psi);
+    boundary->hetero_boundary_flux_old.swap(psi_old);
+    boundary->reflected_anglenum.swap(reflected_anglenum);
+    boundary->angle_readyflags.swap(angle_readyflags);
+    boundary->opposing_reflected = opposing_reflected;
+    boundary->pw_change = pw_change;
+  }
+};
+
+//###################################################################
+/**Candidate subset counts: the user's count and the powers of two up to
+ * the maximum.*/
+std::vector<int> SubsetCandidates(int user_count, int max_count)
+{
+  std::vector<int> candidates;
+  for (int n=1; n<=max_count; n*=2)
+    candidates.push_back(n);
+  if ((user_count >= 1) and (user_count <= max_count) and
+      (std::find(candidates.begin(),candidates.end(),user_count) ==
+       candidates.end()))
+    candidates.push_back(user_count);
+  if (candidates.empty())
+    candidates.push_back(1);
+
+  std::sort(candidates.begin(),candidates.end());
+  return candidates;
+}
+}
+
+//###################################################################
+/**Selects the group subsets and angle aggregation of a groupset from
+ * timed trial sweeps.
+ *
+ * For every candidate configuration the subsets, sweep orderings and angle
+ * aggregation are built and auto_tune_sweeps sweeps are timed with the
+ * scheduler's sweep timer. The slowest location determines the time of a
+ * configuration, which makes the choice identical on all locations. The
+ * search is done coordinate-wise: first the number of group subsets with
+ * the user's aggregation, then the aggregation type and the number of angle
+ * subsets with the best group subsets. The experimental octant and cone
+ * aggregations are not candidates.
+ *
+ * When a cache file is set, a configuration stored for the same groupset,
+ * problem size and process layout is used without trials, and newly tuned
+ * configurations are appended to it. Only team 0 writes the cache, hence
+ * with energy decomposition the groupsets of the other teams are tuned
+ * again in every run.*/
+void LinearBoltzman::Solver::AutoTuneGroupset(int group_set_num)
+{
+  LBSGroupset* groupset = group_sets[group_set_num];
+
+  //In energy decomposition only the owning team initializes the groupset
+  MPI_Comm tune_comm = EnergyTeamsActive()? chi_mpi.comm : MPI_COMM_WORLD;
+  int tune_rank = 0;
+  MPI_Comm_rank(tune_comm,&tune_rank);
+
+  auto ApplyConfig = [groupset](const TuneConfig& config)
+  {
+    groupset->master_num_grp_subsets = std::get<0>(config);
+    groupset->angleagg_method = (AngleAggregationType)std::get<1>(config);
+    groupset->master_num_ang_subsets = std::get<2>(config);
+  };
+
+  //================================================== Cache key
+  std::stringstream key_stream;
+  key_stream
+    << "gs" << group_set_num
+    << "_G" << groupset->groups.size()
+    << "_A" << groupset->quadrature->abscissae.size()
+    << "_D" << glob_dof_count
+    << "_P" << chi_mpi.world_process_count
+    << "_T" << chi_mpi.num_teams;
+  const std::string key = key_stream.str();
+  const std::string& cache_file = groupset->auto_tune_cache_file;
+
+  //================================================== Read cache
+  int cached[4] = {0,0,0,0};
+  if ((not cache_file.empty()) and (tune_rank == 0))
+  {
+    std::ifstream file(cache_file);
+    std::string file_key;
+    int grp_ss, agg_type, ang_ss;
+    while (file >> file_key >> grp_ss >> agg_type >> ang_ss)
+      if (file_key == key)
+      {
+        cached[0] = 1;
+        cached[1] = grp_ss;
+        cached[2] = agg_type;
+        cached[3] = ang_ss;
+      }
+  }
+  MPI_Bcast(cached,4,MPI_INT,0,tune_comm);
+
+  if (cached[0] == 1)
+  {
+    ApplyConfig(TuneConfig(cached[1],cached[2],cached[3]));
+    groupset->auto_tuned = true;
+
+    chi_log.Log(LOG_0)
+      << "Groupset " << group_set_num << " auto-tune configuration "
+      << "read from " << cache_file << ": group subsets " << cached[1]
+      << ", angle aggregation " << cached[2]
+      << ", angle subsets " << cached[3];
+    return;
+  }
+
+  //================================================== Candidates
+  chi_mesh::MeshHandler* handler = chi_mesh::GetCurrentHandler();
+  chi_mesh::VolumeMesher* mesher = handler->volume_mesher;
+  bool polar_possible =
+    (mesher->Type() == chi_mesh::VolumeMesherType::LINEMESH1D) or
+    (mesher->Type() == chi_mesh::VolumeMesherType::PREDEFINED2D) or
+    (mesher->Type() == chi_mesh::VolumeMesherType::EXTRUDER);
+
+  const int SINGLE = (int)AngleAggregationType::SINGLE;
+  const int POLAR  = (int)AngleAggregationType::POLAR;
+
+  const TuneConfig user_config(groupset->master_num_grp_subsets,
+                               (int)groupset->angleagg_method,
+                               groupset->master_num_ang_subsets);
+
+  chi_log.Log(LOG_0)
+    << "\n********* Auto-tuning groupset " << group_set_num << " with "
+    << groupset->auto_tune_sweeps << " trial sweeps per configuration\n";
+
+  groupset->BuildDiscMomOperator(options.scattering_order);
+  groupset->BuildMomDiscOperator(options.scattering_order);
+
+  std::map<TuneConfig,double> timings;
+  auto Time = [this,group_set_num,&timings,&ApplyConfig]
+    (const TuneConfig& config)
+  {
+    if (timings.count(config) == 0)
+    {
+      ApplyConfig(config);
+      timings[config] = TimeTrialSweeps(group_set_num);
+
+      chi_log.Log(LOG_0)
+        << "Auto-tune group subsets " << std::get<0>(config)
+        << ", angle aggregation " << std::get<1>(config)
+        << ", angle subsets " << std::get<2>(config)
+        << ": average sweep time " << timings[config] << " s";
+    }
+    return timings[config];
+  };
+
+  //================================================== Group subsets
+  TuneConfig best_config = user_config;
+  double best_time = Time(user_config);
+  for (int grp_ss : SubsetCandidates(std::get<0>(user_config),
+                                     groupset->groups.size()))
+  {
+    TuneConfig config(grp_ss,std::get<1>(user_config),
+                             std::get<2>(user_config));
+    double time = Time(config);
+    if (time < best_time) {best_time = time; best_config = config;}
+  }
+
+  //================================================== Angle aggregation
+  const int best_grp_ss = std::get<0>(best_config);
+  if (polar_possible)
+  {
+    Time(TuneConfig(best_grp_ss,SINGLE,1));
+
+    int num_pol_angls_hemi = groupset->quadrature->polar_ang.size()/2;
+    for (int ang_ss : SubsetCandidates(std::get<2>(user_config),
+                                       num_pol_angls_hemi))
+      Time(TuneConfig(best_grp_ss,POLAR,ang_ss));
+  }
+
+  for (const auto& timing : timings)
+    if (timing.second < best_time)
+    {
+      best_time = timing.second;
+      best_config = timing.first;
+    }
+
+  ApplyConfig(best_config);
+  groupset->auto_tuned = true;
+
+  chi_log.Log(LOG_0)
+    << "Groupset " << group_set_num << " auto-tuned to group subsets "
+    << std::get<0>(best_config) << ", angle aggregation "
+    << std::get<1>(best_config) << ", angle subsets "
+    << std::get<2>(best_config) << " (" << best_time << " s per sweep, "
+    << timings[user_config] << " s with the user settings)\n";
+
+  //================================================== Write cache
+  if ((not cache_file.empty()) and (tune_rank == 0) and
+      (chi_mpi.team_id == 0))
+  {
+    std::ofstream file(cache_file,std::ofstream::app);
+    if (not file.is_open())
+      chi_log.Log(LOG_ALLWARNING)
+        << "Auto-tune cache file " << cache_file << " could not be opened "
+        << "for writing.";
+    else
+      file << key << " " << std::get<0>(best_config) << " "
+           << std::get<1>(best_config) << " "
+           << std::get<2>(best_config) << "\n";
+  }
+}
+
+//###################################################################
+/**Builds the subsets, sweep orderings and angle aggregation of the
+ * groupset's current settings and returns the average time of
+ * auto_tune_sweeps sweeps, maximized over the locations. The flux vectors,
+ * the batch flux vectors and the angular fluxes of reflecting boundaries
+ * are restored afterwards, and the sweep data is destroyed again, so that
+ * the solve starts from the same state as without tuning.*/
+double LinearBoltzman::Solver::TimeTrialSweeps(int group_set_num)
+{
+  LBSGroupset* groupset = group_sets[group_set_num];
+
+  MPI_Comm tune_comm = EnergyTeamsActive()? chi_mpi.comm : MPI_COMM_WORLD;
+
+  //The angle aggregation resets the reflecting boundaries
+  std::vector<double> phi_new_saved = phi_new_local;
+  std::vector<std::vector<double>> batch_phi_new_saved = batch_phi_new;
+  std::vector<ReflectingBndryState> reflecting_saved;
+  for (auto bndry : sweep_boundaries)
+    if (bndry->IsReflecting())
+      reflecting_saved.emplace_back((ReflectingBndry*)bndry);
+
+  groupset->BuildSubsets();
+  ComputeSweepOrderings(groupset);
+  InitFluxDataStructures(groupset);
+
+  auto sweep_chunk = batch_sources.empty()? SetSweepChunk(group_set_num) :
+                                            SetBatchSweepChunk(group_set_num);
+
+  double local_time = 0.0;
+  {
+    MainSweepScheduler sweepScheduler(SchedulingAlgorithm::DEPTH_OF_GRAPH,
+                                      groupset->angle_agg);
+
+    for (int s=0; s<std::max(groupset->auto_tune_sweeps,1); s++)
+    {
+      groupset->angle_agg->ResetDelayedPsi();
+      sweepScheduler.Sweep(sweep_chunk);
+    }
+
+    local_time = sweepScheduler.GetAverageSweepTime();
+  }
+
+  delete sweep_chunk;
+
+  ResetSweepOrderings(groupset);
+
+  phi_new_local.swap(phi_new_saved);
+  batch_phi_new.swap(batch_phi_new_saved);
+  for (auto& state : reflecting_saved)
+    state.Restore();
+
+  double time = 0.0;
+  MPI_Allreduce(&local_time,&time,1,MPI_DOUBLE,MPI_MAX,tune_comm);
+
+  return time;
+}
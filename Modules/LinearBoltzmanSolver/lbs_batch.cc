@@ -0,0 +1,83 @@
+#include "lbs_linear_boltzman_solver.h"
+
+#include <chi_mpi.h>
+#include <chi_log.h>
+
+extern ChiMPI chi_mpi;
+extern ChiLog chi_log;
+
+//###################################################################
+/**Number of right-hand sides carried by the sweeps. This is 1 unless
+ * batched sources have been added.*/
+int LinearBoltzman::Solver::NumberOfBatchRHS()
+{
+  return std::max(1,(int)batch_sources.size());
+}
+
+//###################################################################
+/**Solves all groupsets for every batched right-hand side.
+ *
+ * The RHS differ only in their material sources and share the mesh,
+ * cross-sections, quadrature and boundary conditions. Sweep orderings,
+ * FLUDS and DSA solvers are set up once per groupset and every sweep
+ * solves all RHS (see ClassicRichardsonBatch). The groupsets are solved
+ * in a single pass, outer iterations are not applied. Afterwards the
+ * solution of the first RHS is selected.*/
+void LinearBoltzman::Solver::ExecuteBatch()
+{
+  const int R = batch_sources.size();
+
+  //================================================== Check supported features
+  for (auto bndry : sweep_boundaries)
+    if (bndry->IsReflecting())
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Batched right-hand sides do not support reflecting boundaries.";
+      exit(EXIT_FAILURE);
+    }
+
+  if (EnergyTeamsActive())
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Batched right-hand sides do not support energy decomposition.";
+    exit(EXIT_FAILURE);
+  }
+
+  if ((options.max_outer_iterations > 1) or options.cmfd_enabled)
+    chi_log.Log(LOG_0WARNING)
+      << "Outer iterations and CMFD acceleration are not applied to "
+      << "batched right-hand sides.";
+
+  chi_log.Log(LOG_0)
+    << "Solving " << R << " batched right-hand sides.";
+
+  batch_phi_old.assign(R,phi_old_local);
+  batch_phi_new.assign(R,phi_new_local);
+  batch_q_moments.assign(R,q_moments_local);
+
+  for (int gs=0; gs<group_sets.size(); gs++)
+  {
+    InitGroupsetSolve(gs);
+    ClassicRichardsonBatch(gs);
+    CleanUpGroupsetSolve(gs);
+  }
+
+  SelectBatchSolution(0);
+}
+
+//###################################################################
+/**Copies the flux of a batched right-hand side into phi_old, making it
+ * available to the field functions.*/
+void LinearBoltzman::Solver::SelectBatchSolution(int rhs)
+{
+  if ((rhs < 0) or (rhs >= batch_phi_old.size()))
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Batched right-hand side " << rhs << " does not exist or has "
+      << "not been solved.";
+    exit(EXIT_FAILURE);
+  }
+
+  phi_old_local = batch_phi_old[rhs];
+  phi_new_local = batch_phi_old[rhs];
+}
@@ -0,0 +1,667 @@
+#include "lbs_linear_boltzman_solver.h"
+
+#include "ChiMesh/SweepUtilities/SweepScheduler/sweepscheduler.h"
+#include "ChiMath/SpatialDiscretization/PiecewiseLinear/pwl.h"
+#include "ChiMath/SparseMatrix/chi_math_sparse_matrix.h"
+
+#include <chi_mpi.h>
+#include <chi_log.h>
+
+#include <map>
+#include <set>
+#include <cfloat>
+#include <algorithm>
+
+extern ChiMPI chi_mpi;
+extern ChiLog chi_log;
+
+typedef chi_mesh::sweep_management::SchedulingAlgorithm SchedulingAlgorithm;
+
+namespace
+{
+//###################################################################
+/**Uniform lattice of bins over the bounding box of the cell
+ * centroids.*/
+struct CMFDLattice
+{
+  double xyz_min[3] = {0.0,0.0,0.0};
+  double xyz_max[3] = {0.0,0.0,0.0};
+  int    divisions[3] = {1,1,1};
+
+  int NumBins() const {return divisions[0]*divisions[1]*divisions[2];}
+
+  int MapBin(const chi_mesh::Vector3& point) const
+  {
+    const double xyz[3] = {point.x,point.y,point.z};
+    int ijk[3] = {0,0,0};
+    for (int d=0; d<3; ++d)
+    {
+      double extent = xyz_max[d] - xyz_min[d];
+      if (extent <= 0.0) continue;
+      ijk[d] = static_cast<int>((xyz[d] - xyz_min[d])/extent*divisions[d]);
+      ijk[d] = std::max(0,std::min(ijk[d],divisions[d]-1));
+    }
+    return ijk[0] + divisions[0]*(ijk[1] + divisions[1]*ijk[2]);
+  }
+};
+}
+
+//###################################################################
+/**Initializes coarse-mesh finite-difference acceleration. Cells are
+ * grouped into coarse cells by a uniform lattice over the domain. The
+ * lattice divisions are taken from options.cmfd_divisions or, when
+ * these are zero, chosen such that a coarse cell holds about two cells
+ * in each direction. Faces on reflecting boundaries get no coarse
+ * coupling, i.e., zero net current.*/
+void LinearBoltzman::Solver::InitCMFD()
+{
+  CleanUpCMFD();
+
+  auto pwl_discretization = (SpatialDiscretization_PWL*)discretization;
+  int num_grps = groups.size();
+
+  cmfd = new CMFDData;
+  cmfd->num_groups = num_grps;
+
+  //================================================== Build lattice
+  CMFDLattice lattice;
+  double local_min[3] = { DBL_MAX, DBL_MAX, DBL_MAX};
+  double local_max[3] = {-DBL_MAX,-DBL_MAX,-DBL_MAX};
+  for (const auto& cell : grid->local_cells)
+  {
+    const double xyz[3] = {cell.centroid.x,cell.centroid.y,cell.centroid.z};
+    for (int d=0; d<3; ++d)
+    {
+      local_min[d] = std::min(local_min[d],xyz[d]);
+      local_max[d] = std::max(local_max[d],xyz[d]);
+    }
+  }
+  MPI_Allreduce(local_min,lattice.xyz_min,3,MPI_DOUBLE,MPI_MIN,chi_mpi.comm);
+  MPI_Allreduce(local_max,lattice.xyz_max,3,MPI_DOUBLE,MPI_MAX,chi_mpi.comm);
+
+  int local_num_cells = grid->local_cells.size();
+  int global_num_cells = 0;
+  MPI_Allreduce(&local_num_cells,&global_num_cells,1,MPI_INT,MPI_SUM,
+                chi_mpi.comm);
+
+  int dimension = 0;
+  for (int d=0; d<3; ++d)
+    if (lattice.xyz_max[d] > lattice.xyz_min[d]) ++dimension;
+
+  const auto& divisions = options.cmfd_divisions;
+  bool automatic = std::all_of(divisions.begin(),divisions.end(),
+                               [](int n){return n <= 0;});
+  for (int d=0; d<3; ++d)
+  {
+    if (lattice.xyz_max[d] <= lattice.xyz_min[d])
+      lattice.divisions[d] = 1;
+    else if (automatic)
+    {
+      double target = std::max(1,global_num_cells/(1 << dimension));
+      lattice.divisions[d] =
+        std::max(1,(int)std::round(std::pow(target,1.0/dimension)));
+    }
+    else
+      lattice.divisions[d] = std::max(1,divisions[d]);
+  }
+
+  //================================================== Compact coarse ids
+  std::vector<int> local_bin_used(lattice.NumBins(),0);
+  for (const auto& cell : grid->local_cells)
+    local_bin_used[lattice.MapBin(cell.centroid)] = 1;
+
+  std::vector<int> bin_used(lattice.NumBins(),0);
+  MPI_Allreduce(local_bin_used.data(),bin_used.data(),lattice.NumBins(),
+                MPI_INT,MPI_MAX,chi_mpi.comm);
+
+  std::vector<int> bin_to_coarse(lattice.NumBins(),-1);
+  int num_coarse = 0;
+  for (int b=0; b<lattice.NumBins(); ++b)
+    if (bin_used[b] > 0) bin_to_coarse[b] = num_coarse++;
+
+  cmfd->num_coarse_cells = num_coarse;
+
+  cmfd->cell_coarse_id.resize(local_num_cells,-1);
+  for (const auto& cell : grid->local_cells)
+    cmfd->cell_coarse_id[cell.local_id] =
+      bin_to_coarse[lattice.MapBin(cell.centroid)];
+
+  //================================================== Neighbor coarse ids
+  std::map<int,int> neighbor_coarse_id;
+  {
+    std::vector<chi_mesh::Cell*> neighbor_cells;
+    grid->CommunicatePartitionNeighborCells(neighbor_cells);
+    for (auto neighbor : neighbor_cells)
+    {
+      neighbor_coarse_id[neighbor->global_id] =
+        bin_to_coarse[lattice.MapBin(neighbor->centroid)];
+      delete neighbor;
+    }
+  }
+
+  //================================================== Coarse geometry and
+  //                                                   interface keys
+  //Coarse cells: volume, volume-weighted centroid, boundary area
+  std::vector<double> local_coarse_geom(num_coarse*5,0.0);
+  std::map<std::pair<int,int>,std::vector<double>> local_interfaces;
+  std::vector<std::vector<std::pair<int,int>>> face_keys(local_num_cells);
+
+  cmfd->face_interface.resize(local_num_cells);
+  cmfd->face_sign.resize(local_num_cells);
+  for (const auto& cell : grid->local_cells)
+  {
+    auto cell_fe_view = pwl_discretization->MapFeViewL(cell.local_id);
+    auto transport_view =
+      (LinearBoltzman::CellViewFull*)cell_transport_views[cell.local_id];
+    int c = cmfd->cell_coarse_id[cell.local_id];
+    size_t num_faces = cell.faces.size();
+
+    double volume = 0.0;
+    for (int i=0; i<cell_fe_view->dofs; ++i)
+      volume += cell_fe_view->IntV_shapeI[i];
+
+    double* geom = &local_coarse_geom[c*5];
+    geom[0] += volume;
+    geom[1] += volume*cell.centroid.x;
+    geom[2] += volume*cell.centroid.y;
+    geom[3] += volume*cell.centroid.z;
+
+    cmfd->face_interface[cell.local_id].assign(num_faces,
+                                               CMFDData::NOT_ON_INTERFACE);
+    cmfd->face_sign[cell.local_id].assign(num_faces,0.0);
+    face_keys[cell.local_id].assign(num_faces,std::make_pair(-1,-1));
+
+    for (int f=0; f<num_faces; ++f)
+    {
+      const auto& face = cell.faces[f];
+
+      double area = 0.0;
+      for (int fi=0; fi<face.vertex_ids.size(); ++fi)
+        area += cell_fe_view->IntS_shapeI[f][
+                  cell_fe_view->face_dof_mappings[f][fi]];
+
+      if (grid->IsCellBndry(face.neighbor))
+      {
+        int bndry_index = -(face.neighbor + 1);
+        if ((bndry_index < (int)boundary_types.size()) and
+            (boundary_types[bndry_index].first == BoundaryType::REFLECTING))
+        {
+          cmfd->face_interface[cell.local_id][f] =
+            CMFDData::REFLECTING_BOUNDARY;
+          continue;
+        }
+
+        cmfd->face_interface[cell.local_id][f] = CMFDData::COARSE_BOUNDARY;
+        geom[4] += area;
+        continue;
+      }
+
+      int c_neighbor = -1;
+      if (transport_view->face_local[f])
+        c_neighbor = cmfd->cell_coarse_id[grid->cells[face.neighbor]->local_id];
+      else
+        c_neighbor = neighbor_coarse_id[face.neighbor];
+
+      if (c_neighbor == c) continue;
+
+      auto key = std::make_pair(std::min(c,c_neighbor),std::max(c,c_neighbor));
+      face_keys[cell.local_id][f] = key;
+      cmfd->face_sign[cell.local_id][f] = (c == key.first)? 1.0 : -1.0;
+
+      //Interface geometry is only accumulated from the lower side so
+      //that every face is counted once
+      auto& igeom = local_interfaces[key];
+      igeom.resize(4,0.0);
+      if (c == key.first)
+      {
+        igeom[0] += area;
+        igeom[1] += area*face.centroid.x;
+        igeom[2] += area*face.centroid.y;
+        igeom[3] += area*face.centroid.z;
+      }
+    }//for f
+  }//for cell
+
+  //================================================== Global interfaces
+  std::vector<int> local_keys;
+  for (const auto& interface : local_interfaces)
+  {
+    local_keys.push_back(interface.first.first);
+    local_keys.push_back(interface.first.second);
+  }
+
+  int local_key_count = local_keys.size();
+  std::vector<int> key_counts(chi_mpi.process_count,0);
+  MPI_Allgather(&local_key_count,1,MPI_INT,
+                key_counts.data(),1,MPI_INT,chi_mpi.comm);
+
+  std::vector<int> key_displs(chi_mpi.process_count,0);
+  for (int p=1; p<chi_mpi.process_count; ++p)
+    key_displs[p] = key_displs[p-1] + key_counts[p-1];
+  int total_key_count = key_displs.back() + key_counts.back();
+
+  std::vector<int> global_keys(total_key_count,0);
+  MPI_Allgatherv(local_keys.data(),local_key_count,MPI_INT,
+                 global_keys.data(),key_counts.data(),key_displs.data(),
+                 MPI_INT,chi_mpi.comm);
+
+  std::set<std::pair<int,int>> unique_keys;
+  for (int k=0; k<total_key_count; k+=2)
+    unique_keys.emplace(global_keys[k],global_keys[k+1]);
+
+  std::map<std::pair<int,int>,int> key_to_interface;
+  for (const auto& key : unique_keys)
+  {
+    key_to_interface[key] = cmfd->interfaces.size();
+    cmfd->interfaces.push_back(key);
+  }
+  int num_interfaces = cmfd->interfaces.size();
+
+  for (const auto& cell : grid->local_cells)
+    for (int f=0; f<cell.faces.size(); ++f)
+      if (face_keys[cell.local_id][f].first >= 0)
+        cmfd->face_interface[cell.local_id][f] =
+          key_to_interface[face_keys[cell.local_id][f]];
+
+  //================================================== Reduce geometry
+  std::vector<double> local_interface_geom(num_interfaces*4,0.0);
+  for (const auto& interface : local_interfaces)
+  {
+    int i = key_to_interface[interface.first];
+    for (int k=0; k<4; ++k)
+      local_interface_geom[i*4+k] = interface.second[k];
+  }
+
+  std::vector<double> coarse_geom(local_coarse_geom.size(),0.0);
+  std::vector<double> interface_geom(local_interface_geom.size(),0.0);
+  MPI_Allreduce(local_coarse_geom.data(),coarse_geom.data(),
+                coarse_geom.size(),MPI_DOUBLE,MPI_SUM,chi_mpi.comm);
+  MPI_Allreduce(local_interface_geom.data(),interface_geom.data(),
+                interface_geom.size(),MPI_DOUBLE,MPI_SUM,chi_mpi.comm);
+
+  cmfd->coarse_volume.resize(num_coarse,0.0);
+  cmfd->coarse_centroid.resize(num_coarse);
+  cmfd->coarse_boundary_area.resize(num_coarse,0.0);
+  for (int c=0; c<num_coarse; ++c)
+  {
+    const double* geom = &coarse_geom[c*5];
+    double volume = geom[0];
+    cmfd->coarse_volume[c] = volume;
+    if (volume > 0.0)
+      cmfd->coarse_centroid[c] =
+        chi_mesh::Vector3(geom[1],geom[2],geom[3])/volume;
+    cmfd->coarse_boundary_area[c] = geom[4];
+  }
+
+  cmfd->interface_area.resize(num_interfaces,0.0);
+  cmfd->interface_centroid.resize(num_interfaces);
+  for (int i=0; i<num_interfaces; ++i)
+  {
+    const double* igeom = &interface_geom[i*4];
+    double area = igeom[0];
+    cmfd->interface_area[i] = area;
+    if (area > 0.0)
+      cmfd->interface_centroid[i] =
+        chi_mesh::Vector3(igeom[1],igeom[2],igeom[3])/area;
+  }
+
+  //================================================== Scattering sparsity
+  std::set<std::pair<int,int>> pairs;
+  for (auto xs : material_xs)
+  {
+    if (xs->transfer_matrix.empty()) continue;
+    const auto& S0 = xs->transfer_matrix[0];
+    for (int g=0; g<num_grps; ++g)
+      for (auto gprime : S0.rowI_indices[g])
+        pairs.emplace(g,(int)gprime);
+  }
+  cmfd->scattering_pairs.assign(pairs.begin(),pairs.end());
+
+  //================================================== Tallies
+  cmfd->interface_current.assign(num_interfaces*num_grps,0.0);
+  cmfd->boundary_outflow.assign(num_coarse*num_grps,0.0);
+  cmfd->boundary_inflow.assign(num_coarse*num_grps,0.0);
+
+  chi_log.Log(LOG_0)
+    << "CMFD initialized with " << num_coarse << " coarse cells ("
+    << lattice.divisions[0] << "x" << lattice.divisions[1] << "x"
+    << lattice.divisions[2] << " lattice) and "
+    << num_interfaces << " coarse interfaces.";
+}
+
+//###################################################################
+/**Whether the coarse face currents of a groupset are tallied during its
+ * inner iterations. Only the final flux of classic Richardson without
+ * DSA is the result of its last sweep. DSA corrects the flux after the
+ * sweep, which the currents of the sweep do not include.*/
+bool LinearBoltzman::Solver::CMFDTalliesDuringIterations(LBSGroupset *groupset)
+{
+  return (cmfd != nullptr) and
+         (groupset->iterative_method == NPT_CLASSICRICHARDSON) and
+         (not groupset->apply_wgdsa) and
+         (not groupset->apply_tgdsa);
+}
+
+//###################################################################
+/**Performs a source iteration sweep of a groupset with the latest
+ * flux, tallying the coarse face currents. The groupset flux is updated
+ * with the result of the sweep so that flux and currents are
+ * consistent. Only needed when the currents are not tallied during the
+ * inner iterations, see CMFDTalliesDuringIterations.*/
+void LinearBoltzman::Solver::CMFDTallySweep(int group_set_num)
+{
+  LBSGroupset* groupset = group_sets[group_set_num];
+
+  auto sweep_chunk = SetSweepChunk(group_set_num);
+  MainSweepScheduler sweepScheduler(SchedulingAlgorithm::DEPTH_OF_GRAPH,
+                                    groupset->angle_agg);
+
+  cmfd->ResetCurrentTallies(groupset->groups.front()->id,
+                            groupset->groups.size());
+
+  SetSource(group_set_num,SourceFlags::USE_MATERIAL_SOURCE);
+
+  groupset->angle_agg->ResetDelayedPsi();
+
+  sweep_chunk->SetDestinationPhi(&phi_new_local);
+  sweep_chunk->SetCurrentTally(cmfd);
+
+  phi_new_local.assign(phi_new_local.size(),0.0);
+  sweepScheduler.Sweep(sweep_chunk);
+  ReduceAngularMoments(groupset);
+
+  DisAssembleVectorLocalToLocal(groupset,phi_new_local.data(),
+                                         phi_old_local.data());
+
+  delete sweep_chunk;
+}
+
+//###################################################################
+/**Solves the multigroup coarse-mesh finite-difference system and
+ * scales the flux moments of every cell with the ratio of the new to
+ * the old coarse flux.
+ *
+ * For every coarse cell c and group g the balance
+ * \f[
+ *  \sum_i A_i J_{i,g} + V_c \Sigma_{t,cg} \bar{\phi}_{cg}
+ *  - V_c\sum_{g'} (\Sigma_{s,c}^{g'\to g} +
+ *    \chi_{cg}\nu\Sigma_{f,cg'}) \bar{\phi}_{cg'} = V_c Q_{cg}
+ * \f]
+ * is solved, with flux-weighted homogenized cross-sections and the
+ * interface currents
+ * \f$ J = -\tilde{D}(\bar{\phi}_{hi}-\bar{\phi}_{lo}) +
+ *         \hat{D}(\bar{\phi}_{hi}+\bar{\phi}_{lo}) \f$.
+ * The correction \f$ \hat{D} \f$ reproduces the tallied transport
+ * current for the current flux. When \f$ |\hat{D}|>\tilde{D} \f$ both
+ * coefficients are recomputed in upwind form to keep the coarse matrix
+ * positive. Boundary outflow is represented by a pure correction term
+ * and boundary inflow is a source.*/
+void LinearBoltzman::Solver::ApplyCMFD()
+{
+  auto pwl_discretization = (SpatialDiscretization_PWL*)discretization;
+
+  const int G  = cmfd->num_groups;
+  const int N  = cmfd->num_coarse_cells;
+  const int K  = cmfd->scattering_pairs.size();
+  const int NI = cmfd->interfaces.size();
+  const int gi = groups.front()->id;
+
+  //================================================== Map scattering entries
+  //Per cross-section, row g and entry t, the index of the pair
+  std::map<std::pair<int,int>,int> pair_index;
+  for (int k=0; k<K; ++k) pair_index[cmfd->scattering_pairs[k]] = k;
+
+  std::vector<std::vector<std::vector<int>>> xs_pair_index(material_xs.size());
+  for (size_t x=0; x<material_xs.size(); ++x)
+  {
+    if (material_xs[x]->transfer_matrix.empty()) continue;
+    const auto& S0 = material_xs[x]->transfer_matrix[0];
+    xs_pair_index[x].resize(G);
+    for (int g=0; g<G; ++g)
+      for (auto gprime : S0.rowI_indices[g])
+        xs_pair_index[x][g].push_back(pair_index[{g,(int)gprime}]);
+  }
+
+  //================================================== Reaction rate tallies
+  //Per coarse cell: Phi[G], Rt[G], Rf[G], ChiF[G], Q[G], F, Rs[K]
+  const int S = 5*G + 1 + K;
+  std::vector<double> local_tallies(N*S,0.0);
+  std::vector<double> phi_int(G,0.0);
+  std::vector<double> default_zero_src(G,0.0);
+  for (const auto& cell : grid->local_cells)
+  {
+    auto cell_fe_view = pwl_discretization->MapFeViewL(cell.local_id);
+    auto transport_view =
+      (LinearBoltzman::CellViewFull*)cell_transport_views[cell.local_id];
+
+    int xs_id  = matid_to_xs_map[cell.material_id];
+    int src_id = matid_to_src_map[cell.material_id];
+    auto xs = material_xs[xs_id];
+    const double* src = default_zero_src.data();
+    if (src_id >= 0)
+      src = material_srcs[src_id]->source_value_g.data();
+
+    double volume = 0.0;
+    phi_int.assign(G,0.0);
+    for (int i=0; i<cell_fe_view->dofs; ++i)
+    {
+      double intV_shapeI = cell_fe_view->IntV_shapeI[i];
+      volume += intV_shapeI;
+      const double* phi = &phi_old_local[transport_view->MapDOF(i,0,gi)];
+      for (int g=0; g<G; ++g)
+        phi_int[g] += intV_shapeI*phi[g];
+    }
+
+    double* tally = &local_tallies[cmfd->cell_coarse_id[cell.local_id]*S];
+    double* Phi  = tally;
+    double* Rt   = tally + G;
+    double* Rf   = tally + 2*G;
+    double* ChiF = tally + 3*G;
+    double* Q    = tally + 4*G;
+    double* F    = tally + 5*G;
+    double* Rs   = tally + 5*G + 1;
+
+    double fission_rate = 0.0;
+    for (int g=0; g<G; ++g)
+    {
+      Phi[g] += phi_int[g];
+      Rt[g]  += xs->sigma_tg[g]*phi_int[g];
+      Rf[g]  += xs->nu_sigma_fg[g]*phi_int[g];
+      Q[g]   += src[g]*volume;
+      fission_rate += xs->nu_sigma_fg[g]*phi_int[g];
+    }
+    for (int g=0; g<G; ++g)
+      ChiF[g] += xs->chi_g[g]*fission_rate;
+    F[0] += fission_rate;
+
+    if (xs->transfer_matrix.empty()) continue;
+    const auto& S0 = xs->transfer_matrix[0];
+    const auto& pair_map = xs_pair_index[xs_id];
+    for (int g=0; g<G; ++g)
+      for (size_t t=0; t<S0.rowI_indices[g].size(); ++t)
+        Rs[pair_map[g][t]] += S0.rowI_values[g][t]*
+                              phi_int[S0.rowI_indices[g][t]];
+  }//for cell
+
+  std::vector<double> tallies(N*S,0.0);
+  std::vector<double> interface_current(NI*G,0.0);
+  std::vector<double> boundary_outflow(N*G,0.0);
+  std::vector<double> boundary_inflow(N*G,0.0);
+  MPI_Allreduce(local_tallies.data(),tallies.data(),N*S,
+                MPI_DOUBLE,MPI_SUM,chi_mpi.comm);
+
+  //Each team tallies its own angle sets or groupsets, hence currents
+  //are summed over the world
+  MPI_Allreduce(cmfd->interface_current.data(),interface_current.data(),NI*G,
+                MPI_DOUBLE,MPI_SUM,MPI_COMM_WORLD);
+  MPI_Allreduce(cmfd->boundary_outflow.data(),boundary_outflow.data(),N*G,
+                MPI_DOUBLE,MPI_SUM,MPI_COMM_WORLD);
+  MPI_Allreduce(cmfd->boundary_inflow.data(),boundary_inflow.data(),N*G,
+                MPI_DOUBLE,MPI_SUM,MPI_COMM_WORLD);
+
+  //================================================== Homogenize
+  const double tiny = std::numeric_limits<double>::min();
+  std::vector<double> phi_bar(N*G,0.0);
+  std::vector<double> sigma_t(N*G,0.0);
+  for (int c=0; c<N; ++c)
+    for (int g=0; g<G; ++g)
+    {
+      double Phi = tallies[c*S + g];
+      if (Phi <= tiny) continue;
+      phi_bar[c*G+g] = Phi/cmfd->coarse_volume[c];
+      sigma_t[c*G+g] = tallies[c*S + G + g]/Phi;
+    }
+
+  //================================================== Assemble
+  chi_math::SparseMatrix A(N*G,N*G);
+  std::vector<double> rhs(N*G,0.0);
+  for (int c=0; c<N; ++c)
+  {
+    const double* tally = &tallies[c*S];
+    const double* Phi  = tally;
+    const double* Rf   = tally + 2*G;
+    const double* ChiF = tally + 3*G;
+    const double* Q    = tally + 4*G;
+    const double  F    = tally[5*G];
+    const double* Rs   = tally + 5*G + 1;
+    double volume = cmfd->coarse_volume[c];
+
+    for (int g=0; g<G; ++g)
+    {
+      int r = c*G + g;
+      A.InsertAdd(r,r,sigma_t[r]*volume);
+      rhs[r] += Q[g] + boundary_inflow[r];
+
+      if (phi_bar[r] > tiny)
+        A.InsertAdd(r,r,boundary_outflow[r]/phi_bar[r]);
+    }
+
+    for (int k=0; k<K; ++k)
+    {
+      int g      = cmfd->scattering_pairs[k].first;
+      int gprime = cmfd->scattering_pairs[k].second;
+      if (Phi[gprime] <= tiny) continue;
+      A.InsertAdd(c*G+g,c*G+gprime,-Rs[k]/Phi[gprime]*volume);
+    }
+
+    if (F > tiny)
+      for (int g=0; g<G; ++g)
+      {
+        if (ChiF[g] <= 0.0) continue;
+        for (int gprime=0; gprime<G; ++gprime)
+        {
+          if ((Phi[gprime] <= tiny) or (Rf[gprime] <= 0.0)) continue;
+          A.InsertAdd(c*G+g,c*G+gprime,
+                      -(ChiF[g]/F)*(Rf[gprime]/Phi[gprime])*volume);
+        }
+      }
+  }//for c
+
+  for (int i=0; i<NI; ++i)
+  {
+    int lo = cmfd->interfaces[i].first;
+    int hi = cmfd->interfaces[i].second;
+    double area = cmfd->interface_area[i];
+    if (area <= 0.0) continue;
+
+    double d_lo = (cmfd->interface_centroid[i]-cmfd->coarse_centroid[lo]).Norm();
+    double d_hi = (cmfd->interface_centroid[i]-cmfd->coarse_centroid[hi]).Norm();
+
+    for (int g=0; g<G; ++g)
+    {
+      int r_lo = lo*G + g;
+      int r_hi = hi*G + g;
+      double phi_lo = phi_bar[r_lo];
+      double phi_hi = phi_bar[r_hi];
+
+      double D_lo = 1.0/(3.0*std::max(sigma_t[r_lo],1.0e-8));
+      double D_hi = 1.0/(3.0*std::max(sigma_t[r_hi],1.0e-8));
+      double D_tilde = 1.0/std::max(d_lo/D_lo + d_hi/D_hi,tiny);
+
+      double J = interface_current[i*G+g]/area;
+      double D_hat = 0.0;
+      if ((phi_lo + phi_hi) > tiny)
+        D_hat = (J + D_tilde*(phi_hi - phi_lo))/(phi_lo + phi_hi);
+
+      if (std::fabs(D_hat) > D_tilde)
+      {
+        if ((J >= 0.0) and (phi_lo > tiny))
+        {
+          D_tilde = J/(2.0*phi_lo);
+          D_hat   = D_tilde;
+        }
+        else if ((J < 0.0) and (phi_hi > tiny))
+        {
+          D_tilde = -J/(2.0*phi_hi);
+          D_hat   = -D_tilde;
+        }
+      }
+
+      A.InsertAdd(r_lo,r_lo, area*(D_tilde + D_hat));
+      A.InsertAdd(r_lo,r_hi, area*(D_hat - D_tilde));
+      A.InsertAdd(r_hi,r_hi, area*(D_tilde - D_hat));
+      A.InsertAdd(r_hi,r_lo,-area*(D_tilde + D_hat));
+    }
+  }//for interface
+
+  //================================================== Solve (Gauss-Seidel)
+  std::vector<double> x = phi_bar;
+  double max_change = 0.0;
+  int k = 0;
+  for (k=0; k<options.cmfd_max_iterations; ++k)
+  {
+    max_change = 0.0;
+    for (int r=0; r<N*G; ++r)
+    {
+      double diag = 0.0;
+      double sum  = rhs[r];
+      for (size_t t=0; t<A.rowI_indices[r].size(); ++t)
+      {
+        size_t j = A.rowI_indices[r][t];
+        if (j == r) diag = A.rowI_values[r][t];
+        else        sum -= A.rowI_values[r][t]*x[j];
+      }
+      if (std::fabs(diag) <= tiny) continue;
+
+      double x_new = sum/diag;
+      double scale = std::max(std::fabs(x_new),std::fabs(x[r]));
+      if (scale > tiny)
+        max_change = std::max(max_change,std::fabs(x_new - x[r])/scale);
+      x[r] = x_new;
+    }
+    if (max_change < options.cmfd_tolerance) break;
+  }
+
+  chi_log.Log(LOG_0)
+    << "CMFD coarse solve: " << k << " iterations, point-wise change "
+    << max_change;
+
+  //================================================== Prolongate
+  std::vector<double> ratio(N*G,1.0);
+  for (int r=0; r<N*G; ++r)
+    if ((phi_bar[r] > tiny) and (x[r] > 0.0))
+      ratio[r] = x[r]/phi_bar[r];
+
+  for (const auto& cell : grid->local_cells)
+  {
+    auto transport_view =
+      (LinearBoltzman::CellViewFull*)cell_transport_views[cell.local_id];
+    const double* cell_ratio = &ratio[cmfd->cell_coarse_id[cell.local_id]*G];
+
+    for (int i=0; i<transport_view->dofs; ++i)
+      for (int m=0; m<num_moments; ++m)
+      {
+        double* phi = &phi_old_local[transport_view->MapDOF(i,m,gi)];
+        for (int g=0; g<G; ++g)
+          phi[g] *= cell_ratio[g];
+      }
+  }
+}
+
+//###################################################################
+/**Destroys CMFD data.*/
+void LinearBoltzman::Solver::CleanUpCMFD()
+{
+  delete cmfd;
+  cmfd = nullptr;
+}
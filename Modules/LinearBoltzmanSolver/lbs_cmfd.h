@@ -0,0 +1,111 @@
+#ifndef _lbs_cmfd_h
+#define _lbs_cmfd_h
+
+#include "ChiMesh/chi_mesh.h"
+#include "ChiMesh/SweepUtilities/sweep_namespace.h"
+
+#include <vector>
+#include <utility>
+
+namespace LinearBoltzman
+{
+
+//###################################################################
+/**Data for coarse-mesh finite-difference (CMFD) acceleration.
+ *
+ * Local cells are grouped into coarse cells. Coarse cells are identified
+ * globally, i.e., a coarse cell can span several locations, and all
+ * tallies are reduced over all locations so that every location holds
+ * the complete (small) coarse system.
+ *
+ * Face currents are tallied during a transport sweep. For every fine face
+ * on a coarse interface the outgoing partial current is added to the
+ * interface with a sign relative to the interface orientation (from the
+ * lower to the higher coarse cell), so that both sides together give the
+ * net current. On the domain boundary outgoing and incoming partial
+ * currents are tallied separately per coarse cell. Reflecting boundary
+ * faces are not tallied since their net current is zero at convergence.*/
+struct CMFDData : public chi_mesh::sweep_management::FaceCurrentTally
+{
+  static const int NOT_ON_INTERFACE    = -1;
+  static const int COARSE_BOUNDARY     = -2;
+  static const int REFLECTING_BOUNDARY = -3;
+
+  int num_groups       = 0;
+  int num_coarse_cells = 0;
+
+  std::vector<int>                 cell_coarse_id;  ///< Per local cell
+  std::vector<std::vector<int>>    face_interface;  ///< Per local cell face
+  std::vector<std::vector<double>> face_sign;       ///< +1 lower side
+
+  std::vector<double>              coarse_volume;
+  std::vector<chi_mesh::Vector3>   coarse_centroid;
+  std::vector<double>              coarse_boundary_area;
+
+  std::vector<std::pair<int,int>>  interfaces;      ///< lower,higher
+  std::vector<double>              interface_area;
+  std::vector<chi_mesh::Vector3>   interface_centroid;
+
+  std::vector<std::pair<int,int>>  scattering_pairs; ///< g,gprime
+
+  //Tallies [index*num_groups + g]
+  std::vector<double>              interface_current;
+  std::vector<double>              boundary_outflow;
+  std::vector<double>              boundary_inflow;
+
+  //================================================== Methods
+  /**Clears the current tallies of a range of groups.*/
+  void ResetCurrentTallies(int first_group, int num_grps)
+  {
+    for (size_t i=0; i<interfaces.size(); ++i)
+      for (int g=first_group; g<first_group+num_grps; ++g)
+        interface_current[i*num_groups + g] = 0.0;
+
+    for (int c=0; c<num_coarse_cells; ++c)
+      for (int g=first_group; g<first_group+num_grps; ++g)
+      {
+        boundary_outflow[c*num_groups + g] = 0.0;
+        boundary_inflow [c*num_groups + g] = 0.0;
+      }
+  }
+
+  /**Adds the outgoing partial current of a face to the tallies.*/
+  void TallyOutgoing(int cell_local_id, int f,
+                     int first_group, int num_grps,
+                     const double* current) override
+  {
+    int iface = face_interface[cell_local_id][f];
+    if (iface >= 0)
+    {
+      double sign = face_sign[cell_local_id][f];
+      double* tally = &interface_current[iface*num_groups + first_group];
+      for (int g=0; g<num_grps; ++g)
+        tally[g] += sign*current[g];
+    }
+    else if (iface == COARSE_BOUNDARY)
+    {
+      int c = cell_coarse_id[cell_local_id];
+      double* tally = &boundary_outflow[c*num_groups + first_group];
+      for (int g=0; g<num_grps; ++g)
+        tally[g] += current[g];
+    }
+  }
+
+  /**Adds the incoming partial current of a boundary face to the
+   * tallies.*/
+  void TallyIncoming(int cell_local_id, int f,
+                     int first_group, int num_grps,
+                     const double* current) override
+  {
+    if (face_interface[cell_local_id][f] != COARSE_BOUNDARY) return;
+
+    int c = cell_coarse_id[cell_local_id];
+    double* tally = &boundary_inflow[c*num_groups + first_group];
+    for (int g=0; g<num_grps; ++g)
+      tally[g] += current[g];
+  }
+};
+
+}
+
+#endif
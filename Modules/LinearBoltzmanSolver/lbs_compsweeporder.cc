@@ -52,8 +52,28 @@ void LinearBoltzman::Solver::ComputeSweepOrderings(LBSGroupset *groupset)
       this->sweep_orderings.push_back(new_swp_order);
     }
   }
+  //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Clustered angle aggr.
+  else if ((groupset->angleagg_method ==
+            LinearBoltzman::AngleAggregationType::OCTANT) or
+           (groupset->angleagg_method ==
+            LinearBoltzman::AngleAggregationType::CONE))
+  {
+    ComputeAngleClusters(groupset);
+
+    for (const auto& cluster : groupset->angle_clusters)
+    {
+      auto angle = groupset->quadrature->abscissae[cluster.front()];
+      chi_mesh::sweep_management::SPDS* new_swp_order =
+        chi_mesh::sweep_management::
+        CreateSweepOrder(angle->theta,
+                         angle->phi,
+                         this->grid,
+                         groupset->allow_cycles);
+      this->sweep_orderings.push_back(new_swp_order);
+    }
+  }
   //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% 1D MESHES
-  else if (typeid(*mesher) == typeid(chi_mesh::VolumeMesherLinemesh1D))
+  else if (mesher->Type() == chi_mesh::VolumeMesherType::LINEMESH1D)
   {
     int num_azi = groupset->quadrature->azimu_ang.size();
     int num_pol = groupset->quadrature->polar_ang.size();
@@ -84,9 +104,9 @@ void LinearBoltzman::Solver::ComputeSweepOrderings(LBSGroupset *groupset)
     this->sweep_orderings.push_back(new_swp_order);
   }
   //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% 2D 3D MESHES
-  else if ( (typeid(*mesher) == typeid(chi_mesh::VolumeMesherExtruder)) or
-            (typeid(*mesher) == typeid(chi_mesh::VolumeMesherPredefined2D)) or
-            (typeid(*mesher) == typeid(chi_mesh::VolumeMesherPredefined3D)))
+  else if ( (mesher->Type() == chi_mesh::VolumeMesherType::EXTRUDER) or
+            (mesher->Type() == chi_mesh::VolumeMesherType::PREDEFINED2D) or
+            (mesher->Type() == chi_mesh::VolumeMesherType::PREDEFINED3D))
   {
     int num_azi = groupset->quadrature->azimu_ang.size();
     int num_pol = groupset->quadrature->polar_ang.size();
@@ -12,23 +12,41 @@
 extern ChiLog chi_log;
 
 //###################################################################
-/** Computes the number of moments for the given mesher types*/
+/** Computes the number of moments for the given mesher types and the
+ * Legendre order of each moment.*/
 void LinearBoltzman::Solver::ComputeNumberOfMoments()
 {
   chi_mesh::MeshHandler*    mesh_handler = chi_mesh::GetCurrentHandler();
   chi_mesh::VolumeMesher*         mesher = mesh_handler->volume_mesher;
 
-  if (typeid(*mesher) == typeid(chi_mesh::VolumeMesherLinemesh1D))
+  int L = options.scattering_order;
+  bool OneD_Slab = false;
+  switch (mesher->Type())
   {
-    int L = options.scattering_order;
-    this->num_moments = L+1;
+    case chi_mesh::VolumeMesherType::LINEMESH1D:
+      OneD_Slab = true;
+      this->num_moments = L+1;
+      break;
+    case chi_mesh::VolumeMesherType::PREDEFINED2D:
+    case chi_mesh::VolumeMesherType::EXTRUDER:
+    case chi_mesh::VolumeMesherType::PREDEFINED3D:
+      this->num_moments = L*(L+2) + 1;
+      break;
+    default:
+      chi_log.Log(LOG_ALLERROR)
+        << "LinearBoltzman::Solver::ComputeNumberOfMoments: Unsupported "
+        << "volume mesher type " << mesher->Type() << ".";
+      exit(EXIT_FAILURE);
   }
-  if (typeid(*mesher) == typeid(chi_mesh::VolumeMesherExtruder) or
-      typeid(*mesher) == typeid(chi_mesh::VolumeMesherPredefined2D) or
-      typeid(*mesher) == typeid(chi_mesh::VolumeMesherPredefined3D))
+
+  //================================================== Legendre order of
+  //                                                   every moment
+  moment_to_ell.clear();
+  for (int ell=0; ell<=options.scattering_order; ell++)
   {
-    int L = options.scattering_order;
-    this->num_moments = L*(L+2) + 1;
+    int num_ell_moments = OneD_Slab? 1 : 2*ell+1;
+    for (int em=0; em<num_ell_moments; em++)
+      moment_to_ell.push_back(ell);
   }
 }
 
@@ -16,4 +16,19 @@ LinearBoltzman::Solver::Solver()
 
   boundary_types.resize(6,
     std::pair<BoundaryType,int>(LinearBoltzman::BoundaryType::VACUUM,-1));
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Destructor for NPT. A pending background restart write is completed
+ * first, which is collective. Execute already completes all writes, in
+ * which case the writer is only freed.*/
+LinearBoltzman::Solver::~Solver()
+{
+  if (async_restart_writer != nullptr)
+  {
+    async_restart_writer->Complete();
+    delete async_restart_writer;
+  }
+
+  for (auto xs : adjoint_xs) delete xs;
+}
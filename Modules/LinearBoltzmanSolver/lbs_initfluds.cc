@@ -28,9 +28,14 @@ void LinearBoltzman::Solver::InitFluxDataStructures(LBSGroupset *groupset)
   chi_mesh::MeshHandler* handler = chi_mesh::GetCurrentHandler();
   chi_mesh::VolumeMesher* mesher = handler->volume_mesher;
 
-  if ((typeid(*mesher) == typeid(chi_mesh::VolumeMesherLinemesh1D)) or
-      (typeid(*mesher) == typeid(chi_mesh::VolumeMesherPredefined2D)) or
-      (typeid(*mesher) == typeid(chi_mesh::VolumeMesherExtruder)))
+  if ((groupset->angleagg_method == AngleAggregationType::OCTANT) or
+      (groupset->angleagg_method == AngleAggregationType::CONE))
+  {
+    InitAngleAggClustered(groupset);
+  }
+  else if ((mesher->Type() == chi_mesh::VolumeMesherType::LINEMESH1D) or
+           (mesher->Type() == chi_mesh::VolumeMesherType::PREDEFINED2D) or
+           (mesher->Type() == chi_mesh::VolumeMesherType::EXTRUDER))
   {
     //================================================== Angle Aggregation
     if      (groupset->angleagg_method == AngleAggregationType::SINGLE)
@@ -47,6 +52,8 @@ void LinearBoltzman::Solver::InitFluxDataStructures(LBSGroupset *groupset)
     InitAngleAggSingle(groupset);
   }
 
+  DistributeAngleSetsToTeams(groupset);
+
   chi_log.Log(LOG_0)
     << chi_program_timer.GetTimeString()
     << " Initialized Angle Aggregation.   "
@@ -55,5 +62,5 @@ void LinearBoltzman::Solver::InitFluxDataStructures(LBSGroupset *groupset)
     << " MB.";
 
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 }
\ No newline at end of file
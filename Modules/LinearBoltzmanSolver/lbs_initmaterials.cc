@@ -32,8 +32,10 @@ void LinearBoltzman::Solver::InitMaterials(std::set<int>& material_ids)
 
   //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Check materials found
   int num_physics_mats = chi_physics_handler.material_stack.size();
-  matid_to_xs_map.resize(num_physics_mats,-1);
-  matid_to_src_map.resize(num_physics_mats,-1);
+  material_xs.clear();
+  material_srcs.clear();
+  matid_to_xs_map.assign(num_physics_mats,-1);
+  matid_to_src_map.assign(num_physics_mats,-1);
   std::set<int>::iterator matID;
   for (matID  = material_ids.begin();
        matID != material_ids.end();
@@ -135,7 +137,10 @@ void LinearBoltzman::Solver::InitMaterials(std::set<int>& material_ids)
   << "Materials Initialized:\n"
   << materials_list.str() << "\n";
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  if (options.adjoint)
+    InitAdjointMaterials();
+
+  MPI_Barrier(chi_mpi.comm);
 
   //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Initialize WGDSA stuff
   if (develop_wgdsa)
@@ -71,7 +71,7 @@ void LinearBoltzman::Solver::InitializeParrays()
   if (options.read_restart_data)
     ReadRestartData(options.read_restart_folder_name,
                     options.read_restart_file_base);
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
   //================================================== Initialize transport views
   // Transport views act as a data structure to store information
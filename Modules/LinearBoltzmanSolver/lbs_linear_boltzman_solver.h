@@ -8,12 +8,16 @@
 #include <ChiPhysics/PhysicsMaterial/property11_isotropic_mg_src.h>
 #include"ChiMath/SpatialDiscretization/spatial_discretization.h"
 #include "lbs_structs.h"
+#include "lbs_restartdata.h"
+#include "lbs_cmfd.h"
 #include "ChiMesh/SweepUtilities/sweep_namespace.h"
 #include "ChiMesh/SweepUtilities/SweepBoundary/sweep_boundaries.h"
 #include "ChiMath/SparseMatrix/chi_math_sparse_matrix.h"
 
 #include <petscksp.h>
 
+#include <map>
+
 typedef chi_mesh::sweep_management::SweepChunk SweepChunk;
 typedef chi_mesh::sweep_management::SweepScheduler MainSweepScheduler;
 
@@ -43,6 +47,8 @@ private:
   size_t source_event_tag=0;
 public:
   double last_restart_write=0.0;
+  AsyncRestartWriter* async_restart_writer = nullptr;
+  CMFDData* cmfd = nullptr;
   LinearBoltzman::Options options;    //In chi_npt_structs.h
 
   int num_moments;
@@ -52,6 +58,7 @@ public:
   std::vector<chi_physics::TransportCrossSections *> material_xs;
   std::vector<chi_physics::IsotropicMultiGrpSource *> material_srcs;
   std::vector<int> matid_to_xs_map;
+  std::vector<int> moment_to_ell;
   std::vector<int> matid_to_src_map;
 
   SpatialDiscretization *discretization;
@@ -64,13 +71,14 @@ public:
   std::vector<std::pair<BoundaryType, int>>     boundary_types;
   std::vector<std::vector<double>>              incident_P0_mg_boundaries;
   std::vector<chi_mesh::sweep_management::SPDS*> sweep_orderings;
+  std::vector<std::vector<chi_mesh::sweep_management::SPDS*>>
+                                                groupset_sweep_orderings;
   std::vector<SweepBndry*>                      sweep_boundaries;
 
   int max_cell_dof_count;
   unsigned long long local_dof_count;
   unsigned long long glob_dof_count;
 
-  Vec phi_new, phi_old, q_fixed;
   std::vector<double> q_moments_local;
   std::vector<double> phi_new_local, phi_old_local;
   std::vector<double> delta_phi_local;
@@ -78,9 +86,23 @@ public:
   std::vector<int> local_cell_phi_dof_array_address;
   std::vector<int> local_cell_dof_array_address;
 
+  //Batched right-hand sides. Per RHS the material id to group source map.
+  std::vector<std::map<int,std::vector<double>>> batch_sources;
+  std::vector<std::vector<double>> batch_phi_old, batch_phi_new;
+  std::vector<std::vector<double>> batch_q_moments;
+  int active_batch_rhs = -1;
+
+  //Adjoint mode. The flux is kept in the direction-reversed frame
+  //while solving, see ApplyAdjointMomentParity.
+  bool phi_in_adjoint_frame = false;
+  //Transposed material cross-sections. Owned by the solver and reused
+  //when the materials are initialized again.
+  std::vector<chi_physics::TransportCrossSections *> adjoint_xs;
+
  public:
   //00
   Solver();
+  ~Solver();
   //01
   void Initialize();
   //01a
@@ -96,14 +118,43 @@ public:
   //02
   void Execute();
   void SolveGroupset(int group_set_num);
+  void InitGroupsetSolve(int group_set_num);
+  void CleanUpGroupsetSolve(int group_set_num);
+  //02a
+  void ExecuteOuterIterations();
+  double ComputeInnerTolerance(double user_tolerance, double outer_change);
+  double ComputeOuterChange(const std::vector<double>& phi_prev_outer);
+  //02c
+  int  NumberOfBatchRHS();
+  void ExecuteBatch();
+  void ClassicRichardsonBatch(int group_set_num);
+  void SelectBatchSolution(int rhs);
+  //02d
+  void InitAdjointMaterials();
+  void CheckAdjointBoundaries();
+  void ApplyAdjointMomentParity();
+  double ComputeResponse(const std::map<int,std::vector<double>>& sources);
+  //02e
+  void AutoTuneGroupset(int group_set_num);
+  double TimeTrialSweeps(int group_set_num);
+  //02b
+  void InitCMFD();
+  bool CMFDTalliesDuringIterations(LBSGroupset *groupset);
+  void CMFDTallySweep(int group_set_num);
+  void ApplyCMFD();
+  void CleanUpCMFD();
 
   //03a
   void ComputeSweepOrderings(LBSGroupset *groupset);
+  void ComputeAngleClusters(LBSGroupset *groupset);
   //03b
   void InitFluxDataStructures(LBSGroupset *groupset);
+  void BuildGroupsetXSBlocks(LBSGroupset *groupset);
   //03c
   void InitAngleAggPolar(LBSGroupset *groupset);
   void InitAngleAggSingle(LBSGroupset *groupset);
+  void InitAngleAggClustered(LBSGroupset *groupset);
+  void DistributeAngleSetsToTeams(LBSGroupset *groupset);
   //03d
   void InitWGDSA(LBSGroupset *groupset);
   void AssembleWGDSADeltaPhiVector(LBSGroupset *groupset, double *ref_phi_old,
@@ -125,15 +176,34 @@ public:
   //05
   void WriteRestartData(std::string folder_name, std::string file_base);
   void ReadRestartData(std::string folder_name, std::string file_base);
+  void BuildRestartLayout(RestartLayout& layout, const std::string& file_name);
+  void CompleteRestartWrites();
 
   //IterativeMethods
   void SetSource(int group_set_num,
                  bool apply_mat_src = false,
                  bool suppress_phi_old = false);
   double ComputePiecewiseChange(LBSGroupset *groupset);
+  double ComputeLocalPiecewiseChangeAndCopy(LBSGroupset* groupset);
+  void ReduceAngularMoments(LBSGroupset *groupset);
+  void CopyGroupsetMoments(LBSGroupset *groupset, std::vector<double>& phi,
+                           std::vector<double>& buffer, bool to_phi);
+  bool EnergyTeamsActive();
+  bool GroupsetOnThisTeam(int group_set_num);
+  void BroadcastGroupsetMoments(LBSGroupset *groupset,
+                                std::vector<double>& phi, int root_team);
   SweepChunk *SetSweepChunk(int group_set_num);
+  SweepChunk *SetBatchSweepChunk(int group_set_num);
   void ClassicRichardson(int group_set_num);
   void GMRES(int group_set_num);
+  void InitKrylovSolver(LBSGroupset* groupset,
+                        int local_size, int globl_size);
+  void DestroyKrylovSolver(LBSGroupset* groupset);
+  void ExecuteKrylovDSA(LBSGroupset* groupset,
+                        chi_physics::Solver* dsa_solver,
+                        double user_tolerance);
+  void LogDSAIterationStats(LBSGroupset* groupset);
+  void Anderson(int group_set_num);
 
   //Vector assembly
   int  MapDOF(chi_mesh::Cell* cell, int dof, int mom, int g);
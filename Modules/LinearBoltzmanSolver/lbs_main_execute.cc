@@ -13,35 +13,95 @@ extern ChiConsole chi_console;
 /**Execute the solver.*/
 void LinearBoltzman::Solver::Execute()
 {
-  MPI_Barrier(MPI_COMM_WORLD);
-  for (int gs=0; gs<group_sets.size(); gs++)
+  MPI_Barrier(chi_mpi.comm);
+  if (options.adjoint)
   {
-    chi_log.Log(LOG_0)
-      << "\n********* Initializing Groupset " << gs << "\n" << std::endl;
+    CheckAdjointBoundaries();
+    if (phi_in_adjoint_frame) ApplyAdjointMomentParity();
+  }
 
-    group_sets[gs]->BuildDiscMomOperator(options.scattering_order);
-    group_sets[gs]->BuildMomDiscOperator(options.scattering_order);
-    group_sets[gs]->BuildSubsets();
+  if (not batch_sources.empty())
+  {
+    ExecuteBatch();
+    if (options.adjoint) ApplyAdjointMomentParity();
+    chi_log.Log(LOG_0) << "NPTransport solver execution completed\n";
+    return;
+  }
 
-    ComputeSweepOrderings(group_sets[gs]);
-    InitFluxDataStructures(group_sets[gs]);
+  if (options.cmfd_enabled and (options.max_outer_iterations <= 1))
+    chi_log.Log(LOG_0WARNING)
+      << "CMFD acceleration is applied to outer iterations only and "
+      << "requires MAX_OUTER_ITERATIONS > 1.";
 
-    InitWGDSA(group_sets[gs]);
-    InitTGDSA(group_sets[gs]);
+  if (EnergyTeamsActive() and (options.outer_scheme != OuterScheme::JACOBI))
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Energy decomposition over process teams requires "
+      << "OUTER_SCHEME OUTER_JACOBI.";
+    exit(EXIT_FAILURE);
+  }
 
-    SolveGroupset(gs);
+  if (((options.max_outer_iterations > 1) and
+       ((group_sets.size() > 1) or options.cmfd_enabled)) or
+      EnergyTeamsActive())
+    ExecuteOuterIterations();
+  else
+  {
+    for (int gs=0; gs<group_sets.size(); gs++)
+    {
+      InitGroupsetSolve(gs);
+      SolveGroupset(gs);
+      CleanUpGroupsetSolve(gs);
+    }
+  }
 
-    CleanUpWGDSA(group_sets[gs]);
-    CleanUpTGDSA(group_sets[gs]);
+  CompleteRestartWrites();
 
-    ResetSweepOrderings(group_sets[gs]);
+  if (options.adjoint) ApplyAdjointMomentParity();
 
-    MPI_Barrier(MPI_COMM_WORLD);
-  }
+  chi_log.Log(LOG_0) << "NPTransport solver execution completed\n";
+}
+
+//###################################################################
+/**Builds the operators, sweep orderings, flux data structures and
+ * DSA solvers of a groupset.*/
+void LinearBoltzman::Solver::InitGroupsetSolve(int group_set_num)
+{
+  LBSGroupset* groupset = group_sets[group_set_num];
 
+  chi_log.Log(LOG_0)
+    << "\n********* Initializing Groupset " << group_set_num
+    << "\n" << std::endl;
 
+  if (groupset->auto_tune and (not groupset->auto_tuned))
+    AutoTuneGroupset(group_set_num);
 
-  chi_log.Log(LOG_0) << "NPTransport solver execution completed\n";
+  groupset->BuildDiscMomOperator(options.scattering_order);
+  groupset->BuildMomDiscOperator(options.scattering_order);
+  groupset->BuildSubsets();
+
+  ComputeSweepOrderings(groupset);
+  InitFluxDataStructures(groupset);
+  BuildGroupsetXSBlocks(groupset);
+
+  InitWGDSA(groupset);
+  InitTGDSA(groupset);
+}
+
+//###################################################################
+/**Destroys the sweep orderings, flux data structures, Krylov objects
+ * and DSA solvers of a groupset.*/
+void LinearBoltzman::Solver::CleanUpGroupsetSolve(int group_set_num)
+{
+  LBSGroupset* groupset = group_sets[group_set_num];
+
+  DestroyKrylovSolver(groupset);
+  CleanUpWGDSA(groupset);
+  CleanUpTGDSA(groupset);
+
+  ResetSweepOrderings(groupset);
+
+  MPI_Barrier(chi_mpi.comm);
 }
 
 
@@ -59,8 +119,12 @@ void LinearBoltzman::Solver::SolveGroupset(int group_set_num)
   {
     GMRES(group_set_num);
   }
+  else if (group_set->iterative_method == NPT_ANDERSON)
+  {
+    Anderson(group_set_num);
+  }
 
-  if (options.write_restart_data)
+  if (options.write_restart_data and (not EnergyTeamsActive()))
     WriteRestartData(options.write_restart_folder_name,
                      options.write_restart_file_base);
 
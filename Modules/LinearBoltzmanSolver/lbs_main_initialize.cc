@@ -21,7 +21,7 @@ void LinearBoltzman::Solver::Initialize()
   PerformInputChecks();
   ComputeNumberOfMoments();
   PrintSimHeader();
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
   //================================================== Add unique material ids
   std::set<int> unique_material_ids;
@@ -46,7 +46,7 @@ void LinearBoltzman::Solver::Initialize()
   chi_log.Log(LOG_0) << "Computing cell matrices.\n";
   discretization->AddViewOfLocalContinuum(grid);
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
   chi_log.Log(LOG_0)
     << "Cell matrices computed.                   Process memory = "
     << std::setprecision(3)
@@ -58,7 +58,7 @@ void LinearBoltzman::Solver::Initialize()
 
   InitializeParrays();
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
   chi_log.Log(LOG_0)
     << "Done with parallel arrays.                Process memory = "
     << std::setprecision(3)
@@ -0,0 +1,224 @@
+#include "lbs_linear_boltzman_solver.h"
+
+#include <ChiConsole/chi_console.h>
+#include "ChiTimer/chi_timer.h"
+
+#include <chi_mpi.h>
+#include <chi_log.h>
+
+extern ChiMPI     chi_mpi;
+extern ChiLog     chi_log;
+extern ChiConsole chi_console;
+extern ChiTimer   chi_program_timer;
+
+//###################################################################
+/**Solves all groupsets with outer iterations over the groupsets.
+ *
+ * A single pass over the groupsets never converges upscattering (and
+ * fission) from later groupsets back into earlier ones. Here the
+ * groupsets are solved repeatedly until the point-wise change of the
+ * flux between two outer iterations drops below
+ * options.outer_tolerance. With the Gauss-Seidel scheme every groupset
+ * uses the latest flux of the groupsets solved before it, with the
+ * Jacobi scheme all groupsets use the flux of the previous outer.
+ *
+ * When CMFD acceleration is enabled every groupset solve is followed by
+ * a tallying sweep and every outer by a coarse-mesh solve that corrects
+ * the flux of all groups.
+ *
+ * The sweep orderings, flux data structures and DSA solvers of all the
+ * groupsets are kept alive across outers, i.e., memory is required for
+ * all groupsets simultaneously.
+ *
+ * With energy decomposition the groupsets are distributed round-robin
+ * over the process teams, each team only initializes and solves its own
+ * groupsets, and the Jacobi flux of every groupset is broadcast from its
+ * team at the end of each outer. Restart data is then also written at the
+ * end of each outer, when every team holds the moments of all groupsets.*/
+void LinearBoltzman::Solver::ExecuteOuterIterations()
+{
+  int num_groupsets = group_sets.size();
+
+  //================================================== Initialize groupsets
+  groupset_sweep_orderings.clear();
+  groupset_sweep_orderings.resize(num_groupsets);
+  std::vector<double> user_tolerances(num_groupsets,0.0);
+  for (int gs=0; gs<num_groupsets; gs++)
+  {
+    user_tolerances[gs] = group_sets[gs]->residual_tolerance;
+    if (not GroupsetOnThisTeam(gs)) continue;
+
+    InitGroupsetSolve(gs);
+    groupset_sweep_orderings[gs].swap(sweep_orderings);
+  }
+
+  if (EnergyTeamsActive())
+    chi_log.Log(LOG_0)
+      << "Groupsets are distributed over " << chi_mpi.num_teams
+      << " teams. Only the groupsets of team 0 are logged.";
+
+  chi_log.Log(LOG_0)
+    << "All groupsets initialized.                Process memory = "
+    << std::setprecision(3)
+    << chi_console.GetMemoryUsageInMB() << " MB";
+
+  if (options.cmfd_enabled)
+    InitCMFD();
+
+  bool jacobi = (options.outer_scheme == OuterScheme::JACOBI);
+
+  //================================================== Outer iterations
+  std::vector<double> phi_prev_outer;
+  std::vector<double> phi_jacobi;
+  double outer_change = 1.0;
+  bool converged = false;
+  for (int k=0; k<options.max_outer_iterations; k++)
+  {
+    phi_prev_outer = phi_old_local;
+    if (jacobi) phi_jacobi = phi_old_local;
+
+    for (int gs=0; gs<num_groupsets; gs++)
+    {
+      if (not GroupsetOnThisTeam(gs)) continue;
+
+      LBSGroupset* groupset = group_sets[gs];
+      groupset->residual_tolerance =
+        ComputeInnerTolerance(user_tolerances[gs],outer_change);
+
+      chi_log.Log(LOG_0)
+        << "Outer iteration " << k << ", groupset " << gs
+        << " inner tolerance " << groupset->residual_tolerance;
+
+      if (jacobi) phi_old_local = phi_prev_outer;
+
+      sweep_orderings.swap(groupset_sweep_orderings[gs]);
+      SolveGroupset(gs);
+      if ((cmfd != nullptr) and (not CMFDTalliesDuringIterations(groupset)))
+        CMFDTallySweep(gs);
+      sweep_orderings.swap(groupset_sweep_orderings[gs]);
+
+      if (jacobi)
+        DisAssembleVectorLocalToLocal(groupset,phi_old_local.data(),
+                                               phi_jacobi.data());
+
+      groupset->residual_tolerance = user_tolerances[gs];
+    }
+
+    if (jacobi)
+    {
+      if (EnergyTeamsActive())
+        for (int gs=0; gs<num_groupsets; gs++)
+          BroadcastGroupsetMoments(group_sets[gs],phi_jacobi,
+                                   gs % chi_mpi.num_teams);
+
+      phi_old_local = phi_jacobi;
+      phi_new_local = phi_jacobi;
+    }
+
+    if (cmfd != nullptr)
+      ApplyCMFD();
+
+    //Groupset solves only write restart data without energy teams
+    if (options.write_restart_data and EnergyTeamsActive())
+      WriteRestartData(options.write_restart_folder_name,
+                       options.write_restart_file_base);
+
+    outer_change = ComputeOuterChange(phi_prev_outer);
+    converged = (outer_change < options.outer_tolerance);
+
+    std::stringstream iter_info;
+    iter_info
+      << chi_program_timer.GetTimeString() << " "
+      << "Outer iteration " << std::setw(5) << k
+      << " Point-wise change " << std::setw(14) << outer_change;
+    if (converged)
+      iter_info << " CONVERGED\n";
+    chi_log.Log(LOG_0) << iter_info.str();
+
+    if (converged) break;
+  }
+
+  if (not converged)
+    chi_log.Log(LOG_0WARNING)
+      << "Outer iterations did not converge to "
+      << options.outer_tolerance << " in "
+      << options.max_outer_iterations << " iterations.";
+
+  //================================================== Clean up groupsets
+  CleanUpCMFD();
+  for (int gs=0; gs<num_groupsets; gs++)
+  {
+    if (not GroupsetOnThisTeam(gs)) continue;
+
+    sweep_orderings.swap(groupset_sweep_orderings[gs]);
+    CleanUpGroupsetSolve(gs);
+  }
+  groupset_sweep_orderings.clear();
+}
+
+//###################################################################
+/**Determines the inner (within-groupset) tolerance for an outer
+ * iteration. When adaptive, the tolerance is tied to the latest outer
+ * change so that early outers, whose sources are still inaccurate, are
+ * not over-solved. It is never tighter than the user tolerance.*/
+double LinearBoltzman::Solver::
+  ComputeInnerTolerance(double user_tolerance, double outer_change)
+{
+  if (not options.adaptive_inner_tolerance) return user_tolerance;
+
+  double adaptive_tolerance =
+    std::min(options.inner_tolerance_max,
+             options.inner_tolerance_factor*outer_change);
+
+  return std::max(user_tolerance,adaptive_tolerance);
+}
+
+//###################################################################
+/**Computes the point-wise change of all groups and moments of phi_old
+ * relative to the flux of the previous outer iteration.*/
+double LinearBoltzman::Solver::
+  ComputeOuterChange(const std::vector<double>& phi_prev_outer)
+{
+  double pw_change = 0.0;
+
+  int gi = groups.front()->id;
+  int num_grps = groups.size();
+
+  for (const auto& cell : grid->local_cells)
+  {
+    auto transport_view =
+      (LinearBoltzman::CellViewFull*)cell_transport_views[cell.local_id];
+
+    for (int i=0; i < cell.vertex_ids.size(); i++)
+    {
+      int map0 = transport_view->MapDOF(i,0,gi);
+      const double* phi_m0      = &phi_old_local[map0];
+      const double* phi_prev_m0 = &phi_prev_outer[map0];
+
+      for (int m=0; m<num_moments; m++)
+      {
+        int mapping = transport_view->MapDOF(i,m,gi);
+        const double* phi_m      = &phi_old_local[mapping];
+        const double* phi_prev_m = &phi_prev_outer[mapping];
+
+        for (int g=0; g<num_grps; g++)
+        {
+          double max_phi = std::max(std::fabs(phi_m0[g]),
+                                    std::fabs(phi_prev_m0[g]));
+          double delta_phi = std::fabs(phi_m[g] - phi_prev_m[g]);
+
+          if (max_phi >= std::numeric_limits<double>::min())
+            pw_change = std::max(delta_phi/max_phi,pw_change);
+          else
+            pw_change = std::max(delta_phi,pw_change);
+        }//for g
+      }//for m
+    }//for i
+  }//for c
+
+  double global_pw_change = 0.0;
+  MPI_Allreduce(&pw_change,&global_pw_change,1,MPI_DOUBLE,MPI_MAX,
+                chi_mpi.comm);
+
+  return global_pw_change;
+}
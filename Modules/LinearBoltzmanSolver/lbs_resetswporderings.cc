@@ -50,8 +50,9 @@ void LinearBoltzman::Solver::ResetSweepOrderings(LBSGroupset *groupset)
   }
   angle_agg->angle_set_groups.clear();
   delete angle_agg;
+  groupset->angle_agg = new AngleAgg;
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
 
   chi_log.Log(LOG_0)
     << "SPDS and FLUDS reset complete.            Process memory = "
@@ -63,10 +64,10 @@ void LinearBoltzman::Solver::ResetSweepOrderings(LBSGroupset *groupset)
                          ChiLog::EventOperation::MAX_VALUE);
   double total_app_memory=0.0;
   MPI_Allreduce(&local_app_memory,&total_app_memory,
-                1,MPI_DOUBLE,MPI_SUM,MPI_COMM_WORLD);
+                1,MPI_DOUBLE,MPI_SUM,chi_mpi.comm);
   double max_proc_memory=0.0;
   MPI_Allreduce(&local_app_memory,&max_proc_memory,
-                1,MPI_DOUBLE,MPI_MAX,MPI_COMM_WORLD);
+                1,MPI_DOUBLE,MPI_MAX,chi_mpi.comm);
 
   chi_log.Log(LOG_0)
     << "\n" << std::setprecision(3)
@@ -1,21 +1,85 @@
 #include "lbs_linear_boltzman_solver.h"
 
+#include <PiecewiseLinear/pwl.h>
+
 #include <sys/stat.h>
-#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
 
 #include <chi_log.h>
 #include <chi_mpi.h>
 extern ChiLog chi_log;
 extern ChiMPI chi_mpi;
 
+namespace
+{
+const char     CHI_RESTART_MAGIC[8] = {'C','H','I','R','S','T','\0','\0'};
+const uint64_t CHI_RESTART_VERSION  = 2;
+
+/**Maximum number of bytes in a single MPI-IO call. Counts are ints.*/
+const uint64_t MAX_IO_CHUNK_BYTES = uint64_t(1) << 30;
+
+/**Collectively writes a contiguous range of bytes at the given offset,
+ * splitting it into chunks that fit an int count. All locations make
+ * the same number of calls.*/
+bool WriteAtAllChunked(MPI_File fh, uint64_t offset,
+                       const char* data, uint64_t num_bytes)
+{
+  uint64_t num_chunks = (num_bytes + MAX_IO_CHUNK_BYTES - 1)/
+                        MAX_IO_CHUNK_BYTES;
+  uint64_t max_num_chunks = 0;
+  MPI_Allreduce(&num_chunks, &max_num_chunks, 1,
+                MPI_UNSIGNED_LONG_LONG, MPI_MAX, chi_mpi.comm);
+
+  bool success = true;
+  for (uint64_t c=0; c<max_num_chunks; ++c)
+  {
+    uint64_t begin = std::min(c*MAX_IO_CHUNK_BYTES, num_bytes);
+    uint64_t end   = std::min(begin + MAX_IO_CHUNK_BYTES, num_bytes);
+    int count      = static_cast<int>(end - begin);
+
+    int error = MPI_File_write_at_all(fh, offset + begin, data + begin,
+                                      count, MPI_BYTE, MPI_STATUS_IGNORE);
+    if (error != MPI_SUCCESS) success = false;
+  }
+  return success;
+}
+
+/**Independently reads a contiguous range of bytes at the given offset.*/
+bool ReadAtChunked(MPI_File fh, uint64_t offset,
+                   char* data, uint64_t num_bytes)
+{
+  for (uint64_t begin=0; begin<num_bytes; begin += MAX_IO_CHUNK_BYTES)
+  {
+    uint64_t end = std::min(begin + MAX_IO_CHUNK_BYTES, num_bytes);
+    int error = MPI_File_read_at(fh, offset + begin, data + begin,
+                                 static_cast<int>(end - begin), MPI_BYTE,
+                                 MPI_STATUS_IGNORE);
+    if (error != MPI_SUCCESS) return false;
+  }
+  return true;
+}
+}
+
 //###################################################################
-/**Writes phi_old to restart file.*/
+/**Writes phi_old to restart file.
+ *
+ * Only team 0 writes since all teams hold the same flux. With energy
+ * decomposition this only holds after the groupset moments have been
+ * broadcast at the end of an outer iteration, hence the groupset solves
+ * do not write restart data and ExecuteOuterIterations writes it once per
+ * outer instead.*/
 void LinearBoltzman::Solver::WriteRestartData(std::string folder_name,
                                               std::string file_base)
 {
   typedef struct stat Stat;
   Stat st;
 
+  //======================================== Teams hold identical data
+  if (chi_mpi.team_id != 0) return;
+
   //======================================== Make sure folder exists
   if (chi_mpi.location_id == 0)
   {
@@ -25,145 +89,299 @@ void LinearBoltzman::Solver::WriteRestartData(std::string folder_name,
       {
         chi_log.Log(LOG_0WARNING)
           << "Failed to create restart directory: " << folder_name;
-        return;
       }
   }
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(chi_mpi.comm);
+
+  std::string file_name = folder_name + std::string("/") +
+                          file_base + std::string(".r");
+
+  //======================================== Hand off to background writer
+  if (options.write_restart_async)
+  {
+    if (async_restart_writer == nullptr)
+      async_restart_writer = new AsyncRestartWriter;
+
+    async_restart_writer->AcquireStagingBuffers();
+    BuildRestartLayout(async_restart_writer->staging_layout, file_name);
+    async_restart_writer->staging_phi.assign(phi_old_local.begin(),
+                                             phi_old_local.end());
+    async_restart_writer->Launch();
+    return;
+  }
+
+  RestartLayout layout;
+  BuildRestartLayout(layout, file_name);
+  const auto& header = layout.header;
+  uint64_t num_local_values = phi_old_local.size();
 
-  //======================================== Create files
+  //======================================== Write file
   //This step might fail for specific locations and
   //can create quite a messy output if we print it all.
   //We also need to consolidate the error to determine if
   //the process as whole succeeded.
   bool location_succeeded = true;
-  char location_cstr[20];
-  sprintf(location_cstr,"%d.r",chi_mpi.location_id);
 
-  std::string file_name = folder_name + std::string("/") +
-                          file_base + std::string(location_cstr);
-
-  std::ofstream ofile;
-  ofile.open(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
-
-  if (not ofile.is_open())
-  {
-    chi_log.Log(LOG_ALLERROR)
-      << "Failed to create restart file: " << file_name;
-    ofile.close();
+  MPI_File fh;
+  int error = MPI_File_open(chi_mpi.comm, file_name.c_str(),
+                            MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                            MPI_INFO_NULL, &fh);
+  if (error != MPI_SUCCESS)
     location_succeeded = false;
-  }
   else
   {
-    size_t phi_old_size = phi_old_local.size();
-    ofile.write((char*)&phi_old_size, sizeof(size_t));
-    for (auto val : phi_old_local)
-      ofile.write((char*)&val, sizeof(double));
+    MPI_File_set_size(fh, 0);
 
-    ofile.close();
+    uint64_t header_size = (chi_mpi.location_id == 0)?
+                           sizeof(RestartHeader) : 0;
+    location_succeeded &= WriteAtAllChunked(
+      fh, 0, (const char*)&header, header_size);
+
+    location_succeeded &= WriteAtAllChunked(
+      fh, header.table_offset + layout.cell_prefix*sizeof(RestartCellEntry),
+      (const char*)layout.cell_table.data(),
+      layout.cell_table.size()*sizeof(RestartCellEntry));
+
+    location_succeeded &= WriteAtAllChunked(
+      fh, header.data_offset + layout.value_prefix*sizeof(double),
+      (const char*)phi_old_local.data(),
+      num_local_values*sizeof(double));
+
+    MPI_File_close(&fh);
   }
 
-  //======================================== Wait for all processes
-  //                                         then check success status
-  MPI_Barrier(MPI_COMM_WORLD);
+  //======================================== Check success status
   bool global_succeeded = true;
   MPI_Allreduce(&location_succeeded,   //Send buffer
                 &global_succeeded,     //Recv buffer
                 1,                     //count
                 MPI_CXX_BOOL,          //Data type
                 MPI_LAND,              //Operation - Logical and
-                MPI_COMM_WORLD);       //Communicator
+                chi_mpi.comm);       //Communicator
 
   //======================================== Write status message
   if (global_succeeded)
     chi_log.Log(LOG_0)
-      << "Successfully wrote restart data: "
-      << folder_name + std::string("/") +
-         file_base + std::string("X.r");
+      << "Successfully wrote restart data: " << file_name;
   else
     chi_log.Log(LOG_0ERROR)
-      << "Failed to write restart data: "
-      << folder_name + std::string("/") +
-         file_base + std::string("X.r");
+      << "Failed to write restart data: " << file_name;
 }
 
 //###################################################################
-/**Read phi_old from restart file.*/
+/**Computes the header, the file offsets and the cell table of this
+ * location's part of a restart file. This call is collective.*/
+void LinearBoltzman::Solver::BuildRestartLayout(RestartLayout& layout,
+                                                const std::string& file_name)
+{
+  auto pwl_discretization = (SpatialDiscretization_PWL*)discretization;
+  uint64_t block_size_per_dof = groups.size()*num_moments;
+
+  uint64_t num_local_cells  = grid->local_cells.size();
+  uint64_t num_local_values = phi_old_local.size();
+
+  uint64_t cell_prefix  = 0;
+  uint64_t value_prefix = 0;
+  uint64_t num_global_cells = 0;
+  MPI_Exscan(&num_local_cells, &cell_prefix, 1,
+             MPI_UNSIGNED_LONG_LONG, MPI_SUM, chi_mpi.comm);
+  MPI_Exscan(&num_local_values, &value_prefix, 1,
+             MPI_UNSIGNED_LONG_LONG, MPI_SUM, chi_mpi.comm);
+  MPI_Allreduce(&num_local_cells, &num_global_cells, 1,
+                MPI_UNSIGNED_LONG_LONG, MPI_SUM, chi_mpi.comm);
+  if (chi_mpi.location_id == 0) {cell_prefix = 0; value_prefix = 0;}
+
+  layout.file_name    = file_name;
+  layout.cell_prefix  = cell_prefix;
+  layout.value_prefix = value_prefix;
+
+  //======================================== Build local cell table
+  auto& cell_table = layout.cell_table;
+  cell_table.clear();
+  cell_table.reserve(num_local_cells);
+  uint64_t local_offset = 0;
+  for (auto& cell : grid->local_cells)
+  {
+    auto cell_fe_view = pwl_discretization->MapFeViewL(cell.local_id);
+    uint64_t num_values = cell_fe_view->dofs*block_size_per_dof;
+
+    RestartCellEntry entry;
+    entry.global_id   = cell.global_id;
+    entry.data_offset = value_prefix + local_offset;
+    entry.num_values  = num_values;
+    cell_table.push_back(entry);
+
+    local_offset += num_values;
+  }
+
+  //======================================== Build header
+  auto& header = layout.header;
+  std::memset(&header, 0, sizeof(RestartHeader));
+  std::memcpy(header.magic, CHI_RESTART_MAGIC, 8);
+  header.version      = CHI_RESTART_VERSION;
+  header.num_cells    = num_global_cells;
+  header.num_groups   = groups.size();
+  header.num_moments  = num_moments;
+  header.table_offset = sizeof(RestartHeader);
+  header.data_offset  = header.table_offset +
+                        num_global_cells*sizeof(RestartCellEntry);
+}
+
+//###################################################################
+/**Waits for any background restart write to finish and reports the
+ * time the solver spent blocked on background writes.*/
+void LinearBoltzman::Solver::CompleteRestartWrites()
+{
+  if (async_restart_writer == nullptr) return;
+
+  async_restart_writer->Complete();
+
+  chi_log.Log(LOG_0)
+    << "Total time blocked on background restart writes: "
+    << async_restart_writer->GetTotalBlockedTime() << " s";
+}
+
+//###################################################################
+/**Read phi_old from restart file. The file may have been written with
+ * a different number of processes or partitioning, cells are located
+ * by their global id.*/
 void LinearBoltzman::Solver::ReadRestartData(std::string folder_name,
                                               std::string file_base)
 {
-  MPI_Barrier(MPI_COMM_WORLD);
+  std::string file_name = folder_name + std::string("/") +
+                          file_base + std::string(".r");
+
+  //======================================== Map local cells
+  auto pwl_discretization = (SpatialDiscretization_PWL*)discretization;
+  uint64_t block_size_per_dof = groups.size()*num_moments;
+
+  std::unordered_map<uint64_t,int> global_to_local;
+  std::vector<uint64_t> local_block_start;
+  std::vector<uint64_t> local_block_size;
+  {
+    uint64_t offset = 0;
+    for (auto& cell : grid->local_cells)
+    {
+      auto cell_fe_view = pwl_discretization->MapFeViewL(cell.local_id);
+      uint64_t num_values = cell_fe_view->dofs*block_size_per_dof;
+
+      global_to_local[cell.global_id] = cell.local_id;
+      local_block_start.push_back(offset);
+      local_block_size.push_back(num_values);
+      offset += num_values;
+    }
+  }
 
-  //======================================== Open files
+  //======================================== Open file
   //This step might fail for specific locations and
   //can create quite a messy output if we print it all.
   //We also need to consolidate the error to determine if
   //the process as whole succeeded.
   bool location_succeeded = true;
-  char location_cstr[20];
-  sprintf(location_cstr,"%d.r",chi_mpi.location_id);
 
-  std::string file_name = folder_name + std::string("/") +
-                          file_base + std::string(location_cstr);
-
-  std::ifstream ifile;
-  ifile.open(file_name, std::ios::in | std::ios::binary );
-
-  if (not ifile.is_open())
-  {
-    ifile.close();
+  MPI_File fh;
+  int error = MPI_File_open(chi_mpi.comm, file_name.c_str(),
+                            MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
+  if (error != MPI_SUCCESS)
     location_succeeded = false;
-  }
   else
   {
-    size_t number_of_unknowns;
-    ifile.read((char*)&number_of_unknowns, sizeof(size_t));
+    //================================= Read and check header
+    RestartHeader header;
+    std::memset(&header, 0, sizeof(RestartHeader));
+    MPI_File_read_at_all(fh, 0, &header, sizeof(RestartHeader),
+                         MPI_BYTE, MPI_STATUS_IGNORE);
 
-    if (number_of_unknowns != phi_old_local.size())
-    {
+    if ((std::memcmp(header.magic, CHI_RESTART_MAGIC, 8) != 0) or
+        (header.version != CHI_RESTART_VERSION) or
+        (header.num_groups != groups.size()) or
+        (header.num_moments != static_cast<uint64_t>(num_moments)))
       location_succeeded = false;
-      ifile.close();
-    }
-    else
+
+    //================================= Scan cell table for local cells
+    //The table is streamed in chunks so that no location needs to
+    //hold the full table.
+    std::vector<RestartCellEntry> local_entries(
+      local_block_size.size(), RestartCellEntry{0,0,0});
+    size_t num_found = 0;
+
+    const uint64_t table_chunk = 1 << 20;
+    std::vector<RestartCellEntry> table_buffer;
+    uint64_t num_table_cells = location_succeeded? header.num_cells : 0;
+    for (uint64_t t=0; t<num_table_cells; t+=table_chunk)
     {
-      std::vector<double> temp_phi_old(phi_old_local.size(),0.0);
+      uint64_t count = std::min(table_chunk, num_table_cells - t);
+      table_buffer.resize(count);
+      MPI_File_read_at(fh, header.table_offset + t*sizeof(RestartCellEntry),
+                       table_buffer.data(),
+                       static_cast<int>(count*sizeof(RestartCellEntry)),
+                       MPI_BYTE, MPI_STATUS_IGNORE);
 
-      size_t v=0;
-      while (not ifile.eof())
+      for (auto& entry : table_buffer)
       {
-        ifile.read((char*)&temp_phi_old[v], sizeof(double));
-        ++v;
+        auto local = global_to_local.find(entry.global_id);
+        if (local == global_to_local.end()) continue;
+        local_entries[local->second] = entry;
+        ++num_found;
       }
+    }
 
-      if (v != (number_of_unknowns+1))
+    if (num_found != local_block_size.size())
+      location_succeeded = false;
+
+    //================================= Read blocks
+    //Blocks that are contiguous in both the file and memory are
+    //coalesced into single reads. With an unchanged partitioning this
+    //results in one read per location.
+    std::vector<double> temp_phi_old(phi_old_local.size(),0.0);
+    size_t num_local_cells = local_entries.size();
+    size_t c=0;
+    while (location_succeeded and (c < num_local_cells))
+    {
+      if (local_entries[c].num_values != local_block_size[c])
+      { location_succeeded = false; break; }
+
+      uint64_t file_start = local_entries[c].data_offset;
+      uint64_t mem_start  = local_block_start[c];
+      uint64_t length     = local_block_size[c];
+
+      size_t cn = c+1;
+      while ((cn < num_local_cells) and
+             (local_entries[cn].num_values == local_block_size[cn]) and
+             (local_entries[cn].data_offset == file_start + length) and
+             (local_block_start[cn] == mem_start + length))
       {
-        location_succeeded = false;
-        ifile.close();
+        length += local_block_size[cn];
+        ++cn;
       }
-      else
-        phi_old_local = std::move(temp_phi_old);
 
-      ifile.close();
+      location_succeeded &= ReadAtChunked(
+        fh, header.data_offset + file_start*sizeof(double),
+        (char*)&temp_phi_old[mem_start], length*sizeof(double));
+
+      c = cn;
     }
+
+    if (location_succeeded)
+      phi_old_local = std::move(temp_phi_old);
+
+    MPI_File_close(&fh);
   }
 
-  //======================================== Wait for all processes
-  //                                         then check success status
-  MPI_Barrier(MPI_COMM_WORLD);
+  //======================================== Check success status
   bool global_succeeded = true;
   MPI_Allreduce(&location_succeeded,   //Send buffer
                 &global_succeeded,     //Recv buffer
                 1,                     //count
                 MPI_CXX_BOOL,          //Data type
                 MPI_LAND,              //Operation - Logical and
-                MPI_COMM_WORLD);       //Communicator
+                chi_mpi.comm);       //Communicator
 
   //======================================== Write status message
   if (global_succeeded)
     chi_log.Log(LOG_0) << "Successfully read restart data";
   else
     chi_log.Log(LOG_0ERROR)
-      << "Failed to read restart data: "
-      << folder_name + std::string("/") +
-         file_base + std::string("X.r");
-}
\ No newline at end of file
+      << "Failed to read restart data: " << file_name;
+}
@@ -0,0 +1,86 @@
+#ifndef _lbs_restartdata_h
+#define _lbs_restartdata_h
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <thread>
+
+namespace LinearBoltzman
+{
+
+//###################################################################
+// Restart files are single shared files. The layout is independent of
+// the number of processes and partitioning:
+//  - header     RestartHeader
+//  - cell table RestartCellEntry[num_cells], one per global cell
+//  - data       double[], the phi block of each cell
+// Each location writes its table entries and its phi blocks as
+// contiguous ranges, with offsets obtained from prefix sums, so that
+// readers locate cells by global id.
+struct RestartHeader
+{
+  char     magic[8];
+  uint64_t version;
+  uint64_t num_cells;
+  uint64_t num_groups;
+  uint64_t num_moments;
+  uint64_t table_offset;
+  uint64_t data_offset;
+  uint64_t reserved;
+};
+
+struct RestartCellEntry
+{
+  uint64_t global_id;
+  uint64_t data_offset;  ///< In number of doubles from the data section
+  uint64_t num_values;
+};
+
+/**Everything a location needs to write its part of a restart file.*/
+struct RestartLayout
+{
+  std::string                   file_name;
+  RestartHeader                 header;
+  uint64_t                      cell_prefix  = 0;
+  uint64_t                      value_prefix = 0;
+  std::vector<RestartCellEntry> cell_table;
+};
+
+//###################################################################
+/**Writes restart files on a background thread. The solver copies phi
+ * into a staging buffer and continues iterating while the thread
+ * writes the file with positioned POSIX writes. The file is written
+ * under a temporary name and renamed once all locations completed, so
+ * a crash during a write never corrupts the previous restart file.
+ * The solver only blocks when a new write is requested before the
+ * previous one finished.*/
+class AsyncRestartWriter
+{
+private:
+  std::thread         writer_thread;
+  bool                write_pending = false;
+  bool                location_succeeded = true;
+
+  double              total_blocked_time = 0.0; //seconds
+  size_t              num_writes = 0;
+
+public:
+  RestartLayout       staging_layout;
+  std::vector<double> staging_phi;
+
+  ~AsyncRestartWriter();
+
+  void AcquireStagingBuffers();
+  void Launch();
+  void Complete();
+
+  double GetTotalBlockedTime() const {return total_blocked_time;}
+
+private:
+  void WriteLocationData();
+};
+
+}
+
+#endif
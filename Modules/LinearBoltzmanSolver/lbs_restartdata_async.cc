@@ -0,0 +1,152 @@
+#include "lbs_restartdata.h"
+
+#include <chi_log.h>
+#include <chi_mpi.h>
+extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
+
+#include <chrono>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+/**Name under which a restart file is written before it is complete.*/
+std::string TemporaryName(const std::string& file_name)
+{
+  return file_name + std::string(".tmp");
+}
+
+/**Writes all bytes at the given file offset, retrying partial writes.*/
+bool PWriteAll(int fd, const char* data, uint64_t num_bytes, uint64_t offset)
+{
+  while (num_bytes > 0)
+  {
+    ssize_t written = pwrite(fd, data, num_bytes, offset);
+    if (written <= 0) return false;
+    data      += written;
+    offset    += written;
+    num_bytes -= written;
+  }
+  return true;
+}
+}
+
+//###################################################################
+/**Destructor. Joins a write still in progress.*/
+LinearBoltzman::AsyncRestartWriter::~AsyncRestartWriter()
+{
+  if (writer_thread.joinable())
+    writer_thread.join();
+}
+
+//###################################################################
+/**Makes the staging buffers available for a new snapshot, completing
+ * the previous write first if there is one. This call is collective.*/
+void LinearBoltzman::AsyncRestartWriter::AcquireStagingBuffers()
+{
+  if (write_pending) Complete();
+}
+
+//###################################################################
+/**Starts writing the staged snapshot on the background thread. The home
+ * location first creates the file and writes the header so that all
+ * locations can write their ranges independently. This call is
+ * collective.*/
+void LinearBoltzman::AsyncRestartWriter::Launch()
+{
+  location_succeeded = true;
+  std::string tmp_name = TemporaryName(staging_layout.file_name);
+
+  if (chi_mpi.location_id == 0)
+  {
+    int fd = open(tmp_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+      location_succeeded = false;
+    else
+    {
+      location_succeeded = PWriteAll(fd,
+        (const char*)&staging_layout.header, sizeof(RestartHeader), 0);
+      close(fd);
+    }
+  }
+
+  MPI_Barrier(chi_mpi.comm);
+
+  write_pending = true;
+  writer_thread = std::thread(&AsyncRestartWriter::WriteLocationData, this);
+}
+
+//###################################################################
+/**Body of the background thread. Writes this location's cell table
+ * entries and phi blocks. No MPI calls are made from this thread.*/
+void LinearBoltzman::AsyncRestartWriter::WriteLocationData()
+{
+  if (not location_succeeded) return;
+
+  const auto& layout = staging_layout;
+  const auto& header = layout.header;
+
+  int fd = open(TemporaryName(layout.file_name).c_str(), O_WRONLY);
+  if (fd < 0) {location_succeeded = false; return;}
+
+  bool success = PWriteAll(
+    fd, (const char*)layout.cell_table.data(),
+    layout.cell_table.size()*sizeof(RestartCellEntry),
+    header.table_offset + layout.cell_prefix*sizeof(RestartCellEntry));
+
+  success = success and PWriteAll(
+    fd, (const char*)staging_phi.data(),
+    staging_phi.size()*sizeof(double),
+    header.data_offset + layout.value_prefix*sizeof(double));
+
+  success = success and (fsync(fd) == 0);
+  close(fd);
+
+  location_succeeded = success;
+}
+
+//###################################################################
+/**Waits for the pending write, if any, to finish on all locations and
+ * then moves the file into place. The time spent waiting is
+ * accumulated as blocked time. This call is collective.*/
+void LinearBoltzman::AsyncRestartWriter::Complete()
+{
+  if (not write_pending) return;
+
+  auto t_start = std::chrono::steady_clock::now();
+  writer_thread.join();
+  auto t_end = std::chrono::steady_clock::now();
+
+  double blocked_time =
+    std::chrono::duration<double>(t_end - t_start).count();
+  total_blocked_time += blocked_time;
+  write_pending = false;
+  ++num_writes;
+
+  bool global_succeeded = true;
+  MPI_Allreduce(&location_succeeded,   //Send buffer
+                &global_succeeded,     //Recv buffer
+                1,                     //count
+                MPI_CXX_BOOL,          //Data type
+                MPI_LAND,              //Operation - Logical and
+                chi_mpi.comm);       //Communicator
+
+  const auto& file_name = staging_layout.file_name;
+  if (global_succeeded and (chi_mpi.location_id == 0))
+    global_succeeded = (std::rename(TemporaryName(file_name).c_str(),
+                                    file_name.c_str()) == 0);
+
+  MPI_Bcast(&global_succeeded, 1, MPI_CXX_BOOL, 0, chi_mpi.comm);
+
+  //======================================== Write status message
+  if (global_succeeded)
+    chi_log.Log(LOG_0)
+      << "Successfully wrote restart data in background: " << file_name
+      << ". Solver blocked " << blocked_time << " s waiting for it.";
+  else
+    chi_log.Log(LOG_0ERROR)
+      << "Failed to write restart data in background: " << file_name;
+}
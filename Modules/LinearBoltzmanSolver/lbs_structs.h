@@ -4,10 +4,24 @@
 #define PARTITION_METHOD_SERIAL        1
 #define PARTITION_METHOD_FROM_SURFACE  2
 
+#include <vector>
+
 namespace LinearBoltzman
 {
 
+/**Ordering of groupset solves within an outer iteration.*/
+enum class OuterScheme
+{
+  GAUSS_SEIDEL = 1, ///< Groupsets use the latest flux of earlier groupsets
+  JACOBI       = 2  ///< Groupsets only use the previous outer flux
+};
 
+/**How the work is split over the process teams (-teams n).*/
+enum class TeamDecomposition
+{
+  ANGLE  = 1, ///< Teams sweep different angle sets of every groupset
+  ENERGY = 2  ///< Teams solve different groupsets concurrently
+};
 
 /**Struct for storing NPT options.*/
 struct Options
@@ -24,6 +38,23 @@ struct Options
   std::string write_restart_folder_name;
   std::string write_restart_file_base;
   double write_restart_interval;
+  bool write_restart_async;
+
+  int         max_outer_iterations;
+  double      outer_tolerance;
+  OuterScheme outer_scheme;
+  bool        adaptive_inner_tolerance;
+  double      inner_tolerance_factor;
+  double      inner_tolerance_max;
+
+  TeamDecomposition team_decomposition;
+
+  bool adjoint;
+
+  bool             cmfd_enabled;
+  std::vector<int> cmfd_divisions;
+  int              cmfd_max_iterations;
+  double           cmfd_tolerance;
 
   Options()
   {
@@ -39,6 +70,23 @@ struct Options
     write_restart_folder_name = std::string("YRestart");
     write_restart_file_base   = std::string("restart");
     write_restart_interval = 30.0;
+    write_restart_async = false;
+
+    max_outer_iterations = 1;
+    outer_tolerance = 1.0e-6;
+    outer_scheme = OuterScheme::GAUSS_SEIDEL;
+    adaptive_inner_tolerance = true;
+    inner_tolerance_factor = 0.1;
+    inner_tolerance_max = 1.0e-2;
+
+    team_decomposition = TeamDecomposition::ANGLE;
+
+    adjoint = false;
+
+    cmfd_enabled = false;
+    cmfd_divisions = {0,0,0};
+    cmfd_max_iterations = 1000;
+    cmfd_tolerance = 1.0e-10;
   }
 };
 
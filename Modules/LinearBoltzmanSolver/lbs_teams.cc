@@ -0,0 +1,162 @@
+#include "lbs_linear_boltzman_solver.h"
+
+#include <ChiMesh/SweepUtilities/FLUDS/FLUDS.h>
+
+#include <chi_log.h>
+#include <chi_mpi.h>
+
+extern ChiLog chi_log;
+extern ChiMPI chi_mpi;
+
+typedef chi_mesh::sweep_management::AngleSet TAngleSet;
+
+//###################################################################
+/**Whether groupsets are distributed over the process teams.*/
+bool LinearBoltzman::Solver::EnergyTeamsActive()
+{
+  return (chi_mpi.num_teams > 1) and
+         (options.team_decomposition == TeamDecomposition::ENERGY);
+}
+
+//###################################################################
+/**Whether a groupset is solved by this process's team. Always true
+ * unless groupsets are distributed over the teams, round-robin.*/
+bool LinearBoltzman::Solver::GroupsetOnThisTeam(int group_set_num)
+{
+  if (not EnergyTeamsActive()) return true;
+
+  return (group_set_num % chi_mpi.num_teams) == chi_mpi.team_id;
+}
+
+//###################################################################
+/**Copies the groupset's groups of a flux moment vector into a contiguous
+ * buffer, or back when to_phi is true.*/
+void LinearBoltzman::Solver::
+  CopyGroupsetMoments(LBSGroupset *groupset, std::vector<double>& phi,
+                      std::vector<double>& buffer, bool to_phi)
+{
+  int gsi = groupset->groups.front()->id;
+  int gss = groupset->groups.size();
+
+  buffer.resize((size_t)local_dof_count*num_moments*gss,0.0);
+
+  size_t index = 0;
+  for (const auto& cell : grid->local_cells)
+  {
+    auto transport_view =
+      (LinearBoltzman::CellViewFull*)cell_transport_views[cell.local_id];
+    for (int i=0; i < cell.vertex_ids.size(); i++)
+      for (int m=0; m<num_moments; m++)
+      {
+        double* phi_mapped = &phi[transport_view->MapDOF(i,m,gsi)];
+        for (int g=0; g<gss; g++, index++)
+        {
+          if (to_phi) phi_mapped[g] = buffer[index];
+          else        buffer[index] = phi_mapped[g];
+        }
+      }
+  }
+}
+
+//###################################################################
+/**Keeps only the angle sets of a groupset that belong to this process's
+ * team and deletes the others.
+ *
+ * Angle sets sharing a sweep ordering (SPDS) also share a primary FLUDS
+ * and are therefore always assigned together, round-robin over the
+ * teams. Every angle set group is filtered the same way so that all
+ * groups keep the same number of angle sets, which the schedulers rely on
+ * for unique angle set numbers. Since every team holds the same spatial
+ * partition all locations of a team keep the same angle sets.*/
+void LinearBoltzman::Solver::DistributeAngleSetsToTeams(LBSGroupset *groupset)
+{
+  if ((chi_mpi.num_teams <= 1) or
+      (options.team_decomposition != TeamDecomposition::ANGLE)) return;
+
+  //=========================================== Check supported features
+  for (auto bndry : sweep_boundaries)
+    if (bndry->IsReflecting())
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Angular teams do not support reflecting boundaries.";
+      exit(EXIT_FAILURE);
+    }
+
+  //=========================================== Filter angle set groups
+  size_t num_kept = 0;
+  size_t num_total = 0;
+  for (auto angset_grp : groupset->angle_agg->angle_set_groups)
+  {
+    std::vector<TAngleSet*> kept_angle_sets;
+    std::vector<TAngleSet*> other_angle_sets;
+
+    int block = -1;
+    chi_mesh::sweep_management::SPDS* last_spds = nullptr;
+    for (auto angset : angset_grp->angle_sets)
+    {
+      if (angset->GetSPDS() != last_spds)
+      {
+        last_spds = angset->GetSPDS();
+        ++block;
+      }
+
+      if ((block % chi_mpi.num_teams) == chi_mpi.team_id)
+        kept_angle_sets.push_back(angset);
+      else
+        other_angle_sets.push_back(angset);
+    }
+
+    //Aux FLUDS reference their primary, delete after all references
+    for (auto angset : other_angle_sets)
+      delete angset->fluds;
+    for (auto angset : other_angle_sets)
+      delete angset;
+
+    num_kept  += kept_angle_sets.size();
+    num_total += angset_grp->angle_sets.size();
+    angset_grp->angle_sets = kept_angle_sets;
+  }
+
+  chi_log.Log(LOG_0)
+    << "Angular team " << chi_mpi.team_id << " of "
+    << chi_mpi.num_teams << " sweeps " << num_kept << " of "
+    << num_total << " angle sets.";
+}
+
+//###################################################################
+/**Sums the groupset flux moments of a sweep over the angular teams.
+ *
+ * Every team sweeps only its own angle sets, hence after a sweep
+ * phi_new_local holds a partial quadrature sum for the groupset. Only the
+ * groupset's groups are reduced since the remaining groups of
+ * phi_new_local are already identical on all teams.*/
+void LinearBoltzman::Solver::ReduceAngularMoments(LBSGroupset *groupset)
+{
+  if ((chi_mpi.num_teams <= 1) or
+      (options.team_decomposition != TeamDecomposition::ANGLE)) return;
+
+  std::vector<double> local_moments;
+  CopyGroupsetMoments(groupset,phi_new_local,local_moments,false);
+
+  std::vector<double> moments(local_moments.size(),0.0);
+  MPI_Allreduce(local_moments.data(),moments.data(),moments.size(),
+                MPI_DOUBLE,MPI_SUM,chi_mpi.across_teams_comm);
+
+  CopyGroupsetMoments(groupset,phi_new_local,moments,true);
+}
+
+//###################################################################
+/**Broadcasts the groupset's groups of a flux moment vector from the
+ * team that solved the groupset to all other teams.*/
+void LinearBoltzman::Solver::
+  BroadcastGroupsetMoments(LBSGroupset *groupset,
+                           std::vector<double>& phi, int root_team)
+{
+  std::vector<double> moments;
+  CopyGroupsetMoments(groupset,phi,moments,false);
+
+  MPI_Bcast(moments.data(),moments.size(),MPI_DOUBLE,
+            root_team,chi_mpi.across_teams_comm);
+
+  CopyGroupsetMoments(groupset,phi,moments,true);
+}
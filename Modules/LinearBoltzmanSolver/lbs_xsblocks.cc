@@ -0,0 +1,76 @@
+#include "lbs_linear_boltzman_solver.h"
+
+#include <chi_log.h>
+
+extern ChiLog chi_log;
+
+//###################################################################
+/**Slices the transfer matrices and fission data of every material for
+ * the groups of a groupset.*/
+void LinearBoltzman::Solver::BuildGroupsetXSBlocks(LBSGroupset *groupset)
+{
+  int gs_i = groupset->groups.front()->id;
+  int gs_f = groupset->groups.back()->id;
+  int gss  = groupset->groups.size();
+
+  groupset->xs_blocks.clear();
+  groupset->xs_blocks.resize(material_xs.size());
+
+  for (size_t x=0; x<material_xs.size(); x++)
+  {
+    chi_physics::TransportCrossSections* xs = material_xs[x];
+    auto& block = groupset->xs_blocks[x];
+
+    //=========================================== Transfer matrices
+    int num_ell = xs->transfer_matrix.size();
+    block.within.resize(num_ell);
+    block.across.resize(num_ell);
+    for (int ell=0; ell<num_ell; ell++)
+    {
+      const auto& transfer = xs->transfer_matrix[ell];
+      auto& within = block.within[ell];
+      auto& across = block.across[ell];
+
+      within.row_start.assign(1,0);
+      across.row_start.assign(1,0);
+      for (int g=gs_i; g<=gs_f; g++)
+      {
+        if (g < transfer.rowI_indices.size())
+        {
+          int num_transfers = transfer.rowI_indices[g].size();
+          for (int t=0; t<num_transfers; t++)
+          {
+            int    gprime   = transfer.rowI_indices[g][t];
+            double sigma_sm = transfer.rowI_values[g][t];
+            auto& target = ((gprime >= gs_i) && (gprime <= gs_f))?
+                           within : across;
+            target.col.push_back(gprime);
+            target.val.push_back(sigma_sm);
+          }
+        }
+        within.row_start.push_back(within.col.size());
+        across.row_start.push_back(across.col.size());
+      }
+    }
+
+    //=========================================== Fission
+    block.fissile = false;
+    block.chi.assign(gss,0.0);
+    if ((xs->chi_g.size() >= groups.size()) and
+        (xs->nu_sigma_fg.size() >= groups.size()))
+    {
+      bool emits = false;
+      for (int g=gs_i; g<=gs_f; g++)
+      {
+        block.chi[g-gs_i] = xs->chi_g[g];
+        if (xs->chi_g[g] != 0.0) emits = true;
+      }
+
+      bool absorbs = false;
+      for (const auto& group : groups)
+        if (xs->nu_sigma_fg[group->id] != 0.0) absorbs = true;
+
+      block.fissile = emits and absorbs;
+    }
+  }
+}
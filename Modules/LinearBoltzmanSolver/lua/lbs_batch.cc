@@ -0,0 +1,202 @@
+#include "ChiLua/chi_lua.h"
+
+#include "../lbs_linear_boltzman_solver.h"
+#include "ChiPhysics/chi_physics.h"
+#include <chi_log.h>
+
+extern ChiPhysics chi_physics_handler;
+extern ChiLog     chi_log;
+
+namespace
+{
+//###################################################################
+/**Obtains the LBS solver from a handle.*/
+LinearBoltzman::Solver* GetLBSSolver(int solver_index, const char* func_name)
+{
+  chi_physics::Solver* psolver;
+  try{
+    psolver = chi_physics_handler.solver_stack.at(solver_index);
+  }
+  catch(const std::out_of_range& o)
+  {
+    fprintf(stderr,"ERROR: Invalid handle to solver in %s\n",func_name);
+    exit(EXIT_FAILURE);
+  }
+
+  if (typeid(*psolver) != typeid(LinearBoltzman::Solver))
+  {
+    fprintf(stderr,"ERROR: Incorrect solver-type in %s\n",func_name);
+    exit(EXIT_FAILURE);
+  }
+
+  return (LinearBoltzman::Solver*)(psolver);
+}
+
+//###################################################################
+/**Reads a table of group-wise sources indexed by material id.*/
+std::map<int,std::vector<double>>
+  GetMaterialSources(lua_State *L, int arg, size_t num_groups,
+                     const char* func_name)
+{
+  if (not lua_istable(L,arg))
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "In call to " << func_name << ", argument " << arg
+      << " must be a table indexed by material id.";
+    exit(EXIT_FAILURE);
+  }
+
+  std::map<int,std::vector<double>> sources;
+
+  lua_pushnil(L);
+  while (lua_next(L,arg) != 0)
+  {
+    int mat_id = lua_tonumber(L,-2);
+
+    if ((not lua_istable(L,-1)) or (lua_rawlen(L,-1) != num_groups))
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "In call to " << func_name << ", the source of material "
+        << mat_id << " must be a table with " << num_groups
+        << " group values. Groups must be created first.";
+      exit(EXIT_FAILURE);
+    }
+
+    std::vector<double> values(num_groups,0.0);
+    for (size_t g=0; g<num_groups; g++)
+    {
+      lua_pushnumber(L,g+1);
+      lua_gettable(L,-2);
+      values[g] = lua_tonumber(L,-1);
+      lua_pop(L,1);
+    }
+    sources[mat_id] = values;
+
+    lua_pop(L,1);
+  }
+
+  return sources;
+}
+}
+
+//###################################################################
+/**Adds a batched right-hand side to the solver.
+
+Once batched right-hand sides have been added, chiLBSExecute solves all of
+them in the same sweeps instead of the problem with the material sources.
+The right-hand sides share the mesh, cross-sections, quadrature and
+boundary conditions and differ only in their isotropic volumetric sources.
+The memory of the angular flux buffers grows with the number of right-hand
+sides. Reflecting boundaries are not supported and the groupsets are
+always solved with Classic-Richardson in a single pass.
+
+\param SolverIndex int Handle to the solver.
+\param Sources table A table indexed by material id of which every entry is
+                     a table with the source strength of every group.
+                     Materials without an entry have no source.
+
+\return Index of the right-hand side.
+
+\code
+rhs0 = chiLBSAddBatchSource(phys1,{[0]=src_fuel})
+rhs1 = chiLBSAddBatchSource(phys1,{[1]=src_detector})
+chiLBSExecute(phys1)
+chiLBSSelectBatchSolution(phys1,rhs1)
+\endcode
+
+\ingroup LuaNPT
+*/
+int chiLBSAddBatchSource(lua_State *L)
+{
+  int num_args = lua_gettop(L);
+  if (num_args != 2)
+    LuaPostArgAmountError("chiLBSAddBatchSource",2,num_args);
+
+  LuaCheckNilValue("chiLBSAddBatchSource",L,1);
+  LuaCheckNilValue("chiLBSAddBatchSource",L,2);
+
+  int solver_index = lua_tonumber(L,1);
+  auto solver = GetLBSSolver(solver_index,"chiLBSAddBatchSource");
+
+  auto rhs_sources = GetMaterialSources(L,2,solver->groups.size(),
+                                        "chiLBSAddBatchSource");
+
+  solver->batch_sources.push_back(rhs_sources);
+
+  lua_pushnumber(L,solver->batch_sources.size()-1);
+  return 1;
+}
+
+//###################################################################
+/**Selects the solution of a batched right-hand side. Its flux moments
+are copied to the solver's flux vector, making it available to the field
+functions.
+
+\param SolverIndex int Handle to the solver.
+\param RHSIndex int Index of the right-hand side as returned by
+                    chiLBSAddBatchSource.
+
+\ingroup LuaNPT
+*/
+int chiLBSSelectBatchSolution(lua_State *L)
+{
+  int num_args = lua_gettop(L);
+  if (num_args != 2)
+    LuaPostArgAmountError("chiLBSSelectBatchSolution",2,num_args);
+
+  LuaCheckNilValue("chiLBSSelectBatchSolution",L,1);
+  LuaCheckNilValue("chiLBSSelectBatchSolution",L,2);
+
+  int solver_index = lua_tonumber(L,1);
+  int rhs_index    = lua_tonumber(L,2);
+  auto solver = GetLBSSolver(solver_index,"chiLBSSelectBatchSolution");
+
+  solver->SelectBatchSolution(rhs_index);
+
+  return 0;
+}
+
+//###################################################################
+/**Computes the response of the current scalar flux to an isotropic
+volumetric source, \f$ R = \sum_g \int_V q_g \phi_{0,g} dV \f$. After an
+adjoint solve (see chiLBSSetProperty ADJOINT) this is the detector response
+to the given forward source. With batched adjoint sources, select the
+adjoint solution of a response function with chiLBSSelectBatchSolution
+first.
+
+\param SolverIndex int Handle to the solver.
+\param Sources table A table indexed by material id of which every entry is
+                     a table with the source strength of every group.
+                     Materials without an entry have no source.
+
+\return The response.
+
+\code
+chiLBSSetProperty(phys1,ADJOINT,true)
+rhs_det = chiLBSAddBatchSource(phys1,{[1]=sigma_detector})
+chiLBSInitialize(phys1)
+chiLBSExecute(phys1)
+chiLBSSelectBatchSolution(phys1,rhs_det)
+response = chiLBSComputeResponse(phys1,{[0]=src_fuel})
+\endcode
+
+\ingroup LuaNPT
+*/
+int chiLBSComputeResponse(lua_State *L)
+{
+  int num_args = lua_gettop(L);
+  if (num_args != 2)
+    LuaPostArgAmountError("chiLBSComputeResponse",2,num_args);
+
+  LuaCheckNilValue("chiLBSComputeResponse",L,1);
+  LuaCheckNilValue("chiLBSComputeResponse",L,2);
+
+  int solver_index = lua_tonumber(L,1);
+  auto solver = GetLBSSolver(solver_index,"chiLBSComputeResponse");
+
+  auto sources = GetMaterialSources(L,2,solver->groups.size(),
+                                    "chiLBSComputeResponse");
+
+  lua_pushnumber(L,solver->ComputeResponse(sources));
+  return 1;
+}
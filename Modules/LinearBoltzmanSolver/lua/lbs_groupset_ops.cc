@@ -5,6 +5,8 @@
 #include "ChiMath/chi_math.h"
 #include <chi_log.h>
 
+#include <algorithm>
+
 extern ChiPhysics chi_physics_handler;
 extern ChiMath    chi_math_handler;
 extern ChiLog     chi_log;
@@ -385,6 +387,22 @@ LBSGroupset.ANGLE_AGG_POLAR\n
 LBSGroupset.ANGLE_AGG_SINGLE\n
  Use Single angle aggregation.\n\n
 
+LBSGroupset.ANGLE_AGG_OCTANT\n
+ Experimental. Aggregate all directions of an octant that share the same
+ sweep ordering, i.e., for which every mesh face has the same incident or
+ outgoing orientation. Works on any mesh. On orthogonal meshes this gives
+ one angle set per octant.\n\n
+
+LBSGroupset.ANGLE_AGG_CONE\n
+ Experimental. Like ANGLE_AGG_OCTANT but only directions within a cone
+ around the first direction of an angle set are aggregated. See
+ chiLBSGroupsetSetAngleAggLimits.\n\n
+
+The octant and cone aggregations reduce the number of angle sets, but their
+effect on the sweep time has not been measured yet and may be adverse, e.g.,
+through larger FLUDS. Compare the logged sweep times with the polar or
+single aggregation before using them in production.\n\n
+
 Example:
 \code
 chiLBSGroupsetSetAngleAggregationType(phys1,cur_gs,LBSGroupset.ANGLE_AGG_POLAR)
@@ -450,6 +468,10 @@ int chiLBSGroupsetSetAngleAggregationType(lua_State *L)
     groupset->angleagg_method = LinearBoltzman::AngleAggregationType::SINGLE;
   else if (agg_type == (int)LinearBoltzman::AngleAggregationType::POLAR)
     groupset->angleagg_method = LinearBoltzman::AngleAggregationType::POLAR;
+  else if (agg_type == (int)LinearBoltzman::AngleAggregationType::OCTANT)
+    groupset->angleagg_method = LinearBoltzman::AngleAggregationType::OCTANT;
+  else if (agg_type == (int)LinearBoltzman::AngleAggregationType::CONE)
+    groupset->angleagg_method = LinearBoltzman::AngleAggregationType::CONE;
   else
   {
     chi_log.Log(LOG_ALLERROR)
@@ -467,6 +489,120 @@ int chiLBSGroupsetSetAngleAggregationType(lua_State *L)
   return 0;
 }
 
+//###################################################################
+/**Sets the limits of the octant and cone angle aggregation types. These
+aggregation types are experimental, see
+chiLBSGroupsetSetAngleAggregationType.
+
+\param SolverIndex int Handle to the solver for which the group
+is to be created.
+
+\param GroupsetIndex int Index to the groupset to which this function should
+                         apply
+\param MaxAngles int Maximum number of directions per angle set. The FLUDS
+                     memory of an angle set grows with its number of
+                     directions. 0 means no limit. Default 0.
+\param ConeAngle float Optional. Half-angle, in degrees, of the cones of
+                       ANGLE_AGG_CONE. Default 30.
+
+##_
+
+Example:
+\code
+chiLBSGroupsetSetAngleAggregationType(phys1,cur_gs,LBSGroupset.ANGLE_AGG_CONE)
+chiLBSGroupsetSetAngleAggLimits(phys1,cur_gs,32,20.0)
+\endcode
+
+\ingroup LuaLBSGroupsets
+*/
+int chiLBSGroupsetSetAngleAggLimits(lua_State *L)
+{
+  //============================================= Get arguments
+  int num_args = lua_gettop(L);
+  if ((num_args != 3) and (num_args != 4))
+    LuaPostArgAmountError("chiLBSGroupsetSetAngleAggLimits",3,num_args);
+
+  LuaCheckNilValue("chiLBSGroupsetSetAngleAggLimits",L,1);
+  LuaCheckNilValue("chiLBSGroupsetSetAngleAggLimits",L,2);
+  LuaCheckNilValue("chiLBSGroupsetSetAngleAggLimits",L,3);
+  int solver_index = lua_tonumber(L,1);
+  int grpset_index = lua_tonumber(L,2);
+  int max_angles   = lua_tonumber(L,3);
+  double cone_angle = -1.0;
+  if (num_args == 4)
+  {
+    LuaCheckNilValue("chiLBSGroupsetSetAngleAggLimits",L,4);
+    cone_angle = lua_tonumber(L,4);
+  }
+
+  //============================================= Get pointer to solver
+  chi_physics::Solver* psolver;
+  LinearBoltzman::Solver* solver;
+  try{
+    psolver = chi_physics_handler.solver_stack.at(solver_index);
+
+    if (typeid(*psolver) == typeid(LinearBoltzman::Solver))
+    {
+      solver = (LinearBoltzman::Solver*)(psolver);
+    }
+    else
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Incorrect solver-type "
+        << "in call to chiLBSGroupsetSetAngleAggLimits";
+      exit(EXIT_FAILURE);
+    }
+  }
+  catch(const std::out_of_range& o)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid handle to solver "
+      << "in call to chiLBSGroupsetSetAngleAggLimits";
+    exit(EXIT_FAILURE);
+  }
+
+  //============================================= Obtain pointer to groupset
+  LBSGroupset* groupset;
+  try{
+    groupset = solver->group_sets.at(grpset_index);
+  }
+  catch (const std::out_of_range& o)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid handle to groupset "
+      << "in call to chiLBSGroupsetSetAngleAggLimits";
+    exit(EXIT_FAILURE);
+  }
+
+  //============================================= Bounds checking
+  if (max_angles < 0)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid maximum number of angles specified "
+      << "in call to chiLBSGroupsetSetAngleAggLimits. Must be >= 0.";
+    exit(EXIT_FAILURE);
+  }
+  if ((num_args == 4) and ((cone_angle <= 0.0) or (cone_angle > 90.0)))
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid cone angle specified "
+      << "in call to chiLBSGroupsetSetAngleAggLimits. Must be in (0,90].";
+    exit(EXIT_FAILURE);
+  }
+
+  groupset->angle_agg_max_angles = max_angles;
+  if (num_args == 4)
+    groupset->angle_agg_cone_angle = cone_angle*M_PI/180.0;
+
+  chi_log.Log(LOG_0)
+    << "Groupset " << grpset_index
+    << " angle aggregation limited to " << max_angles
+    << " angles per angle set, cone angle "
+    << groupset->angle_agg_cone_angle*180.0/M_PI << " degrees";
+
+  return 0;
+}
+
 //###################################################################
 /**Sets the angle aggregation divisions
 \param SolverIndex int Handle to the solver for which the group
@@ -676,6 +812,15 @@ NPT_GMRES_CYCLES\n
 Generalized Minimal Residual formulation for iterations with cyclic dependency
 convergence.\n\n
 
+NPT_ANDERSON\n
+Source iteration with Anderson acceleration (nonlinear Krylov acceleration).
+Works with or without DSA and only stores a small window of previous
+iterates. See chiLBSGroupsetSetAndersonParameters.\n\n
+
+NPT_ANDERSON_CYCLES\n
+Anderson accelerated source iteration with cyclic dependency
+convergence.\n\n
+
 Example:
 \code
 chiLBSGroupsetSetIterativeMethod(phys1,cur_gs,NPT_CLASSICRICHARDSON)
@@ -755,6 +900,15 @@ int chiLBSGroupsetSetIterativeMethod(lua_State *L)
     groupset->allow_cycles = true;
     groupset->iterative_method = NPT_GMRES;
   }
+  else if (iter_method == NPT_ANDERSON)
+  {
+    groupset->iterative_method = NPT_ANDERSON;
+  }
+  else if (iter_method == NPT_ANDERSON_CYCLES)
+  {
+    groupset->allow_cycles = true;
+    groupset->iterative_method = NPT_ANDERSON;
+  }
   else
   {
     chi_log.Log(LOG_0ERROR)
@@ -1037,6 +1191,244 @@ int chiLBSGroupsetSetGMRESRestartIntvl(lua_State *L)
   return 0;
 }
 
+//###################################################################
+/**Sets the parameters of Anderson acceleration if applied to the groupset.
+\param SolverIndex int Handle to the solver for which the group
+is to be created.
+
+\param GroupsetIndex int Index to the groupset to which this function should
+                         apply
+\param Depth int Number of previous iterates used. Default 5. A depth of 0
+                 reduces the method to (damped) source iteration.
+\param Damping float Damping/mixing factor applied to the residual.
+                     Default 1.0.
+
+##_
+
+Example:
+\code
+chiLBSGroupsetSetIterativeMethod(phys1,cur_gs,NPT_ANDERSON)
+chiLBSGroupsetSetAndersonParameters(phys1,cur_gs,5,1.0)
+\endcode
+
+\ingroup LuaLBSGroupsets
+*/
+int chiLBSGroupsetSetAndersonParameters(lua_State *L)
+{
+  //============================================= Get arguments
+  int num_args = lua_gettop(L);
+  if (num_args != 4)
+    LuaPostArgAmountError("chiLBSGroupsetSetAndersonParameters",4,num_args);
+
+  LuaCheckNilValue("chiLBSGroupsetSetAndersonParameters",L,1);
+  LuaCheckNilValue("chiLBSGroupsetSetAndersonParameters",L,2);
+  LuaCheckNilValue("chiLBSGroupsetSetAndersonParameters",L,3);
+  LuaCheckNilValue("chiLBSGroupsetSetAndersonParameters",L,4);
+  int solver_index = lua_tonumber(L,1);
+  int grpset_index = lua_tonumber(L,2);
+  int depth        = lua_tonumber(L,3);
+  double damping   = lua_tonumber(L,4);
+
+  //============================================= Get pointer to solver
+  chi_physics::Solver* psolver;
+  LinearBoltzman::Solver* solver;
+  try{
+    psolver = chi_physics_handler.solver_stack.at(solver_index);
+
+    if (typeid(*psolver) == typeid(LinearBoltzman::Solver))
+    {
+      solver = (LinearBoltzman::Solver*)(psolver);
+    }
+    else
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Incorrect solver-type "
+        << "in call to chiLBSGroupsetSetAndersonParameters";
+      exit(EXIT_FAILURE);
+    }
+  }
+  catch(const std::out_of_range& o)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid handle to solver "
+      << "in call to chiLBSGroupsetSetAndersonParameters";
+    exit(EXIT_FAILURE);
+  }
+
+  //============================================= Obtain pointer to groupset
+  LBSGroupset* groupset;
+  try{
+    groupset = solver->group_sets.at(grpset_index);
+  }
+  catch (const std::out_of_range& o)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid handle to groupset "
+      << "in call to chiLBSGroupsetSetAndersonParameters";
+    exit(EXIT_FAILURE);
+  }
+
+  //============================================= Bounds checking
+  if (depth < 0)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid Anderson depth specified "
+      << "in call to chiLBSGroupsetSetAndersonParameters. Must be >= 0.";
+    exit(EXIT_FAILURE);
+  }
+  if ((damping <= 0.0) or (damping > 1.0))
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid Anderson damping specified "
+      << "in call to chiLBSGroupsetSetAndersonParameters. "
+      << "Must be in (0,1].";
+    exit(EXIT_FAILURE);
+  }
+
+  groupset->anderson_depth   = depth;
+  groupset->anderson_damping = damping;
+
+  chi_log.Log(LOG_0)
+    << "Groupset " << grpset_index << " Anderson depth set to "
+    << depth << " and damping set to " << damping;
+
+  return 0;
+}
+
+
+//###################################################################
+/**Sets the Krylov method used for the groupset when the iterative method
+is NPT_GMRES or NPT_GMRES_CYCLES, and how DSA is applied.
+\param SolverIndex int Handle to the solver for which the group
+is to be created.
+
+\param GroupsetIndex int Index to the groupset to which this function should
+                         apply
+\param KrylovType string PETSc Krylov type. Supported are "gmres" (default),
+                  "fgmres", "lgmres", "pgmres", "pipefgmres", "bcgs",
+                  "pipebcgs", "gcr", "pipegcr" and "tfqmr".
+\param DSAMode int Optional. How WGDSA/TGDSA, if enabled, are applied:
+
+DSA_IN_OPERATOR\n
+DSA is part of the operator, no preconditioner is used (default).\n\n
+
+DSA_LEFT_PRECONDITIONER\n
+DSA is applied as a left preconditioner.\n\n
+
+DSA_RIGHT_PRECONDITIONER\n
+DSA is applied as a right preconditioner. Flexible methods ("fgmres",
+"pipefgmres", "gcr", "pipegcr") always use right preconditioning and are
+suited for inexact DSA solves.\n\n
+
+##_
+
+Example:
+\code
+chiLBSGroupsetSetKrylovMethod(phys1,cur_gs,"fgmres",
+                              LBSGroupset.DSA_RIGHT_PRECONDITIONER)
+\endcode
+
+\ingroup LuaLBSGroupsets
+*/
+int chiLBSGroupsetSetKrylovMethod(lua_State *L)
+{
+  //============================================= Get arguments
+  int num_args = lua_gettop(L);
+  if ((num_args != 3) and (num_args != 4))
+    LuaPostArgAmountError("chiLBSGroupsetSetKrylovMethod",3,num_args);
+
+  LuaCheckNilValue("chiLBSGroupsetSetKrylovMethod",L,1);
+  LuaCheckNilValue("chiLBSGroupsetSetKrylovMethod",L,2);
+  LuaCheckNilValue("chiLBSGroupsetSetKrylovMethod",L,3);
+  int solver_index = lua_tonumber(L,1);
+  int grpset_index = lua_tonumber(L,2);
+  std::string krylov_type = lua_tostring(L,3);
+  int dsa_mode = 0;
+  if (num_args == 4)
+  {
+    LuaCheckNilValue("chiLBSGroupsetSetKrylovMethod",L,4);
+    dsa_mode = lua_tonumber(L,4);
+  }
+
+  //============================================= Get pointer to solver
+  chi_physics::Solver* psolver;
+  LinearBoltzman::Solver* solver;
+  try{
+    psolver = chi_physics_handler.solver_stack.at(solver_index);
+
+    if (typeid(*psolver) == typeid(LinearBoltzman::Solver))
+    {
+      solver = (LinearBoltzman::Solver*)(psolver);
+    }
+    else
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Incorrect solver-type "
+        << "in call to chiLBSGroupsetSetKrylovMethod";
+      exit(EXIT_FAILURE);
+    }
+  }
+  catch(const std::out_of_range& o)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid handle to solver "
+      << "in call to chiLBSGroupsetSetKrylovMethod";
+    exit(EXIT_FAILURE);
+  }
+
+  //============================================= Obtain pointer to groupset
+  LBSGroupset* groupset;
+  try{
+    groupset = solver->group_sets.at(grpset_index);
+  }
+  catch (const std::out_of_range& o)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid handle to groupset "
+      << "in call to chiLBSGroupsetSetKrylovMethod";
+    exit(EXIT_FAILURE);
+  }
+
+  //============================================= Bounds checking
+  const std::vector<std::string> supported_types =
+    {"gmres","fgmres","lgmres","pgmres","pipefgmres",
+     "bcgs","pipebcgs","gcr","pipegcr","tfqmr"};
+  if (std::find(supported_types.begin(),supported_types.end(),krylov_type) ==
+      supported_types.end())
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Unsupported Krylov type \"" << krylov_type << "\" specified "
+      << "in call to chiLBSGroupsetSetKrylovMethod.";
+    exit(EXIT_FAILURE);
+  }
+  if ((dsa_mode < 0) or (dsa_mode > 2))
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid DSA mode specified "
+      << "in call to chiLBSGroupsetSetKrylovMethod.";
+    exit(EXIT_FAILURE);
+  }
+
+  groupset->krylov_type = krylov_type;
+  groupset->dsa_mode    = static_cast<LinearBoltzman::DSAMode>(dsa_mode);
+
+  if (groupset->dsa_inexact and (not groupset->InexactDSAAllowed()))
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Groupset " << grpset_index << " has inexact DSA enabled, which "
+      << "requires a flexible Krylov type (fgmres, pipefgmres, gcr or "
+      << "pipegcr) with DSA applied as a preconditioner "
+      << "in call to chiLBSGroupsetSetKrylovMethod.";
+    exit(EXIT_FAILURE);
+  }
+
+  chi_log.Log(LOG_0)
+    << "Groupset " << grpset_index << " Krylov method set to "
+    << krylov_type << " with DSA mode " << dsa_mode;
+
+  return 0;
+}
+
 
 //###################################################################
 /**Enables or disables the printing of a sweep log.
@@ -1337,3 +1729,245 @@ int chiLBSGroupsetSetTGDSA(lua_State *L)
 
   return 0;
 }
+
+//###################################################################
+/**Enables or disables inexact DSA within the groupset Krylov solve.
+When enabled, the relative tolerance of the WGDSA/TGDSA diffusion solves
+applied within the Krylov iterations is relaxed, from the tolerance set
+with chiLBSGroupsetSetWGDSA/chiLBSGroupsetSetTGDSA, inversely with the
+Krylov relative residual. The groupset convergence criterion itself is
+not changed. Only applies to the Krylov iterative methods.
+
+A DSA solve with a varying tolerance is a varying preconditioner, hence
+inexact DSA requires a flexible Krylov type ("fgmres", "pipefgmres", "gcr"
+or "pipegcr") with DSA applied as a preconditioner. This must be set with
+chiLBSGroupsetSetKrylovMethod before inexact DSA is enabled.
+
+\param SolverIndex int Handle to the solver for which the group
+is to be created.
+
+\param GroupsetIndex int Index to the groupset to which this function should
+                         apply
+\param Flag bool Flag indicating whether to use inexact DSA. Default false.
+\param MaxTol float Optional. Loosest DSA relative tolerance allowed.
+                    Default 1.0e-1.
+
+##_
+
+Example:
+\code
+chiLBSGroupsetSetKrylovMethod(phys1,cur_gs,"fgmres",
+                              LBSGroupset.DSA_RIGHT_PRECONDITIONER)
+chiLBSGroupsetSetInexactDSA(phys1,cur_gs,true,0.1)
+\endcode
+
+\ingroup LuaLBSGroupsets
+*/
+int chiLBSGroupsetSetInexactDSA(lua_State *L)
+{
+  //============================================= Get arguments
+  int num_args = lua_gettop(L);
+  if ((num_args != 3) and (num_args != 4))
+    LuaPostArgAmountError("chiLBSGroupsetSetInexactDSA",3,num_args);
+
+  LuaCheckNilValue("chiLBSGroupsetSetInexactDSA",L,1);
+  LuaCheckNilValue("chiLBSGroupsetSetInexactDSA",L,2);
+  LuaCheckNilValue("chiLBSGroupsetSetInexactDSA",L,3);
+  int solver_index = lua_tonumber(L,1);
+  int grpset_index = lua_tonumber(L,2);
+  bool flag        = lua_toboolean(L,3);
+  double max_tol   = 1.0e-1;
+  if (num_args == 4)
+  {
+    LuaCheckNilValue("chiLBSGroupsetSetInexactDSA",L,4);
+    max_tol = lua_tonumber(L,4);
+  }
+
+  //============================================= Get pointer to solver
+  chi_physics::Solver* psolver;
+  LinearBoltzman::Solver* solver;
+  try{
+    psolver = chi_physics_handler.solver_stack.at(solver_index);
+
+    if (typeid(*psolver) == typeid(LinearBoltzman::Solver))
+    {
+      solver = (LinearBoltzman::Solver*)(psolver);
+    }
+    else
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Incorrect solver-type "
+        << "in call to chiLBSGroupsetSetInexactDSA";
+      exit(EXIT_FAILURE);
+    }
+  }
+  catch(const std::out_of_range& o)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid handle to solver "
+      << "in call to chiLBSGroupsetSetInexactDSA";
+    exit(EXIT_FAILURE);
+  }
+
+  //============================================= Obtain pointer to groupset
+  LBSGroupset* groupset;
+  try{
+    groupset = solver->group_sets.at(grpset_index);
+  }
+  catch (const std::out_of_range& o)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid handle to groupset "
+      << "in call to chiLBSGroupsetSetInexactDSA";
+    exit(EXIT_FAILURE);
+  }
+
+  //============================================= Bounds checking
+  if ((max_tol <= 0.0) or (max_tol >= 1.0))
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid maximum DSA tolerance specified "
+      << "in call to chiLBSGroupsetSetInexactDSA. Must be in (0,1).";
+    exit(EXIT_FAILURE);
+  }
+  if (flag and (not groupset->InexactDSAAllowed()))
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Inexact DSA requires a flexible Krylov type (fgmres, pipefgmres, "
+      << "gcr or pipegcr) with DSA applied as a preconditioner, but groupset "
+      << grpset_index << " uses \"" << groupset->krylov_type << "\" with "
+      << "DSA mode " << static_cast<int>(groupset->dsa_mode)
+      << ". Call chiLBSGroupsetSetKrylovMethod first "
+      << "in call to chiLBSGroupsetSetInexactDSA.";
+    exit(EXIT_FAILURE);
+  }
+
+  groupset->dsa_inexact         = flag;
+  groupset->dsa_inexact_max_tol = max_tol;
+
+  chi_log.Log(LOG_0)
+    << "Groupset " << grpset_index << " inexact DSA "
+    << (flag? "enabled" : "disabled") << " with maximum tolerance "
+    << max_tol;
+
+  return 0;
+}
+
+//###################################################################
+/**Enables auto-tuning of the group subsets and angle aggregation of a
+groupset. Before the groupset is solved for the first time, short trial
+sweeps are timed for candidate numbers of group subsets, for single and
+polar angle aggregation, for candidate numbers of angle subsets, and the
+fastest configuration replaces the settings of
+chiLBSGroupsetSetGroupSubsets, chiLBSGroupsetSetAngleAggregationType and
+chiLBSGroupsetSetAngleAggDiv. The candidates are searched one setting at a
+time, starting from the user settings. The experimental octant and cone
+aggregations are only timed when they are the user setting.
+
+\param SolverIndex int Handle to the solver for which the group
+is to be created.
+
+\param GroupsetIndex int Index to the groupset to which this function should
+                         apply
+\param Flag bool Flag indicating whether to auto-tune. Default false.
+\param NumSweeps int Optional. Number of timed sweeps per configuration.
+                     Default 2.
+\param CacheFile string Optional. File in which tuned configurations are
+                        stored. A configuration stored for the same
+                        groupset, problem size and number of processes is
+                        used without trial sweeps.
+
+##_
+
+Example:
+\code
+chiLBSGroupsetSetAutoTune(phys1,cur_gs,true,2,"autotune.txt")
+\endcode
+
+\ingroup LuaLBSGroupsets
+*/
+int chiLBSGroupsetSetAutoTune(lua_State *L)
+{
+  //============================================= Get arguments
+  int num_args = lua_gettop(L);
+  if ((num_args < 3) or (num_args > 5))
+    LuaPostArgAmountError("chiLBSGroupsetSetAutoTune",3,num_args);
+
+  LuaCheckNilValue("chiLBSGroupsetSetAutoTune",L,1);
+  LuaCheckNilValue("chiLBSGroupsetSetAutoTune",L,2);
+  LuaCheckNilValue("chiLBSGroupsetSetAutoTune",L,3);
+  int solver_index = lua_tonumber(L,1);
+  int grpset_index = lua_tonumber(L,2);
+  bool flag        = lua_toboolean(L,3);
+  int num_sweeps   = 2;
+  std::string cache_file;
+  if (num_args >= 4)
+  {
+    LuaCheckNilValue("chiLBSGroupsetSetAutoTune",L,4);
+    num_sweeps = lua_tonumber(L,4);
+  }
+  if (num_args == 5)
+  {
+    LuaCheckNilValue("chiLBSGroupsetSetAutoTune",L,5);
+    cache_file = lua_tostring(L,5);
+  }
+
+  //============================================= Get pointer to solver
+  chi_physics::Solver* psolver;
+  LinearBoltzman::Solver* solver;
+  try{
+    psolver = chi_physics_handler.solver_stack.at(solver_index);
+
+    if (typeid(*psolver) == typeid(LinearBoltzman::Solver))
+    {
+      solver = (LinearBoltzman::Solver*)(psolver);
+    }
+    else
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Incorrect solver-type "
+        << "in call to chiLBSGroupsetSetAutoTune";
+      exit(EXIT_FAILURE);
+    }
+  }
+  catch(const std::out_of_range& o)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid handle to solver "
+      << "in call to chiLBSGroupsetSetAutoTune";
+    exit(EXIT_FAILURE);
+  }
+
+  //============================================= Obtain pointer to groupset
+  LBSGroupset* groupset;
+  try{
+    groupset = solver->group_sets.at(grpset_index);
+  }
+  catch (const std::out_of_range& o)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid handle to groupset "
+      << "in call to chiLBSGroupsetSetAutoTune";
+    exit(EXIT_FAILURE);
+  }
+
+  //============================================= Bounds checking
+  if (num_sweeps < 1)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Invalid number of trial sweeps specified "
+      << "in call to chiLBSGroupsetSetAutoTune. Must be at least 1.";
+    exit(EXIT_FAILURE);
+  }
+
+  groupset->auto_tune            = flag;
+  groupset->auto_tune_sweeps     = num_sweeps;
+  groupset->auto_tune_cache_file = cache_file;
+  groupset->auto_tuned           = false;
+
+  chi_log.Log(LOG_0)
+    << "Groupset " << grpset_index << " auto-tuning "
+    << (flag? "enabled" : "disabled");
+
+  return 0;
+}
@@ -32,6 +32,26 @@ extern ChiMath    chi_math_handler;
 
 #define WRITE_RESTART_DATA 7
 
+#define WRITE_RESTART_ASYNC 8
+
+#define MAX_OUTER_ITERATIONS 9
+
+#define OUTER_TOLERANCE 10
+
+#define OUTER_SCHEME 11
+  #define OUTER_GAUSS_SEIDEL 1
+  #define OUTER_JACOBI       2
+
+#define ADAPTIVE_INNER_TOLERANCE 12
+
+#define CMFD_ACCELERATION 13
+
+#define TEAM_DECOMPOSITION 14
+  #define TEAMS_ANGLE  1
+  #define TEAMS_ENERGY 2
+
+#define ADJOINT 15
+
 #include <chi_log.h>
 
 extern ChiLog chi_log;
@@ -69,7 +89,9 @@ READ_RESTART_DATA\n
  The value can be followed by two
  optional strings. The first is the folder name which can be relative or
  absolute, and the second is the file base name. These are defaulted to
- "YRestart" and "restart" respectively.\n\n
+ "YRestart" and "restart" respectively. Restart data is stored in a single
+ file, FolderName/FileBase.r, which can be read back with a different number
+ of processes or a different partitioning of the same mesh.\n\n
 
 \code
 chiLBSSetProperty(phys1,READ_RESTART_DATA,"YRestart1")
@@ -88,6 +110,92 @@ WRITE_RESTART_DATA\n
 chiLBSSetProperty(phys1,WRITE_RESTART_DATA,"YRestart1","restart",1)
 \endcode
 
+WRITE_RESTART_ASYNC\n
+ Expects to be followed by true/false. When true, restart data is copied to a
+ staging buffer and written by a background thread while the solver keeps
+ iterating. The solver only waits if a previous write has not finished and
+ the time spent waiting is reported. Default false.\n\n
+
+MAX_OUTER_ITERATIONS\n
+ Expects to be followed by an integer. Maximum number of outer iterations
+ over all the groupsets. With more than one outer iteration the groupsets
+ are solved repeatedly so that upscattering (and fission) from later
+ groupsets is converged back into earlier ones. Default 1, i.e., a single
+ pass over the groupsets.\n\n
+
+OUTER_TOLERANCE\n
+ Expects to be followed by a number. The outer iterations are converged when
+ the point-wise change of the flux between two outer iterations is below this
+ value. Default 1.0e-6.\n\n
+
+OUTER_SCHEME\n
+ Expects to be followed by OUTER_GAUSS_SEIDEL or OUTER_JACOBI. With
+ Gauss-Seidel, groupsets use the latest flux of the groupsets solved before
+ them. With Jacobi, all groupsets use the flux of the previous outer
+ iteration. Default OUTER_GAUSS_SEIDEL.\n\n
+
+ADAPTIVE_INNER_TOLERANCE\n
+ Expects to be followed by true/false and optionally by a factor and a
+ maximum tolerance. When true, the within-groupset tolerance of each outer
+ iteration is set to min(max, factor*outer_change), but never tighter than
+ the groupset's own tolerance, so that early outers are not over-solved.
+ Defaults true, 0.1 and 1.0e-2.\n\n
+
+\code
+chiLBSSetProperty(phys1,MAX_OUTER_ITERATIONS,50)
+chiLBSSetProperty(phys1,OUTER_TOLERANCE,1.0e-6)
+chiLBSSetProperty(phys1,OUTER_SCHEME,OUTER_GAUSS_SEIDEL)
+chiLBSSetProperty(phys1,ADAPTIVE_INNER_TOLERANCE,true,0.1,1.0e-2)
+\endcode
+
+CMFD_ACCELERATION\n
+ Expects to be followed by true/false and optionally by a lua table with the
+ number of coarse cells in x, y and z. When true, the outer iterations are
+ accelerated with a multigroup coarse-mesh finite-difference (CMFD) system
+ with nonlinear current correction. Cells are grouped into coarse cells with
+ a uniform lattice over the domain. Without a table the lattice is chosen
+ such that coarse cells contain about two cells in each direction. The
+ coarse face currents are tallied during the last sweep of groupsets solved
+ with classic Richardson and without WGDSA or TGDSA. Groupsets solved with a
+ Krylov method, Anderson acceleration or a DSA correction end on an iterate
+ that is not the result of a sweep, hence their solve is followed by one
+ additional sweep, per outer iteration, that tallies the currents. Reflecting boundaries have zero net current in the
+ coarse system. Requires MAX_OUTER_ITERATIONS > 1. Default false.\n\n
+
+\code
+chiLBSSetProperty(phys1,MAX_OUTER_ITERATIONS,20)
+chiLBSSetProperty(phys1,CMFD_ACCELERATION,true,{8,8,1})
+\endcode
+
+TEAM_DECOMPOSITION\n
+ Expects to be followed by TEAMS_ANGLE or TEAMS_ENERGY. Selects how the work
+ is split when the processes are split into teams with the -teams command
+ line option. Every team holds the same spatial partition. With TEAMS_ANGLE
+ the teams sweep different angle sets of each groupset. With TEAMS_ENERGY
+ the groupsets are distributed round-robin over the teams and solved
+ concurrently, exchanging the groupset fluxes after every outer iteration.
+ TEAMS_ENERGY requires OUTER_SCHEME OUTER_JACOBI. Default TEAMS_ANGLE.\n\n
+
+\code
+chiLBSSetProperty(phys1,OUTER_SCHEME,OUTER_JACOBI)
+chiLBSSetProperty(phys1,TEAM_DECOMPOSITION,TEAMS_ENERGY)
+\endcode
+
+ADJOINT\n
+ Expects to be followed by true/false. When true, the adjoint transport
+ equation is solved with the transposed material cross-sections. The
+ material sources, or the batched sources, then act as the adjoint source,
+ i.e., as the response function, and the responses of forward sources can
+ be evaluated with chiLBSComputeResponse. Incident boundaries are not
+ supported. Must be set before chiLBSInitialize. Default false.\n\n
+
+\code
+chiLBSSetProperty(phys1,ADJOINT,true)
+chiLBSInitialize(phys1)
+chiLBSExecute(phys1)
+response = chiLBSComputeResponse(phys1,{[0]=src_fuel})
+\endcode
+
 ###Discretization methods
  PWLD2D = Piecewise Linear Finite Element 2D.\n
  PWLD3D = Piecewise Linear Finite Element 3D.
@@ -366,6 +474,137 @@ int chiLBSSetProperty(lua_State *L)
     }
     solver->options.write_restart_data = true;
   }
+  else if (property == WRITE_RESTART_ASYNC)
+  {
+    if (numArgs!=3)
+      LuaPostArgAmountError("chiLBSSetProperty:WRITE_RESTART_ASYNC",
+                            3,numArgs);
+
+    solver->options.write_restart_async = lua_toboolean(L,3);
+  }
+  else if (property == MAX_OUTER_ITERATIONS)
+  {
+    if (numArgs!=3)
+      LuaPostArgAmountError("chiLBSSetProperty:MAX_OUTER_ITERATIONS",
+                            3,numArgs);
+
+    int max_outer_iterations = lua_tonumber(L,3);
+    if (max_outer_iterations < 1)
+    {
+      chi_log.Log(LOG_0ERROR)
+        << "Invalid number of outer iterations in call to "
+        << "chiLBSSetProperty:MAX_OUTER_ITERATIONS. Value must be >= 1.";
+      exit(EXIT_FAILURE);
+    }
+
+    solver->options.max_outer_iterations = max_outer_iterations;
+  }
+  else if (property == OUTER_TOLERANCE)
+  {
+    if (numArgs!=3)
+      LuaPostArgAmountError("chiLBSSetProperty:OUTER_TOLERANCE",
+                            3,numArgs);
+
+    double tolerance = lua_tonumber(L,3);
+    if (tolerance <= 0.0)
+    {
+      chi_log.Log(LOG_0ERROR)
+        << "Invalid outer tolerance in call to "
+        << "chiLBSSetProperty:OUTER_TOLERANCE. Value must be > 0.";
+      exit(EXIT_FAILURE);
+    }
+
+    solver->options.outer_tolerance = tolerance;
+  }
+  else if (property == OUTER_SCHEME)
+  {
+    if (numArgs!=3)
+      LuaPostArgAmountError("chiLBSSetProperty:OUTER_SCHEME",
+                            3,numArgs);
+
+    int scheme = lua_tonumber(L,3);
+    if (scheme == OUTER_GAUSS_SEIDEL)
+      solver->options.outer_scheme = LinearBoltzman::OuterScheme::GAUSS_SEIDEL;
+    else if (scheme == OUTER_JACOBI)
+      solver->options.outer_scheme = LinearBoltzman::OuterScheme::JACOBI;
+    else
+    {
+      chi_log.Log(LOG_0ERROR)
+        << "Invalid outer scheme in call to "
+        << "chiLBSSetProperty:OUTER_SCHEME.";
+      exit(EXIT_FAILURE);
+    }
+  }
+  else if (property == ADAPTIVE_INNER_TOLERANCE)
+  {
+    if (numArgs<3)
+      LuaPostArgAmountError("chiLBSSetProperty:ADAPTIVE_INNER_TOLERANCE",
+                            3,numArgs);
+
+    solver->options.adaptive_inner_tolerance = lua_toboolean(L,3);
+    if (numArgs >= 4)
+      solver->options.inner_tolerance_factor = lua_tonumber(L,4);
+    if (numArgs >= 5)
+      solver->options.inner_tolerance_max = lua_tonumber(L,5);
+  }
+  else if (property == CMFD_ACCELERATION)
+  {
+    if (numArgs<3)
+      LuaPostArgAmountError("chiLBSSetProperty:CMFD_ACCELERATION",
+                            3,numArgs);
+
+    solver->options.cmfd_enabled = lua_toboolean(L,3);
+
+    if (numArgs >= 4)
+    {
+      if (!lua_istable(L,4))
+      {
+        chi_log.Log(LOG_0ERROR)
+          << "In call to chiLBSSetProperty:CMFD_ACCELERATION, argument 4 "
+          << "must be a lua table with the number of coarse cells in "
+          << "x, y and z.";
+        exit(EXIT_FAILURE);
+      }
+
+      int table_len = lua_rawlen(L,4);
+      solver->options.cmfd_divisions.assign(3,1);
+      for (int d=0; d<std::min(table_len,3); d++)
+      {
+        lua_pushnumber(L,d+1);
+        lua_gettable(L,4);
+        solver->options.cmfd_divisions[d] = lua_tonumber(L,-1);
+        lua_pop(L,1);
+      }
+    }
+  }
+  else if (property == TEAM_DECOMPOSITION)
+  {
+    if (numArgs!=3)
+      LuaPostArgAmountError("chiLBSSetProperty:TEAM_DECOMPOSITION",
+                            3,numArgs);
+
+    int decomposition = lua_tonumber(L,3);
+    if (decomposition == TEAMS_ANGLE)
+      solver->options.team_decomposition =
+        LinearBoltzman::TeamDecomposition::ANGLE;
+    else if (decomposition == TEAMS_ENERGY)
+      solver->options.team_decomposition =
+        LinearBoltzman::TeamDecomposition::ENERGY;
+    else
+    {
+      chi_log.Log(LOG_0ERROR)
+        << "Invalid team decomposition in call to "
+        << "chiLBSSetProperty:TEAM_DECOMPOSITION.";
+      exit(EXIT_FAILURE);
+    }
+  }
+  else if (property == ADJOINT)
+  {
+    if (numArgs!=3)
+      LuaPostArgAmountError("chiLBSSetProperty:ADJOINT",3,numArgs);
+
+    solver->options.adjoint = lua_toboolean(L,3);
+  }
   else
   {
     std::cerr << "Invalid property in chiLBSSetProperty.\n";
@@ -31,6 +31,8 @@ RegisterConstant(NPT_CLASSICRICHARDSON,          1);
 RegisterConstant(NPT_CLASSICRICHARDSON_CYCLES,   2);
 RegisterConstant(NPT_GMRES,                      3);
 RegisterConstant(NPT_GMRES_CYCLES,               4);
+RegisterConstant(NPT_ANDERSON,                   5);
+RegisterConstant(NPT_ANDERSON_CYCLES,            6);
 RegisterConstant(GROUPSET_TOLERANCE,   102);
 RegisterConstant(GROUPSET_MAXITERATIONS,   103);
 RegisterConstant(GROUPSET_GMRESRESTART_INTVL,   104);
@@ -46,8 +48,23 @@ RegisterConstant(SCATTERING_ORDER,   4);
 RegisterConstant(SWEEP_EAGER_LIMIT,   5);
 RegisterConstant(READ_RESTART_DATA,   6);
 RegisterConstant(WRITE_RESTART_DATA,  7);
+RegisterConstant(WRITE_RESTART_ASYNC, 8);
+RegisterConstant(MAX_OUTER_ITERATIONS, 9);
+RegisterConstant(OUTER_TOLERANCE,     10);
+RegisterConstant(OUTER_SCHEME,        11);
+RegisterConstant(OUTER_GAUSS_SEIDEL,   1);
+RegisterConstant(OUTER_JACOBI,         2);
+RegisterConstant(ADAPTIVE_INNER_TOLERANCE, 12);
+RegisterConstant(CMFD_ACCELERATION,   13);
+RegisterConstant(TEAM_DECOMPOSITION,  14);
+RegisterConstant(TEAMS_ANGLE,          1);
+RegisterConstant(TEAMS_ENERGY,         2);
+RegisterConstant(ADJOINT,             15);
 RegisterFunction(chiLBSInitialize)
 RegisterFunction(chiLBSExecute)
+RegisterFunction(chiLBSAddBatchSource)
+RegisterFunction(chiLBSSelectBatchSolution)
+RegisterFunction(chiLBSComputeResponse)
 RegisterFunction(chiLBSGetFieldFunctionList)
 RegisterFunction(chiLBSGetScalarFieldFunctionList)
 
@@ -61,12 +78,22 @@ RegisterFunction(chiLBSGroupsetSetQuadrature)
 RegisterFunction(chiLBSGroupsetSetAngleAggregationType)
 AddNamedConstantToNamespace(ANGLE_AGG_SINGLE,1,LBSGroupset)
 AddNamedConstantToNamespace(ANGLE_AGG_POLAR ,2,LBSGroupset)
+AddNamedConstantToNamespace(ANGLE_AGG_OCTANT,3,LBSGroupset)
+AddNamedConstantToNamespace(ANGLE_AGG_CONE  ,4,LBSGroupset)
+RegisterFunction(chiLBSGroupsetSetAngleAggLimits)
 RegisterFunction(chiLBSGroupsetSetAngleAggDiv)
 RegisterFunction(chiLBSGroupsetSetGroupSubsets)
 RegisterFunction(chiLBSGroupsetSetIterativeMethod)
 RegisterFunction(chiLBSGroupsetSetResidualTolerance)
 RegisterFunction(chiLBSGroupsetSetMaxIterations)
 RegisterFunction(chiLBSGroupsetSetGMRESRestartIntvl)
+RegisterFunction(chiLBSGroupsetSetAndersonParameters)
+RegisterFunction(chiLBSGroupsetSetKrylovMethod)
+AddNamedConstantToNamespace(DSA_IN_OPERATOR         ,0,LBSGroupset)
+AddNamedConstantToNamespace(DSA_LEFT_PRECONDITIONER ,1,LBSGroupset)
+AddNamedConstantToNamespace(DSA_RIGHT_PRECONDITIONER,2,LBSGroupset)
 RegisterFunction(chiLBSGroupsetSetEnableSweepLog)
+RegisterFunction(chiLBSGroupsetSetAutoTune)
 RegisterFunction(chiLBSGroupsetSetWGDSA)
-RegisterFunction(chiLBSGroupsetSetTGDSA)
\ No newline at end of file
+RegisterFunction(chiLBSGroupsetSetTGDSA)
+RegisterFunction(chiLBSGroupsetSetInexactDSA)
\ No newline at end of file